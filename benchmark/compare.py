@@ -0,0 +1,87 @@
+#
+# Copyright (c) 2022, INRIA
+#
+"""
+Compares two JSON reports of proxsuite-bench, e.g. obtained on two commits:
+
+    python compare.py before.json after.json [--threshold 0.05]
+
+For each problem and backend present in both reports, the ratios (after /
+before) of the median and 99th percentile of the setup and solve times are
+printed, as well as the change of the median number of iterations. The ratios
+beyond the threshold are flagged.
+"""
+import argparse
+import json
+
+
+def load(path):
+    with open(path) as f:
+        report = json.load(f)
+    results = {}
+    for r in report["results"]:
+        results[(r["source"], r["name"], r["backend"])] = r
+    return report, results
+
+
+def ratio(after, before):
+    if before == 0:
+        return float("nan")
+    return after / before
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("before")
+    parser.add_argument("after")
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=0.05,
+        help="relative change of the median times which is flagged",
+    )
+    args = parser.parse_args()
+
+    report_before, before = load(args.before)
+    report_after, after = load(args.after)
+    print(f"before: {report_before['label']}, after: {report_after['label']}")
+
+    header = (
+        f"{'problem':<36}{'backend':<8}{'setup':>8}{'solve':>8}"
+        f"{'setup p99':>11}{'solve p99':>11}{'iter':>12}"
+    )
+    print(header)
+    solve_ratios = []
+    for key in sorted(before.keys() & after.keys()):
+        b, a = before[key], after[key]
+        setup = ratio(a["setup_time"]["median"], b["setup_time"]["median"])
+        solve = ratio(a["solve_time"]["median"], b["solve_time"]["median"])
+        setup_p99 = ratio(a["setup_time"]["p99"], b["setup_time"]["p99"])
+        solve_p99 = ratio(a["solve_time"]["p99"], b["solve_time"]["p99"])
+        iterations = f"{b['iterations']['median']:g}->{a['iterations']['median']:g}"
+        flag = ""
+        if abs(solve - 1) > args.threshold or abs(setup - 1) > args.threshold:
+            flag = " *"
+        if a["solved"] != b["solved"]:
+            flag += " (solved " + f"{b['solved']}->{a['solved']})"
+        print(
+            f"{key[0] + '/' + key[1]:<36}{key[2]:<8}{setup:>8.3f}{solve:>8.3f}"
+            f"{setup_p99:>11.3f}{solve_p99:>11.3f}{iterations:>12}{flag}"
+        )
+        if solve == solve:  # not nan
+            solve_ratios.append(solve)
+
+    if solve_ratios:
+        product = 1.0
+        for r in solve_ratios:
+            product *= r
+        geometric_mean = product ** (1.0 / len(solve_ratios))
+        print(f"geometric mean of the median solve time ratios: {geometric_mean:.3f}")
+
+    missing = before.keys() ^ after.keys()
+    if missing:
+        print(f"{len(missing)} problems are only present in one of the reports")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,560 @@
+//
+// Copyright (c) 2022 INRIA
+//
+/**
+ * @file proxsuite_bench.cpp
+ *
+ * Reproducible benchmark of the dense and sparse backends of ProxQP, over the
+ * Maros-Meszaros test set and over randomly generated problems of increasing
+ * sizes. Each problem is set up and solved several times from scratch, and the
+ * median and 99th percentile of the setup and solve times are reported, with
+ * the number of iterations and the memory high-water mark of the process.
+ *
+ * The results are written in JSON, e.g. for comparing two commits with
+ * benchmark/compare.py:
+ *
+ *   proxsuite-bench --output before.json
+ *   ... (checkout and build another commit)
+ *   proxsuite-bench --output after.json
+ *   python benchmark/compare.py before.json after.json
+ *
+ * Run `proxsuite-bench --help` for the list of options.
+ */
+
+#include <maros_meszaros.hpp>
+#include <proxsuite/config.hpp>
+#include <proxsuite/proxqp/dense/dense.hpp>
+#include <proxsuite/proxqp/sparse/sparse.hpp>
+#include <proxsuite/proxqp/utils/random_qp_problems.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#ifndef PROXSUITE_BENCH_GIT_REVISION
+#define PROXSUITE_BENCH_GIT_REVISION "unknown"
+#endif
+
+using namespace proxsuite::proxqp;
+using proxsuite::linalg::veg::isize;
+using T = double;
+
+namespace {
+
+char const* maros_meszaros_problems[] = {
+  "AUG2D",    "AUG2DC",   "AUG2DCQP", "AUG2DQP",  "AUG3D",    "AUG3DC",
+  "AUG3DCQP", "AUG3DQP",  "BOYD1",    "BOYD2",    "CONT-050", "CONT-100",
+  "CONT-101", "CONT-200", "CONT-201", "CONT-300", "CVXQP1_L", "CVXQP1_M",
+  "CVXQP1_S", "CVXQP2_L", "CVXQP2_M", "CVXQP2_S", "CVXQP3_L", "CVXQP3_M",
+  "CVXQP3_S", "DPKLO1",   "DTOC3",    "DUAL1",    "DUAL2",    "DUAL3",
+  "DUAL4",    "DUALC1",   "DUALC2",   "DUALC5",   "DUALC8",   "EXDATA",
+  "GENHS28",  "GOULDQP2", "GOULDQP3", "HS118",    "HS21",     "HS268",
+  "HS35",     "HS35MOD",  "HS51",     "HS52",     "HS53",     "HS76",
+  "HUES-MOD", "HUESTIS",  "KSIP",     "LASER",    "LISWET1",  "LISWET10",
+  "LISWET11", "LISWET12", "LISWET2",  "LISWET3",  "LISWET4",  "LISWET5",
+  "LISWET6",  "LISWET7",  "LISWET8",  "LISWET9",  "LOTSCHD",  "MOSARQP1",
+  "MOSARQP2", "POWELL20", "PRIMAL1",  "PRIMAL2",  "PRIMAL3",  "PRIMAL4",
+  "PRIMALC1", "PRIMALC2", "PRIMALC5", "PRIMALC8", "Q25FV47",  "QADLITTL",
+  "QAFIRO",   "QBANDM",   "QBEACONF", "QBORE3D",  "QBRANDY",  "QCAPRI",
+  "QE226",    "QETAMACR", "QFFFFF80", "QFORPLAN", "QGFRDXPN", "QGROW15",
+  "QGROW22",  "QGROW7",   "QISRAEL",  "QPCBLEND", "QPCBOEI1", "QPCBOEI2",
+  "QPCSTAIR", "QPILOTNO", "QPTEST",   "QRECIPE",  "QSC205",   "QSCAGR25",
+  "QSCAGR7",  "QSCFXM1",  "QSCFXM2",  "QSCFXM3",  "QSCORPIO", "QSCRS8",
+  "QSCSD1",   "QSCSD6",   "QSCSD8",   "QSCTAP1",  "QSCTAP2",  "QSCTAP3",
+  "QSEBA",    "QSHARE1B", "QSHARE2B", "QSHELL",   "QSHIP04L", "QSHIP04S",
+  "QSHIP08L", "QSHIP08S", "QSHIP12L", "QSHIP12S", "QSIERRA",  "QSTAIR",
+  "QSTANDAT", "S268",     "STADAT1",  "STADAT2",  "STADAT3",  "STCQP1",
+  "STCQP2",   "TAME",     "UBH1",     "VALUES",   "YAO",      "ZECEVIC2",
+};
+
+struct BenchOptions
+{
+  std::string output = "proxsuite-bench.json";
+  std::string label = PROXSUITE_BENCH_GIT_REVISION;
+  std::string maros_meszaros_dir = PROBLEM_PATH "/data/maros_meszaros_data/";
+  std::string filter;
+  isize repetitions = 10;
+  // problems with more variables or constraints are skipped
+  isize max_size = 1000;
+  std::vector<isize> sizes = { 10, 50, 100, 200, 500 };
+  T sparsity_factor = 0.15;
+  T eps_abs = 1e-5;
+  bool dense = true;
+  bool sparse = true;
+  bool maros_meszaros = true;
+  bool random = true;
+};
+
+/*!
+ * Statistics of the repeated setups and solves of one problem by one backend.
+ */
+struct BenchResult
+{
+  std::string source;
+  std::string name;
+  std::string backend;
+  isize n;
+  isize n_eq;
+  isize n_in;
+  isize solved;
+  std::vector<T> setup_times;
+  std::vector<T> solve_times;
+  std::vector<T> iterations;
+  long memory_high_water_mark_kb;
+};
+
+/*!
+ * Returns the median of the values.
+ */
+T
+median(std::vector<T> values)
+{
+  if (values.empty()) {
+    return 0;
+  }
+  std::sort(values.begin(), values.end());
+  std::size_t k = values.size() / 2;
+  if (values.size() % 2 == 1) {
+    return values[k];
+  }
+  return (values[k - 1] + values[k]) / 2;
+}
+
+/*!
+ * Returns the given percentile of the values (nearest-rank method).
+ * @param values values.
+ * @param p percentile, in (0, 1].
+ */
+T
+percentile(std::vector<T> values, T p)
+{
+  if (values.empty()) {
+    return 0;
+  }
+  std::sort(values.begin(), values.end());
+  std::size_t rank = std::size_t(std::ceil(p * T(values.size())));
+  return values[std::min(std::max(rank, std::size_t(1)), values.size()) - 1];
+}
+
+/*!
+ * Resets the peak resident set size of the process, so that the next call to
+ * peak_rss_kb only accounts for the memory used from now on. Returns false if
+ * this is not supported, in which case the peak is the one of the whole run.
+ */
+bool
+reset_peak_rss()
+{
+#if defined(__linux__)
+  std::ofstream clear_refs("/proc/self/clear_refs");
+  clear_refs << "5";
+  clear_refs.close();
+  return !clear_refs.fail();
+#else
+  return false;
+#endif
+}
+
+/*!
+ * Returns the peak resident set size of the process (in kB), or -1 if it is
+ * not available.
+ */
+long
+peak_rss_kb()
+{
+#if defined(__linux__)
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.compare(0, 6, "VmHWM:") == 0) {
+      return std::atol(line.c_str() + 6);
+    }
+  }
+#endif
+#if defined(__APPLE__)
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return long(usage.ru_maxrss / 1024); // in bytes on macOS
+#elif defined(__unix__)
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return long(usage.ru_maxrss);
+#else
+  return -1;
+#endif
+}
+
+/*!
+ * Sets up and solves the problem from scratch opts.repetitions times, and
+ * records the timings and iterations of each run.
+ * @param make_and_solve callable taking the settings to use, and returning
+ * the results of the solve.
+ */
+template<typename F>
+BenchResult
+run(std::string source,
+    std::string name,
+    std::string backend,
+    isize n,
+    isize n_eq,
+    isize n_in,
+    BenchOptions const& opts,
+    F make_and_solve)
+{
+  BenchResult result;
+  result.source = std::move(source);
+  result.name = std::move(name);
+  result.backend = std::move(backend);
+  result.n = n;
+  result.n_eq = n_eq;
+  result.n_in = n_in;
+  result.solved = 0;
+
+  Settings<T> settings;
+  settings.eps_abs = opts.eps_abs;
+  settings.eps_rel = 0;
+  settings.max_iter = 1000000;
+  settings.compute_timings = true;
+
+  reset_peak_rss();
+  for (isize k = 0; k < opts.repetitions; ++k) {
+    Results<T> results = make_and_solve(settings);
+    result.setup_times.push_back(results.info.setup_time);
+    result.solve_times.push_back(results.info.solve_time);
+    result.iterations.push_back(T(results.info.iter));
+    if (results.info.status == QPSolverOutput::PROXQP_SOLVED) {
+      ++result.solved;
+    }
+  }
+  result.memory_high_water_mark_kb = peak_rss_kb();
+
+  std::cout << std::left << std::setw(16) << result.source << std::setw(20)
+            << result.name << std::setw(8) << result.backend
+            << " setup (median): " << std::setw(12)
+            << median(result.setup_times)
+            << " solve (median): " << std::setw(12)
+            << median(result.solve_times)
+            << " iter (median): " << median(result.iterations) << std::endl;
+  return result;
+}
+
+template<typename I>
+Results<T>
+solve_sparse(sparse::SparseMat<T, I> const& H,
+             sparse::Vec<T> const& g,
+             sparse::SparseMat<T, I> const& A,
+             sparse::Vec<T> const& b,
+             sparse::SparseMat<T, I> const& C,
+             sparse::Vec<T> const& l,
+             sparse::Vec<T> const& u,
+             Settings<T> const& settings)
+{
+  sparse::QP<T, I> qp(H.rows(), A.rows(), C.rows());
+  qp.settings = settings;
+  qp.init(H, g, A, b, C, l, u);
+  qp.solve();
+  return qp.results;
+}
+
+Results<T>
+solve_dense(dense::Mat<T> const& H,
+            dense::Vec<T> const& g,
+            dense::Mat<T> const& A,
+            dense::Vec<T> const& b,
+            dense::Mat<T> const& C,
+            dense::Vec<T> const& l,
+            dense::Vec<T> const& u,
+            Settings<T> const& settings)
+{
+  dense::QP<T> qp(H.rows(), A.rows(), C.rows());
+  qp.settings = settings;
+  qp.init(H, g, A, b, C, l, u);
+  qp.solve();
+  return qp.results;
+}
+
+bool
+file_exists(std::string const& path)
+{
+  return std::ifstream(path).good();
+}
+
+void
+bench_maros_meszaros(BenchOptions const& opts, std::vector<BenchResult>& out)
+{
+  for (char const* name : maros_meszaros_problems) {
+    if (std::string(name).find(opts.filter) == std::string::npos) {
+      continue;
+    }
+    std::string path = opts.maros_meszaros_dir + name + ".mat";
+    if (!file_exists(path)) {
+      std::cerr << "missing problem " << path << ", skipping" << std::endl;
+      continue;
+    }
+    MarosMeszarosQp qp_raw = load_qp(path.c_str());
+    isize n = qp_raw.P.rows();
+    isize n_eq_in = qp_raw.A.rows();
+    if (n > opts.max_size || n_eq_in > opts.max_size) {
+      continue;
+    }
+
+    if (opts.dense) {
+      // the dense preprocessing moves some of the vectors out of the problem
+      MarosMeszarosQp qp_copy = qp_raw;
+      PreprocessedQp qp = preprocess_qp(qp_copy);
+      out.push_back(run("maros_meszaros",
+                        name,
+                        "dense",
+                        n,
+                        qp.A.rows(),
+                        qp.C.rows(),
+                        opts,
+                        [&](Settings<T> const& settings) {
+                          return solve_dense(qp.H,
+                                             qp.g,
+                                             qp.A,
+                                             qp.b,
+                                             qp.C,
+                                             qp.l,
+                                             qp.u,
+                                             settings);
+                        }));
+    }
+    if (opts.sparse) {
+      using Mat = MarosMeszarosQp::Mat;
+      PreprocessedQpSparse qp = preprocess_qp_sparse(VEG_FWD(qp_raw));
+      Mat A = qp.AT.transpose();
+      Mat C = qp.CT.transpose();
+      out.push_back(run("maros_meszaros",
+                        name,
+                        "sparse",
+                        n,
+                        A.rows(),
+                        C.rows(),
+                        opts,
+                        [&](Settings<T> const& settings) {
+                          return solve_sparse<mat_int32_t>(
+                            qp.H, qp.g, A, qp.b, C, qp.l, qp.u, settings);
+                        }));
+    }
+  }
+}
+
+void
+bench_random(BenchOptions const& opts, std::vector<BenchResult>& out)
+{
+  T strong_convexity_factor(1.e-2);
+  for (isize n : opts.sizes) {
+    isize n_eq = n / 4;
+    isize n_in = n / 4;
+    std::string name = "strongly_convex_" + std::to_string(n);
+    if (name.find(opts.filter) == std::string::npos) {
+      continue;
+    }
+
+    if (opts.dense) {
+      // the seed is fixed so that the problems are the same between runs
+      utils::rand::set_seed(1);
+      dense::Model<T> qp = utils::dense_strongly_convex_qp(
+        n, n_eq, n_in, opts.sparsity_factor, strong_convexity_factor);
+      out.push_back(run("random",
+                        name,
+                        "dense",
+                        n,
+                        n_eq,
+                        n_in,
+                        opts,
+                        [&](Settings<T> const& settings) {
+                          return solve_dense(qp.H,
+                                             qp.g,
+                                             qp.A,
+                                             qp.b,
+                                             qp.C,
+                                             qp.l,
+                                             qp.u,
+                                             settings);
+                        }));
+    }
+    if (opts.sparse) {
+      using I = utils::c_int;
+      utils::rand::set_seed(1);
+      sparse::SparseModel<T> qp = utils::sparse_strongly_convex_qp(
+        n, n_eq, n_in, opts.sparsity_factor, strong_convexity_factor);
+      sparse::SparseMat<T, I> H = qp.H;
+      sparse::SparseMat<T, I> A = qp.A;
+      sparse::SparseMat<T, I> C = qp.C;
+      out.push_back(run("random",
+                        name,
+                        "sparse",
+                        n,
+                        n_eq,
+                        n_in,
+                        opts,
+                        [&](Settings<T> const& settings) {
+                          return solve_sparse<I>(
+                            H, qp.g, A, qp.b, C, qp.l, qp.u, settings);
+                        }));
+    }
+  }
+}
+
+void
+write_statistics(std::ostream& os, char const* key, std::vector<T> const& v)
+{
+  os << "\"" << key << "\": {\"median\": " << median(v)
+     << ", \"p99\": " << percentile(v, T(0.99))
+     << ", \"min\": " << *std::min_element(v.begin(), v.end())
+     << ", \"max\": " << *std::max_element(v.begin(), v.end()) << "}";
+}
+
+void
+write_json(std::ostream& os,
+           BenchOptions const& opts,
+           bool memory_reset,
+           std::vector<BenchResult> const& results)
+{
+  os << std::setprecision(10);
+  os << "{\n";
+  os << "  \"label\": \"" << opts.label << "\",\n";
+  os << "  \"proxsuite_version\": \"" << PROXSUITE_VERSION << "\",\n";
+#ifdef PROXSUITE_VECTORIZE
+  os << "  \"vectorized\": true,\n";
+#else
+  os << "  \"vectorized\": false,\n";
+#endif
+#ifdef PROXSUITE_ENABLE_OPENMP
+  os << "  \"openmp\": true,\n";
+#else
+  os << "  \"openmp\": false,\n";
+#endif
+  os << "  \"repetitions\": " << opts.repetitions << ",\n";
+  os << "  \"eps_abs\": " << opts.eps_abs << ",\n";
+  os << "  \"sparsity_factor\": " << opts.sparsity_factor << ",\n";
+  os << "  \"time_unit\": \"us\",\n";
+  // without a reset, the high-water mark is the one of the whole run so far
+  os << "  \"memory_high_water_mark_per_problem\": "
+     << (memory_reset ? "true" : "false") << ",\n";
+  os << "  \"results\": [";
+  for (std::size_t k = 0; k < results.size(); ++k) {
+    BenchResult const& r = results[k];
+    os << (k == 0 ? "\n" : ",\n");
+    os << "    {\"source\": \"" << r.source << "\", \"name\": \"" << r.name
+       << "\", \"backend\": \"" << r.backend << "\", \"n\": " << r.n
+       << ", \"n_eq\": " << r.n_eq << ", \"n_in\": " << r.n_in
+       << ", \"solved\": " << r.solved << ", ";
+    write_statistics(os, "setup_time", r.setup_times);
+    os << ", ";
+    write_statistics(os, "solve_time", r.solve_times);
+    os << ", ";
+    write_statistics(os, "iterations", r.iterations);
+    os << ", \"memory_high_water_mark_kb\": " << r.memory_high_water_mark_kb
+       << "}";
+  }
+  os << "\n  ]\n}\n";
+}
+
+void
+print_help()
+{
+  std::cout
+    << "usage: proxsuite-bench [options]\n"
+       "  --output FILE            JSON report (default proxsuite-bench.json)\n"
+       "  --label LABEL            label of the run (default: git revision)\n"
+       "  --repetitions N          setups and solves per problem (default "
+       "10)\n"
+       "  --backend dense|sparse   only benchmark the given backend\n"
+       "  --maros-meszaros-only    skip the random problems\n"
+       "  --random-only            skip the Maros-Meszaros problems\n"
+       "  --maros-meszaros-dir DIR directory of the .mat files\n"
+       "  --max-size N             skip Maros-Meszaros problems with more than "
+       "N\n"
+       "                           variables or constraints (default 1000)\n"
+       "  --sizes N1,N2,...        sizes of the random problems\n"
+       "  --sparsity-factor S      density of the random problems (default "
+       "0.15)\n"
+       "  --eps-abs EPS            absolute accuracy (default 1e-5)\n"
+       "  --filter STRING          only run the problems whose name contains "
+       "STRING\n";
+}
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+  BenchOptions opts;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool has_value = i + 1 < argc;
+    if (arg == "--help" || arg == "-h") {
+      print_help();
+      return 0;
+    } else if (arg == "--maros-meszaros-only") {
+      opts.random = false;
+    } else if (arg == "--random-only") {
+      opts.maros_meszaros = false;
+    } else if (!has_value) {
+      std::cerr << "unknown option or missing value: " << arg << std::endl;
+      print_help();
+      return 1;
+    } else if (arg == "--output") {
+      opts.output = argv[++i];
+    } else if (arg == "--label") {
+      opts.label = argv[++i];
+    } else if (arg == "--repetitions") {
+      opts.repetitions = std::max(std::atol(argv[++i]), 1L);
+    } else if (arg == "--backend") {
+      std::string backend = argv[++i];
+      opts.dense = backend == "dense";
+      opts.sparse = backend == "sparse";
+    } else if (arg == "--maros-meszaros-dir") {
+      opts.maros_meszaros_dir = std::string(argv[++i]) + "/";
+    } else if (arg == "--max-size") {
+      opts.max_size = std::atol(argv[++i]);
+    } else if (arg == "--sizes") {
+      opts.sizes.clear();
+      std::stringstream sizes(argv[++i]);
+      std::string size;
+      while (std::getline(sizes, size, ',')) {
+        opts.sizes.push_back(std::atol(size.c_str()));
+      }
+    } else if (arg == "--sparsity-factor") {
+      opts.sparsity_factor = std::atof(argv[++i]);
+    } else if (arg == "--eps-abs") {
+      opts.eps_abs = std::atof(argv[++i]);
+    } else if (arg == "--filter") {
+      opts.filter = argv[++i];
+    } else {
+      std::cerr << "unknown option: " << arg << std::endl;
+      print_help();
+      return 1;
+    }
+  }
+
+  bool memory_reset = reset_peak_rss();
+  std::vector<BenchResult> results;
+  if (opts.maros_meszaros) {
+    bench_maros_meszaros(opts, results);
+  }
+  if (opts.random) {
+    bench_random(opts, results);
+  }
+
+  std::ofstream output(opts.output);
+  write_json(output, opts, memory_reset, results);
+  if (!output) {
+    std::cerr << "could not write " << opts.output << std::endl;
+    return 1;
+  }
+  std::cout << "report written to " << opts.output << std::endl;
+  return 0;
+}
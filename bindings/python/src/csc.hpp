@@ -0,0 +1,86 @@
+//
+// Copyright (c) 2022 INRIA
+//
+#ifndef proxsuite_python_csc_hpp
+#define proxsuite_python_csc_hpp
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <proxsuite/linalg/sparse/core.hpp>
+#include <memory>
+#include <string>
+
+namespace pybind11 {
+namespace detail {
+
+/*!
+ * Loads a scipy.sparse.csc_matrix (with sorted indices, and index and value
+ * types matching I and T) as a view on its indptr, indices and data buffers,
+ * without copying them. The buffers are kept alive by the caster during the
+ * call. Other inputs are rejected, so that pybind11 falls back on the next
+ * overload (which copies the matrix into an Eigen sparse matrix).
+ */
+template<typename T, typename I>
+struct type_caster<proxsuite::linalg::sparse::MatRef<T, I>>
+{
+  using Type = proxsuite::linalg::sparse::MatRef<T, I>;
+  template<typename U>
+  using Buffer = array_t<U, array::c_style>;
+
+  bool load(handle src, bool /*convert*/)
+  {
+    if (!hasattr(src, "format") || !hasattr(src, "has_sorted_indices") ||
+        src.attr("format").cast<std::string>() != "csc" ||
+        !src.attr("has_sorted_indices").cast<bool>()) {
+      return false;
+    }
+    object indptr = src.attr("indptr");
+    object indices = src.attr("indices");
+    object data = src.attr("data");
+    if (!Buffer<I>::check_(indptr) || !Buffer<I>::check_(indices) ||
+        !Buffer<T>::check_(data)) {
+      return false;
+    }
+    auto col_ptrs = reinterpret_borrow<Buffer<I>>(indptr);
+    auto row_indices = reinterpret_borrow<Buffer<I>>(indices);
+    auto values = reinterpret_borrow<Buffer<T>>(data);
+
+    tuple shape = src.attr("shape");
+    proxsuite::linalg::veg::isize nrows = shape[0].cast<ssize_t>();
+    proxsuite::linalg::veg::isize ncols = shape[1].cast<ssize_t>();
+    if (col_ptrs.size() != ncols + 1) {
+      return false;
+    }
+    proxsuite::linalg::veg::isize nnz = col_ptrs.at(ncols);
+    if (row_indices.size() < nnz || values.size() < nnz) {
+      return false;
+    }
+    value.reset(new Type(proxsuite::linalg::sparse::from_raw_parts,
+                         nrows,
+                         ncols,
+                         nnz,
+                         col_ptrs.data(),
+                         nullptr,
+                         row_indices.data(),
+                         values.data()));
+    buffers = make_tuple(indptr, indices, data);
+    return true;
+  }
+
+  // MatRef is not default constructible, hence it is stored behind a pointer
+  static constexpr auto name = _("scipy.sparse.csc_matrix");
+  template<typename U>
+  using cast_op_type = movable_cast_op_type<U>;
+  operator Type*() { return value.get(); }
+  operator Type&() { return *value; }
+  operator Type&&() && { return std::move(*value); }
+
+private:
+  std::unique_ptr<Type> value;
+  object buffers; // keeps the borrowed buffers alive
+};
+
+} // namespace detail
+} // namespace pybind11
+
+#endif // ifndef proxsuite_python_csc_hpp
@@ -29,6 +29,8 @@ exposeSparseAlgorithms(pybind11::module_ m)
   sparse::python::exposeSparseModel<T, I>(m);
   sparse::python::exposeQpObjectSparse<T, I>(m);
   sparse::python::solveSparseQp<T, I>(m);
+  sparse::python::exposeParallel<T, I>(m);
+  sparse::python::exposeQpFile<T, I>(m);
 }
 
 template<typename T>
@@ -38,6 +40,8 @@ exposeDenseAlgorithms(pybind11::module_ m)
   dense::python::exposeDenseModel<T>(m);
   dense::python::exposeQpObjectDense<T>(m);
   dense::python::solveDenseQp<T>(m);
+  dense::python::exposeParallel<T>(m);
+  dense::python::exposeQpFile<T>(m);
 }
 
 PYBIND11_MODULE(PYTHON_MODULE_NAME, m)
@@ -22,10 +22,17 @@ void
 exposeDenseModel(pybind11::module_ m)
 {
   ::pybind11::class_<proxsuite::proxqp::dense::Model<T>>(m, "model")
-    .def(::pybind11::init<i64, i64, i64>(),
+    .def(::pybind11::init<i64, i64, i64, bool, HessianType>(),
          pybind11::arg_v("n", 0, "primal dimension."),
          pybind11::arg_v("n_eq", 0, "number of equality constraints."),
          pybind11::arg_v("n_in", 0, "number of inequality constraints."),
+         pybind11::arg_v("box_constraints",
+                         false,
+                         "whether the model has box constraints on the primal "
+                         "variable."),
+         pybind11::arg_v("hessian_type",
+                         HessianType::Dense,
+                         "structure of the hessian (Dense, Zero or Diagonal)."),
          "Constructor using QP model dimensions.") // constructor)
     .def_readonly("H", &Model<T>::H)
     .def_readonly("g", &Model<T>::g)
@@ -34,10 +41,14 @@ exposeDenseModel(pybind11::module_ m)
     .def_readonly("C", &Model<T>::C)
     .def_readonly("l", &Model<T>::l)
     .def_readonly("u", &Model<T>::u)
+    .def_readonly("l_box", &Model<T>::l_box)
+    .def_readonly("u_box", &Model<T>::u_box)
     .def_readonly("dim", &Model<T>::dim)
     .def_readonly("n_eq", &Model<T>::n_eq)
     .def_readonly("n_in", &Model<T>::n_in)
     .def_readonly("n_total", &Model<T>::n_total)
+    .def_readonly("box_constraints", &Model<T>::box_constraints)
+    .def_readonly("hessian_type", &Model<T>::hessian_type)
     .def("is_valid",
          &Model<T>::is_valid,
          "Check if model is containing valid data.")
@@ -0,0 +1,277 @@
+//
+// Copyright (c) 2022 INRIA
+//
+#include <proxsuite/proxqp/parallel/qp_solve.hpp>
+#include <pybind11/pybind11.h>
+#include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+#include <algorithm>
+#include <exception>
+
+#include "optional.hpp"
+
+namespace proxsuite {
+namespace proxqp {
+using proxsuite::linalg::veg::isize;
+
+namespace dense {
+namespace python {
+
+template<typename T>
+using StackedArray =
+  pybind11::array_t<T, pybind11::array::c_style | pybind11::array::forcecast>;
+
+/*!
+ * Checks that the stacked array has the expected shape.
+ * @param array stacked array.
+ * @param shape expected shape.
+ * @param name name of the array (used in the error message).
+ */
+template<typename T>
+void
+check_stacked_shape(const StackedArray<T>& array,
+                    std::initializer_list<isize> shape,
+                    const char* name)
+{
+  bool valid = array.ndim() == isize(shape.size());
+  isize k = 0;
+  for (isize dim : shape) {
+    valid = valid && array.shape(k) == dim;
+    ++k;
+  }
+  PROXSUITE_THROW_PRETTY(!valid,
+                         std::invalid_argument,
+                         "wrong shape for the stacked array " << name << ".");
+}
+
+/*!
+ * Solves in parallel a batch of dense QPs stacked along the first dimension
+ * of the input arrays, and returns the stacked primal and dual solutions.
+ * The GIL is released while the QPs are set up and solved.
+ */
+template<typename T>
+auto
+solve_batch(StackedArray<T> H,
+            StackedArray<T> g,
+            optional<StackedArray<T>> A,
+            optional<StackedArray<T>> b,
+            optional<StackedArray<T>> C,
+            optional<StackedArray<T>> l,
+            optional<StackedArray<T>> u,
+            optional<T> eps_abs,
+            optional<T> eps_rel,
+            optional<isize> max_iter,
+            optional<std::size_t> num_threads) -> pybind11::tuple
+{
+  PROXSUITE_THROW_PRETTY(H.ndim() != 3,
+                         std::invalid_argument,
+                         "H should be of shape (batch_size, dim, dim).");
+  isize batch_size = H.shape(0);
+  isize n = H.shape(1);
+  isize n_eq = A ? A.value().shape(1) : 0;
+  isize n_in = C ? C.value().shape(1) : 0;
+  PROXSUITE_THROW_PRETTY(bool(A) != bool(b) || bool(C) != bool(l) ||
+                           bool(C) != bool(u),
+                         std::invalid_argument,
+                         "A and b (resp. C, l and u) should be provided "
+                         "together.");
+  check_stacked_shape<T>(H, { batch_size, n, n }, "H");
+  check_stacked_shape<T>(g, { batch_size, n }, "g");
+  if (A) {
+    check_stacked_shape<T>(A.value(), { batch_size, n_eq, n }, "A");
+    check_stacked_shape<T>(b.value(), { batch_size, n_eq }, "b");
+  }
+  if (C) {
+    check_stacked_shape<T>(C.value(), { batch_size, n_in, n }, "C");
+    check_stacked_shape<T>(l.value(), { batch_size, n_in }, "l");
+    check_stacked_shape<T>(u.value(), { batch_size, n_in }, "u");
+  }
+  std::size_t NUM_THREADS = helpers::get_default_num_threads();
+  if (num_threads != nullopt) {
+    NUM_THREADS = num_threads.value();
+  }
+  PROXSUITE_THROW_PRETTY(NUM_THREADS == 0,
+                         std::invalid_argument,
+                         "the number of threads should be positive.");
+
+  BatchQP<T> qps(static_cast<std::size_t>(batch_size));
+  for (isize i = 0; i < batch_size; ++i) {
+    QP<T>& qp = qps.init_qp_in_place(n, n_eq, n_in);
+    if (eps_abs != nullopt) {
+      qp.settings.eps_abs = eps_abs.value();
+    }
+    if (eps_rel != nullopt) {
+      qp.settings.eps_rel = eps_rel.value();
+    }
+    if (max_iter != nullopt) {
+      qp.settings.max_iter = max_iter.value();
+    }
+  }
+
+  StackedArray<T> x({ batch_size, n });
+  StackedArray<T> y({ batch_size, n_eq });
+  StackedArray<T> z({ batch_size, n_in });
+
+  T const* H_ptr = H.data();
+  T const* g_ptr = g.data();
+  T const* A_ptr = A ? A.value().data() : nullptr;
+  T const* b_ptr = b ? b.value().data() : nullptr;
+  T const* C_ptr = C ? C.value().data() : nullptr;
+  T const* l_ptr = l ? l.value().data() : nullptr;
+  T const* u_ptr = u ? u.value().data() : nullptr;
+  T* x_ptr = x.mutable_data();
+  T* y_ptr = y.mutable_data();
+  T* z_ptr = z.mutable_data();
+
+  std::exception_ptr error = nullptr;
+  {
+    pybind11::gil_scoped_release release;
+
+    using RowMajorMap = Eigen::Map<
+      const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>;
+    using VecMap = Eigen::Map<const Vec<T>>;
+
+    std::ptrdiff_t i = 0;
+#ifdef PROXSUITE_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic, 1)                                  \
+  num_threads(static_cast<int>(NUM_THREADS))
+#endif
+    for (i = 0; i < batch_size; i++) {
+      // exceptions cannot escape the parallel region
+      try {
+        // the arrays are stored in row major order
+        Mat<T> H_i = RowMajorMap(H_ptr + i * n * n, n, n);
+        Vec<T> g_i = VecMap(g_ptr + i * n, n);
+        Mat<T> A_i(n_eq, n);
+        Vec<T> b_i(n_eq);
+        Mat<T> C_i(n_in, n);
+        Vec<T> l_i(n_in);
+        Vec<T> u_i(n_in);
+        if (A_ptr != nullptr) {
+          A_i = RowMajorMap(A_ptr + i * n_eq * n, n_eq, n);
+          b_i = VecMap(b_ptr + i * n_eq, n_eq);
+        }
+        if (C_ptr != nullptr) {
+          C_i = RowMajorMap(C_ptr + i * n_in * n, n_in, n);
+          l_i = VecMap(l_ptr + i * n_in, n_in);
+          u_i = VecMap(u_ptr + i * n_in, n_in);
+        }
+
+        QP<T>& qp = qps.get(isize(i));
+        qp.init(H_i, g_i, A_i, b_i, C_i, l_i, u_i);
+        qp.solve();
+
+        std::copy_n(qp.results.x.data(), n, x_ptr + i * n);
+        std::copy_n(qp.results.y.data(), n_eq, y_ptr + i * n_eq);
+        std::copy_n(qp.results.z.data(), n_in, z_ptr + i * n_in);
+      } catch (...) {
+#ifdef PROXSUITE_ENABLE_OPENMP
+#pragma omp critical
+#endif
+        error = std::current_exception();
+      }
+    }
+  }
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+  return pybind11::make_tuple(x, y, z);
+}
+
+template<typename T>
+void
+exposeParallel(pybind11::module_ m)
+{
+  ::pybind11::class_<dense::BatchQP<T>>(m, "BatchQP")
+    .def(::pybind11::init<std::size_t>(),
+         pybind11::arg("batch_size"),
+         "Default constructor using the maximal number of QPs held by the "
+         "batch.")
+    .def("init_qp_in_place",
+         &dense::BatchQP<T>::init_qp_in_place,
+         pybind11::return_value_policy::reference_internal,
+         pybind11::arg("dim"),
+         pybind11::arg("n_eq"),
+         pybind11::arg("n_in"),
+         "Constructs in place a new QP at the end of the batch and returns "
+         "it.")
+    .def("get",
+         static_cast<dense::QP<T>& (dense::BatchQP<T>::*)(isize)>(
+           &dense::BatchQP<T>::get),
+         pybind11::return_value_policy::reference_internal,
+         pybind11::arg("i"),
+         "Returns the i-th QP of the batch.")
+    .def("size",
+         &dense::BatchQP<T>::size,
+         "Returns the number of QPs held by the batch.");
+
+  m.def(
+    "solve_in_parallel",
+    [](dense::BatchQP<T>& qps, optional<std::size_t> num_threads) {
+      parallel::solve_in_parallel(qps, num_threads);
+    },
+    "Solves in parallel a batch of QPs, which must have been initialized "
+    "beforehand. The GIL is released during the solves.",
+    pybind11::arg("qps"),
+    pybind11::arg_v("num_threads", nullopt, "number of threads used."),
+    pybind11::call_guard<pybind11::gil_scoped_release>());
+  m.def(
+    "solve_in_parallel",
+    [](std::vector<dense::QP<T>*> qps, optional<std::size_t> num_threads) {
+      parallel::solve_in_parallel(qps, num_threads);
+    },
+    "Solves in parallel a list of QPs, which must have been initialized "
+    "beforehand. The GIL is released during the solves.",
+    pybind11::arg("qps"),
+    pybind11::arg_v("num_threads", nullopt, "number of threads used."),
+    pybind11::call_guard<pybind11::gil_scoped_release>());
+
+  m.def("solve_batch",
+        &solve_batch<T>,
+        "Solves in parallel a batch of QPs stacked along the first dimension "
+        "of the input arrays (e.g., H of shape (batch_size, dim, dim)), and "
+        "returns the stacked solutions (x, y, z). The GIL is released during "
+        "the solves.",
+        pybind11::arg("H"),
+        pybind11::arg("g"),
+        pybind11::arg_v("A", nullopt, "stacked equality constraint matrices."),
+        pybind11::arg_v("b", nullopt, "stacked equality constraint vectors."),
+        pybind11::arg_v(
+          "C", nullopt, "stacked inequality constraint matrices."),
+        pybind11::arg_v(
+          "l", nullopt, "stacked lower inequality constraint vectors."),
+        pybind11::arg_v(
+          "u", nullopt, "stacked upper inequality constraint vectors."),
+        pybind11::arg_v("eps_abs", nullopt, "absolute accuracy level."),
+        pybind11::arg_v("eps_rel", nullopt, "relative accuracy level."),
+        pybind11::arg_v("max_iter", nullopt, "maximum number of iteration."),
+        pybind11::arg_v("num_threads", nullopt, "number of threads used."));
+}
+
+} // namespace python
+} // namespace dense
+
+namespace sparse {
+namespace python {
+
+template<typename T, typename I>
+void
+exposeParallel(pybind11::module_ m)
+{
+  m.def(
+    "solve_in_parallel",
+    [](std::vector<sparse::QP<T, I>*> qps, optional<std::size_t> num_threads) {
+      parallel::solve_in_parallel(qps, num_threads);
+    },
+    "Solves in parallel a list of QPs, which must have been initialized "
+    "beforehand. The GIL is released during the solves.",
+    pybind11::arg("qps"),
+    pybind11::arg_v("num_threads", nullopt, "number of threads used."),
+    pybind11::call_guard<pybind11::gil_scoped_release>());
+}
+
+} // namespace python
+} // namespace sparse
+} // namespace proxqp
+} // namespace proxsuite
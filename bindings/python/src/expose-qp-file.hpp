@@ -0,0 +1,253 @@
+//
+// Copyright (c) 2022 INRIA
+//
+#include <pybind11/pybind11.h>
+#include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
+#include <vector>
+
+#include <proxsuite/serialization/qp_file.hpp>
+
+namespace proxsuite {
+namespace proxqp {
+
+namespace python {
+/*!
+ * Returns a read-only numpy array viewing the given data of a mapped QP file,
+ * which is kept alive by the array.
+ */
+template<typename U>
+pybind11::array
+mapped_array(const U* data,
+             std::vector<isize> shape,
+             pybind11::handle owner)
+{
+  std::vector<isize> strides(shape.size(), isize(sizeof(U)));
+  if (shape.size() == 2) {
+    strides[0] = shape[1] * isize(sizeof(U)); // row major
+  }
+  pybind11::array array(pybind11::dtype::of<U>(), shape, strides, data, owner);
+  array.attr("setflags")(pybind11::arg("write") = false);
+  return array;
+}
+} // namespace python
+
+namespace dense {
+namespace python {
+
+template<typename T>
+void
+exposeQpFile(pybind11::module_ m)
+{
+  using QpFile = serialization::DenseQpFile<T>;
+  using proxqp::python::mapped_array;
+  ::pybind11::class_<QpFile>(m, "QpFile")
+    .def(::pybind11::init<const std::string&>(),
+         pybind11::arg("filename"),
+         "Maps in memory a QP file storing a dense problem. The arrays of the "
+         "problem are read-only views on the mapping, without copies.")
+    .def_property_readonly("dim", &QpFile::dim)
+    .def_property_readonly("n_eq", &QpFile::n_eq)
+    .def_property_readonly("n_in", &QpFile::n_in)
+    .def_property_readonly("box_constraints", &QpFile::box_constraints)
+    .def_property_readonly("hessian_type", &QpFile::hessian_type)
+    .def_property_readonly("H",
+                           [](pybind11::object self) {
+                             QpFile& file = self.cast<QpFile&>();
+                             return mapped_array(
+                               file.H().data(),
+                               { file.H().rows(), file.H().cols() },
+                               self);
+                           })
+    .def_property_readonly("g",
+                           [](pybind11::object self) {
+                             QpFile& file = self.cast<QpFile&>();
+                             return mapped_array(
+                               file.g().data(), { file.dim() }, self);
+                           })
+    .def_property_readonly("A",
+                           [](pybind11::object self) {
+                             QpFile& file = self.cast<QpFile&>();
+                             return mapped_array(file.A().data(),
+                                                 { file.n_eq(), file.dim() },
+                                                 self);
+                           })
+    .def_property_readonly("b",
+                           [](pybind11::object self) {
+                             QpFile& file = self.cast<QpFile&>();
+                             return mapped_array(
+                               file.b().data(), { file.n_eq() }, self);
+                           })
+    .def_property_readonly("C",
+                           [](pybind11::object self) {
+                             QpFile& file = self.cast<QpFile&>();
+                             return mapped_array(file.C().data(),
+                                                 { file.n_in(), file.dim() },
+                                                 self);
+                           })
+    .def_property_readonly("l",
+                           [](pybind11::object self) {
+                             QpFile& file = self.cast<QpFile&>();
+                             return mapped_array(
+                               file.l().data(), { file.n_in() }, self);
+                           })
+    .def_property_readonly("u",
+                           [](pybind11::object self) {
+                             QpFile& file = self.cast<QpFile&>();
+                             return mapped_array(
+                               file.u().data(), { file.n_in() }, self);
+                           })
+    .def_property_readonly("l_box",
+                           [](pybind11::object self) {
+                             QpFile& file = self.cast<QpFile&>();
+                             return mapped_array(file.l_box().data(),
+                                                 { file.l_box().size() },
+                                                 self);
+                           })
+    .def_property_readonly("u_box", [](pybind11::object self) {
+      QpFile& file = self.cast<QpFile&>();
+      return mapped_array(file.u_box().data(), { file.u_box().size() }, self);
+    });
+
+  m.def(
+    "save_qp_file",
+    [](const Model<T>& model, const std::string& filename) {
+      serialization::saveToQpFile(model, filename);
+    },
+    "Saves the problem of a dense model (e.g., qp.model) to a QP file.",
+    pybind11::arg("model"),
+    pybind11::arg("filename"));
+}
+
+} // namespace python
+} // namespace dense
+
+namespace sparse {
+namespace python {
+
+template<typename T, typename I>
+void
+exposeQpFile(pybind11::module_ m)
+{
+  using QpFile = serialization::SparseQpFile<T, I>;
+  using proxqp::python::mapped_array;
+  // views the arrays of a compressed column matrix of the mapping as a scipy
+  // csc matrix, or as the csr matrix of its transpose
+  auto scipy_matrix = [](proxsuite::linalg::sparse::MatRef<T, I> mat,
+                         bool transpose,
+                         pybind11::handle owner) {
+    pybind11::object scipy_sparse = pybind11::module_::import("scipy.sparse");
+    isize nnz = mat.nnz();
+    pybind11::tuple arrays = pybind11::make_tuple(
+      mapped_array(mat.values(), { nnz }, owner),
+      mapped_array(mat.row_indices(), { nnz }, owner),
+      mapped_array(mat.col_ptrs(), { mat.ncols() + 1 }, owner));
+    pybind11::tuple shape =
+      transpose ? pybind11::make_tuple(mat.ncols(), mat.nrows())
+                : pybind11::make_tuple(mat.nrows(), mat.ncols());
+    return scipy_sparse.attr(transpose ? "csr_matrix" : "csc_matrix")(
+      arrays, pybind11::arg("shape") = shape, pybind11::arg("copy") = false);
+  };
+
+  ::pybind11::class_<QpFile>(m, "QpFile")
+    .def(::pybind11::init<const std::string&>(),
+         pybind11::arg("filename"),
+         "Maps in memory a QP file storing a sparse problem. The arrays of "
+         "the problem are read-only views on the mapping, without copies.")
+    .def_property_readonly("dim", &QpFile::dim)
+    .def_property_readonly("n_eq", &QpFile::n_eq)
+    .def_property_readonly("n_in", &QpFile::n_in)
+    .def_property_readonly(
+      "H",
+      [scipy_matrix](pybind11::object self) {
+        QpFile& file = self.cast<QpFile&>();
+        return scipy_matrix(file.H(), false, self);
+      },
+      "Upper triangular part of the hessian (scipy.sparse.csc_matrix).")
+    .def_property_readonly(
+      "A",
+      [scipy_matrix](pybind11::object self) {
+        QpFile& file = self.cast<QpFile&>();
+        // the columns of AT are the rows of A
+        return scipy_matrix(file.AT(), true, self);
+      },
+      "Equality constraint matrix (scipy.sparse.csr_matrix).")
+    .def_property_readonly(
+      "C",
+      [scipy_matrix](pybind11::object self) {
+        QpFile& file = self.cast<QpFile&>();
+        return scipy_matrix(file.CT(), true, self);
+      },
+      "Inequality constraint matrix (scipy.sparse.csr_matrix).")
+    .def_property_readonly("g",
+                           [](pybind11::object self) {
+                             QpFile& file = self.cast<QpFile&>();
+                             return mapped_array(
+                               file.g().data(), { file.dim() }, self);
+                           })
+    .def_property_readonly("b",
+                           [](pybind11::object self) {
+                             QpFile& file = self.cast<QpFile&>();
+                             return mapped_array(
+                               file.b().data(), { file.n_eq() }, self);
+                           })
+    .def_property_readonly("l",
+                           [](pybind11::object self) {
+                             QpFile& file = self.cast<QpFile&>();
+                             return mapped_array(
+                               file.l().data(), { file.n_in() }, self);
+                           })
+    .def_property_readonly("u", [](pybind11::object self) {
+      QpFile& file = self.cast<QpFile&>();
+      return mapped_array(file.u().data(), { file.n_in() }, self);
+    });
+
+  m.def(
+    "save_qp_file",
+    [](const SparseMat<T, I>& H,
+       const Vec<T>& g,
+       const SparseMat<T, I>& A,
+       const Vec<T>& b,
+       const SparseMat<T, I>& C,
+       const Vec<T>& l,
+       const Vec<T>& u,
+       const std::string& filename) {
+      SparseMat<T, I> AT = A.transpose();
+      SparseMat<T, I> CT = C.transpose();
+      using proxsuite::linalg::sparse::DenseVecRef;
+      using proxsuite::linalg::sparse::MatRef;
+      using proxsuite::linalg::sparse::from_eigen;
+      QpView<T, I> qp = {
+        MatRef<T, I>(from_eigen, H),  DenseVecRef<T>(from_eigen, g),
+        MatRef<T, I>(from_eigen, AT), DenseVecRef<T>(from_eigen, b),
+        MatRef<T, I>(from_eigen, CT), DenseVecRef<T>(from_eigen, l),
+        DenseVecRef<T>(from_eigen, u),
+      };
+      serialization::saveToQpFile(qp, filename);
+    },
+    "Saves a sparse problem to a QP file (only the upper triangular part of "
+    "H is stored).",
+    pybind11::arg("H"),
+    pybind11::arg("g"),
+    pybind11::arg("A"),
+    pybind11::arg("b"),
+    pybind11::arg("C"),
+    pybind11::arg("l"),
+    pybind11::arg("u"),
+    pybind11::arg("filename"));
+  m.def(
+    "save_qp_file",
+    [](const Model<T, I>& model, const std::string& filename) {
+      serialization::saveToQpFile(model, filename);
+    },
+    "Saves the (unscaled) problem of an initialized sparse model (e.g., "
+    "qp.model) to a QP file.",
+    pybind11::arg("model"),
+    pybind11::arg("filename"));
+}
+
+} // namespace python
+} // namespace sparse
+
+} // namespace proxqp
+} // namespace proxsuite
@@ -12,6 +12,8 @@
 #include <proxsuite/serialization/archive.hpp>
 #include <proxsuite/serialization/wrapper.hpp>
 
+#include "csc.hpp"
+
 namespace proxsuite {
 namespace proxqp {
 using proxsuite::linalg::veg::isize;
@@ -26,10 +28,22 @@ exposeQpObjectDense(pybind11::module_ m)
 {
 
   ::pybind11::class_<dense::QP<T>>(m, "QP")
-    .def(::pybind11::init<i64, i64, i64>(),
+    .def(::pybind11::init<i64, i64, i64, bool, HessianType, DenseBackend>(),
          pybind11::arg_v("n", 0, "primal dimension."),
          pybind11::arg_v("n_eq", 0, "number of equality constraints."),
          pybind11::arg_v("n_in", 0, "number of inequality constraints."),
+         pybind11::arg_v("box_constraints",
+                         false,
+                         "whether the QP has box constraints on the primal "
+                         "variable."),
+         pybind11::arg_v("hessian_type",
+                         HessianType::Dense,
+                         "structure of the hessian (Dense, Zero or Diagonal): "
+                         "a diagonal hessian may be given as its diagonal."),
+         pybind11::arg_v("dense_backend",
+                         DenseBackend::PrimalDualLDLT,
+                         "factorization backend (Automatic, PrimalDualLDLT or "
+                         "PrimalLDLT)."),
          "Default constructor using QP model dimensions.") // constructor
     .def_readwrite(
       "results",
@@ -71,15 +85,50 @@ exposeQpObjectDense(pybind11::module_ m)
            "mu_eq", nullopt, "dual equality constraint proximal parameter"),
          pybind11::arg_v(
            "mu_in", nullopt, "dual inequality constraint proximal parameter"))
+    .def("init",
+         static_cast<void (dense::QP<T>::*)(optional<dense::MatRef<T>>,
+                                            optional<dense::VecRef<T>>,
+                                            optional<dense::MatRef<T>>,
+                                            optional<dense::VecRef<T>>,
+                                            optional<dense::MatRef<T>>,
+                                            optional<dense::VecRef<T>>,
+                                            optional<dense::VecRef<T>>,
+                                            optional<dense::VecRef<T>>,
+                                            optional<dense::VecRef<T>>,
+                                            bool compute_preconditioner,
+                                            optional<T>,
+                                            optional<T>,
+                                            optional<T>)>(&dense::QP<T>::init),
+         "function for initialize the QP model with box constraints.",
+         pybind11::arg_v("H", nullopt, "quadratic cost"),
+         pybind11::arg_v("g", nullopt, "linear cost"),
+         pybind11::arg_v("A", nullopt, "equality constraint matrix"),
+         pybind11::arg_v("b", nullopt, "equality constraint vector"),
+         pybind11::arg_v("C", nullopt, "inequality constraint matrix"),
+         pybind11::arg_v("l", nullopt, "upper inequality constraint vector"),
+         pybind11::arg_v("u", nullopt, "lower inequality constraint vector"),
+         pybind11::arg_v("l_box", nullopt, "lower box constraint vector"),
+         pybind11::arg_v("u_box", nullopt, "upper box constraint vector"),
+         pybind11::arg_v("compute_preconditioner",
+                         true,
+                         "execute the preconditioner for reducing "
+                         "ill-conditioning and speeding up solver execution."),
+         pybind11::arg_v("rho", nullopt, "primal proximal parameter"),
+         pybind11::arg_v(
+           "mu_eq", nullopt, "dual equality constraint proximal parameter"),
+         pybind11::arg_v(
+           "mu_in", nullopt, "dual inequality constraint proximal parameter"))
     .def("solve",
          static_cast<void (dense::QP<T>::*)()>(&dense::QP<T>::solve),
-         "function used for solving the QP problem, using default parameters.")
+         "function used for solving the QP problem, using default parameters.",
+         pybind11::call_guard<pybind11::gil_scoped_release>())
     .def("solve",
          static_cast<void (dense::QP<T>::*)(optional<dense::VecRef<T>> x,
                                             optional<dense::VecRef<T>> y,
                                             optional<dense::VecRef<T>> z)>(
            &dense::QP<T>::solve),
-         "function used for solving the QP problem, when passing a warm start.")
+         "function used for solving the QP problem, when passing a warm start.",
+         pybind11::call_guard<pybind11::gil_scoped_release>())
 
     .def(
       "update",
@@ -114,6 +163,43 @@ exposeQpObjectDense(pybind11::module_ m)
         "mu_eq", nullopt, "dual equality constraint proximal parameter"),
       pybind11::arg_v(
         "mu_in", nullopt, "dual inequality constraint proximal parameter"))
+    .def(
+      "update",
+      static_cast<void (dense::QP<T>::*)(optional<dense::MatRef<T>>,
+                                         optional<dense::VecRef<T>>,
+                                         optional<dense::MatRef<T>>,
+                                         optional<dense::VecRef<T>>,
+                                         optional<dense::MatRef<T>>,
+                                         optional<dense::VecRef<T>>,
+                                         optional<dense::VecRef<T>>,
+                                         optional<dense::VecRef<T>>,
+                                         optional<dense::VecRef<T>>,
+                                         bool update_preconditioner,
+                                         optional<T>,
+                                         optional<T>,
+                                         optional<T>)>(&dense::QP<T>::update),
+      "function used for updating matrix or vector entry of the model with box "
+      "constraints using dense matrix entries.",
+      pybind11::arg_v("H", nullopt, "quadratic cost"),
+      pybind11::arg_v("g", nullopt, "linear cost"),
+      pybind11::arg_v("A", nullopt, "equality constraint matrix"),
+      pybind11::arg_v("b", nullopt, "equality constraint vector"),
+      pybind11::arg_v("C", nullopt, "inequality constraint matrix"),
+      pybind11::arg_v("l", nullopt, "upper inequality constraint vector"),
+      pybind11::arg_v("u", nullopt, "lower inequality constraint vector"),
+      pybind11::arg_v("l_box", nullopt, "lower box constraint vector"),
+      pybind11::arg_v("u_box", nullopt, "upper box constraint vector"),
+      pybind11::arg_v(
+        "update_preconditioner",
+        true,
+        "update the preconditioner considering new matrices entries for "
+        "reducing ill-conditioning and speeding up solver execution. If set up "
+        "to false, use previous derived preconditioner."),
+      pybind11::arg_v("rho", nullopt, "primal proximal parameter"),
+      pybind11::arg_v(
+        "mu_eq", nullopt, "dual equality constraint proximal parameter"),
+      pybind11::arg_v(
+        "mu_in", nullopt, "dual inequality constraint proximal parameter"))
     .def("cleanup",
          &dense::QP<T>::cleanup,
          "function used for cleaning the workspace and result "
@@ -169,8 +255,52 @@ exposeQpObjectSparse(pybind11::module_ m)
       "information statistics in an info subclass.")
     .def_readwrite(
       "settings", &sparse::QP<T, I>::settings, "Settings of the solver.")
+    // registered first, so that csc matrices with matching index and value
+    // types are borrowed instead of being copied
     .def("init",
-         &sparse::QP<T, I>::init,
+         static_cast<void (sparse::QP<T, I>::*)(
+           optional<proxsuite::linalg::sparse::MatRef<T, I>>,
+           optional<sparse::VecRef<T>>,
+           optional<proxsuite::linalg::sparse::MatRef<T, I>>,
+           optional<sparse::VecRef<T>>,
+           optional<proxsuite::linalg::sparse::MatRef<T, I>>,
+           optional<sparse::VecRef<T>>,
+           optional<sparse::VecRef<T>>,
+           bool compute_preconditioner,
+           optional<T>,
+           optional<T>,
+           optional<T>)>(&sparse::QP<T, I>::init),
+         "function for initializing the model when passing scipy.sparse "
+         "csc matrices in entry, whose buffers are read without copy.",
+         pybind11::arg_v("H", nullopt, "quadratic cost"),
+         pybind11::arg_v("g", nullopt, "linear cost"),
+         pybind11::arg_v("A", nullopt, "equality constraint matrix"),
+         pybind11::arg_v("b", nullopt, "equality constraint vector"),
+         pybind11::arg_v("C", nullopt, "inequality constraint matrix"),
+         pybind11::arg_v("l", nullopt, "upper inequality constraint vector"),
+         pybind11::arg_v("u", nullopt, "lower inequality constraint vector"),
+         pybind11::arg_v("compute_preconditioner",
+                         true,
+                         "execute the preconditioner for reducing "
+                         "ill-conditioning and speeding up solver execution."),
+         pybind11::arg_v("rho", nullopt, "primal proximal parameter"),
+         pybind11::arg_v(
+           "mu_eq", nullopt, "dual equality constraint proximal parameter"),
+         pybind11::arg_v(
+           "mu_in", nullopt, "dual inequality constraint proximal parameter"))
+    .def("init",
+         static_cast<void (sparse::QP<T, I>::*)(
+           optional<sparse::SparseMat<T, I>>,
+           optional<sparse::VecRef<T>>,
+           optional<sparse::SparseMat<T, I>>,
+           optional<sparse::VecRef<T>>,
+           optional<sparse::SparseMat<T, I>>,
+           optional<sparse::VecRef<T>>,
+           optional<sparse::VecRef<T>>,
+           bool compute_preconditioner,
+           optional<T>,
+           optional<T>,
+           optional<T>)>(&sparse::QP<T, I>::init),
          "function for initializing the model when passing sparse matrices in "
          "entry.",
          pybind11::arg_v("H", nullopt, "quadratic cost"),
@@ -211,19 +341,55 @@ exposeQpObjectSparse(pybind11::module_ m)
            "mu_eq", nullopt, "dual equality constraint proximal parameter"),
          pybind11::arg_v(
            "mu_in", nullopt, "dual inequality constraint proximal parameter"))
+    .def("update_values",
+         &sparse::QP<T, I>::update_values,
+         "function for updating the model values when the sparsity structure "
+         "is unchanged, the matrices being given by the data arrays of csc "
+         "matrices with the structure passed to init.",
+         pybind11::arg_v("H_values", nullopt, "quadratic cost values"),
+         pybind11::arg_v("g", nullopt, "linear cost"),
+         pybind11::arg_v(
+           "A_values", nullopt, "equality constraint matrix values"),
+         pybind11::arg_v("b", nullopt, "equality constraint vector"),
+         pybind11::arg_v(
+           "C_values", nullopt, "inequality constraint matrix values"),
+         pybind11::arg_v("l", nullopt, "upper inequality constraint vector"),
+         pybind11::arg_v("u", nullopt, "lower inequality constraint vector"),
+         pybind11::arg_v(
+           "update_preconditioner",
+           true,
+           "update the preconditioner or re-use previous derived for reducing "
+           "ill-conditioning and speeding up solver execution."),
+         pybind11::arg_v("rho", nullopt, "primal proximal parameter"),
+         pybind11::arg_v(
+           "mu_eq", nullopt, "dual equality constraint proximal parameter"),
+         pybind11::arg_v(
+           "mu_in", nullopt, "dual inequality constraint proximal parameter"))
     .def("solve",
          static_cast<void (sparse::QP<T, I>::*)()>(&sparse::QP<T, I>::solve),
-         "function used for solving the QP problem, using default parameters.")
+         "function used for solving the QP problem, using default parameters.",
+         pybind11::call_guard<pybind11::gil_scoped_release>())
     .def("solve",
          static_cast<void (sparse::QP<T, I>::*)(optional<sparse::VecRef<T>> x,
                                                 optional<sparse::VecRef<T>> y,
                                                 optional<sparse::VecRef<T>> z)>(
            &sparse::QP<T, I>::solve),
-         "function used for solving the QP problem, when passing a warm start.")
+         "function used for solving the QP problem, when passing a warm start.",
+         pybind11::call_guard<pybind11::gil_scoped_release>())
     .def("cleanup",
          &sparse::QP<T, I>::cleanup,
          "function used for cleaning the result "
-         "class.");
+         "class.")
+    .def(pybind11::pickle(
+
+      [](const sparse::QP<T, I>& qp) {
+        return pybind11::bytes(proxsuite::serialization::saveToString(qp));
+      },
+      [](pybind11::bytes& s) {
+        proxsuite::proxqp::sparse::QP<T, I> qp(1, 0, 0);
+        proxsuite::serialization::loadFromString(qp, s);
+        return qp;
+      }));
 }
 
 } // namespace python
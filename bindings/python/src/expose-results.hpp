@@ -29,6 +29,61 @@ exposeResults(pybind11::module_ m)
     .value("PROXQP_NOT_RUN", QPSolverOutput::PROXQP_NOT_RUN)
     .export_values();
 
+  ::pybind11::class_<Profile<T>>(m, "Profile", pybind11::module_local())
+    .def(::pybind11::init(), "Default constructor.")
+    .def_readwrite("equilibration_time",
+                   &Profile<T>::equilibration_time,
+                   "Time spent in the equilibration of the last setup.")
+    .def_readwrite("factorization_time",
+                   &Profile<T>::factorization_time,
+                   "Time spent in the initial factorizations of the KKT "
+                   "matrix.")
+    .def_readwrite("factorizations",
+                   &Profile<T>::factorizations,
+                   "Number of initial factorizations of the KKT matrix.")
+    .def_readwrite("refactorization_time",
+                   &Profile<T>::refactorization_time,
+                   "Time spent in the refactorizations of the KKT matrix.")
+    .def_readwrite("refactorizations",
+                   &Profile<T>::refactorizations,
+                   "Number of refactorizations of the KKT matrix.")
+    .def_readwrite("mu_update_time",
+                   &Profile<T>::mu_update_time,
+                   "Time spent updating the factorization after mu updates.")
+    .def_readwrite("mu_update_rank",
+                   &Profile<T>::mu_update_rank,
+                   "Sum of the ranks of the factorization updates performed "
+                   "after mu updates (dense backend only).")
+    .def_readwrite("active_set_change_time",
+                   &Profile<T>::active_set_change_time,
+                   "Time spent updating the factorization after active set "
+                   "changes.")
+    .def_readwrite("active_set_insertions",
+                   &Profile<T>::active_set_insertions,
+                   "Number of constraints added to the active set.")
+    .def_readwrite("active_set_deletions",
+                   &Profile<T>::active_set_deletions,
+                   "Number of constraints removed from the active set.")
+    .def_readwrite("line_search_time",
+                   &Profile<T>::line_search_time,
+                   "Time spent in the primal-dual line searches.")
+    .def_readwrite("line_searches",
+                   &Profile<T>::line_searches,
+                   "Number of primal-dual line searches.")
+    .def_readwrite("iterative_refinement_time",
+                   &Profile<T>::iterative_refinement_time,
+                   "Time spent solving the KKT systems with iterative "
+                   "refinement.")
+    .def_readwrite("iterative_refinement_steps",
+                   &Profile<T>::iterative_refinement_steps,
+                   "Total number of iterative refinement steps.")
+    .def_readwrite("residual_time",
+                   &Profile<T>::residual_time,
+                   "Time spent evaluating the primal and dual residuals.")
+    .def_readwrite("residual_evaluations",
+                   &Profile<T>::residual_evaluations,
+                   "Number of evaluations of the primal and dual residuals.");
+
   ::pybind11::class_<Info<T>>(m, "Info", pybind11::module_local())
     .def(::pybind11::init(), "Default constructor.")
     .def_readwrite("mu_eq", &Info<T>::mu_eq)
@@ -48,14 +103,39 @@ exposeResults(pybind11::module_ m)
     .def_readwrite("mu_updates", &Info<T>::mu_updates)
     .def_readwrite("sparse_backend",
                    &Info<T>::sparse_backend,
-                   "Sparse backend used to solve the qp, either SparseCholesky "
-                   "or MatrixFree.");
+                   "Sparse backend used to solve the qp, either "
+                   "SparseCholesky, SupernodalCholesky or MatrixFree.")
+    .def_readwrite("symbolic_factorization_reuses",
+                   &Info<T>::symbolic_factorization_reuses,
+                   "Number of consecutive setups of the sparse solver which "
+                   "reused the symbolic factorization of the KKT matrix.")
+    .def_readwrite("lnnz",
+                   &Info<T>::lnnz,
+                   "Number of non zeros of the LDLT factor of the KKT matrix "
+                   "with the chosen sparse ordering.")
+    .def_readwrite("mixed_precision_fallback",
+                   &Info<T>::mixed_precision_fallback,
+                   "Whether the solver fell back to a full precision "
+                   "factorization of the KKT matrix in mixed precision mode.")
+    .def_readwrite("iterative_refinement_steps",
+                   &Info<T>::iterative_refinement_steps,
+                   "Maximal number of iterative refinement steps needed by a "
+                   "linear system solve during the last solve.")
+    .def_readwrite("profile",
+                   &Info<T>::profile,
+                   "Breakdown of the time spent in the phases of the last "
+                   "setup and solve (only filled when proxsuite is compiled "
+                   "with PROXSUITE_ENABLE_PROFILING).");
 
   ::pybind11::class_<Results<T>>(m, "Results", pybind11::module_local())
-    .def(::pybind11::init<i64, i64, i64>(),
+    .def(::pybind11::init<i64, i64, i64, bool>(),
          pybind11::arg_v("n", 0, "primal dimension."),
          pybind11::arg_v("n_eq", 0, "number of equality constraints."),
          pybind11::arg_v("n_in", 0, "number of inequality constraints."),
+         pybind11::arg_v("box_constraints",
+                         false,
+                         "whether the problem has box constraints on the "
+                         "primal variable."),
          "Constructor from QP model dimensions.") // constructor
     .PROXSUITE_PYTHON_EIGEN_READWRITE(Results<T>, x, "The primal solution.")
     .PROXSUITE_PYTHON_EIGEN_READWRITE(
@@ -66,6 +146,10 @@ exposeResults(pybind11::module_ m)
       Results<T>,
       z,
       "The dual solution associated to the inequality constraints.")
+    .PROXSUITE_PYTHON_EIGEN_READWRITE(
+      Results<T>,
+      z_box,
+      "The dual solution associated to the box constraints (dense backend).")
     .def_readwrite("info", &Results<T>::info)
     .def(pybind11::self == pybind11::self)
     .def(pybind11::self != pybind11::self)
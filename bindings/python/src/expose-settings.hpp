@@ -30,10 +30,38 @@ exposeSettings(pybind11::module_ m)
            InitialGuessStatus::COLD_START_WITH_PREVIOUS_RESULT)
     .export_values();
 
+  ::pybind11::enum_<HessianType>(m, "HessianType", pybind11::module_local())
+    .value("Dense", HessianType::Dense)
+    .value("Zero", HessianType::Zero)
+    .value("Diagonal", HessianType::Diagonal)
+    .export_values();
+
+  ::pybind11::enum_<DenseBackend>(m, "DenseBackend", pybind11::module_local())
+    .value("Automatic", DenseBackend::Automatic)
+    .value("PrimalDualLDLT", DenseBackend::PrimalDualLDLT)
+    .value("PrimalLDLT", DenseBackend::PrimalLDLT)
+    .export_values();
+
   ::pybind11::enum_<SparseBackend>(m, "SparseBackend", pybind11::module_local())
     .value("Automatic", SparseBackend::Automatic)
     .value("MatrixFree", SparseBackend::MatrixFree)
     .value("SparseCholesky", SparseBackend::SparseCholesky)
+    .value("SupernodalCholesky", SparseBackend::SupernodalCholesky)
+    .export_values();
+
+  ::pybind11::enum_<proxsuite::linalg::sparse::Ordering>(
+    m, "SparseOrdering", pybind11::module_local())
+    .value("natural", proxsuite::linalg::sparse::Ordering::natural)
+    .value("amd", proxsuite::linalg::sparse::Ordering::amd)
+    .value("nested_dissection",
+           proxsuite::linalg::sparse::Ordering::nested_dissection)
+    .export_values();
+
+  ::pybind11::enum_<MatrixFreePreconditioner>(
+    m, "MatrixFreePreconditioner", pybind11::module_local())
+    .value("Identity", MatrixFreePreconditioner::Identity)
+    .value("BlockJacobi", MatrixFreePreconditioner::BlockJacobi)
+    .value("IncompleteLdlt", MatrixFreePreconditioner::IncompleteLdlt)
     .export_values();
 
   ::pybind11::class_<Settings<T>>(m, "Settings", pybind11::module_local())
@@ -62,6 +90,13 @@ exposeSettings(pybind11::module_ m)
                    &Settings<T>::nb_iterative_refinement)
     .def_readwrite("initial_guess", &Settings<T>::initial_guess)
     .def_readwrite("sparse_backend", &Settings<T>::sparse_backend)
+    .def_readwrite("sparse_ordering", &Settings<T>::sparse_ordering)
+    .def_readwrite("matrix_free_preconditioner",
+                   &Settings<T>::matrix_free_preconditioner)
+    .def_readwrite("mixed_precision", &Settings<T>::mixed_precision)
+    .def_readwrite("cache_scaled_model", &Settings<T>::cache_scaled_model)
+    .def_readwrite("preconditioner_warm_start",
+                   &Settings<T>::preconditioner_warm_start)
     .def_readwrite("preconditioner_accuracy",
                    &Settings<T>::preconditioner_accuracy)
     .def_readwrite("preconditioner_max_iter",
@@ -98,7 +98,8 @@ solveDenseQp(pybind11::module_ m)
     pybind11::arg_v("eps_duality_gap_rel",
                     nullopt,
                     "relative accuracy threshold used for the duality-gap "
-                    "stopping criterion."));
+                    "stopping criterion."),
+    pybind11::call_guard<pybind11::gil_scoped_release>());
 }
 
 } // namespace python
@@ -169,7 +170,8 @@ solveSparseQp(pybind11::module_ m)
     pybind11::arg_v("eps_duality_gap_rel",
                     nullopt,
                     "relative accuracy threshold used for the duality-gap "
-                    "stopping criterion."));
+                    "stopping criterion."),
+    pybind11::call_guard<pybind11::gil_scoped_release>());
 }
 
 } // namespace python
@@ -20,6 +20,7 @@ exposeWorkspaceDense(pybind11::module_ m)
          pybind11::arg_v("n_eq", 0, "number of equality constraints."),
          pybind11::arg_v("n_in", 0, "number of inequality constraints."),
          "Constructor using QP model dimensions.") // constructor)
+    .def_readonly("dense_backend", &Workspace<T>::dense_backend)
     .def_readonly("H_scaled", &Workspace<T>::H_scaled)
     .def_readonly("g_scaled", &Workspace<T>::g_scaled)
     .def_readonly("A_scaled", &Workspace<T>::A_scaled)
@@ -40,7 +41,13 @@ exposeWorkspaceDense(pybind11::module_ m)
     .def_readonly("Cdx", &Workspace<T>::Cdx)
     .def_readonly("Adx", &Workspace<T>::Adx)
     .def_readonly("active_part_z", &Workspace<T>::active_part_z)
-    .def_readonly("alphas", &Workspace<T>::alphas)
+    .def_readonly("alphas",
+                  &Workspace<T>::alphas,
+                  "breakpoints of the last linesearch, unsorted: the step at "
+                  "which the upper (resp. lower) side of bound i changes state "
+                  "is stored at alphas[i] (resp. alphas[n_in + n_box + i]), "
+                  "with the box constraints stored after the n_in inequality "
+                  "constraints.")
     .def_readonly("dw_aug", &Workspace<T>::dw_aug)
     .def_readonly("rhs", &Workspace<T>::rhs)
     .def_readonly("err", &Workspace<T>::err)
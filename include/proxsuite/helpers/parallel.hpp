@@ -0,0 +1,50 @@
+//
+// Copyright (c) 2022 INRIA
+//
+/**
+ * @file parallel.hpp
+ */
+
+#ifndef PROXSUITE_HELPERS_PARALLEL_HPP
+#define PROXSUITE_HELPERS_PARALLEL_HPP
+
+#include <cstddef>
+
+#ifdef PROXSUITE_ENABLE_OPENMP
+#include <omp.h>
+#endif
+
+namespace proxsuite {
+namespace helpers {
+
+/// @brief \brief Returns the number of threads used by default in the parallel
+/// regions of the library (1 when OpenMP support is disabled).
+inline std::size_t
+get_default_num_threads()
+{
+#ifdef PROXSUITE_ENABLE_OPENMP
+  return static_cast<std::size_t>(omp_get_max_threads());
+#else
+  return 1;
+#endif
+}
+
+/// @brief \brief Sets the number of threads used by the next parallel regions
+/// and disables the dynamic adjustment of the team size, so that the requested
+/// number of threads is honored.
+inline void
+set_default_omp_options(
+  const std::size_t num_threads = get_default_num_threads())
+{
+#ifdef PROXSUITE_ENABLE_OPENMP
+  omp_set_num_threads(static_cast<int>(num_threads));
+  omp_set_dynamic(0);
+#else
+  static_cast<void>(num_threads);
+#endif
+}
+
+} // namespace helpers
+} // namespace proxsuite
+
+#endif /* end of include guard PROXSUITE_HELPERS_PARALLEL_HPP */
@@ -14,6 +14,17 @@
 #include <immintrin.h>
 #endif
 
+// the hot kernels of the dense LDLT updates are additionally compiled for
+// AVX2 and AVX-512, and selected at runtime depending on the host CPU. This
+// requires the target attribute of GCC/Clang, and is useless when the binary
+// is already compiled for AVX-512.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) &&        \
+  !defined(_WIN32) && !defined(__AVX512F__) &&                                 \
+  !defined(PROXSUITE_DENSE_NO_RUNTIME_DISPATCH)
+#define PROXSUITE_DENSE_RUNTIME_DISPATCH
+#include <proxsuite/helpers/instruction-set.hpp>
+#endif
+
 #ifdef PROXSUITE_VECTORIZE
 #include <cmath> // to avoid error of the type no member named 'isnan' in namespace 'std';
 #include <simde/x86/avx2.h>
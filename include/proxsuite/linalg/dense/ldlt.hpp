@@ -690,6 +690,50 @@ public:
   auto p() -> Perm { return { VecMapISize(perm.ptr(), dim()) }; }
   auto pt() -> Perm { return { VecMapISize(perm_inv.ptr(), dim()) }; }
 
+  /*!
+   * Returns the permutation of the decomposition, i.e., the indices of the
+   * rows and columns of the decomposed matrix in the order of `L` and `D`.
+   */
+  auto permutation() const noexcept -> proxsuite::linalg::veg::Slice<isize>
+  {
+    return perm.as_ref();
+  }
+
+  /*!
+   * Returns the diagonal of the permuted decomposed matrix, which is sorted on
+   * a best effort basis and determines where inserted rows are placed.
+   */
+  auto permuted_diagonal() const noexcept -> proxsuite::linalg::veg::Slice<T>
+  {
+    return maybe_sorted_diag.as_ref();
+  }
+  auto permuted_diagonal_mut() noexcept -> proxsuite::linalg::veg::SliceMut<T>
+  {
+    return maybe_sorted_diag.as_mut();
+  }
+
+  /*!
+   * Sets the dimension and the permutation of the decomposition, whose
+   * factors and permuted diagonal are then to be written through `ld_col_mut`
+   * and `permuted_diagonal_mut` (e.g., when a stored decomposition is loaded).
+   * This operation invalidates the existing decomposition.
+   *
+   * @param permutation pointer to the `n` indices of the permutation
+   * @param n dimension of the decomposition
+   */
+  void set_permutation(isize const* permutation, isize n)
+  {
+    reserve_uninit(n);
+
+    perm.resize_for_overwrite(n);
+    perm_inv.resize_for_overwrite(n);
+    maybe_sorted_diag.resize_for_overwrite(n);
+    for (isize i = 0; i < n; ++i) {
+      perm[i] = permutation[i];
+      perm_inv[permutation[i]] = i;
+    }
+  }
+
   /*!
    * Returns the memory storage requirements for a factorization of a matrix
    * of size at most `n×n`
@@ -0,0 +1,369 @@
+/** \file */
+//
+// Copyright (c) 2022-2023 INRIA
+//
+#ifndef PROXSUITE_LINALG_DENSE_LDLT_MIXED_LDLT_HPP
+#define PROXSUITE_LINALG_DENSE_LDLT_MIXED_LDLT_HPP
+
+#include "proxsuite/linalg/dense/ldlt.hpp"
+
+namespace proxsuite {
+namespace linalg {
+namespace dense {
+/*!
+ * LDLT decomposition which can be stored and updated in a lower precision
+ * type `Low` than the type `T` of the matrices and vectors it is given.
+ *
+ * It exposes the same interface as `Ldlt<T>`: the inputs are converted to
+ * `Low` before the factorization, the updates and the solves, and the
+ * solutions are converted back to `T`. The decomposition is meant to be used
+ * together with iterative refinement performed in the precision `T`.
+ *
+ * The precision is chosen with `set_low_precision`, and takes effect at the
+ * next call to `factorize`.
+ */
+template<typename T, typename Low = f32>
+struct MixedLdlt
+{
+private:
+  static constexpr auto DYN = Eigen::Dynamic;
+  using ColMat = Eigen::Matrix<T, DYN, DYN, Eigen::ColMajor>;
+  using Vec = Eigen::Matrix<T, DYN, 1>;
+
+  Ldlt<T> full;
+  Ldlt<Low> low;
+  isize capacity = 0;
+  bool low_precision_requested = false;
+  bool low_precision = false;
+
+public:
+  /*!
+   * Default constructor, initialized with a `0×0` empty matrix in precision
+   * `T`.
+   */
+  MixedLdlt() = default;
+
+  /*!
+   * Requests the decomposition to be stored in the precision `Low` (or `T`
+   * when `value` is false) from the next factorization on. The storage in the
+   * precision `Low` is reserved with the capacity given to `reserve_uninit`.
+   *
+   * @param value whether the lower precision is used
+   */
+  void set_low_precision(bool value) noexcept
+  {
+    low_precision_requested = value;
+    if (value) {
+      low.reserve(capacity);
+    }
+  }
+
+  /*!
+   * Returns whether the current decomposition is stored in the precision
+   * `Low`.
+   */
+  auto is_low_precision() const noexcept -> bool { return low_precision; }
+
+  /*!
+   * Returns whether the next factorization is stored in the precision `Low`.
+   */
+  auto is_low_precision_requested() const noexcept -> bool
+  {
+    return low_precision_requested;
+  }
+
+  /*!
+   * Returns the decomposition stored in the precision `T`, which is the
+   * current one unless `is_low_precision()`.
+   */
+  auto full_precision_ldlt() const noexcept -> Ldlt<T> const& { return full; }
+  auto full_precision_ldlt_mut() noexcept -> Ldlt<T>& { return full; }
+
+  /*!
+   * Returns the decomposition stored in the precision `Low`, which is the
+   * current one when `is_low_precision()`.
+   */
+  auto low_precision_ldlt() const noexcept -> Ldlt<Low> const& { return low; }
+  auto low_precision_ldlt_mut() noexcept -> Ldlt<Low>& { return low; }
+
+  /*!
+   * Sets the precision of the current decomposition, e.g., after it has been
+   * restored through `full_precision_ldlt_mut` or `low_precision_ldlt_mut`.
+   *
+   * @param value whether the current decomposition is the one stored in the
+   * precision `Low`
+   */
+  void set_current_precision(bool value) noexcept { low_precision = value; }
+
+  /*!
+   * Reserves enough internal storage for a matrix `A` of size at least
+   * `cap×cap`, in the requested precision. When the precision `Low` is
+   * requested, the storage in the precision `T` is reserved as well, so that
+   * falling back to the full precision does not allocate.
+   * This operation invalidates the existing decomposition.
+   *
+   * @param cap new capacity
+   */
+  void reserve_uninit(isize cap) noexcept
+  {
+    capacity = cap;
+    if (low_precision_requested) {
+      low.reserve_uninit(cap);
+    }
+    full.reserve_uninit(cap);
+  }
+
+  /*!
+   * Returns the memory storage requirements for deleting at most `r` rows and
+   * columns from a matrix with size at most `n×n`.
+   *
+   * @param n maximum dimension of the matrix
+   * @param r maximum number of rows to be deleted
+   */
+  static auto delete_at_req(isize n, isize r) noexcept
+    -> proxsuite::linalg::veg::dynstack::StackReq
+  {
+    return Ldlt<T>::delete_at_req(n, r) | Ldlt<Low>::delete_at_req(n, r);
+  }
+
+  /*!
+   * Given an LDLT decomposition for a matrix `A`, this computes the
+   * decomposition for the matrix `A` with `r` columns and rows removed, as
+   * indicated by the indices `indices[0], ..., indices[r-1]`.
+   *
+   * @param indices pointer to the array of indices to be deleted
+   * @param r number of the indices to be deleted
+   * @param stack workspace memory stack
+   */
+  void delete_at(isize const* indices,
+                 isize r,
+                 proxsuite::linalg::veg::dynstack::DynStackMut stack)
+  {
+    if (low_precision) {
+      low.delete_at(indices, r, stack);
+    } else {
+      full.delete_at(indices, r, stack);
+    }
+  }
+
+  /*!
+   * Returns the memory storage requirements for inserting at most `r` rows and
+   * columns from a matrix with size at most `n×n`.
+   *
+   * @param n maximum dimension of the matrix
+   * @param r maximum number of rows to be inserted
+   */
+  static auto insert_block_at_req(isize n, isize r) noexcept
+    -> proxsuite::linalg::veg::dynstack::StackReq
+  {
+    return Ldlt<T>::insert_block_at_req(n, r) |
+           (temp_mat_req(proxsuite::linalg::veg::Tag<Low>{}, n + r, r) &
+            Ldlt<Low>::insert_block_at_req(n, r));
+  }
+
+  /*!
+   * Given an LDLT decomposition for a matrix `A`, this computes the
+   * decomposition for the matrix `A` with extra `r` columns and rows from `a`
+   * added at the index `i`.
+   *
+   * @param i index where the block should be inserted
+   * @param a matrix of the new columns that are inserted
+   * @param stack workspace memory stack
+   */
+  void insert_block_at(isize i,
+                       Eigen::Ref<ColMat const> a,
+                       proxsuite::linalg::veg::dynstack::DynStackMut stack)
+  {
+    if (!low_precision) {
+      full.insert_block_at(i, a, stack);
+      return;
+    }
+    if (a.cols() == 0) {
+      return;
+    }
+    LDLT_TEMP_MAT_UNINIT(Low, a_low, a.rows(), a.cols(), stack);
+    a_low = a.template cast<Low>();
+    low.insert_block_at(i, a_low, stack);
+  }
+
+  /*!
+   * Returns the memory storage requirements for a diagonal subsection update
+   * with size at most `r`, in a matrix with size at most `n×n`.
+   *
+   * @param n maximum dimension of the matrix
+   * @param r maximum size of diagonal subsection that gets updated
+   */
+  static auto diagonal_update_req(isize n, isize r) noexcept
+    -> proxsuite::linalg::veg::dynstack::StackReq
+  {
+    return Ldlt<T>::diagonal_update_req(n, r) |
+           (temp_vec_req(proxsuite::linalg::veg::Tag<Low>{}, r) &
+            Ldlt<Low>::diagonal_update_req(n, r));
+  }
+
+  /*!
+   * Given an LDLT decomposition for a matrix `A`, this computes the
+   * decomposition for the matrix `A` with the vector `alpha` added to a
+   * diagonal subset, as specified by the provided indices.
+   *
+   * The values pointed at by `indices` are unspecified after a call to this
+   * function.
+   *
+   * @param indices pointer to the array of indices of diagonal elements that
+   * are updated
+   * @param r number of the indices to be updated
+   * @param alpha values added to the diagonal elements
+   * @param stack workspace memory stack
+   */
+  void diagonal_update_clobber_indices( //
+    isize* indices,
+    isize r,
+    Eigen::Ref<Vec const> alpha,
+    proxsuite::linalg::veg::dynstack::DynStackMut stack)
+  {
+    if (!low_precision) {
+      full.diagonal_update_clobber_indices(indices, r, alpha, stack);
+      return;
+    }
+    if (r == 0) {
+      return;
+    }
+    LDLT_TEMP_VEC_UNINIT(Low, alpha_low, r, stack);
+    alpha_low = alpha.template cast<Low>();
+    low.diagonal_update_clobber_indices(indices, r, alpha_low, stack);
+  }
+
+  /*!
+   * Returns the memory storage requirements for a rank `r` update of a matrix
+   * with size at most `n×n`.
+   *
+   * @param n maximum dimension of the matrix
+   * @param r maximum number of simultaneous rank updates
+   */
+  static auto rank_r_update_req(isize n, isize r) noexcept
+    -> proxsuite::linalg::veg::dynstack::StackReq
+  {
+    return Ldlt<T>::rank_r_update_req(n, r) |
+           (temp_mat_req(proxsuite::linalg::veg::Tag<Low>{}, n, r) &
+            temp_vec_req(proxsuite::linalg::veg::Tag<Low>{}, r) &
+            Ldlt<Low>::rank_r_update_req(n, r));
+  }
+
+  /*!
+   * Given an LDLT decomposition for a matrix `A`, this computes the
+   * decomposition for the matrix `A + W×diag(alpha)×W.T`.
+   *
+   * @param w rank update matrix
+   * @param alpha rank update diagonal vector
+   * @param stack workspace memory stack
+   */
+  void rank_r_update(Eigen::Ref<ColMat const> w,
+                     Eigen::Ref<Vec const> alpha,
+                     proxsuite::linalg::veg::dynstack::DynStackMut stack)
+  {
+    if (!low_precision) {
+      full.rank_r_update(w, alpha, stack);
+      return;
+    }
+    if (w.cols() == 0) {
+      return;
+    }
+    LDLT_TEMP_MAT_UNINIT(Low, w_low, w.rows(), w.cols(), stack);
+    LDLT_TEMP_VEC_UNINIT(Low, alpha_low, alpha.rows(), stack);
+    w_low = w.template cast<Low>();
+    alpha_low = alpha.template cast<Low>();
+    low.rank_r_update(w_low, alpha_low, stack);
+  }
+
+  /*!
+   * Returns the dimension of the stored decomposition.
+   */
+  auto dim() const noexcept -> isize
+  {
+    return low_precision ? low.dim() : full.dim();
+  }
+
+  /*!
+   * Returns the memory storage requirements for a factorization of a matrix
+   * of size at most `n×n`
+   *
+   * @param n maximum dimension of the matrix
+   */
+  static auto factorize_req(isize n)
+    -> proxsuite::linalg::veg::dynstack::StackReq
+  {
+    return Ldlt<T>::factorize_req(n) |
+           (temp_mat_req(proxsuite::linalg::veg::Tag<Low>{}, n, n) &
+            Ldlt<Low>::factorize_req(n));
+  }
+
+  /*!
+   * Computes the decomposition of a given matrix `A` in the requested
+   * precision.
+   * The matrix is interpreted as a symmetric matrix and only
+   * the lower triangular part of `A` is accessed.
+   *
+   * @param mat matrix whose decomposition should be computed
+   * @param stack workspace memory stack
+   */
+  void factorize(Eigen::Ref<ColMat const> mat /* NOLINT */,
+                 proxsuite::linalg::veg::dynstack::DynStackMut stack)
+  {
+    low_precision = low_precision_requested;
+    if (!low_precision) {
+      full.factorize(mat, stack);
+      return;
+    }
+    isize n = mat.rows();
+    LDLT_TEMP_MAT_UNINIT(Low, mat_low, n, n, stack);
+    mat_low.template triangularView<Eigen::Lower>() =
+      mat.template cast<Low>();
+    low.factorize(mat_low, stack);
+  }
+
+  /*!
+   * Returns the memory storage requirements for solving a linear system
+   * with a decomposition of dimension at most `n`
+   *
+   * @param n maximum dimension of the matrix
+   */
+  static auto solve_in_place_req(isize n)
+    -> proxsuite::linalg::veg::dynstack::StackReq
+  {
+    return Ldlt<T>::solve_in_place_req(n) |
+           (temp_vec_req(proxsuite::linalg::veg::Tag<Low>{}, n) &
+            Ldlt<Low>::solve_in_place_req(n));
+  }
+
+  /*!
+   * Solves the system `A×x = rhs`, and stores the result in `rhs`.
+   *
+   * @param rhs right hand side of the linear system
+   * @param stack workspace memory stack
+   */
+  void solve_in_place(Eigen::Ref<Vec> rhs,
+                      proxsuite::linalg::veg::dynstack::DynStackMut stack) const
+  {
+    if (!low_precision) {
+      full.solve_in_place(rhs, stack);
+      return;
+    }
+    LDLT_TEMP_VEC_UNINIT(Low, rhs_low, rhs.rows(), stack);
+    rhs_low = rhs.template cast<Low>();
+    low.solve_in_place(rhs_low, stack);
+    rhs = rhs_low.template cast<T>();
+  }
+
+  auto dbg_reconstructed_matrix() const -> ColMat
+  {
+    if (low_precision) {
+      return low.dbg_reconstructed_matrix().template cast<T>();
+    }
+    return full.dbg_reconstructed_matrix();
+  }
+};
+} // namespace dense
+} // namespace linalg
+} // namespace proxsuite
+
+#endif /* end of include guard PROXSUITE_LINALG_DENSE_LDLT_MIXED_LDLT_HPP */
@@ -203,6 +203,169 @@ struct RankRUpdateLoopImpl<true>
   }
 };
 
+#ifdef PROXSUITE_DENSE_RUNTIME_DISPATCH
+enum struct SimdLevel
+{
+  Generic,
+  Avx2,
+  Avx512,
+};
+
+/*!
+ * Detects once the widest instruction set usable by the dispatched kernels,
+ * i.e., supported by both the CPU and the operating system.
+ */
+inline auto
+runtime_simd_level() noexcept -> SimdLevel
+{
+  struct Detect
+  {
+    static auto fn() noexcept -> SimdLevel
+    {
+      using proxsuite::helpers::InstructionSet;
+      if (!InstructionSet::has_OSXSAVE()) {
+        return SimdLevel::Generic;
+      }
+      unsigned eax = 0;
+      unsigned edx = 0;
+      __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+      // ymm state, then opmask and zmm states enabled by the OS
+      bool os_avx = (eax & 0x06U) == 0x06U;
+      bool os_avx512 = (eax & 0xe6U) == 0xe6U;
+      if (os_avx512 && InstructionSet::has_AVX512F()) {
+        return SimdLevel::Avx512;
+      }
+      if (os_avx && InstructionSet::has_AVX2() && InstructionSet::has_FMA()) {
+        return SimdLevel::Avx2;
+      }
+      return SimdLevel::Generic;
+    }
+  };
+  static SimdLevel const level = Detect::fn();
+  return level;
+}
+
+// same computation as RankRUpdateLoopImpl<true>::fn, written with the native
+// intrinsics of the target instruction set
+#define PROXSUITE_RANK_R_UPDATE_KERNEL(Name, Target, T, Vec, N, Pre, Suf)      \
+  template<usize R>                                                            \
+  __attribute__((target(Target))) void Name(isize n,                           \
+                                            T* inout_l,                        \
+                                            T* pw,                             \
+                                            isize w_stride,                    \
+                                            T const* p,                        \
+                                            T const* mu) noexcept              \
+  {                                                                            \
+    Vec p_p[R];                                                                \
+    Vec p_mu[R];                                                               \
+    for (usize k = 0; k < R; ++k) {                                            \
+      p_p[k] = Pre##_set1_##Suf(p[k]);                                         \
+      p_mu[k] = Pre##_set1_##Suf(mu[k]);                                       \
+    }                                                                          \
+    isize n_vectorized = n / N * N;                                            \
+    T* inout_l_vectorized_end = inout_l + n_vectorized;                        \
+    while (inout_l < inout_l_vectorized_end) {                                 \
+      Vec in_l = Pre##_loadu_##Suf(inout_l);                                   \
+      for (usize k = 0; k < R; ++k) {                                          \
+        T* pwk = pw + w_stride * isize(k);                                     \
+        Vec wr = Pre##_loadu_##Suf(pwk);                                       \
+        wr = Pre##_fnmadd_##Suf(p_p[k], in_l, wr);                             \
+        in_l = Pre##_fmadd_##Suf(p_mu[k], wr, in_l);                           \
+        Pre##_storeu_##Suf(pwk, wr);                                           \
+      }                                                                        \
+      Pre##_storeu_##Suf(inout_l, in_l);                                       \
+      inout_l += N;                                                            \
+      pw += N;                                                                 \
+    }                                                                          \
+    RankRUpdateLoopImpl<false>::template fn<R>(                                \
+      n - n_vectorized, inout_l, pw, w_stride, p, mu);                         \
+  }                                                                            \
+  VEG_NOM_SEMICOLON
+
+PROXSUITE_RANK_R_UPDATE_KERNEL(rank_r_update_inner_loop_avx2,
+                               "avx2,fma",
+                               f32,
+                               __m256,
+                               8,
+                               _mm256,
+                               ps);
+PROXSUITE_RANK_R_UPDATE_KERNEL(rank_r_update_inner_loop_avx2,
+                               "avx2,fma",
+                               f64,
+                               __m256d,
+                               4,
+                               _mm256,
+                               pd);
+PROXSUITE_RANK_R_UPDATE_KERNEL(rank_r_update_inner_loop_avx512,
+                               "avx512f,avx2,fma",
+                               f32,
+                               __m512,
+                               16,
+                               _mm512,
+                               ps);
+PROXSUITE_RANK_R_UPDATE_KERNEL(rank_r_update_inner_loop_avx512,
+                               "avx512f,avx2,fma",
+                               f64,
+                               __m512d,
+                               8,
+                               _mm512,
+                               pd);
+
+#undef PROXSUITE_RANK_R_UPDATE_KERNEL
+
+template<typename T>
+struct RankRUpdateDispatch
+{
+  template<usize R>
+  VEG_INLINE static void fn(isize n,
+                            T* inout_l,
+                            T* pw,
+                            isize w_stride,
+                            T const* p,
+                            T const* mu,
+                            SimdLevel /*level*/) noexcept
+  {
+    RankRUpdateLoopImpl<should_vectorize<T>::value>::template fn<R>(
+      n, inout_l, pw, w_stride, p, mu);
+  }
+};
+
+template<typename T>
+struct RankRUpdateDispatchFloat
+{
+  template<usize R>
+  VEG_INLINE static void fn(isize n,
+                            T* inout_l,
+                            T* pw,
+                            isize w_stride,
+                            T const* p,
+                            T const* mu,
+                            SimdLevel level) noexcept
+  {
+    switch (level) {
+      case SimdLevel::Avx512:
+        _detail::rank_r_update_inner_loop_avx512<R>(
+          n, inout_l, pw, w_stride, p, mu);
+        break;
+      case SimdLevel::Avx2:
+        _detail::rank_r_update_inner_loop_avx2<R>(
+          n, inout_l, pw, w_stride, p, mu);
+        break;
+      default:
+        RankRUpdateLoopImpl<should_vectorize<T>::value>::template fn<R>(
+          n, inout_l, pw, w_stride, p, mu);
+    }
+  }
+};
+
+template<>
+struct RankRUpdateDispatch<f32> : RankRUpdateDispatchFloat<f32>
+{};
+template<>
+struct RankRUpdateDispatch<f64> : RankRUpdateDispatchFloat<f64>
+{};
+#endif
+
 template<usize R, typename T>
 VEG_INLINE void
 rank_r_update_inner_loop(isize n,
@@ -212,8 +375,13 @@ rank_r_update_inner_loop(isize n,
                          T const* p,
                          T const* mu)
 {
+#ifdef PROXSUITE_DENSE_RUNTIME_DISPATCH
+  RankRUpdateDispatch<T>::template fn<R>(
+    n, inout_l, pw, w_stride, p, mu, _detail::runtime_simd_level());
+#else
   RankRUpdateLoopImpl<should_vectorize<T>::value>::template fn<R>(
     n, inout_l, pw, w_stride, p, mu);
+#endif
 }
 
 template<typename LD, typename T, typename Fn>
@@ -121,6 +121,16 @@ VEG_NIEBLOID(sign_extend);
 VEG_NIEBLOID(zero_extend);
 } // namespace util
 
+// kind of permutation that is applied to a matrix before its factorization
+enum struct Ordering : unsigned char
+{
+  natural,
+  user_provided,
+  amd,
+  nested_dissection,
+  ENUM_END,
+};
+
 template<typename T>
 struct DenseVecRef
 {
@@ -6,7 +6,7 @@
 #define PROXSUITE_LINALG_SPARSE_LDLT_FACTORIZE_HPP
 
 #include "proxsuite/linalg/sparse/core.hpp"
-#include <Eigen/OrderingMethods>
+#include "proxsuite/linalg/sparse/ordering.hpp"
 
 namespace proxsuite {
 namespace linalg {
@@ -714,46 +714,6 @@ column_counts(I* counts,
   }
 }
 
-template<typename I>
-auto
-amd_req(proxsuite::linalg::veg::Tag<I> /*tag*/, isize /*n*/, isize nnz) noexcept
-  -> proxsuite::linalg::veg::dynstack::StackReq
-{
-  return { nnz * isize{ sizeof(char) }, alignof(char) };
-}
-
-template<typename I>
-void
-amd(I* perm, SymbolicMatRef<I> mat, DynStackMut stack) noexcept
-{
-  // TODO: reimplement amd under BSD-3
-  // https://github.com/DrTimothyAldenDavis/SuiteSparse/tree/master/AMD
-
-  isize n = mat.nrows();
-  isize nnz = mat.nnz();
-
-  Eigen::PermutationMatrix<-1, -1, I> perm_eigen;
-  auto _ = stack.make_new(proxsuite::linalg::veg::Tag<char>{}, nnz);
-
-  Eigen::AMDOrdering<I>{}(
-    Eigen::Map<Eigen::SparseMatrix<char, Eigen::ColMajor, I> const>{
-      n,
-      n,
-      nnz,
-      mat.col_ptrs(),
-      mat.row_indices(),
-      _.ptr(),
-      mat.nnz_per_col(),
-    }
-      .template selfadjointView<Eigen::Upper>(),
-
-    perm_eigen);
-  std::memmove( //
-    perm,
-    perm_eigen.indices().data(),
-    usize(n) * sizeof(I));
-}
-
 namespace _detail {
 template<typename I>
 void
@@ -911,14 +871,6 @@ symmetric_permute(MatMut<T, I> new_a,
 }
 } // namespace _detail
 
-enum struct Ordering : unsigned char
-{
-  natural,
-  user_provided,
-  amd,
-  ENUM_END,
-};
-
 /*!
  * Computes the stack memory requirements of symbolic factorization.
  *
@@ -945,8 +897,9 @@ factorize_symbolic_req(proxsuite::linalg::veg::Tag<I> tag,
     case Ordering::natural:
       break;
     case Ordering::amd:
-      amd_req =
-        StackReq{ n * sz, al } & StackReq{ sparse::amd_req(tag, n, nnz) };
+    case Ordering::nested_dissection:
+      amd_req = StackReq{ n * sz, al } &
+                sparse::fill_reducing_ordering_req(tag, n, nnz, o);
       HEDLEY_FALL_THROUGH;
     case Ordering::user_provided:
       perm_req = perm_req & StackReq{ (n + 1 + nnz) * sz, al };
@@ -980,6 +933,8 @@ factorize_symbolic_req(proxsuite::linalg::veg::Tag<I> tag,
  * @param perm optionally user-provided permutation, either null or of size `n`
  * @param a matrix to be symbolically factorized
  * @param stack temporary allocation stack
+ * @param ordering fill-reducing ordering that is computed when `perm` is null
+ * and `perm_inv` is not, either Ordering::amd or Ordering::nested_dissection
  */
 template<typename I>
 void
@@ -988,7 +943,8 @@ factorize_symbolic_non_zeros(I* nnz_per_col,
                              I* perm_inv,
                              I const* perm,
                              SymbolicMatRef<I> a,
-                             DynStackMut stack) noexcept
+                             DynStackMut stack,
+                             Ordering ordering = Ordering::amd) noexcept
 {
 
   bool id_perm = perm_inv == nullptr;
@@ -996,7 +952,7 @@ factorize_symbolic_non_zeros(I* nnz_per_col,
 
   Ordering o = user_perm ? Ordering::user_provided
                : id_perm ? Ordering::natural
-                         : Ordering::amd;
+                         : ordering;
 
   proxsuite::linalg::veg::Tag<I> tag{};
 
@@ -1004,11 +960,20 @@ factorize_symbolic_non_zeros(I* nnz_per_col,
 
   switch (o) {
     case Ordering::natural:
+      if (!id_perm) {
+        // the identity is stored as the inverse permutation, the matrix does
+        // not need to be permuted
+        for (usize i = 0; i < n; ++i) {
+          perm_inv[i] = I(i);
+        }
+        id_perm = true;
+      }
       break;
 
-    case Ordering::amd: {
+    case Ordering::amd:
+    case Ordering::nested_dissection: {
       auto amd_perm = stack.make_new_for_overwrite(tag, isize(n));
-      sparse::amd(amd_perm.ptr_mut(), a, stack);
+      sparse::fill_reducing_ordering(amd_perm.ptr_mut(), o, a, stack);
       perm = amd_perm.ptr();
     }
       HEDLEY_FALL_THROUGH;
@@ -1069,6 +1034,8 @@ factorize_symbolic_non_zeros(I* nnz_per_col,
  * @param perm optionally user-provided permutation, either null or of size `n`
  * @param a matrix to be symbolically factorized
  * @param stack temporary allocation stack
+ * @param ordering fill-reducing ordering that is computed when `perm` is null
+ * and `perm_inv` is not, either Ordering::amd or Ordering::nested_dissection
  */
 template<typename I>
 void
@@ -1077,7 +1044,8 @@ factorize_symbolic_col_counts(I* col_ptrs,
                               I* perm_inv,
                               I const* perm,
                               SymbolicMatRef<I> a,
-                              DynStackMut stack) noexcept
+                              DynStackMut stack,
+                              Ordering ordering = Ordering::amd) noexcept
 {
 
   sparse::factorize_symbolic_non_zeros( //
@@ -1086,7 +1054,8 @@ factorize_symbolic_col_counts(I* col_ptrs,
     perm_inv,
     perm,
     a,
-    stack);
+    stack,
+    ordering);
 
   usize n = usize(a.ncols());
   auto pcol_ptrs = col_ptrs;
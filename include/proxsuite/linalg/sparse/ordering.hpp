@@ -0,0 +1,721 @@
+/** \file */
+//
+// Copyright (c) 2022 INRIA
+//
+#ifndef PROXSUITE_LINALG_SPARSE_LDLT_ORDERING_HPP
+#define PROXSUITE_LINALG_SPARSE_LDLT_ORDERING_HPP
+
+#include "proxsuite/linalg/sparse/core.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace proxsuite {
+namespace linalg {
+namespace sparse {
+namespace _detail {
+
+// minimal number of vertices of a subgraph for it to be bisected by the nested
+// dissection ordering, smaller subgraphs are ordered with amd
+constexpr isize nested_dissection_leaf_size = 128;
+
+// number of entries of the adjacency graph of the symmetric matrix whose upper
+// triangular part is `mat`, diagonal excluded
+template<typename I>
+auto
+adjacency_nnz(SymbolicMatRef<I> mat) noexcept -> isize
+{
+  isize nnz = 0;
+  for (usize j = 0; j < usize(mat.ncols()); ++j) {
+    for (usize p = mat.col_start(j); p < mat.col_end(j); ++p) {
+      if (util::zero_extend(mat.row_indices()[p]) < j) {
+        nnz += 2;
+      }
+    }
+  }
+  return nnz;
+}
+
+// builds the adjacency graph of the symmetric matrix whose upper triangular
+// part is `mat`, diagonal excluded. `xadj` is of size `n + 1` and `adj` of size
+// `adjacency_nnz(mat)`
+template<typename I>
+void
+adjacency(isize* xadj, isize* adj, SymbolicMatRef<I> mat) noexcept
+{
+  usize n = usize(mat.ncols());
+  for (usize j = 0; j <= n; ++j) {
+    xadj[j] = 0;
+  }
+  for (usize j = 0; j < n; ++j) {
+    for (usize p = mat.col_start(j); p < mat.col_end(j); ++p) {
+      usize i = util::zero_extend(mat.row_indices()[p]);
+      if (i < j) {
+        ++xadj[i + 1];
+        ++xadj[j + 1];
+      }
+    }
+  }
+  for (usize j = 0; j < n; ++j) {
+    xadj[j + 1] += xadj[j];
+  }
+  for (usize j = 0; j < n; ++j) {
+    for (usize p = mat.col_start(j); p < mat.col_end(j); ++p) {
+      usize i = util::zero_extend(mat.row_indices()[p]);
+      if (i < j) {
+        adj[xadj[i]++] = isize(j);
+        adj[xadj[j]++] = isize(i);
+      }
+    }
+  }
+  // shift back the column pointers
+  for (usize j = n; j > 0; --j) {
+    xadj[j] = xadj[j - 1];
+  }
+  xadj[0] = 0;
+}
+
+// states of the nodes of the quotient graph used by the minimum degree ordering
+constexpr isize amd_variable = 0;  // not yet eliminated
+constexpr isize amd_element = 1;   // eliminated, represents a clique
+constexpr isize amd_absorbed = 2;  // absorbed element or ordered variable
+constexpr isize amd_postponed = 3; // dense variable, ordered last
+
+inline auto
+amd_impl_req(isize n, isize adj_nnz) noexcept -> isize
+{
+  // quotient graph with elbow room, its initial column pointers, permutation
+  // and 12 arrays of size n
+  return (adj_nnz + adj_nnz / 5 + n) + (n + 1) + n + 12 * n;
+}
+
+// approximate minimum degree ordering, based on Amestoy, Davis and Duff, "An
+// approximate minimum degree ordering algorithm", SIAM J. Matrix Anal. Appl.,
+// 1996.
+//
+// the elimination is performed on the quotient graph: the list of each
+// variable holds the elements it belongs to, followed by its neighbouring
+// variables, and the list of each element holds its variables. when a variable
+// `k` is eliminated, its elements and neighbours are merged into the new
+// element `Lk`. the degree of each variable `i` of `Lk` is then bounded by
+// `|Lk \ i| + |Ai| + sum(|Le \ Lk|)` over its other elements `e`, and the
+// variables with no neighbours outside of `Lk` are eliminated along with `k`.
+//
+// `xadj` and `iw` hold the adjacency graph, with `iw` of capacity `cap`, which
+// is overwritten. `perm` and `work` are of size n and 12 * n.
+inline void
+amd_impl(isize* perm,
+         isize n,
+         isize const* xadj,
+         isize* iw,
+         isize cap,
+         isize* work) noexcept
+{
+  isize* pos = work;             // start of the list of each node in `iw`
+  isize* len = work + n;         // length of the list of each node
+  isize* n_elems = work + 2 * n; // number of elements of each variable
+  isize* degree = work + 3 * n;
+  isize* state = work + 4 * n;
+  isize* head = work + 5 * n; // degree lists
+  isize* next = work + 6 * n;
+  isize* prev = work + 7 * n;
+  isize* diff = work + 8 * n;  // |Le \ Lk| for each element e
+  isize* in_lk = work + 9 * n; // last step at which each node was in Lk
+  isize* seen = work + 10 * n; // last step at which `diff` was set
+  isize* tmp = work + 11 * n;
+
+  for (isize i = 0; i < n; ++i) {
+    pos[i] = xadj[i];
+    len[i] = xadj[i + 1] - xadj[i];
+    n_elems[i] = 0;
+    head[i] = -1;
+    in_lk[i] = -1;
+    seen[i] = -1;
+  }
+  isize used = xadj[n];
+
+  // variables with too many neighbours are left out of the graph, and ordered
+  // last
+  isize dense = std::max(isize(64), isize(8 * std::sqrt(double(n))));
+  isize n_postponed = 0;
+  for (isize i = 0; i < n; ++i) {
+    if (len[i] > dense) {
+      state[i] = amd_postponed;
+      ++n_postponed;
+    } else {
+      state[i] = amd_variable;
+    }
+  }
+
+  auto insert = [&](isize i, isize d) {
+    degree[i] = d;
+    prev[i] = -1;
+    next[i] = head[d];
+    if (head[d] != -1) {
+      prev[head[d]] = i;
+    }
+    head[d] = i;
+  };
+  auto remove = [&](isize i) {
+    if (prev[i] != -1) {
+      next[prev[i]] = next[i];
+    } else {
+      head[degree[i]] = next[i];
+    }
+    if (next[i] != -1) {
+      prev[next[i]] = prev[i];
+    }
+  };
+  // moves the lists of the live nodes to the front of `iw`, in the same order
+  auto compact = [&]() -> isize {
+    isize n_live = 0;
+    for (isize i = 0; i < n; ++i) {
+      if (state[i] == amd_variable || state[i] == amd_element) {
+        tmp[n_live++] = i;
+      }
+    }
+    std::sort(
+      tmp, tmp + n_live, [&](isize i, isize j) { return pos[i] < pos[j]; });
+    isize dst = 0;
+    for (isize q = 0; q < n_live; ++q) {
+      isize i = tmp[q];
+      isize src = pos[i];
+      pos[i] = dst;
+      for (isize p = 0; p < len[i]; ++p) {
+        iw[dst++] = iw[src + p];
+      }
+    }
+    return dst;
+  };
+
+  for (isize i = 0; i < n; ++i) {
+    if (state[i] != amd_variable) {
+      continue;
+    }
+    isize d = 0;
+    for (isize p = pos[i]; p < pos[i] + len[i]; ++p) {
+      if (state[iw[p]] == amd_variable) {
+        ++d;
+      }
+    }
+    insert(i, d);
+  }
+
+  isize n_vars = n - n_postponed;
+  isize n_ordered = 0;
+  isize min_degree = 0;
+  for (isize step = 0; n_ordered < n_vars; ++step) {
+    while (head[min_degree] == -1) {
+      ++min_degree;
+    }
+    isize k = head[min_degree];
+    remove(k);
+    perm[n_ordered++] = k;
+
+    // the new element is stored at the end of `iw`
+    isize bound = len[k] - n_elems[k];
+    for (isize p = pos[k]; p < pos[k] + n_elems[k]; ++p) {
+      bound += len[iw[p]];
+    }
+    bound = std::min(bound, n_vars - n_ordered);
+    if (used + bound > cap) {
+      used = compact();
+    }
+
+    // Lk is the union of the elements of k and of its neighbours, and the
+    // elements of k are absorbed into it
+    in_lk[k] = step;
+    isize lk_begin = used;
+    isize lk_end = used;
+    auto add_to_lk = [&](isize i) {
+      if (state[i] == amd_variable && in_lk[i] != step) {
+        in_lk[i] = step;
+        iw[lk_end++] = i;
+      }
+    };
+    for (isize p = pos[k]; p < pos[k] + len[k]; ++p) {
+      isize e = iw[p];
+      if (p >= pos[k] + n_elems[k]) {
+        add_to_lk(e);
+      } else if (state[e] == amd_element) {
+        for (isize q = pos[e]; q < pos[e] + len[e]; ++q) {
+          add_to_lk(iw[q]);
+        }
+        state[e] = amd_absorbed;
+      }
+    }
+    state[k] = amd_element;
+    pos[k] = lk_begin;
+    len[k] = lk_end - lk_begin;
+    n_elems[k] = 0;
+
+    // |Le \ Lk| for the other elements of the variables of Lk
+    for (isize p = lk_begin; p < lk_end; ++p) {
+      isize i = iw[p];
+      remove(i);
+      for (isize q = pos[i]; q < pos[i] + n_elems[i]; ++q) {
+        isize e = iw[q];
+        if (state[e] != amd_element) {
+          continue;
+        }
+        if (seen[e] != step) {
+          seen[e] = step;
+          diff[e] = len[e];
+        }
+        --diff[e];
+      }
+    }
+
+    // the lists of the variables of Lk are pruned, and k is added to their
+    // elements. the elements contained in Lk are absorbed into it
+    isize lk_pos = lk_begin;
+    for (isize p = lk_begin; p < lk_end; ++p) {
+      isize i = iw[p];
+      isize external = 0;
+      isize dst = pos[i];
+      for (isize q = pos[i]; q < pos[i] + n_elems[i]; ++q) {
+        isize e = iw[q];
+        if (state[e] != amd_element || e == k) {
+          continue;
+        }
+        if (diff[e] == 0) {
+          state[e] = amd_absorbed;
+          continue;
+        }
+        external += diff[e];
+        iw[dst++] = e;
+      }
+      isize n_kept = dst - pos[i];
+      for (isize q = pos[i] + n_elems[i]; q < pos[i] + len[i]; ++q) {
+        isize j = iw[q];
+        if (state[j] == amd_variable && in_lk[j] != step) {
+          ++external;
+          iw[dst++] = j;
+        }
+      }
+      // i had either an element absorbed into Lk, or k as a neighbour, so
+      // there is room left for k
+      iw[dst] = iw[pos[i] + n_kept];
+      iw[pos[i] + n_kept] = k;
+      n_elems[i] = n_kept + 1;
+      len[i] = dst + 1 - pos[i];
+
+      if (external == 0) {
+        // i is only adjacent to Lk, and is eliminated with k
+        perm[n_ordered++] = i;
+        state[i] = amd_absorbed;
+      } else {
+        tmp[i] = external;
+        iw[lk_pos++] = i;
+      }
+    }
+    len[k] = lk_pos - lk_begin;
+    used = lk_pos;
+
+    isize n_left = n_vars - n_ordered;
+    for (isize p = lk_begin; p < lk_pos; ++p) {
+      isize i = iw[p];
+      isize d = std::min(degree[i], tmp[i]) + len[k] - 1;
+      d = std::min(d, n_left - 1);
+      insert(i, d);
+      min_degree = std::min(min_degree, d);
+    }
+  }
+
+  for (isize i = 0; i < n; ++i) {
+    if (state[i] == amd_postponed) {
+      perm[n_ordered++] = i;
+    }
+  }
+}
+} // namespace _detail
+
+/*!
+ * Computes the stack memory requirements of the approximate minimum degree
+ * ordering.
+ *
+ * @param n dimension of the matrix to be ordered.
+ * @param nnz number of non zeros of the matrix to be ordered.
+ */
+template<typename I>
+auto
+amd_req(proxsuite::linalg::veg::Tag<I> /*tag*/, isize n, isize nnz) noexcept
+  -> proxsuite::linalg::veg::dynstack::StackReq
+{
+  return {
+    _detail::amd_impl_req(n, 2 * nnz) * isize{ sizeof(isize) },
+    alignof(isize),
+  };
+}
+
+/*!
+ * Computes a fill-reducing permutation of a symmetric matrix with the
+ * approximate minimum degree algorithm.
+ *
+ * @param perm storage for the permutation, of size `n`
+ * @param mat symmetric matrix to be ordered, only its upper triangular part is
+ * accessed
+ * @param stack temporary allocation stack
+ */
+template<typename I>
+void
+amd(I* perm, SymbolicMatRef<I> mat, DynStackMut stack) noexcept
+{
+  isize n = mat.nrows();
+  if (n == 0) {
+    return;
+  }
+  if (n == 1) {
+    perm[0] = I(0);
+    return;
+  }
+
+  isize adj_nnz = _detail::adjacency_nnz(mat);
+  isize cap = adj_nnz + adj_nnz / 5 + n;
+
+  auto _mem = stack.make_new_for_overwrite(
+    proxsuite::linalg::veg::Tag<isize>{}, _detail::amd_impl_req(n, adj_nnz));
+  isize* iw = _mem.ptr_mut();
+  isize* xadj = iw + cap;
+  isize* pperm = xadj + (n + 1);
+  isize* work = pperm + n;
+
+  _detail::adjacency(xadj, iw, mat);
+  _detail::amd_impl(pperm, n, xadj, iw, cap, work);
+
+  for (isize k = 0; k < n; ++k) {
+    perm[k] = I(pperm[k]);
+  }
+}
+
+/*!
+ * Computes the stack memory requirements of the nested dissection ordering.
+ *
+ * @param n dimension of the matrix to be ordered.
+ * @param nnz number of non zeros of the matrix to be ordered.
+ */
+template<typename I>
+auto
+nested_dissection_req(proxsuite::linalg::veg::Tag<I> tag,
+                      isize n,
+                      isize nnz) noexcept
+  -> proxsuite::linalg::veg::dynstack::StackReq
+{
+  using proxsuite::linalg::veg::dynstack::StackReq;
+  constexpr isize sz{ sizeof(I) };
+  constexpr isize al{ alignof(I) };
+  constexpr isize isz{ sizeof(isize) };
+  constexpr isize ial{ alignof(isize) };
+
+  // adjacency graph, vertices, labels, parts, levels, queue and segments
+  StackReq graph_req = { (n + 1 + 2 * nnz + 7 * n) * isz, ial };
+  // subgraphs of the leaves, ordered with amd
+  StackReq leaf_req = StackReq{ (3 * n + 1 + nnz) * sz, al } &
+                      sparse::amd_req(tag, n, nnz);
+  return graph_req & leaf_req;
+}
+
+/*!
+ * Computes a fill-reducing permutation of a symmetric matrix with a nested
+ * dissection ordering: the graph of the matrix is recursively bisected with
+ * level-set vertex separators, which are ordered last, and the subgraphs that
+ * are small enough are ordered with the approximate minimum degree algorithm.
+ * It is best suited to large matrices with a grid-like structure.
+ *
+ * @param perm storage for the permutation, of size `n`
+ * @param mat symmetric matrix to be ordered, only its upper triangular part is
+ * accessed
+ * @param stack temporary allocation stack
+ */
+template<typename I>
+void
+nested_dissection(I* perm, SymbolicMatRef<I> mat, DynStackMut stack) noexcept
+{
+  proxsuite::linalg::veg::Tag<isize> stag{};
+  proxsuite::linalg::veg::Tag<I> itag{};
+
+  isize n = mat.nrows();
+  isize adj_nnz = _detail::adjacency_nnz(mat);
+
+  auto _xadj = stack.make_new_for_overwrite(stag, n + 1);
+  auto _adj = stack.make_new_for_overwrite(stag, adj_nnz);
+  auto _verts = stack.make_new_for_overwrite(stag, n);
+  auto _label = stack.make_new_for_overwrite(stag, n);
+  auto _part = stack.make_new_for_overwrite(stag, n);
+  auto _level = stack.make_new_for_overwrite(stag, n);
+  auto _queue = stack.make_new_for_overwrite(stag, n);
+  auto _segments = stack.make_new_for_overwrite(stag, 2 * n);
+
+  isize* xadj = _xadj.ptr_mut();
+  isize* adj = _adj.ptr_mut();
+  isize* verts = _verts.ptr_mut();
+  isize* label = _label.ptr_mut();
+  isize* part = _part.ptr_mut();
+  isize* level = _level.ptr_mut();
+  isize* queue = _queue.ptr_mut();
+  isize* segments = _segments.ptr_mut();
+
+  _detail::adjacency(xadj, adj, mat);
+  for (isize i = 0; i < n; ++i) {
+    verts[i] = i;
+    label[i] = -1;
+  }
+
+  // local indices and structure of the leaves
+  auto _local = stack.make_new_for_overwrite(itag, n);
+  auto _leaf_col_ptrs = stack.make_new_for_overwrite(itag, n + 1);
+  auto _leaf_row_indices = stack.make_new_for_overwrite(itag, mat.nnz());
+  I* local = _local.ptr_mut();
+  I* leaf_col_ptrs = _leaf_col_ptrs.ptr_mut();
+  I* leaf_row_indices = _leaf_row_indices.ptr_mut();
+
+  // the vertices of the subgraph being processed are labeled with a stamp that
+  // is unique to it, stamp + 1 marks the vertices visited by a search
+  isize stamp = 0;
+
+  // breadth first search from `root` restricted to the current subgraph, the
+  // level of each reached vertex is stored and their number is returned
+  auto bfs = [&](isize root, isize& depth) -> isize {
+    isize qbegin = 0;
+    isize qend = 0;
+    queue[qend++] = root;
+    level[root] = 0;
+    label[root] = stamp + 1;
+    depth = 0;
+    while (qbegin < qend) {
+      isize v = queue[qbegin++];
+      depth = level[v];
+      for (isize p = xadj[v]; p < xadj[v + 1]; ++p) {
+        isize u = adj[p];
+        if (label[u] == stamp) {
+          label[u] = stamp + 1;
+          level[u] = level[v] + 1;
+          queue[qend++] = u;
+        }
+      }
+    }
+    for (isize q = 0; q < qend; ++q) {
+      label[queue[q]] = stamp;
+    }
+    return qend;
+  };
+
+  auto order_leaf = [&](isize begin, isize end) {
+    isize m = end - begin;
+    for (isize q = 0; q < m; ++q) {
+      local[verts[begin + q]] = I(q);
+    }
+    // upper triangular part of the induced subgraph
+    isize nnz = 0;
+    leaf_col_ptrs[0] = I(0);
+    for (isize q = 0; q < m; ++q) {
+      isize v = verts[begin + q];
+      for (isize p = xadj[v]; p < xadj[v + 1]; ++p) {
+        isize u = adj[p];
+        if (label[u] == stamp && isize(util::zero_extend(local[u])) < q) {
+          leaf_row_indices[nnz++] = local[u];
+        }
+      }
+      leaf_col_ptrs[q + 1] = I(nnz);
+    }
+    SymbolicMatRef<I> leaf{
+      from_raw_parts, m, m, nnz, leaf_col_ptrs, nullptr, leaf_row_indices,
+    };
+    auto _leaf_perm = stack.make_new_for_overwrite(itag, m);
+    I* leaf_perm = _leaf_perm.ptr_mut();
+    sparse::amd(leaf_perm, leaf, stack);
+    for (isize q = 0; q < m; ++q) {
+      queue[q] = verts[begin + isize(util::zero_extend(leaf_perm[q]))];
+    }
+    for (isize q = 0; q < m; ++q) {
+      verts[begin + q] = queue[q];
+    }
+  };
+
+  // each segment [begin, end) of `verts` is a subgraph whose vertices take the
+  // positions [begin, end) of the ordering
+  isize n_segments = 0;
+  if (n > 0) {
+    segments[0] = 0;
+    segments[1] = n;
+    n_segments = 1;
+  }
+  while (n_segments > 0) {
+    --n_segments;
+    isize begin = segments[2 * n_segments];
+    isize end = segments[2 * n_segments + 1];
+    isize m = end - begin;
+
+    stamp += 2;
+    for (isize q = begin; q < end; ++q) {
+      label[verts[q]] = stamp;
+    }
+
+    if (m <= _detail::nested_dissection_leaf_size) {
+      order_leaf(begin, end);
+      continue;
+    }
+
+    // pseudo-peripheral vertex, found by repeated breadth first searches
+    isize root = verts[begin];
+    isize depth = 0;
+    isize reached = bfs(root, depth);
+    for (isize iter = 0; iter < 4 && reached == m; ++iter) {
+      isize candidate = queue[reached - 1];
+      isize candidate_depth = 0;
+      bfs(candidate, candidate_depth);
+      if (candidate_depth <= depth) {
+        bfs(root, depth);
+        break;
+      }
+      root = candidate;
+      depth = candidate_depth;
+    }
+
+    if (reached < m) {
+      // disconnected subgraph: the reached component and the rest are ordered
+      // independently
+      for (isize q = begin; q < end; ++q) {
+        level[verts[q]] = -1;
+      }
+      bfs(root, depth);
+      for (isize q = begin; q < end; ++q) {
+        isize v = verts[q];
+        part[v] = level[v] >= 0 ? 0 : 1;
+      }
+    } else if (depth < 2) {
+      order_leaf(begin, end);
+      continue;
+    } else {
+      // the level that splits the vertices in halves is the separator
+      for (isize q = 0; q <= depth; ++q) {
+        queue[q] = 0;
+      }
+      for (isize q = begin; q < end; ++q) {
+        ++queue[level[verts[q]]];
+      }
+      isize sep_level = 1;
+      isize acc = queue[0];
+      while (sep_level < depth - 1 && acc + queue[sep_level] / 2 < m / 2) {
+        acc += queue[sep_level];
+        ++sep_level;
+      }
+      for (isize q = begin; q < end; ++q) {
+        isize v = verts[q];
+        isize lv = level[v];
+        part[v] = lv < sep_level ? 0 : lv > sep_level ? 1 : 2;
+      }
+      // separator vertices without neighbours in the second part are moved
+      // to the first one
+      for (isize q = begin; q < end; ++q) {
+        isize v = verts[q];
+        if (part[v] != 2) {
+          continue;
+        }
+        bool adjacent_to_b = false;
+        for (isize p = xadj[v]; p < xadj[v + 1]; ++p) {
+          isize u = adj[p];
+          if (label[u] == stamp && part[u] == 1) {
+            adjacent_to_b = true;
+            break;
+          }
+        }
+        if (!adjacent_to_b) {
+          part[v] = 0;
+        }
+      }
+    }
+
+    // partition the segment as [first part | second part | separator]
+    isize n_parts[3] = { 0, 0, 0 };
+    isize pos = 0;
+    for (isize k = 0; k < 3; ++k) {
+      for (isize q = begin; q < end; ++q) {
+        if (part[verts[q]] == k) {
+          queue[pos++] = verts[q];
+          ++n_parts[k];
+        }
+      }
+    }
+    for (isize q = 0; q < m; ++q) {
+      verts[begin + q] = queue[q];
+    }
+
+    if (n_parts[0] > 0) {
+      segments[2 * n_segments] = begin;
+      segments[2 * n_segments + 1] = begin + n_parts[0];
+      ++n_segments;
+    }
+    if (n_parts[1] > 0) {
+      segments[2 * n_segments] = begin + n_parts[0];
+      segments[2 * n_segments + 1] = begin + n_parts[0] + n_parts[1];
+      ++n_segments;
+    }
+  }
+
+  for (isize k = 0; k < n; ++k) {
+    perm[k] = I(verts[k]);
+  }
+}
+
+/*!
+ * Computes the stack memory requirements of a fill-reducing ordering.
+ *
+ * @param n dimension of the matrix to be ordered.
+ * @param nnz number of non zeros of the matrix to be ordered.
+ * @param o kind of ordering.
+ */
+template<typename I>
+auto
+fill_reducing_ordering_req(proxsuite::linalg::veg::Tag<I> tag,
+                           isize n,
+                           isize nnz,
+                           Ordering o) noexcept
+  -> proxsuite::linalg::veg::dynstack::StackReq
+{
+  switch (o) {
+    case Ordering::amd:
+      return sparse::amd_req(tag, n, nnz);
+    case Ordering::nested_dissection:
+      return sparse::nested_dissection_req(tag, n, nnz);
+    default:
+      return { 0, alignof(I) };
+  }
+}
+
+/*!
+ * Computes a fill-reducing permutation of a symmetric matrix.
+ *
+ * @param perm storage for the permutation, of size `n`
+ * @param o kind of ordering, the identity permutation is returned for
+ * Ordering::natural and Ordering::user_provided.
+ * @param mat symmetric matrix to be ordered, only its upper triangular part is
+ * accessed
+ * @param stack temporary allocation stack
+ */
+template<typename I>
+void
+fill_reducing_ordering(I* perm,
+                       Ordering o,
+                       SymbolicMatRef<I> mat,
+                       DynStackMut stack) noexcept
+{
+  switch (o) {
+    case Ordering::amd:
+      sparse::amd(perm, mat, stack);
+      break;
+    case Ordering::nested_dissection:
+      sparse::nested_dissection(perm, mat, stack);
+      break;
+    default:
+      for (isize i = 0; i < mat.nrows(); ++i) {
+        perm[i] = I(i);
+      }
+      break;
+  }
+}
+
+} // namespace sparse
+} // namespace linalg
+} // namespace proxsuite
+
+#endif /* end of include guard PROXSUITE_LINALG_SPARSE_LDLT_ORDERING_HPP */
@@ -0,0 +1,967 @@
+/** \file */
+//
+// Copyright (c) 2022 INRIA
+//
+#ifndef PROXSUITE_LINALG_SPARSE_LDLT_SUPERNODAL_HPP
+#define PROXSUITE_LINALG_SPARSE_LDLT_SUPERNODAL_HPP
+
+#include "proxsuite/linalg/sparse/core.hpp"
+#include "proxsuite/linalg/sparse/factorize.hpp"
+#include "proxsuite/linalg/dense/core.hpp"
+#include "proxsuite/linalg/dense/factorize.hpp"
+#include <proxsuite/linalg/veg/vec.hpp>
+#include <algorithm>
+
+namespace proxsuite {
+namespace linalg {
+namespace sparse {
+
+/*!
+ * Supernodal `LDLT` factorization of a symmetric matrix.
+ *
+ * Consecutive columns of the factor that share the same sparsity structure
+ * below their diagonal block (fundamental supernodes) are stored together as
+ * a dense column-major panel. The diagonal block of each panel holds the unit
+ * lower triangular part of `L`, with the elements of `D` replacing its
+ * implicit diagonal `1` elements, and the rows below it hold the rest of the
+ * columns of `L`. The numerical factorization and the triangular solves are
+ * then performed panel-wise with dense kernels.
+ */
+template<typename T, typename I>
+struct SupernodalLdlt
+{
+  isize n = 0;
+  isize n_supernodes = 0;
+  isize max_rows = 0; // largest number of rows of a panel
+  isize max_cols = 0; // largest number of columns of a panel
+
+  proxsuite::linalg::veg::Vec<I> perm;
+  proxsuite::linalg::veg::Vec<I> perm_inv;
+  proxsuite::linalg::veg::Vec<I> etree;
+
+  // first column of each supernode, of size `n_supernodes + 1`
+  proxsuite::linalg::veg::Vec<I> super_ptr;
+  // supernode containing each column, of size `n`
+  proxsuite::linalg::veg::Vec<I> col_to_super;
+  // offsets of the row structures of the supernodes, of size `n_supernodes + 1`
+  proxsuite::linalg::veg::Vec<I> row_ptr;
+  // sorted row indices of each supernode, starting with its own columns
+  proxsuite::linalg::veg::Vec<I> row_indices;
+  // offsets of the panels, of size `n_supernodes + 1`
+  proxsuite::linalg::veg::Vec<isize> values_ptr;
+  proxsuite::linalg::veg::Vec<T> values;
+
+  auto nnz() const noexcept -> isize
+  {
+    return n_supernodes == 0 ? 0 : values_ptr[n_supernodes];
+  }
+};
+
+/*!
+ * Computes the stack memory requirements of the supernodal symbolic
+ * factorization.
+ *
+ * @param n dimension of the matrix to be factorized.
+ * @param nnz number of non zeros of the matrix to be factorized.
+ */
+template<typename I>
+auto
+factorize_symbolic_supernodal_req(proxsuite::linalg::veg::Tag<I> tag,
+                                  isize n,
+                                  isize nnz) noexcept
+  -> proxsuite::linalg::veg::dynstack::StackReq
+{
+  using proxsuite::linalg::veg::dynstack::StackReq;
+  constexpr isize sz{ sizeof(I) };
+  constexpr isize al{ alignof(I) };
+
+  StackReq col_counts_req = { n * sz, al };
+  StackReq lower_req = { (n + 1 + nnz) * sz, al };
+  StackReq work_req = { 3 * n * sz, al };
+
+  return col_counts_req &
+         (sparse::factorize_symbolic_req(tag, n, nnz, Ordering::user_provided) |
+          (lower_req & work_req));
+}
+
+/*!
+ * Performs the symbolic supernodal factorization of a symmetric matrix,
+ * computing its elimination tree, its fundamental supernodes and their
+ * sparsity structures. The storage of `ldl` is allocated accordingly.
+ *
+ * @param ldl supernodal factorization to set up
+ * @param perm fill-reducing permutation applied to the matrix, of size `n`
+ * @param a matrix to be symbolically factorized, only its upper triangular
+ * part is accessed
+ * @param stack temporary allocation stack
+ */
+template<typename T, typename I>
+void
+factorize_symbolic_supernodal(SupernodalLdlt<T, I>& ldl,
+                              I const* perm,
+                              SymbolicMatRef<I> a,
+                              DynStackMut stack)
+{
+  using namespace _detail;
+  proxsuite::linalg::veg::Tag<I> tag{};
+  usize n = usize(a.ncols());
+
+  ldl.n = isize(n);
+  ldl.perm.resize_for_overwrite(isize(n));
+  ldl.perm_inv.resize_for_overwrite(isize(n));
+  ldl.etree.resize_for_overwrite(isize(n));
+  ldl.col_to_super.resize_for_overwrite(isize(n));
+  for (usize i = 0; i < n; ++i) {
+    ldl.perm[isize(i)] = perm[i];
+  }
+
+  auto _counts = stack.make_new_for_overwrite(tag, isize(n));
+  I* pcounts = _counts.ptr_mut();
+  sparse::factorize_symbolic_non_zeros(pcounts,
+                                       ldl.etree.ptr_mut(),
+                                       ldl.perm_inv.ptr_mut(),
+                                       ldl.perm.ptr(),
+                                       a,
+                                       stack);
+
+  I const* pparent = ldl.etree.ptr();
+  I const* pperm_inv = ldl.perm_inv.ptr();
+  I* pcol_to_super = ldl.col_to_super.ptr_mut();
+
+  // lower triangular structure of the permuted matrix
+  auto _lp = stack.make_new(tag, isize(n + 1));
+  auto _li = stack.make_new_for_overwrite(tag, a.nnz());
+  auto _work = stack.make_new(tag, isize(3 * n));
+  I* plp = _lp.ptr_mut();
+  I* pli = _li.ptr_mut();
+  I* pnchildren = _work.ptr_mut();
+  I* pmarker = pnchildren + n;
+  I* pchild_next = pmarker + n;
+
+  for (usize old_j = 0; old_j < n; ++old_j) {
+    usize new_j = util::zero_extend(pperm_inv[old_j]);
+    for (usize p = a.col_start(old_j); p < a.col_end(old_j); ++p) {
+      usize old_i = util::zero_extend(a.row_indices()[p]);
+      if (old_i <= old_j) {
+        usize new_i = util::zero_extend(pperm_inv[old_i]);
+        util::wrapping_inc(mut(plp[(new_i < new_j ? new_i : new_j) + 1]));
+      }
+    }
+  }
+  for (usize j = 0; j < n; ++j) {
+    plp[j + 1] = util::checked_non_negative_plus(plp[j + 1], plp[j]);
+  }
+  {
+    // reuse the marker storage for the current insertion position
+    I* ppos = pmarker;
+    for (usize j = 0; j < n; ++j) {
+      ppos[j] = plp[j];
+    }
+    for (usize old_j = 0; old_j < n; ++old_j) {
+      usize new_j = util::zero_extend(pperm_inv[old_j]);
+      for (usize p = a.col_start(old_j); p < a.col_end(old_j); ++p) {
+        usize old_i = util::zero_extend(a.row_indices()[p]);
+        if (old_i <= old_j) {
+          usize new_i = util::zero_extend(pperm_inv[old_i]);
+          usize new_min = new_i < new_j ? new_i : new_j;
+          usize new_max = new_i < new_j ? new_j : new_i;
+          pli[util::zero_extend(ppos[new_min])] = I(new_max);
+          util::wrapping_inc(mut(ppos[new_min]));
+        }
+      }
+    }
+    for (usize j = 0; j < n; ++j) {
+      pmarker[j] = I(-1);
+    }
+  }
+
+  // fundamental supernodes: column j + 1 is merged into the supernode of column
+  // j when j is its only child and their structures only differ by j
+  for (usize j = 0; j < n; ++j) {
+    if (pparent[j] != I(-1)) {
+      util::wrapping_inc(mut(pnchildren[util::zero_extend(pparent[j])]));
+    }
+  }
+  isize n_supernodes = 0;
+  for (usize j = 0; j < n; ++j) {
+    bool merge = j > 0 && util::zero_extend(pparent[j - 1]) == j &&
+                 util::zero_extend(pcounts[j - 1]) ==
+                   util::zero_extend(pcounts[j]) + 1 &&
+                 pnchildren[j] == I(1);
+    if (!merge) {
+      ++n_supernodes;
+    }
+    pcol_to_super[j] = I(n_supernodes - 1);
+  }
+
+  ldl.n_supernodes = n_supernodes;
+  ldl.super_ptr.resize_for_overwrite(n_supernodes + 1);
+  ldl.row_ptr.resize_for_overwrite(n_supernodes + 1);
+  ldl.values_ptr.resize_for_overwrite(n_supernodes + 1);
+  I* psuper_ptr = ldl.super_ptr.ptr_mut();
+  I* prow_ptr = ldl.row_ptr.ptr_mut();
+  isize* pvalues_ptr = ldl.values_ptr.ptr_mut();
+
+  for (usize j = 0; j < n; ++j) {
+    if (j == 0 || pcol_to_super[j] != pcol_to_super[j - 1]) {
+      psuper_ptr[util::zero_extend(pcol_to_super[j])] = I(j);
+    }
+  }
+  psuper_ptr[n_supernodes] = I(n);
+
+  ldl.max_rows = 0;
+  ldl.max_cols = 0;
+  prow_ptr[0] = I(0);
+  pvalues_ptr[0] = 0;
+  for (usize s = 0; s < usize(n_supernodes); ++s) {
+    isize ncols = isize(util::zero_extend(psuper_ptr[s + 1]) -
+                        util::zero_extend(psuper_ptr[s]));
+    isize nrows =
+      isize(util::zero_extend(pcounts[util::zero_extend(psuper_ptr[s])]));
+    prow_ptr[s + 1] = util::checked_non_negative_plus(prow_ptr[s], I(nrows));
+    pvalues_ptr[s + 1] = pvalues_ptr[s] + nrows * ncols;
+    ldl.max_rows = nrows > ldl.max_rows ? nrows : ldl.max_rows;
+    ldl.max_cols = ncols > ldl.max_cols ? ncols : ldl.max_cols;
+  }
+
+  ldl.row_indices.resize_for_overwrite(
+    isize(util::zero_extend(prow_ptr[n_supernodes])));
+  ldl.values.resize_for_overwrite(pvalues_ptr[n_supernodes]);
+  I* prows = ldl.row_indices.ptr_mut();
+
+  // the structure of a supernode is the union of the lower triangular
+  // structure of its columns and of the structures of its children
+  I* pchild_head = pnchildren;
+  for (usize s = 0; s < usize(n_supernodes); ++s) {
+    pchild_head[s] = I(-1);
+  }
+  for (usize s = 0; s < usize(n_supernodes); ++s) {
+    usize f = util::zero_extend(psuper_ptr[s]);
+    usize l = util::zero_extend(psuper_ptr[s + 1]);
+    usize rp = util::zero_extend(prow_ptr[s]);
+    usize len = 0;
+
+    for (usize j = f; j < l; ++j) {
+      prows[rp + len] = I(j);
+      pmarker[j] = I(s);
+      ++len;
+    }
+    for (usize j = f; j < l; ++j) {
+      for (usize p = util::zero_extend(plp[j]);
+           p < util::zero_extend(plp[j + 1]);
+           ++p) {
+        usize i = util::zero_extend(pli[p]);
+        if (pmarker[i] != I(s)) {
+          pmarker[i] = I(s);
+          prows[rp + len] = I(i);
+          ++len;
+        }
+      }
+    }
+    for (I c = pchild_head[s]; c != I(-1);
+         c = pchild_next[util::zero_extend(c)]) {
+      usize c_ = util::zero_extend(c);
+      for (usize q = util::zero_extend(prow_ptr[c_]);
+           q < util::zero_extend(prow_ptr[c_ + 1]);
+           ++q) {
+        usize i = util::zero_extend(prows[q]);
+        if (i >= f && pmarker[i] != I(s)) {
+          pmarker[i] = I(s);
+          prows[rp + len] = I(i);
+          ++len;
+        }
+      }
+    }
+    VEG_ASSERT(len == util::zero_extend(prow_ptr[s + 1]) - rp);
+    std::sort(prows + rp + (l - f), prows + rp + len);
+
+    I parent = pparent[l - 1];
+    if (parent != I(-1)) {
+      usize ps = util::zero_extend(pcol_to_super[util::zero_extend(parent)]);
+      pchild_next[s] = pchild_head[ps];
+      pchild_head[ps] = I(s);
+    }
+  }
+}
+
+/*!
+ * Computes the stack memory requirements of the supernodal numerical
+ * factorization.
+ *
+ * @param ldl supernodal factorization, whose symbolic part has already been
+ * computed.
+ * @param a_nnz number of non zeros of the matrix to be factorized.
+ */
+template<typename T, typename I>
+auto
+factorize_numeric_supernodal_req(SupernodalLdlt<T, I> const& ldl,
+                                 isize a_nnz) noexcept
+  -> proxsuite::linalg::veg::dynstack::StackReq
+{
+  using proxsuite::linalg::veg::dynstack::StackReq;
+  proxsuite::linalg::veg::Tag<T> xtag{};
+
+  constexpr isize sz{ sizeof(I) };
+  constexpr isize al{ alignof(I) };
+  constexpr isize tsz{ sizeof(T) };
+  constexpr isize tal{ alignof(T) };
+
+  isize n = ldl.n;
+  isize ns = ldl.n_supernodes;
+
+  StackReq lower_req = StackReq{ (n + 1 + a_nnz + n) * sz, al } &
+                       StackReq{ a_nnz * tsz, tal };
+  StackReq lists_req = { (n + 3 * ns) * sz, al };
+
+  return lower_req & lists_req &
+         proxsuite::linalg::dense::temp_mat_req(
+           xtag, ldl.max_rows, ldl.max_cols) &
+         proxsuite::linalg::dense::temp_mat_req(
+           xtag, ldl.max_cols, ldl.max_cols) &
+         proxsuite::linalg::dense::factorize_req(xtag, ldl.max_cols);
+}
+
+/*!
+ * Performs the numerical supernodal `LDLT` factorization, assuming the
+ * symbolic factorization has already been computed. The supernodes are
+ * processed in a left-looking fashion: the updates from the descendants of
+ * each supernode are computed with dense matrix products, and its diagonal
+ * block is then factorized with the dense `LDLT` kernel.
+ *
+ * @param ldl supernodal factorization, whose symbolic part has already been
+ * computed.
+ * @param diag_to_add pointer to a vector that is added to the diagonal of the
+ * matrix during factorization, in the original ordering. May be null.
+ * @param a matrix to be factorized, only its upper triangular part is accessed.
+ * Its structure must be a subset of the one used for the symbolic
+ * factorization.
+ * @param stack temporary allocation stack
+ */
+template<typename T, typename I>
+void
+factorize_numeric_supernodal(
+  SupernodalLdlt<T, I>& ldl,
+  proxsuite::linalg::veg::DoNotDeduce<T const*> diag_to_add,
+  MatRef<T, I> a,
+  DynStackMut stack)
+{
+  using namespace _detail;
+  using Mat = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor>;
+
+  proxsuite::linalg::veg::Tag<I> itag{};
+  proxsuite::linalg::veg::Tag<T> xtag{};
+
+  usize n = usize(ldl.n);
+  usize ns = usize(ldl.n_supernodes);
+
+  I const* pperm = ldl.perm.ptr();
+  I const* pperm_inv = ldl.perm_inv.ptr();
+  I const* psuper_ptr = ldl.super_ptr.ptr();
+  I const* pcol_to_super = ldl.col_to_super.ptr();
+  I const* prow_ptr = ldl.row_ptr.ptr();
+  I const* prows = ldl.row_indices.ptr();
+  isize const* pvalues_ptr = ldl.values_ptr.ptr();
+  T* pvalues = ldl.values.ptr_mut();
+
+  isize a_nnz = 0;
+  for (usize j = 0; j < n; ++j) {
+    a_nnz += isize(a.col_end(j) - a.col_start(j));
+  }
+
+  // lower triangular part of the permuted matrix
+  auto _lp = stack.make_new(itag, isize(n + 1));
+  auto _li = stack.make_new_for_overwrite(itag, a_nnz);
+  auto _pos = stack.make_new_for_overwrite(itag, isize(n));
+  auto _lx = stack.make_new_for_overwrite(xtag, a_nnz);
+  I* plp = _lp.ptr_mut();
+  I* pli = _li.ptr_mut();
+  I* ppos = _pos.ptr_mut();
+  T* plx = _lx.ptr_mut();
+
+  I const* pai = a.row_indices();
+  T const* pax = a.values();
+  for (usize old_j = 0; old_j < n; ++old_j) {
+    usize new_j = util::zero_extend(pperm_inv[old_j]);
+    for (usize p = a.col_start(old_j); p < a.col_end(old_j); ++p) {
+      usize old_i = util::zero_extend(pai[p]);
+      if (old_i <= old_j) {
+        usize new_i = util::zero_extend(pperm_inv[old_i]);
+        util::wrapping_inc(mut(plp[(new_i < new_j ? new_i : new_j) + 1]));
+      }
+    }
+  }
+  for (usize j = 0; j < n; ++j) {
+    plp[j + 1] = util::checked_non_negative_plus(plp[j + 1], plp[j]);
+    ppos[j] = plp[j];
+  }
+  for (usize old_j = 0; old_j < n; ++old_j) {
+    usize new_j = util::zero_extend(pperm_inv[old_j]);
+    for (usize p = a.col_start(old_j); p < a.col_end(old_j); ++p) {
+      usize old_i = util::zero_extend(pai[p]);
+      if (old_i <= old_j) {
+        usize new_i = util::zero_extend(pperm_inv[old_i]);
+        usize new_min = new_i < new_j ? new_i : new_j;
+        usize new_max = new_i < new_j ? new_j : new_i;
+        usize q = util::zero_extend(ppos[new_min]);
+        pli[q] = I(new_max);
+        plx[q] = pax[p];
+        ppos[new_min] = I(q + 1);
+      }
+    }
+  }
+
+  // relative position of each row in the structure of the current supernode
+  auto _map = stack.make_new_for_overwrite(itag, isize(n));
+  // linked lists of the descendants updating each supernode
+  auto _head = stack.make_new_for_overwrite(itag, isize(ns));
+  auto _next = stack.make_new_for_overwrite(itag, isize(ns));
+  // position of the next row of each supernode to be used for updates
+  auto _first = stack.make_new_for_overwrite(itag, isize(ns));
+  I* pmap = _map.ptr_mut();
+  I* phead = _head.ptr_mut();
+  I* pnext = _next.ptr_mut();
+  I* pfirst = _first.ptr_mut();
+  for (usize s = 0; s < ns; ++s) {
+    phead[s] = I(-1);
+  }
+
+  LDLT_TEMP_MAT_UNINIT(T, update_storage, ldl.max_rows, ldl.max_cols, stack);
+  LDLT_TEMP_MAT_UNINIT(T, ld_storage, ldl.max_cols, ldl.max_cols, stack);
+
+  auto link = [&](usize s, usize pos) {
+    usize rp = util::zero_extend(prow_ptr[s]);
+    usize m = util::zero_extend(prow_ptr[s + 1]) - rp;
+    pfirst[s] = I(pos);
+    if (pos < m) {
+      usize target =
+        util::zero_extend(pcol_to_super[util::zero_extend(prows[rp + pos])]);
+      pnext[s] = phead[target];
+      phead[target] = I(s);
+    }
+  };
+
+  for (usize s = 0; s < ns; ++s) {
+    usize f = util::zero_extend(psuper_ptr[s]);
+    usize l = util::zero_extend(psuper_ptr[s + 1]);
+    isize k = isize(l - f);
+    usize rp = util::zero_extend(prow_ptr[s]);
+    isize m = isize(util::zero_extend(prow_ptr[s + 1]) - rp);
+    I const* rows = prows + rp;
+
+    Eigen::Map<Mat> panel{ pvalues + pvalues_ptr[s], m, k };
+    panel.setZero();
+    for (isize q = 0; q < m; ++q) {
+      pmap[util::zero_extend(rows[q])] = I(q);
+    }
+
+    // assemble the columns of the matrix
+    for (usize j = f; j < l; ++j) {
+      for (usize p = util::zero_extend(plp[j]);
+           p < util::zero_extend(plp[j + 1]);
+           ++p) {
+        panel(isize(util::zero_extend(pmap[util::zero_extend(pli[p])])),
+              isize(j - f)) += plx[p];
+      }
+      if (diag_to_add != nullptr) {
+        panel(isize(j - f), isize(j - f)) +=
+          diag_to_add[util::zero_extend(pperm[j])];
+      }
+    }
+
+    // apply the updates of the descendants
+    I d = phead[s];
+    while (d != I(-1)) {
+      usize d_ = util::zero_extend(d);
+      I d_next = pnext[d_];
+
+      isize kd = isize(util::zero_extend(psuper_ptr[d_ + 1]) -
+                       util::zero_extend(psuper_ptr[d_]));
+      usize rpd = util::zero_extend(prow_ptr[d_]);
+      isize md = isize(util::zero_extend(prow_ptr[d_ + 1]) - rpd);
+      I const* rows_d = prows + rpd;
+
+      isize p1 = isize(util::zero_extend(pfirst[d_]));
+      isize p2 = p1;
+      while (p2 < md && util::zero_extend(rows_d[p2]) < l) {
+        ++p2;
+      }
+
+      Eigen::Map<Mat const> panel_d{ pvalues + pvalues_ptr[d_], md, kd };
+      auto ld = ld_storage.topLeftCorner(p2 - p1, kd);
+      auto update = update_storage.topLeftCorner(md - p1, p2 - p1);
+
+      ld = panel_d.middleRows(p1, p2 - p1) *
+           panel_d.topRows(kd).diagonal().asDiagonal();
+      update.noalias() = panel_d.bottomRows(md - p1) * ld.transpose();
+
+      for (isize c = 0; c < p2 - p1; ++c) {
+        isize col = isize(util::zero_extend(rows_d[p1 + c]) - f);
+        for (isize r = c; r < md - p1; ++r) {
+          panel(isize(util::zero_extend(
+                  pmap[util::zero_extend(rows_d[p1 + r])])),
+                col) -= update(r, c);
+        }
+      }
+
+      link(d_, usize(p2));
+      d = d_next;
+    }
+
+    // factorize the diagonal block, then compute the off-diagonal block
+    auto l11 = panel.topRows(k);
+    proxsuite::linalg::dense::factorize(l11, stack);
+    if (m > k) {
+      auto l21 = panel.bottomRows(m - k);
+      l11.template triangularView<Eigen::UnitLower>()
+        .transpose()
+        .template solveInPlace<Eigen::OnTheRight>(l21);
+      l21 = l21 * l11.diagonal().cwiseInverse().asDiagonal();
+    }
+
+    link(s, usize(k));
+  }
+}
+
+/*!
+ * Computes the stack memory requirements of the supernodal solve.
+ *
+ * @param ldl supernodal factorization.
+ */
+template<typename T, typename I>
+auto
+solve_supernodal_req(SupernodalLdlt<T, I> const& ldl) noexcept
+  -> proxsuite::linalg::veg::dynstack::StackReq
+{
+  proxsuite::linalg::veg::Tag<T> xtag{};
+  return proxsuite::linalg::dense::temp_vec_req(xtag, ldl.n) &
+         proxsuite::linalg::dense::temp_vec_req(xtag, ldl.max_rows);
+}
+
+/*!
+ * Solves in place the linear system `A x = rhs`, using the supernodal
+ * factorization of `A`.
+ *
+ * @param x right hand side of the system on input, solution on output, in the
+ * original ordering
+ * @param ldl supernodal factorization of the matrix.
+ * @param stack temporary allocation stack
+ */
+template<typename T, typename I>
+void
+solve_supernodal_in_place(DenseVecMut<T> x,
+                          SupernodalLdlt<T, I> const& ldl,
+                          DynStackMut stack)
+{
+  using Mat = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor>;
+
+  isize n = ldl.n;
+  usize ns = usize(ldl.n_supernodes);
+  auto zx = util::zero_extend;
+
+  I const* pperm = ldl.perm.ptr();
+  I const* pperm_inv = ldl.perm_inv.ptr();
+  I const* psuper_ptr = ldl.super_ptr.ptr();
+  I const* prow_ptr = ldl.row_ptr.ptr();
+  I const* prows = ldl.row_indices.ptr();
+  isize const* pvalues_ptr = ldl.values_ptr.ptr();
+  T const* pvalues = ldl.values.ptr();
+
+  LDLT_TEMP_VEC_UNINIT(T, work, n, stack);
+  LDLT_TEMP_VEC_UNINIT(T, tmp, ldl.max_rows, stack);
+
+  auto x_e = x.to_eigen();
+  for (isize i = 0; i < n; ++i) {
+    work[i] = x_e[isize(zx(pperm[i]))];
+  }
+
+  auto panel_of = [&](usize s, isize& f, isize& k, isize& m) {
+    f = isize(zx(psuper_ptr[s]));
+    k = isize(zx(psuper_ptr[s + 1])) - f;
+    m = isize(zx(prow_ptr[s + 1]) - zx(prow_ptr[s]));
+    return Eigen::Map<Mat const>{ pvalues + pvalues_ptr[s], m, k };
+  };
+
+  // L y = b
+  for (usize s = 0; s < ns; ++s) {
+    isize f, k, m;
+    auto panel = panel_of(s, f, k, m);
+    I const* rows = prows + zx(prow_ptr[s]);
+
+    auto ws = work.segment(f, k);
+    panel.topRows(k).template triangularView<Eigen::UnitLower>().solveInPlace(
+      ws);
+    if (m > k) {
+      auto t = tmp.head(m - k);
+      t.noalias() = panel.bottomRows(m - k) * ws;
+      for (isize r = 0; r < m - k; ++r) {
+        work[isize(zx(rows[k + r]))] -= t[r];
+      }
+    }
+  }
+
+  // D z = y
+  for (usize s = 0; s < ns; ++s) {
+    isize f, k, m;
+    auto panel = panel_of(s, f, k, m);
+    work.segment(f, k).array() /= panel.topRows(k).diagonal().array();
+  }
+
+  // L.T x = z
+  for (usize s = ns; s > 0; --s) {
+    isize f, k, m;
+    auto panel = panel_of(s - 1, f, k, m);
+    I const* rows = prows + zx(prow_ptr[s - 1]);
+
+    auto ws = work.segment(f, k);
+    if (m > k) {
+      auto t = tmp.head(m - k);
+      for (isize r = 0; r < m - k; ++r) {
+        t[r] = work[isize(zx(rows[k + r]))];
+      }
+      ws.noalias() -= panel.bottomRows(m - k).transpose() * t;
+    }
+    panel.topRows(k)
+      .transpose()
+      .template triangularView<Eigen::UnitUpper>()
+      .solveInPlace(ws);
+  }
+
+  for (isize i = 0; i < n; ++i) {
+    x_e[i] = work[isize(zx(pperm_inv[i]))];
+  }
+}
+
+namespace _detail {
+// returns the values of the column `j` of the factor, stored in its panel
+// starting with the diagonal block, along with its position `c` in the panel,
+// the number of rows `m` of the panel, and their indices
+template<typename T, typename I>
+auto
+supernodal_col(SupernodalLdlt<T, I>& ldl,
+               usize j,
+               isize& c,
+               isize& m,
+               I const*& rows) noexcept -> T*
+{
+  auto zx = util::zero_extend;
+  usize s = zx(ldl.col_to_super[isize(j)]);
+  usize rp = zx(ldl.row_ptr[isize(s)]);
+  c = isize(j - zx(ldl.super_ptr[isize(s)]));
+  m = isize(zx(ldl.row_ptr[isize(s + 1)]) - rp);
+  rows = ldl.row_indices.ptr() + rp;
+  return ldl.values.ptr_mut() + ldl.values_ptr[isize(s)] + c * m;
+}
+
+// stores in `reach` the columns on the paths of the elimination tree going
+// from the columns `cols` (in the permuted ordering) to the root, stopping
+// before `stop`, in increasing order, and returns their number.
+// `marks` must be zero filled, and is zero filled again on return
+template<typename I>
+auto
+supernodal_reach(I* reach,
+                 bool* marks,
+                 I const* parent,
+                 I const* cols,
+                 isize ncols,
+                 usize stop) noexcept -> isize
+{
+  auto zx = util::zero_extend;
+  isize len = 0;
+  for (isize p = 0; p < ncols; ++p) {
+    usize j = zx(cols[p]);
+    while (j < stop && !marks[j]) {
+      marks[j] = true;
+      reach[len] = I(j);
+      ++len;
+      if (parent[j] == I(-1)) {
+        break;
+      }
+      j = zx(parent[j]);
+    }
+  }
+  std::sort(reach, reach + len);
+  for (isize p = 0; p < len; ++p) {
+    marks[zx(reach[p])] = false;
+  }
+  return len;
+}
+
+// computes the factors of `L D L.T + alpha w w.T`, where `w` is a dense vector
+// in the permuted ordering whose non zeros are all on the columns `cols`. `w`
+// is zero filled on return
+template<typename T, typename I>
+void
+supernodal_rank1_update(SupernodalLdlt<T, I>& ldl,
+                        T* w,
+                        I const* cols,
+                        isize ncols,
+                        T alpha) noexcept
+{
+  auto zx = util::zero_extend;
+  for (isize p = 0; p < ncols; ++p) {
+    usize j = zx(cols[p]);
+    isize c, m;
+    I const* rows;
+    T* col = supernodal_col(ldl, j, c, m, rows);
+
+    T wj = w[j];
+    w[j] = T(0);
+    if (wj == T(0)) {
+      continue;
+    }
+    T dj = col[c];
+    T new_dj = dj + alpha * wj * wj;
+    T gamma = wj * alpha / new_dj;
+    alpha = alpha * dj / new_dj;
+    col[c] = new_dj;
+    for (isize q = c + 1; q < m; ++q) {
+      usize i = zx(rows[q]);
+      w[i] -= wj * col[q];
+      col[q] += gamma * w[i];
+    }
+  }
+}
+} // namespace _detail
+
+/*!
+ * Computes the stack memory requirements of the updates of the supernodal
+ * factorization.
+ *
+ * @param ldl supernodal factorization.
+ * @param col_nnz number of non zeros of the update vector, or of the added or
+ * removed column.
+ */
+template<typename T, typename I>
+auto
+update_supernodal_req(SupernodalLdlt<T, I> const& ldl, isize col_nnz) noexcept
+  -> proxsuite::linalg::veg::dynstack::StackReq
+{
+  using proxsuite::linalg::veg::dynstack::StackReq;
+  isize n = ldl.n;
+  return StackReq{ n * isize{ sizeof(T) }, isize{ alignof(T) } } &
+         StackReq{ (n + col_nnz) * isize{ sizeof(I) }, isize{ alignof(I) } } &
+         StackReq{ n * isize{ sizeof(bool) }, isize{ alignof(bool) } };
+}
+
+/*!
+ * Performs a rank one update of the supernodal factorization in place. Given
+ * the factors of a matrix `a`, this computes the factors of
+ * `a + alpha w w.T`. Only the columns on the paths of the elimination tree
+ * going from the non zeros of `w` to the root are modified, so the structure
+ * of `w` must be a subset of the structure of `a`'s columns (e.g. `w` is a
+ * column of the identity).
+ *
+ * @param ldl supernodal factorization.
+ * @param w update vector, in the original ordering.
+ * @param alpha update coefficient.
+ * @param stack temporary allocation stack
+ */
+template<typename T, typename I>
+void
+rank1_update_supernodal(SupernodalLdlt<T, I>& ldl,
+                        VecRef<T, I> w,
+                        proxsuite::linalg::veg::DoNotDeduce<T> alpha,
+                        DynStackMut stack)
+{
+  proxsuite::linalg::veg::Tag<I> itag{};
+  proxsuite::linalg::veg::Tag<T> xtag{};
+  proxsuite::linalg::veg::Tag<bool> btag{};
+  auto zx = util::zero_extend;
+
+  isize n = ldl.n;
+  I const* pperm_inv = ldl.perm_inv.ptr();
+
+  auto _work = stack.make_new(xtag, n);
+  auto _reach = stack.make_new_for_overwrite(itag, n);
+  auto _cols = stack.make_new_for_overwrite(itag, w.nnz());
+  auto _marks = stack.make_new(btag, n);
+  T* work = _work.ptr_mut();
+  I* cols = _cols.ptr_mut();
+
+  for (isize p = 0; p < w.nnz(); ++p) {
+    cols[p] = pperm_inv[zx(w.row_indices()[p])];
+    work[zx(cols[p])] = w.values()[p];
+  }
+  isize len = _detail::supernodal_reach(_reach.ptr_mut(),
+                                        _marks.ptr_mut(),
+                                        ldl.etree.ptr(),
+                                        cols,
+                                        w.nnz(),
+                                        usize(n));
+  _detail::supernodal_rank1_update(ldl, work, _reach.ptr(), len, alpha);
+}
+
+/*!
+ * Adds a row and column to the supernodal factorization in place. The added
+ * row must be decoupled from the rest of the matrix beforehand, i.e. its
+ * elements in the factor are all zero, except for the diagonal one. This is
+ * the case right after it has been removed with `delete_row_supernodal`, or
+ * if it was factorized with a zero column and a non zero diagonal element.
+ * The structure of the new column must be a subset of the one used for the
+ * symbolic factorization.
+ *
+ * @param ldl supernodal factorization.
+ * @param pos position of the row and column in the original ordering.
+ * @param new_col upper triangular part of the new column, in the original
+ * ordering, without its diagonal element.
+ * @param diag_element diagonal element of the new column.
+ * @param stack temporary allocation stack
+ */
+template<typename T, typename I>
+void
+add_row_supernodal(SupernodalLdlt<T, I>& ldl,
+                   isize pos,
+                   VecRef<T, I> new_col,
+                   proxsuite::linalg::veg::DoNotDeduce<T> diag_element,
+                   DynStackMut stack)
+{
+  proxsuite::linalg::veg::Tag<I> itag{};
+  proxsuite::linalg::veg::Tag<T> xtag{};
+  proxsuite::linalg::veg::Tag<bool> btag{};
+  auto zx = util::zero_extend;
+
+  isize n = ldl.n;
+  I const* pperm_inv = ldl.perm_inv.ptr();
+  I const* pparent = ldl.etree.ptr();
+  usize k = zx(pperm_inv[pos]);
+
+  auto _work = stack.make_new(xtag, n);
+  auto _reach = stack.make_new_for_overwrite(itag, n);
+  auto _cols = stack.make_new_for_overwrite(itag, new_col.nnz());
+  auto _marks = stack.make_new(btag, n);
+  T* work = _work.ptr_mut();
+  I* reach = _reach.ptr_mut();
+  I* cols = _cols.ptr_mut();
+
+  for (isize p = 0; p < new_col.nnz(); ++p) {
+    cols[p] = pperm_inv[zx(new_col.row_indices()[p])];
+    work[zx(cols[p])] = new_col.values()[p];
+  }
+
+  // the new row of the factor is obtained by solving the lower triangular
+  // system on the columns before it, which are the ones of the row subtree.
+  // the contributions of these columns to the rows after it are accumulated at
+  // the same time
+  isize len = _detail::supernodal_reach(
+    reach, _marks.ptr_mut(), pparent, cols, new_col.nnz(), k);
+  T d = diag_element;
+  for (isize p = 0; p < len; ++p) {
+    usize j = zx(reach[p]);
+    isize c, m;
+    I const* rows;
+    T* col = _detail::supernodal_col(ldl, j, c, m, rows);
+
+    T zj = work[j];
+    work[j] = T(0);
+    isize row_k = -1;
+    for (isize q = c + 1; q < m; ++q) {
+      usize i = zx(rows[q]);
+      work[i] -= col[q] * zj;
+      if (i == k) {
+        row_k = q;
+      }
+    }
+    VEG_ASSERT(row_k != -1);
+    T lkj = zj / col[c];
+    col[row_k] = lkj;
+    d -= lkj * zj;
+  }
+
+  // the new column of the factor, whose outer product is then removed from the
+  // trailing part of the factorization
+  isize c, m;
+  I const* rows;
+  T* col = _detail::supernodal_col(ldl, k, c, m, rows);
+  col[c] = d;
+  work[k] = T(0);
+  for (isize q = c + 1; q < m; ++q) {
+    usize i = zx(rows[q]);
+    col[q] = work[i] / d;
+    work[i] = col[q];
+  }
+
+  if (pparent[k] != I(-1)) {
+    len = _detail::supernodal_reach(
+      reach, _marks.ptr_mut(), pparent, pparent + k, 1, usize(n));
+    _detail::supernodal_rank1_update(ldl, work, reach, len, -d);
+  }
+}
+
+/*!
+ * Removes a row and column from the supernodal factorization in place. The row
+ * is not removed from the structure of the factorization: it is decoupled from
+ * the rest of the matrix, and its diagonal element is set to `1`.
+ *
+ * @param ldl supernodal factorization.
+ * @param pos position of the row and column in the original ordering.
+ * @param old_col upper triangular part of the removed column, in the original
+ * ordering. Only its structure is accessed.
+ * @param stack temporary allocation stack
+ */
+template<typename T, typename I>
+void
+delete_row_supernodal(SupernodalLdlt<T, I>& ldl,
+                      isize pos,
+                      VecRef<T, I> old_col,
+                      DynStackMut stack)
+{
+  proxsuite::linalg::veg::Tag<I> itag{};
+  proxsuite::linalg::veg::Tag<T> xtag{};
+  proxsuite::linalg::veg::Tag<bool> btag{};
+  auto zx = util::zero_extend;
+
+  isize n = ldl.n;
+  I const* pperm_inv = ldl.perm_inv.ptr();
+  I const* pparent = ldl.etree.ptr();
+  usize k = zx(pperm_inv[pos]);
+
+  auto _work = stack.make_new(xtag, n);
+  auto _reach = stack.make_new_for_overwrite(itag, n);
+  auto _cols = stack.make_new_for_overwrite(itag, old_col.nnz());
+  auto _marks = stack.make_new(btag, n);
+  T* work = _work.ptr_mut();
+  I* reach = _reach.ptr_mut();
+  I* cols = _cols.ptr_mut();
+
+  // the row of the factor is zeroed
+  for (isize p = 0; p < old_col.nnz(); ++p) {
+    cols[p] = pperm_inv[zx(old_col.row_indices()[p])];
+  }
+  isize len = _detail::supernodal_reach(
+    reach, _marks.ptr_mut(), pparent, cols, old_col.nnz(), k);
+  for (isize p = 0; p < len; ++p) {
+    isize c, m;
+    I const* rows;
+    T* col = _detail::supernodal_col(ldl, zx(reach[p]), c, m, rows);
+    for (isize q = c + 1; q < m; ++q) {
+      if (zx(rows[q]) == k) {
+        col[q] = T(0);
+        break;
+      }
+    }
+  }
+
+  // the outer product of the column is added back to the trailing part of the
+  // factorization, and the column is zeroed
+  isize c, m;
+  I const* rows;
+  T* col = _detail::supernodal_col(ldl, k, c, m, rows);
+  T d = col[c];
+  col[c] = T(1);
+  for (isize q = c + 1; q < m; ++q) {
+    work[zx(rows[q])] = col[q];
+    col[q] = T(0);
+  }
+
+  if (pparent[k] != I(-1)) {
+    len = _detail::supernodal_reach(
+      reach, _marks.ptr_mut(), pparent, pparent + k, 1, usize(n));
+    _detail::supernodal_rank1_update(ldl, work, reach, len, d);
+  }
+}
+
+} // namespace sparse
+} // namespace linalg
+} // namespace proxsuite
+
+#endif /* end of include guard PROXSUITE_LINALG_SPARSE_LDLT_SUPERNODAL_HPP */
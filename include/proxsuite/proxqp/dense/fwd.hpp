@@ -7,6 +7,7 @@
 
 #include <Eigen/Sparse>
 #include "proxsuite/helpers/common.hpp"
+#include "proxsuite/proxqp/status.hpp"
 
 namespace proxsuite {
 namespace proxqp {
@@ -48,6 +49,54 @@ using VecISize = Eigen::Matrix<isize, DYN, 1>;
 using VecMapBool = Eigen::Map<Eigen::Matrix<bool, DYN, 1> const>;
 using VecBool = Eigen::Matrix<bool, DYN, 1>;
 
+/*!
+ * Number of columns used to store a hessian of dimension dim with the given
+ * structure: the full matrix, its diagonal only, or nothing.
+ */
+inline isize
+hessian_cols(isize dim, HessianType hessian_type) noexcept
+{
+  switch (hessian_type) {
+    case HessianType::Diagonal:
+      return 1;
+    case HessianType::Zero:
+      return 0;
+    default:
+      return dim;
+  }
+}
+
+/*!
+ * Resolves the Automatic dense backend, which is only used when requested
+ * explicitly (the default backend is PrimalDualLDLT), from a flop estimate of
+ * the factorizations: the PrimalDualLDLT backend factorizes a matrix of size up
+ * to dim + n_eq + n_in, whereas the PrimalLDLT backend first forms the dim x
+ * dim matrix H + A.T A / mu_eq + C.T C / mu_in. The PrimalLDLT backend is
+ * chosen when it is estimated to be at least twice cheaper.
+ *
+ * @param dense_backend requested backend.
+ * @param dim primal dimension.
+ * @param n_eq number of equality constraints.
+ * @param n_in number of inequality constraints.
+ */
+inline DenseBackend
+dense_backend_choice(DenseBackend dense_backend,
+                     isize dim,
+                     isize n_eq,
+                     isize n_in) noexcept
+{
+  if (dense_backend != DenseBackend::Automatic) {
+    return dense_backend;
+  }
+  double n = double(dim);
+  double n_constraints = double(n_eq + n_in);
+  double primal_dual_cost =
+    (n + n_constraints) * (n + n_constraints) * (n + n_constraints) / 3;
+  double primal_cost = n * n * n_constraints + n * n * n / 3;
+  return (2 * primal_cost < primal_dual_cost) ? DenseBackend::PrimalLDLT
+                                              : DenseBackend::PrimalDualLDLT;
+}
+
 } // namespace dense
 } // namespace proxqp
 } // namespace proxsuite
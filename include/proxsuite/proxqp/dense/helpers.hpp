@@ -55,6 +55,124 @@ compute_equality_constrained_initial_guess(Workspace<T>& qpwork,
   qpwork.rhs.setZero();
 }
 
+/*!
+ * Factorizes the matrix used by the PrimalLDLT backend, i.e., the Schur
+ * complement of the regularized KKT matrix with respect to its dual block:
+ * H + rho I + A.T A / mu_eq + C_act.T C_act / mu_in + I_box / mu_in, where
+ * qpwork.kkt holds H + rho I, C_act are the active inequality constraints and
+ * I_box the factorized box constraints.
+ *
+ * @param qpmodel QP problem model as defined by the user (without any scaling
+ * performed).
+ * @param qpwork solver workspace.
+ * @param mu_eq dual equality constrained proximal parameter.
+ * @param mu_in dual inequality constrained proximal parameter.
+ * @param with_active_constraints whether the active inequality and box
+ * constraints are included.
+ */
+template<typename T>
+void
+primal_factorize(const Model<T>& qpmodel,
+                 Workspace<T>& qpwork,
+                 T mu_eq,
+                 T mu_in,
+                 bool with_active_constraints)
+{
+  proxsuite::linalg::veg::dynstack::DynStackMut stack{
+    proxsuite::linalg::veg::from_slice_mut,
+    qpwork.ldl_stack.as_mut(),
+  };
+  isize n = qpmodel.dim;
+  T mu_eq_inv = T(1) / mu_eq;
+  T mu_in_inv = T(1) / mu_in;
+
+  // only the lower triangular part is accessed by the factorization
+  LDLT_TEMP_MAT_UNINIT(T, primal_kkt, n, n, stack);
+  primal_kkt = qpwork.kkt;
+  auto primal_kkt_lower =
+    primal_kkt.template selfadjointView<Eigen::Lower>();
+  // A.T A and C_act.T C_act are each formed with a single rank-k update
+  if (qpmodel.n_eq > 0) {
+    primal_kkt_lower.rankUpdate(qpwork.A_scaled.transpose(), mu_eq_inv);
+  }
+  if (with_active_constraints) {
+    LDLT_TEMP_MAT_UNINIT(T, c_active, n, qpmodel.n_in, stack);
+    isize n_c = 0;
+    for (isize i = 0; i < qpmodel.n_in; ++i) {
+      if (qpwork.current_bijection_map(i) < qpwork.n_c) {
+        c_active.col(n_c) = qpwork.C_scaled.row(i).transpose();
+        ++n_c;
+      }
+    }
+    if (n_c > 0) {
+      primal_kkt_lower.rankUpdate(c_active.leftCols(n_c), mu_in_inv);
+    }
+    if (qpmodel.box_constraints) {
+      primal_kkt.diagonal().array() +=
+        mu_in_inv * qpwork.factorized_box.template cast<T>().array();
+    }
+  }
+  qpwork.ldl.factorize(primal_kkt, stack);
+}
+/*!
+ * Stores in qpwork.kkt the regularized KKT matrix of the scaled problem
+ * without its inequality constraints (H + rho I for the PrimalLDLT backend).
+ *
+ * @param qpwork workspace of the solver.
+ * @param qpmodel QP problem model as defined by the user (without any scaling
+ * performed).
+ * @param qpresults solution results.
+ */
+template<typename T>
+void
+setup_kkt(Workspace<T>& qpwork, const Model<T>& qpmodel, Results<T>& qpresults)
+{
+  switch (qpmodel.hessian_type) {
+    case HessianType::Dense:
+      qpwork.kkt.topLeftCorner(qpmodel.dim, qpmodel.dim) = qpwork.H_scaled;
+      break;
+    case HessianType::Diagonal:
+      qpwork.kkt.topLeftCorner(qpmodel.dim, qpmodel.dim).setZero();
+      qpwork.kkt.topLeftCorner(qpmodel.dim, qpmodel.dim).diagonal() =
+        qpwork.H_scaled.col(0);
+      break;
+    case HessianType::Zero:
+      qpwork.kkt.topLeftCorner(qpmodel.dim, qpmodel.dim).setZero();
+      break;
+  }
+  qpwork.kkt.topLeftCorner(qpmodel.dim, qpmodel.dim).diagonal().array() +=
+    qpresults.info.rho;
+  qpwork.factorized_box.setConstant(false);
+
+  if (qpwork.dense_backend != DenseBackend::PrimalLDLT) {
+    qpwork.kkt.block(0, qpmodel.dim, qpmodel.dim, qpmodel.n_eq) =
+      qpwork.A_scaled.transpose();
+    qpwork.kkt.block(qpmodel.dim, 0, qpmodel.n_eq, qpmodel.dim) =
+      qpwork.A_scaled;
+    qpwork.kkt.bottomRightCorner(qpmodel.n_eq, qpmodel.n_eq).setZero();
+    qpwork.kkt.diagonal()
+      .segment(qpmodel.dim, qpmodel.n_eq)
+      .setConstant(-qpresults.info.mu_eq);
+  }
+}
+/*!
+ * Returns whether the copy of the first factorization stored in the workspace
+ * can be restored, i.e., whether it was computed with the current proximal
+ * parameters and in the requested precision.
+ *
+ * @param qpwork workspace of the solver.
+ * @param qpresults solution results.
+ */
+template<typename T>
+bool
+has_cached_factorization(const Workspace<T>& qpwork,
+                         const Results<T>& qpresults)
+{
+  return qpwork.ldl_cached && qpwork.ldl_cache_rho == qpresults.info.rho &&
+         qpwork.ldl_cache_mu_eq == qpresults.info.mu_eq &&
+         qpwork.ldl_cache.is_low_precision_requested() ==
+           qpwork.ldl.is_low_precision_requested();
+}
 /*!
  * Setups and performs the first factorization of the regularized KKT matrix of
  * the problem.
@@ -70,24 +188,38 @@ setup_factorization(Workspace<T>& qpwork,
                     const Model<T>& qpmodel,
                     Results<T>& qpresults)
 {
+  PROXSUITE_PROFILE_SCOPE(qpresults.info.profile.factorization_time);
 
   proxsuite::linalg::veg::dynstack::DynStackMut stack{
     proxsuite::linalg::veg::from_slice_mut,
     qpwork.ldl_stack.as_mut(),
   };
+  setup_kkt(qpwork, qpmodel, qpresults);
 
-  qpwork.kkt.topLeftCorner(qpmodel.dim, qpmodel.dim) = qpwork.H_scaled;
-  qpwork.kkt.topLeftCorner(qpmodel.dim, qpmodel.dim).diagonal().array() +=
-    qpresults.info.rho;
-  qpwork.kkt.block(0, qpmodel.dim, qpmodel.dim, qpmodel.n_eq) =
-    qpwork.A_scaled.transpose();
-  qpwork.kkt.block(qpmodel.dim, 0, qpmodel.n_eq, qpmodel.dim) = qpwork.A_scaled;
-  qpwork.kkt.bottomRightCorner(qpmodel.n_eq, qpmodel.n_eq).setZero();
-  qpwork.kkt.diagonal()
-    .segment(qpmodel.dim, qpmodel.n_eq)
-    .setConstant(-qpresults.info.mu_eq);
-
-  qpwork.ldl.factorize(qpwork.kkt.transpose(), stack);
+  // the factorization of the scaled model with the same proximal parameters
+  // is restored from its copy
+  if (has_cached_factorization(qpwork, qpresults)) {
+    qpwork.ldl = qpwork.ldl_cache;
+    return;
+  }
+  PROXSUITE_PROFILE_COUNT(qpresults.info.profile.factorizations, 1);
+
+  if (qpwork.dense_backend == DenseBackend::PrimalLDLT) {
+    primal_factorize(qpmodel,
+                     qpwork,
+                     qpresults.info.mu_eq,
+                     qpresults.info.mu_in,
+                     false);
+  } else {
+    qpwork.ldl.factorize(qpwork.kkt.transpose(), stack);
+  }
+
+  if (qpwork.scaled_model_cached) {
+    qpwork.ldl_cache = qpwork.ldl;
+    qpwork.ldl_cache_rho = qpresults.info.rho;
+    qpwork.ldl_cache_mu_eq = qpresults.info.mu_eq;
+    qpwork.ldl_cached = true;
+  }
 }
 /*!
  * Performs the equilibration of the QP problem for reducing its
@@ -100,13 +232,18 @@ setup_factorization(Workspace<T>& qpwork,
  * preconditioner. If set to False, it uses the previous preconditioning
  * variables (initialized to the identity preconditioner if it is the first
  * scaling performed).
+ * @param box_constraints whether the problem has box constraints, whose bounds
+ * are scaled as the primal variable.
+ * @param hessian_type structure of the hessian stored in qpwork.H_scaled.
  */
 template<typename T>
 void
 setup_equilibration(Workspace<T>& qpwork,
                     const Settings<T>& qpsettings,
                     preconditioner::RuizEquilibration<T>& ruiz,
-                    bool execute_preconditioner)
+                    bool execute_preconditioner,
+                    bool box_constraints,
+                    HessianType hessian_type)
 {
 
   QpViewBoxMut<T> qp_scaled{
@@ -124,7 +261,13 @@ setup_equilibration(Workspace<T>& qpwork,
                          execute_preconditioner,
                          qpsettings.preconditioner_max_iter,
                          qpsettings.preconditioner_accuracy,
+                         box_constraints,
+                         hessian_type,
                          stack);
+  if (box_constraints) {
+    ruiz.scale_primal_in_place({ from_eigen, qpwork.u_box_scaled });
+    ruiz.scale_primal_in_place({ from_eigen, qpwork.l_box_scaled });
+  }
   qpwork.correction_guess_rhs_g = infty_norm(qpwork.g_scaled);
 }
 
@@ -153,6 +296,33 @@ initial_guess(Workspace<T>& qpwork,
     }
   }
 }
+/*!
+ * Stores the quadratic cost H in the model, with the storage of its hessian
+ * type: H may be given as a full dim x dim matrix, or as its diagonal
+ * (dim x 1) for a diagonal hessian. It is ignored for a zero hessian.
+ *
+ * @param qpmodel solver model.
+ * @param H quadratic cost input defining the QP model.
+ */
+template<typename T>
+void
+assign_hessian(Model<T>& qpmodel, MatRef<T> H)
+{
+  switch (qpmodel.hessian_type) {
+    case HessianType::Dense:
+      qpmodel.H = H;
+      break;
+    case HessianType::Diagonal:
+      if (H.cols() == 1) {
+        qpmodel.H = H;
+      } else {
+        qpmodel.H.col(0) = H.diagonal();
+      }
+      break;
+    case HessianType::Zero:
+      break;
+  }
+}
 /*!
  * Updates the QP solver model.
  *
@@ -163,6 +333,8 @@ initial_guess(Workspace<T>& qpwork,
  * @param C inequality constraint matrix input defining the QP model.
  * @param l lower inequality constraint vector input defining the QP model.
  * @param u upper inequality constraint vector input defining the QP model.
+ * @param l_box lower bounds on the primal variable.
+ * @param u_box upper bounds on the primal variable.
  * @param qpwork solver workspace.
  * @param qpsettings solver settings.
  * @param qpmodel solver model.
@@ -178,6 +350,8 @@ update(optional<MatRef<T>> H,
        optional<MatRef<T>> C,
        optional<VecRef<T>> l,
        optional<VecRef<T>> u,
+       optional<VecRef<T>> l_box,
+       optional<VecRef<T>> u_box,
        Model<T>& model,
        Workspace<T>& work)
 {
@@ -206,14 +380,29 @@ update(optional<MatRef<T>> H,
                                   "the dimension wrt inequality constrained "
                                   "variables for updating l is not valid.");
   }
+  if (u_box != nullopt) {
+    PROXSUITE_CHECK_ARGUMENT_SIZE(u_box.value().size(),
+                                  model.u_box.size(),
+                                  "the dimension wrt box constrained variables "
+                                  "for updating u_box is not valid.");
+  }
+  if (l_box != nullopt) {
+    PROXSUITE_CHECK_ARGUMENT_SIZE(l_box.value().size(),
+                                  model.l_box.size(),
+                                  "the dimension wrt box constrained variables "
+                                  "for updating l_box is not valid.");
+  }
   if (H != nullopt) {
     PROXSUITE_CHECK_ARGUMENT_SIZE(
       H.value().rows(),
       model.dim,
       "the row dimension for updating H is not valid.");
+    // a diagonal hessian may also be given as its diagonal only
     PROXSUITE_CHECK_ARGUMENT_SIZE(
       H.value().cols(),
-      model.dim,
+      (model.hessian_type == HessianType::Diagonal && H.value().cols() == 1
+         ? 1
+         : model.dim),
       "the column dimension for updating H is not valid.");
   }
   if (A != nullopt) {
@@ -250,13 +439,19 @@ update(optional<MatRef<T>> H,
   if (l != nullopt) {
     model.l = l.value().eval();
   }
+  if (u_box != nullopt) {
+    model.u_box = u_box.value().eval();
+  }
+  if (l_box != nullopt) {
+    model.l_box = l_box.value().eval();
+  }
 
   if (H != nullopt || A != nullopt || C != nullopt) {
     work.refactorize = true;
   }
 
   if (H != nullopt) {
-    model.H = H.value();
+    assign_hessian(model, H.value());
   }
   if (A != nullopt) {
     model.A = A.value();
@@ -276,6 +471,8 @@ update(optional<MatRef<T>> H,
  * @param C inequality constraint matrix input defining the QP model.
  * @param l lower inequality constraint vector input defining the QP model.
  * @param u upper inequality constraint vector input defining the QP model.
+ * @param l_box lower bounds on the primal variable.
+ * @param u_box upper bounds on the primal variable.
  * @param qpwork solver workspace.
  * @param qpsettings solver settings.
  * @param qpmodel solver model.
@@ -295,6 +492,8 @@ setup( //
   optional<MatRef<T>> C,
   optional<VecRef<T>> l,
   optional<VecRef<T>> u,
+  optional<VecRef<T>> l_box,
+  optional<VecRef<T>> u_box,
   Settings<T>& qpsettings,
   Model<T>& qpmodel,
   Workspace<T>& qpwork,
@@ -354,7 +553,7 @@ setup( //
     }
   }
   if (H != nullopt) {
-    qpmodel.H = H.value();
+    assign_hessian(qpmodel, H.value());
   } // else qpmodel.H remains initialzed to a matrix with zero elements
   if (g != nullopt) {
     qpmodel.g = g.value();
@@ -384,6 +583,14 @@ setup( //
     qpmodel.l = l.value();
   } // else qpmodel.l remains initialized to a matrix with zero elements or zero
     // shape
+
+  if (u_box != nullopt) {
+    qpmodel.u_box = u_box.value();
+  } // else qpmodel.u_box remains initialized to infinite bounds
+
+  if (l_box != nullopt) {
+    qpmodel.l_box = l_box.value();
+  } // else qpmodel.l_box remains initialized to infinite bounds
   assert(qpmodel.is_valid());
 
   qpwork.H_scaled = qpmodel.H;
@@ -401,21 +608,45 @@ setup( //
       .select(qpmodel.l,
               Eigen::Matrix<T, Eigen::Dynamic, 1>::Zero(qpmodel.n_in).array() -
                 T(1.E20));
+  qpwork.u_box_scaled = helpers::at_most(qpmodel.u_box, T(1.E20));
+  qpwork.l_box_scaled = helpers::at_least(qpmodel.l_box, T(-1.E20));
 
   qpwork.dual_feasibility_rhs_2 = infty_norm(qpmodel.g);
 
+  qpresults.info.profile.clear();
+  PROXSUITE_PROFILE_SCOPE(qpresults.info.profile.equilibration_time);
   switch (preconditioner_status) {
     case PreconditionerStatus::EXECUTE:
-      setup_equilibration(qpwork, qpsettings, ruiz, true);
+      setup_equilibration(qpwork,
+                          qpsettings,
+                          ruiz,
+                          true,
+                          qpmodel.box_constraints,
+                          qpmodel.hessian_type);
       break;
     case PreconditionerStatus::IDENTITY:
-      setup_equilibration(qpwork, qpsettings, ruiz, false);
+      setup_equilibration(qpwork,
+                          qpsettings,
+                          ruiz,
+                          false,
+                          qpmodel.box_constraints,
+                          qpmodel.hessian_type);
       break;
     case PreconditionerStatus::KEEP:
       // keep previous one
-      setup_equilibration(qpwork, qpsettings, ruiz, false);
+      setup_equilibration(qpwork,
+                          qpsettings,
+                          ruiz,
+                          false,
+                          qpmodel.box_constraints,
+                          qpmodel.hessian_type);
       break;
   }
+  if (qpsettings.cache_scaled_model) {
+    qpwork.store_scaled_model();
+  } else {
+    qpwork.release_scaled_model_cache();
+  }
 }
 ////// UPDATES ///////
 
@@ -167,6 +167,35 @@ primal_dual_derivative_results(const Model<T>& qpmodel,
   b += qpresults.info.nu * qpresults.info.mu_in_inv *
        qpwork.err.tail(qpmodel.n_in).dot(qpwork.active_part_z);
 
+  if (qpmodel.box_constraints) {
+    // same terms for the box constraints, which are identity rows of the
+    // scaled problem (i.e., Cdx is replaced by dx)
+    auto dx = qpwork.dw_aug.head(qpmodel.dim).array();
+    auto up_plus_alphadx =
+      qpwork.primal_residual_box_scaled_up.array() + alpha * dx;
+    auto low_plus_alphadx =
+      qpwork.primal_residual_box_scaled_low.array() + alpha * dx;
+    auto dx_act = ((up_plus_alphadx > T(0.)) || (low_plus_alphadx < T(0.)))
+                    .select(dx, T(0.));
+    auto active_part_z_box =
+      (up_plus_alphadx > T(0.))
+        .select(qpwork.primal_residual_box_scaled_up.array(), T(0.)) +
+      (low_plus_alphadx < T(0.))
+        .select(qpwork.primal_residual_box_scaled_low.array(), T(0.));
+    auto dx_act_minus_dz =
+      dx_act - qpwork.dz_box.array() * qpresults.info.mu_in;
+    auto active_part_z_box_minus_z =
+      active_part_z_box - qpresults.z_box.array() * qpresults.info.mu_in;
+
+    a += qpresults.info.mu_in_inv * dx_act.matrix().squaredNorm() +
+         qpresults.info.nu * qpresults.info.mu_in_inv *
+           dx_act_minus_dz.matrix().squaredNorm();
+    b += qpresults.info.mu_in_inv *
+           active_part_z_box.matrix().dot(dx_act.matrix()) +
+         qpresults.info.nu * qpresults.info.mu_in_inv *
+           dx_act_minus_dz.matrix().dot(active_part_z_box_minus_z.matrix());
+  }
+
   return {
     a,
     b,
@@ -190,166 +219,221 @@ primal_dual_ls(const Model<T>& qpmodel,
 {
 
   /*
-   * The algorithm performs the following step
+   * phi(alpha) = [proximal primal dual augmented lagrangian of the subproblem
+   * evaluated at x_k + alpha dx, y_k + alpha dy, z_k + alpha dz] is piecewise
+   * quadratic: its derivative phi'(alpha) = a * alpha + b is affine between
+   * two consecutive breakpoints, i.e., the steps at which one inequality (or
+   * box) constraint enters or leaves the active set. By construction
+   * phi'(0) <= 0, and the algorithm looks for the first alpha* at which
+   * phi' cancels.
    *
    * 1/
-   * 1.1/ Store solutions of equations
-   * C(x+alpha dx) - l + ze/mu_in = 0
+   * 1.1/ Store (in a vectorized pass) the solutions of equations
    * C(x+alpha dx) - u + ze/mu_in = 0
+   * C(x+alpha dx) - l + ze/mu_in = 0
+   * and keep the indices of the positive ones as breakpoints.
    *
-   * 1.2/ Sort the alpha
-   * 2/
-   * 2.1
-   * For each positive alpha compute the first derivative of
-   * phi(alpha) = [proximal primal dual augmented lagrangian of the subproblem
-   * evaluated at x_k + alpha dx, y_k + alpha dy, z_k + alpha dz] using function
-   * "gradient_norm" By construction for alpha = 0, phi'(alpha) <= 0 and
-   * phi'(alpha) goes to infinity with alpha hence it cancels uniquely at one
-   * optimal alpha*
-   *
-   * while phi'(alpha)<=0 store the derivative (noted last_grad_neg) and
-   * alpha (last_alpha_neg)
-   * the first time phi'(alpha) > 0 store the derivative (noted
-   * first_grad_pos) and alpha (first_alpha_pos), and break the loo
+   * 1.2/ Compute a and b for alpha -> 0+ and sort the breakpoints.
    *
-   * 2.2
-   * If first_alpha_pos corresponds to the first positive alpha of previous
-   * loop, then do
-   *   last_alpha_neg = 0
-   *   last_grad_neg = phi'(0)
+   * 2/
+   * Sweep the breakpoints in increasing order. Crossing a breakpoint changes
+   * the state of a single constraint, hence a and b are updated in O(1). The
+   * sweep stops at the first interval [alpha_prev, alpha_next] at whose end
+   * phi' is nonnegative, and
+   *   alpha* = max(alpha_prev, -b / a)
+   * (alpha* = alpha_prev when phi' jumps above zero at alpha_prev).
    *
-   * 2.3
-   * the optimal alpha is within the interval
-   * [last_alpha_neg,first_alpha_pos] and can be computed exactly as phi' is
-   * an affine function in alph
-   * alpha* = alpha_last_neg
-   *        - last_neg_grad * (alpha_first_pos - alpha_last_neg) /
-   *                          (first_pos_grad - last_neg_grad);
+   * The whole linesearch costs O(n_in log(n_in)), which is dominated by the
+   * sort.
    */
+  PROXSUITE_PROFILE_SCOPE(qpresults.info.profile.line_search_time);
+  PROXSUITE_PROFILE_COUNT(qpresults.info.profile.line_searches, 1);
 
-  const T machine_eps = std::numeric_limits<T>::epsilon();
+  const isize n_in = qpmodel.n_in;
+  const isize n_box = qpmodel.box_constraints ? qpmodel.dim : 0;
+  const isize n_bounds = n_in + n_box;
+  const T mu_in = qpresults.info.mu_in;
+  const T mu_in_inv = qpresults.info.mu_in_inv;
+  const T nu = qpresults.info.nu;
 
-  qpwork.alpha = T(1);
-  T alpha_(1.);
+  auto dx = qpwork.dw_aug.head(qpmodel.dim);
+  auto dz = qpwork.dw_aug.tail(n_in);
 
-  qpwork.alphas.clear();
+  qpwork.alpha = T(1);
 
   ///////// STEP 1 /////////
-  // 1.1 add solutions of equations C(x+alpha dx)-l +ze/mu_in = 0 and C(x+alpha
-  // dx)-u +ze/mu_in = 0
+  // 1.1 the breakpoint associated to the upper (resp. lower) side of the
+  // bound i is stored at alphas[i] (resp. alphas[n_bounds + i]), bounds
+  // [n_in, n_bounds) being the box constraints.
+
+  qpwork.alphas.resize(2 * n_bounds);
+  Eigen::Map<Vec<T>> alphas(qpwork.alphas.ptr_mut(), 2 * n_bounds);
+  alphas.head(n_in).array() =
+    -qpwork.primal_residual_in_scaled_up.array() / qpwork.Cdx.array();
+  alphas.segment(n_bounds, n_in).array() =
+    -qpwork.primal_residual_in_scaled_low.array() / qpwork.Cdx.array();
+  if (qpmodel.box_constraints) {
+    alphas.segment(n_in, n_box).array() =
+      -qpwork.primal_residual_box_scaled_up.array() / dx.array();
+    alphas.tail(n_box).array() =
+      -qpwork.primal_residual_box_scaled_low.array() / dx.array();
+  }
+
+  // c is Cdx (dx for the box constraints), r the residual of the constraint
+  // and (z, dz) its multiplier and multiplier step
+  auto c_of = [&](isize i) -> T {
+    return i < n_in ? qpwork.Cdx(i) : dx(i - n_in);
+  };
+  auto r_up_of = [&](isize i) -> T {
+    return i < n_in ? qpwork.primal_residual_in_scaled_up(i)
+                    : qpwork.primal_residual_box_scaled_up(i - n_in);
+  };
+  auto r_low_of = [&](isize i) -> T {
+    return i < n_in ? qpwork.primal_residual_in_scaled_low(i)
+                    : qpwork.primal_residual_box_scaled_low(i - n_in);
+  };
+
+  T a(0);
+  T b(0);
+
+  // adds sign * (contribution of the bound i when active with residual r -
+  // contribution of the bound i when inactive) to a and b
+  auto activate = [&](isize i, T r, T sign) {
+    T c = c_of(i);
+    T dz_i = i < n_in ? dz(i) : qpwork.dz_box(i - n_in);
+    T z_i = i < n_in ? qpresults.z(i) : qpresults.z_box(i - n_in);
+    T d_act = c - dz_i * mu_in;
+    T d_inact = dz_i * mu_in;
+    a += sign * mu_in_inv * (c * c + nu * (d_act * d_act - d_inact * d_inact));
+    b += sign * mu_in_inv *
+         (r * c + nu * (d_act * (r - z_i * mu_in) - d_inact * z_i * mu_in));
+  };
 
-  for (isize i = 0; i < qpmodel.n_in; i++) {
+  // 1.2 all bounds are first counted as inactive: their contribution is then
+  // nu*mu_in_inv * |dz*mu_in|**2 for a, and
+  // nu*mu_in_inv * (dz*mu_in).dot(z*mu_in) for b
+  a += nu * mu_in * dz.squaredNorm();
+  b += nu * mu_in * dz.dot(qpresults.z);
+  if (qpmodel.box_constraints) {
+    a += nu * mu_in * qpwork.dz_box.squaredNorm();
+    b += nu * mu_in * qpwork.dz_box.dot(qpresults.z_box);
+  }
 
-    if (qpwork.Cdx(i) != 0.) {
-      alpha_ =
-        -qpwork.primal_residual_in_scaled_up(i) / (qpwork.Cdx(i) + machine_eps);
-      if (alpha_ > machine_eps) {
-        qpwork.alphas.push(alpha_);
+  qpwork.breakpoints.clear();
+  for (isize i = 0; i < n_bounds; ++i) {
+    T c = c_of(i);
+    T r_up = r_up_of(i);
+    T r_low = r_low_of(i);
+
+    // state of the bound for alpha -> 0+
+    if (r_up > T(0) || (r_up == T(0) && c > T(0))) {
+      activate(i, r_up, T(1));
+    } else if (r_low < T(0) || (r_low == T(0) && c < T(0))) {
+      activate(i, r_low, T(1));
+    }
+
+    if (c != T(0)) {
+      if (alphas[i] > T(0)) {
+        qpwork.breakpoints.push(i);
       }
-      alpha_ = -qpwork.primal_residual_in_scaled_low(i) /
-               (qpwork.Cdx(i) + machine_eps);
-      if (alpha_ > machine_eps) {
-        qpwork.alphas.push(alpha_);
+      if (alphas[n_bounds + i] > T(0)) {
+        qpwork.breakpoints.push(n_bounds + i);
       }
     }
   }
 
-  isize n_alpha = qpwork.alphas.len();
-
-  // 1.2 sort the alphas
-
-  std::sort(qpwork.alphas.ptr_mut(), qpwork.alphas.ptr_mut() + n_alpha);
-  isize new_len = std::unique( //
-                    qpwork.alphas.ptr_mut(),
-                    qpwork.alphas.ptr_mut() + n_alpha) -
-                  qpwork.alphas.ptr_mut();
-  qpwork.alphas.resize(new_len);
-
-  n_alpha = qpwork.alphas.len();
-
-  if (n_alpha == 0 || qpwork.alphas[0] > 1) {
+  // terms which do not depend on the active set: a = dx.dot(H.dot(dx)) + rho
+  // * norm(dx)**2 + mu_eq_inv * norm(Adx)**2 + nu*mu_eq_inv *
+  // norm(Adx-dy*mu_eq)**2 and b = dx.dot(H.dot(x) + rho*(x-xe) + g) +
+  // mu_eq_inv * Adx.dot(res_eq + y*mu_eq) + nu*mu_eq_inv *
+  // (Adx-dy*mu_eq).dot(res_eq)
+  qpwork.err.segment(qpmodel.dim, qpmodel.n_eq) =
+    qpwork.Adx -
+    qpwork.dw_aug.segment(qpmodel.dim, qpmodel.n_eq) * qpresults.info.mu_eq;
+  a += dx.dot(qpwork.Hdx) +
+       qpresults.info.mu_eq_inv * qpwork.Adx.squaredNorm() +
+       qpresults.info.rho * dx.squaredNorm() +
+       nu * qpresults.info.mu_eq_inv *
+         qpwork.err.segment(qpmodel.dim, qpmodel.n_eq).squaredNorm();
+  qpwork.err.head(qpmodel.dim) =
+    qpresults.info.rho * (qpresults.x - qpwork.x_prev) + qpwork.g_scaled;
+  b += qpresults.x.dot(qpwork.Hdx) + qpwork.err.head(qpmodel.dim).dot(dx) +
+       qpresults.info.mu_eq_inv *
+         qpwork.Adx.dot(qpwork.primal_residual_eq_scaled +
+                        qpresults.y * qpresults.info.mu_eq) +
+       nu * qpresults.info.mu_eq_inv *
+         qpwork.err.segment(qpmodel.dim, qpmodel.n_eq)
+           .dot(qpwork.primal_residual_eq_scaled);
+
+  isize* breakpoints = qpwork.breakpoints.ptr_mut();
+  isize n_breakpoints = qpwork.breakpoints.len();
+  std::sort(breakpoints,
+            breakpoints + n_breakpoints,
+            [&](isize lhs, isize rhs) { return alphas[lhs] < alphas[rhs]; });
+
+  if (n_breakpoints == 0 || alphas[breakpoints[0]] > 1) {
     qpwork.alpha = 1;
     return;
   }
 
   ////////// STEP 2 ///////////
-  auto infty = std::numeric_limits<T>::infinity();
-
-  T last_neg_grad = 0;
-  T alpha_last_neg = 0;
-  T first_pos_grad = 0;
-  T alpha_first_pos = infty;
-  for (isize i = 0; i < n_alpha; ++i) {
-    alpha_ = qpwork.alphas[i];
-
-    /*
-     * 2.1
-     * For each positive alpha compute the first derivative of
-     * phi(alpha) = [proximal augmented lagrangian of the
-     *               subproblem evaluated at x_k + alpha dx]
-     *
-     * (By construction for alpha = 0,  phi'(alpha) <= 0 and
-     * phi'(alpha) goes to infinity with alpha hence it cancels
-     * uniquely at one optimal alpha*
-     *
-     * while phi'(alpha)<=0 store the derivative (noted
-     * last_grad_neg) and alpha (last_alpha_neg
-     * the first time phi'(alpha) > 0 store the derivative
-     * (noted first_grad_pos) and alpha (first_alpha_pos), and
-     * break the loop
-     */
-    T gr =
-      primal_dual_derivative_results(qpmodel, qpresults, qpwork, alpha_).grad;
-
-    if (gr < T(0)) {
-      alpha_last_neg = alpha_;
-      last_neg_grad = gr;
-    } else {
-      first_pos_grad = gr;
-      alpha_first_pos = alpha_;
-      break;
+  T alpha_prev(0);
+  for (isize k = 0; k < n_breakpoints; ++k) {
+    isize code = breakpoints[k];
+    T alpha_next = alphas[code];
+    if (alpha_next > alpha_prev) {
+      // phi' = a * alpha + b on [alpha_prev, alpha_next]
+      if (a * alpha_next + b >= T(0)) {
+        qpwork.alpha = std::max(alpha_prev, -b / a);
+        return;
+      }
+      alpha_prev = alpha_next;
     }
+
+    // the bound enters the active set when its residual changes sign in the
+    // direction of the violated side, and leaves it otherwise
+    bool low = code >= n_bounds;
+    isize i = low ? code - n_bounds : code;
+    T sign = (low == (c_of(i) < T(0))) ? T(1) : T(-1);
+    activate(i, low ? r_low_of(i) : r_up_of(i), sign);
   }
 
-  /*
-   * 2.2
-   * If first_alpha_pos corresponds to the first positive alpha of
-   * previous loop, then do
-   * last_alpha_neg = 0 and last_grad_neg = phi'(0) using function
-   * "gradient_norm"
-   */
-  if (alpha_last_neg == T(0)) {
-    last_neg_grad =
-      primal_dual_derivative_results(qpmodel, qpresults, qpwork, alpha_last_neg)
-        .grad;
+  // the optimal alpha is within the interval [alpha_prev, +inf)
+  qpwork.alpha = std::max(alpha_prev, -b / a);
+}
+
+/*!
+ * Adds alpha * C_i.T C_i to the matrix factorized by the PrimalLDLT backend,
+ * for the inequality constraints i given by indices.
+ *
+ * @param qpmodel QP problem model as defined by the user (without any scaling
+ * performed).
+ * @param qpwork solver workspace.
+ * @param indices indices of the inequality constraints.
+ * @param count number of inequality constraints.
+ * @param alpha weight of the rank updates.
+ * @param stack workspace memory stack.
+ */
+template<typename T>
+void
+rank_update_constraints(const Model<T>& qpmodel,
+                        Workspace<T>& qpwork,
+                        isize const* indices,
+                        isize count,
+                        T alpha,
+                        proxsuite::linalg::veg::dynstack::DynStackMut stack)
+{
+  if (count == 0) {
+    return;
   }
-  if (alpha_first_pos == infty) {
-    /*
-     * 2.3
-     * the optimal alpha is within the interval
-     * [last_alpha_neg, +∞)
-     */
-    PrimalDualDerivativeResult<T> res = primal_dual_derivative_results(
-      qpmodel, qpresults, qpwork, 2 * alpha_last_neg + 1);
-    auto& a = res.a;
-    auto& b = res.b;
-    // grad = a * alpha + b
-    // grad = 0 => alpha = -b/a
-    qpwork.alpha = -b / a;
-  } else {
-    /*
-     * 2.3
-     * the optimal alpha is within the interval
-     * [last_alpha_neg,first_alpha_pos] and can be computed exactly as phi'
-     * is an affine function in alpha
-     */
-
-    qpwork.alpha = alpha_last_neg - last_neg_grad *
-                                      (alpha_first_pos - alpha_last_neg) /
-                                      (first_pos_grad - last_neg_grad);
+  LDLT_TEMP_MAT_UNINIT(T, w, qpmodel.dim, count, stack);
+  LDLT_TEMP_VEC_UNINIT(T, rank_update_alpha, count, stack);
+  for (isize k = 0; k < count; ++k) {
+    w.col(k) = qpwork.C_scaled.row(indices[k]).transpose();
   }
+  rank_update_alpha.setConstant(alpha);
+  qpwork.ldl.rank_r_update(w, rank_update_alpha, stack);
 }
-
 /*!
  * Performs the active set change of the factorized KKT matrix (using rank one
  * updates or downgrades).
@@ -387,70 +471,75 @@ active_set_change(const Model<T>& qpmodel,
    * (all other correspond to inactive rows
    *
    * To do so,
-   * 1/ for initialization
-   * 1.1/ new_bijection_map = current_bijection_map
-   * 1.2/ n_c_f = n_
+   * 1/ the inverse of current_bijection_map (i.e., the constraint stored at
+   * each row of C_current) is stored in new_bijection_map
    *
-   * 2/ All active indexes of the current bijection map (i.e
-   * current_bijection_map(i) < n_c by assumption) which are not active
-   * anymore in the new active set (new_active_set(i)=false are put at the
-   * end of new_bijection_map, i.
+   * 2/ the rows i < n_c of C_current which are not active anymore in the new
+   * active set (new_active_set(i) = false) are deleted from the
+   * factorization, and n_c_f = n_c - (number of deleted rows)
    *
-   * 2.1/ for all j if new_bijection_map(j) > new_bijection_map(i), then
-   * new_bijection_map(j)-=1
-   * 2.2/ n_c_f -=1
-   * 2.3/ new_bijection_map(i) = n_in-1
+   * 3/ the active indexes of the new active set which are not active in the
+   * current bijection map (current_bijection_map(i) >= n_c) are put at the
+   * end of the active rows of C_current, in increasing order of i
    *
-   * 3/ All active indexe of the new active set (new_active_set(i) == true)
-   * which are not active in the new_bijection_map (new_bijection_map(i) >=
-   * n_c_f) are put at the end of the current version of C, i.e
-   * 3.1/ if new_bijection_map(j) < new_bijection_map(i) &&
-   * new_bijection_map(j) >= n_c_f then new_bijection_map(j)+=1
-   * 3.2/ new_bijection_map(i) = n_c_f
-   * 3.3/ n_c_f +=1
+   * 4/ the bijection map is rebuilt in a single pass: the rows which remain
+   * active keep their relative order, followed by the added ones, and then by
+   * the inactive ones
    *
-   * It returns finally the new_bijection_map, for which
-   * new_bijection_map(n_in) = n_c_f
+   * It returns finally the new bijection map (in both current_bijection_map
+   * and new_bijection_map), and the new number of active inequalities n_c.
+   * The whole procedure costs O(n_in) besides the update of the
+   * factorization.
    */
+  PROXSUITE_PROFILE_SCOPE(qpresults.info.profile.active_set_change_time);
 
   qpwork.dw_aug.setZero();
 
+  isize n_in = qpmodel.n_in;
   isize n_c_f = qpwork.n_c;
-  qpwork.new_bijection_map = qpwork.current_bijection_map;
+  // new_bijection_map(k) is the constraint stored at the row k of C_current
+  for (isize i = 0; i < n_in; i++) {
+    qpwork.new_bijection_map(qpwork.current_bijection_map(i)) = i;
+  }
 
   // suppression pour le nouvel active set, ajout dans le nouvel unactive set
 
   proxsuite::linalg::veg::dynstack::DynStackMut stack{
     proxsuite::linalg::veg::from_slice_mut, qpwork.ldl_stack.as_mut()
   };
+  // with the PrimalLDLT backend, the changes of the active set are rank
+  // updates of the factorized matrix, with the rows of C scaled by 1/mu_in
+  bool primal_backend = qpwork.dense_backend == DenseBackend::PrimalLDLT;
 
   {
     auto _planned_to_delete = stack.make_new_for_overwrite(
-      proxsuite::linalg::veg::Tag<isize>{}, isize(qpmodel.n_in));
+      proxsuite::linalg::veg::Tag<isize>{}, isize(n_in));
     isize* planned_to_delete = _planned_to_delete.ptr_mut();
     isize planned_to_delete_count = 0;
 
-    for (isize i = 0; i < qpmodel.n_in; i++) {
-      if (qpwork.current_bijection_map(i) < qpwork.n_c) {
-        if (!qpwork.active_inequalities(i)) {
-          // delete current_bijection_map(i)
-
-          planned_to_delete[planned_to_delete_count] =
-            qpwork.current_bijection_map(i) + qpmodel.dim + qpmodel.n_eq;
-          ++planned_to_delete_count;
-
-          for (isize j = 0; j < qpmodel.n_in; j++) {
-            if (qpwork.new_bijection_map(j) > qpwork.new_bijection_map(i)) {
-              qpwork.new_bijection_map(j) -= 1;
-            }
-          }
-          n_c_f -= 1;
-          qpwork.new_bijection_map(i) = qpmodel.n_in - 1;
-        }
+    // the rows are visited in increasing order, hence planned_to_delete is
+    // sorted
+    for (isize k = 0; k < qpwork.n_c; k++) {
+      isize i = qpwork.new_bijection_map(k);
+      if (!qpwork.active_inequalities(i)) {
+        planned_to_delete[planned_to_delete_count] =
+          primal_backend ? i : k + qpmodel.dim + qpmodel.n_eq;
+        ++planned_to_delete_count;
       }
     }
-    std::sort(planned_to_delete, planned_to_delete + planned_to_delete_count);
-    qpwork.ldl.delete_at(planned_to_delete, planned_to_delete_count, stack);
+    n_c_f -= planned_to_delete_count;
+    PROXSUITE_PROFILE_COUNT(qpresults.info.profile.active_set_deletions,
+                            planned_to_delete_count);
+    if (primal_backend) {
+      rank_update_constraints(qpmodel,
+                              qpwork,
+                              planned_to_delete,
+                              planned_to_delete_count,
+                              -T(1) / qpresults.info.mu_in,
+                              stack);
+    } else {
+      qpwork.ldl.delete_at(planned_to_delete, planned_to_delete_count, stack);
+    }
     if (planned_to_delete_count > 0) {
       qpwork.constraints_changed = true;
     }
@@ -460,31 +549,54 @@ active_set_change(const Model<T>& qpmodel,
 
   {
     auto _planned_to_add = stack.make_new_for_overwrite(
-      proxsuite::linalg::veg::Tag<isize>{}, qpmodel.n_in);
+      proxsuite::linalg::veg::Tag<isize>{}, n_in);
     auto planned_to_add = _planned_to_add.ptr_mut();
 
     isize planned_to_add_count = 0;
     T mu_in_neg = -qpresults.info.mu_in;
     isize n_c = n_c_f;
-    for (isize i = 0; i < qpmodel.n_in; i++) {
+    for (isize i = 0; i < n_in; i++) {
+      if (qpwork.active_inequalities(i) &&
+          qpwork.current_bijection_map(i) >= qpwork.n_c) {
+        // add at the end
+        planned_to_add[planned_to_add_count] = i;
+        ++planned_to_add_count;
+      }
+    }
+
+    // rebuild the bijection map: remaining active rows, added rows, and then
+    // inactive rows
+    isize row = 0;
+    for (isize k = 0; k < qpwork.n_c; k++) {
+      isize i = qpwork.new_bijection_map(k);
       if (qpwork.active_inequalities(i)) {
-        if (qpwork.new_bijection_map(i) >= n_c_f) {
-          // add at the end
-          planned_to_add[planned_to_add_count] = i;
-          ++planned_to_add_count;
-
-          for (isize j = 0; j < qpmodel.n_in; j++) {
-            if (qpwork.new_bijection_map(j) < qpwork.new_bijection_map(i) &&
-                qpwork.new_bijection_map(j) >= n_c_f) {
-              qpwork.new_bijection_map(j) += 1;
-            }
-          }
-          qpwork.new_bijection_map(i) = n_c_f;
-          n_c_f += 1;
-        }
+        qpwork.current_bijection_map(i) = row;
+        ++row;
+      }
+    }
+    for (isize k = 0; k < planned_to_add_count; k++) {
+      qpwork.current_bijection_map(planned_to_add[k]) = row;
+      ++row;
+    }
+    for (isize k = 0; k < n_in; k++) {
+      isize i = qpwork.new_bijection_map(k);
+      if (!qpwork.active_inequalities(i)) {
+        qpwork.current_bijection_map(i) = row;
+        ++row;
       }
     }
-    {
+    n_c_f += planned_to_add_count;
+    PROXSUITE_PROFILE_COUNT(qpresults.info.profile.active_set_insertions,
+                            planned_to_add_count);
+
+    if (primal_backend) {
+      rank_update_constraints(qpmodel,
+                              qpwork,
+                              planned_to_add,
+                              planned_to_add_count,
+                              T(1) / qpresults.info.mu_in,
+                              stack);
+    } else {
       isize n = qpmodel.dim;
       isize n_eq = qpmodel.n_eq;
       LDLT_TEMP_MAT_UNINIT(
@@ -504,8 +616,41 @@ active_set_change(const Model<T>& qpmodel,
     }
   }
 
+  // the active box constraints add 1/mu_in to the diagonal of the factorized
+  // matrix: update the entries of the box constraints which changed
+  if (qpmodel.box_constraints) {
+    isize n = qpmodel.dim;
+    T mu_in_inv = T(1) / qpresults.info.mu_in;
+    LDLT_TEMP_VEC_UNINIT(T, box_update_alpha, n, stack);
+    auto _box_indices =
+      stack.make_new_for_overwrite(proxsuite::linalg::veg::Tag<isize>{}, n);
+    isize* box_indices = _box_indices.ptr_mut();
+    isize box_update_count = 0;
+    for (isize i = 0; i < n; i++) {
+      if (qpwork.active_box(i) != qpwork.factorized_box(i)) {
+        box_indices[box_update_count] = i;
+        box_update_alpha(box_update_count) =
+          qpwork.active_box(i) ? mu_in_inv : -mu_in_inv;
+        ++box_update_count;
+        PROXSUITE_PROFILE_COUNT(
+          qpwork.active_box(i) ? qpresults.info.profile.active_set_insertions
+                               : qpresults.info.profile.active_set_deletions,
+          1);
+      }
+    }
+    if (box_update_count > 0) {
+      qpwork.ldl.diagonal_update_clobber_indices(
+        box_indices,
+        box_update_count,
+        box_update_alpha.head(box_update_count),
+        stack);
+      qpwork.factorized_box = qpwork.active_box;
+      qpwork.constraints_changed = true;
+    }
+  }
+
   qpwork.n_c = n_c_f;
-  qpwork.current_bijection_map = qpwork.new_bijection_map;
+  qpwork.new_bijection_map = qpwork.current_bijection_map;
   qpwork.dw_aug.setZero();
 }
 
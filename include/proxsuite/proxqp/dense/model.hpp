@@ -24,38 +24,53 @@ struct Model
 {
 
   ///// QP STORAGE
-  Mat<T> H;
+  Mat<T> H; // dim x dim, or dim x 1 (diagonal) / dim x 0 (zero) hessian
   Vec<T> g;
   Mat<T> A;
   Mat<T> C;
   Vec<T> b;
   Vec<T> u;
   Vec<T> l;
+  Vec<T> u_box; // upper bounds on x (empty without box constraints)
+  Vec<T> l_box; // lower bounds on x (empty without box constraints)
 
   ///// model sizes
   isize dim;
   isize n_eq;
   isize n_in;
   isize n_total;
+  bool box_constraints;
+  HessianType hessian_type;
 
   /*!
    * Default constructor.
    * @param dim primal variable dimension.
    * @param n_eq number of equality constraints.
    * @param n_in number of inequality constraints.
+   * @param box_constraints whether the model has bounds l_box <= x <= u_box.
+   * @param hessian_type structure of the hessian: only its diagonal is stored
+   * when it is diagonal, and nothing when it is zero.
    */
-  Model(isize dim, isize n_eq, isize n_in)
-    : H(dim, dim)
+  Model(isize dim,
+        isize n_eq,
+        isize n_in,
+        bool box_constraints = false,
+        HessianType hessian_type = HessianType::Dense)
+    : H(dim, hessian_cols(dim, hessian_type))
     , g(dim)
     , A(n_eq, dim)
     , C(n_in, dim)
     , b(n_eq)
     , u(n_in)
     , l(n_in)
+    , u_box(box_constraints ? dim : 0)
+    , l_box(box_constraints ? dim : 0)
     , dim(dim)
     , n_eq(n_eq)
     , n_in(n_in)
     , n_total(dim + n_eq + n_in)
+    , box_constraints(box_constraints)
+    , hessian_type(hessian_type)
   {
     PROXSUITE_THROW_PRETTY(dim == 0,
                            std::invalid_argument,
@@ -73,15 +88,44 @@ struct Model
                                    // problem is only lower bounded)
     l.fill(-infinite_bound_value); // in case it appears l is nullopt (i.e., the
                                    // problem is only upper bounded)
+    u_box.fill(+infinite_bound_value);
+    l_box.fill(-infinite_bound_value);
   }
 
   proxsuite::proxqp::sparse::SparseModel<T> to_sparse()
   {
-    SparseMat<T> H_sparse = H.sparseView();
+    SparseMat<T> H_sparse(dim, dim);
+    switch (hessian_type) {
+      case HessianType::Dense:
+        H_sparse = H.sparseView();
+        break;
+      case HessianType::Diagonal: {
+        Mat<T> H_full = H.col(0).asDiagonal();
+        H_sparse = H_full.sparseView();
+        break;
+      }
+      case HessianType::Zero:
+        break;
+    }
     SparseMat<T> A_sparse = A.sparseView();
-    SparseMat<T> C_sparse = C.sparseView();
-    proxsuite::proxqp::sparse::SparseModel<T> res{ H_sparse, g, A_sparse, b,
-                                                   C_sparse, u, l };
+    if (!box_constraints) {
+      SparseMat<T> C_sparse = C.sparseView();
+      proxsuite::proxqp::sparse::SparseModel<T> res{ H_sparse, g, A_sparse, b,
+                                                     C_sparse, u, l };
+      return res;
+    }
+    // the sparse backend has no box constraints: they are stacked below C
+    Mat<T> C_box(n_in + dim, dim);
+    C_box.topRows(n_in) = C;
+    C_box.bottomRows(dim).setIdentity();
+    Vec<T> u_all(n_in + dim);
+    Vec<T> l_all(n_in + dim);
+    u_all << u, u_box;
+    l_all << l, l_box;
+    SparseMat<T> C_sparse = C_box.sparseView();
+    proxsuite::proxqp::sparse::SparseModel<T> res{
+      H_sparse, g, A_sparse, b, C_sparse, u_all, l_all
+    };
     return res;
   }
 
@@ -99,10 +143,13 @@ struct Model
     PROXSUITE_CHECK_SIZE(b.size(), n_eq);
     PROXSUITE_CHECK_SIZE(u.size(), n_in);
     PROXSUITE_CHECK_SIZE(l.size(), n_in);
+    PROXSUITE_CHECK_SIZE(u_box.size(), (box_constraints ? dim : 0));
+    PROXSUITE_CHECK_SIZE(l_box.size(), (box_constraints ? dim : 0));
     if (H.size()) {
       PROXSUITE_CHECK_SIZE(H.rows(), dim);
-      PROXSUITE_CHECK_SIZE(H.cols(), dim);
-      if (!H.isApprox(H.transpose(), 0.0))
+      PROXSUITE_CHECK_SIZE(H.cols(), hessian_cols(dim, hessian_type));
+      if (hessian_type == HessianType::Dense &&
+          !H.isApprox(H.transpose(), 0.0))
         return false;
     }
     if (A.size()) {
@@ -129,7 +176,10 @@ operator==(const Model<T>& model1, const Model<T>& model2)
                model1.H == model2.H && model1.g == model2.g &&
                model1.A == model2.A && model1.b == model2.b &&
                model1.C == model2.C && model1.l == model2.l &&
-               model1.u == model2.u;
+               model1.u == model2.u &&
+               model1.box_constraints == model2.box_constraints &&
+               model1.hessian_type == model2.hessian_type &&
+               model1.u_box == model2.u_box && model1.l_box == model2.l_box;
   return value;
 }
 
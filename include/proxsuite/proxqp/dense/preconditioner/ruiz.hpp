@@ -9,6 +9,8 @@
 
 #include "proxsuite/proxqp/dense/views.hpp"
 #include "proxsuite/proxqp/dense/fwd.hpp"
+#include "proxsuite/proxqp/status.hpp"
+#include "proxsuite/helpers/parallel.hpp"
 #include <proxsuite/linalg/dense/core.hpp>
 #include <ostream>
 
@@ -25,6 +27,141 @@ enum struct Symmetry
 namespace dense {
 namespace detail {
 
+/// Minimal number of matrix entries for which the passes of the equilibration
+/// are split over the threads of OpenMP.
+static constexpr isize ruiz_parallel_min_entries = isize(1) << 16;
+
+/*!
+ * Scales in place the rows of H, A and C of the qp with the equilibration
+ * factors delta, and computes in the same pass the infinity norms of the
+ * rows and columns of the scaled matrices. H is multiplied beforehand by
+ * gamma, its scaling of the previous iteration. If delta is null, the
+ * matrices are not modified and only their norms are computed.
+ *
+ * The rows are distributed over at most num_threads threads, each of them
+ * accumulating the column norms of its rows in its own slice of local_norms
+ * before they are merged. Since the maximum is computed exactly, the norms do
+ * not depend on the number of threads.
+ *
+ * @param qp qp whose matrices are scaled (a dense hessian only is scaled).
+ * @param delta equilibration factors of the primal variable followed by those
+ * of the constraints, or nullptr.
+ * @param gamma scaling of H of the previous iteration.
+ * @param sym part of H which is stored.
+ * @param hessian_type structure of the quadratic cost.
+ * @param h_col_norm norms of the (stored) columns of the scaled H (size n).
+ * @param h_row_norm norms of the (stored) rows of the scaled H (size n), for
+ * triangular storages.
+ * @param col_norm norms of the columns of the scaled A and C (size n).
+ * @param row_norm norms of the rows of the scaled A, then C (size n_eq +
+ * n_in).
+ * @param local_norms column norms accumulated by each thread (size
+ * num_threads * 2 * n).
+ * @param num_threads maximal number of threads.
+ */
+template<typename T>
+void
+ruiz_scale_rows_and_norms(QpViewBoxMut<T> qp,
+                          T const* delta,
+                          T gamma,
+                          Symmetry sym,
+                          HessianType hessian_type,
+                          T* h_col_norm,
+                          T* h_row_norm,
+                          T* col_norm,
+                          T* row_norm,
+                          T* local_norms,
+                          isize num_threads)
+{
+  using RowVec = Eigen::Matrix<T, 1, Eigen::Dynamic>;
+  using RowMap = Eigen::Map<RowVec>;
+  using RowCMap = Eigen::Map<RowVec const>;
+
+  auto H = qp.H.to_eigen();
+  auto A = qp.A.to_eigen();
+  auto C = qp.C.to_eigen();
+
+  isize n = qp.H.rows;
+  isize n_eq = qp.A.rows;
+  isize n_in = qp.C.rows;
+  isize n_h = (hessian_type == HessianType::Dense) ? n : 0;
+  isize n_rows = n_h + n_eq + n_in;
+
+  RowMap(h_col_norm, n).setZero();
+  RowMap(h_row_norm, n).setZero();
+  RowMap(col_norm, n).setZero();
+
+  bool parallel = n_rows * n >= ruiz_parallel_min_entries;
+  static_cast<void>(parallel);
+  static_cast<void>(num_threads);
+
+#ifdef PROXSUITE_ENABLE_OPENMP
+#pragma omp parallel if (parallel) num_threads(int(num_threads))
+#endif
+  {
+    isize thread = 0;
+#ifdef PROXSUITE_ENABLE_OPENMP
+    thread = isize(omp_get_thread_num());
+#endif
+    RowMap h_col_norm_local(local_norms + 2 * n * thread, n);
+    RowMap col_norm_local(local_norms + 2 * n * thread + n, n);
+    h_col_norm_local.setZero();
+    col_norm_local.setZero();
+
+    isize r = 0;
+#ifdef PROXSUITE_ENABLE_OPENMP
+#pragma omp for schedule(dynamic, 32)
+#endif
+    for (r = 0; r < n_rows; ++r) {
+      if (r < n_h) {
+        isize i = r;
+        // stored part of the i-th row of H, starting at column j0
+        isize j0 = 0;
+        isize len = n;
+        switch (sym) {
+          case Symmetry::upper:
+            j0 = i;
+            len = n - i;
+            break;
+          case Symmetry::lower:
+            len = i + 1;
+            break;
+          case Symmetry::general:
+            break;
+        }
+        auto h = H.row(i).segment(j0, len);
+        if (delta != nullptr) {
+          auto d = RowCMap(delta + j0, len);
+          if (sym == Symmetry::general) {
+            h.array() = (delta[i] * (h.array() * gamma)) * d.array();
+          } else {
+            h.array() = ((h.array() * gamma) * d.array()) * delta[i];
+          }
+        }
+        h_row_norm[i] = (len > 0) ? h.cwiseAbs().maxCoeff() : T(0);
+        h_col_norm_local.segment(j0, len) =
+          h_col_norm_local.segment(j0, len).cwiseMax(h.cwiseAbs());
+      } else {
+        isize i = r - n_h;
+        auto m = (i < n_eq) ? A.row(i) : C.row(i - n_eq);
+        if (delta != nullptr) {
+          m.array() = (delta[n + i] * m.array()) * RowCMap(delta, n).array();
+        }
+        row_norm[i] = (n > 0) ? m.cwiseAbs().maxCoeff() : T(0);
+        col_norm_local = col_norm_local.cwiseMax(m.cwiseAbs());
+      }
+    }
+
+#ifdef PROXSUITE_ENABLE_OPENMP
+#pragma omp critical
+#endif
+    {
+      RowMap(h_col_norm, n) = RowMap(h_col_norm, n).cwiseMax(h_col_norm_local);
+      RowMap(col_norm, n) = RowMap(col_norm, n).cwiseMax(col_norm_local);
+    }
+  }
+}
+
 template<typename T>
 auto
 ruiz_scale_qp_in_place( //
@@ -34,6 +171,8 @@ ruiz_scale_qp_in_place( //
   T epsilon,
   isize max_iter,
   Symmetry sym,
+  bool box_constraints,
+  HessianType hessian_type,
   proxsuite::linalg::veg::dynstack::DynStackMut stack) -> T
 {
 
@@ -42,9 +181,7 @@ ruiz_scale_qp_in_place( //
 
   auto H = qp.H.to_eigen();
   auto g = qp.g.to_eigen();
-  auto A = qp.A.to_eigen();
   auto b = qp.b.to_eigen();
-  auto C = qp.C.to_eigen();
   auto u = qp.u.to_eigen();
   auto l = qp.l.to_eigen();
 
@@ -54,15 +191,55 @@ ruiz_scale_qp_in_place( //
    * algorithm
    *
    * modified: removed g in gamma computation
+   *
+   * H is stored as its diagonal (n x 1) for a diagonal hessian, and is empty
+   * (n x 0) for a zero hessian
+   *
+   * each iteration performs a single pass over the matrices, which scales them
+   * and computes the norms used by the next iteration. The scaling gamma of a
+   * dense H is applied lazily at the beginning of the next pass (norms being
+   * scaled accordingly, as the maximum commutes with a positive scaling).
    */
 
   isize n = qp.H.rows;
   isize n_eq = qp.A.rows;
   isize n_in = qp.C.rows;
 
+  // the box constraints l_box <= x <= u_box are scaled along with x, so that
+  // they remain identity rows of the scaled problem: they contribute a unit
+  // entry to each column norm
+  T box_norm = box_constraints ? T(1) : T(0);
+
   T gamma = T(1);
 
   LDLT_TEMP_VEC(T, delta, n + n_eq + n_in, stack);
+  LDLT_TEMP_VEC_UNINIT(T, norms, 3 * n + n_eq + n_in, stack);
+  T* h_col_norm = norms.data();
+  T* h_row_norm = h_col_norm + n;
+  T* col_norm = h_row_norm + n;
+  T* row_norm = col_norm + n;
+  // the number of threads is bounded by the scratch space of their column
+  // norms, reserved by scale_qp_in_place_req for the default number of threads
+  isize num_threads = isize(proxsuite::helpers::get_default_num_threads());
+  if (n > 0) {
+    isize n_fit = (stack.remaining_bytes() -
+                   proxsuite::linalg::dense::_detail::align<T>()) /
+                  (2 * n * isize{ sizeof(T) });
+    num_threads = std::max(isize(1), std::min(num_threads, n_fit));
+  }
+  LDLT_TEMP_VEC_UNINIT(T, local_norms, num_threads * 2 * n, stack);
+
+  ruiz_scale_rows_and_norms(qp,
+                            static_cast<T const*>(nullptr),
+                            gamma,
+                            sym,
+                            hessian_type,
+                            h_col_norm,
+                            h_row_norm,
+                            col_norm,
+                            row_norm,
+                            local_norms.data(),
+                            num_threads);
 
   i64 iter = 1;
 
@@ -84,155 +261,157 @@ ruiz_scale_qp_in_place( //
     // normalization vector
     {
       for (isize k = 0; k < n; ++k) {
-        switch (sym) {
-          case Symmetry::upper: { // upper triangular part
-            T aux = sqrt(std::max({
-              infty_norm(H.col(k).head(k)),
-              infty_norm(H.row(k).tail(n - k)),
-              n_eq > 0 ? infty_norm(A.col(k)) : T(0),
-              n_in > 0 ? infty_norm(C.col(k)) : T(0),
-            }));
-            if (aux == T(0)) {
-              delta(k) = T(1);
-            } else {
-              delta(k) = T(1) / (aux + machine_eps);
+        T h_norm(0);
+        switch (hessian_type) {
+          case HessianType::Dense: {
+            switch (sym) {
+              case Symmetry::upper:
+              case Symmetry::lower: {
+                // the k-th column of the symmetric H is made of the k-th
+                // stored row and column
+                h_norm = std::max(h_col_norm[k], h_row_norm[k]);
+                break;
+              }
+              case Symmetry::general: {
+                h_norm = h_col_norm[k];
+                break;
+              }
             }
             break;
           }
-          case Symmetry::lower: { // lower triangular part
-
-            T aux = sqrt(std::max({
-              infty_norm(H.col(k).head(k)),
-              infty_norm(H.col(k).tail(n - k)),
-              n_eq > 0 ? infty_norm(A.col(k)) : T(0),
-              n_in > 0 ? infty_norm(C.col(k)) : T(0),
-            }));
-            if (aux == T(0)) {
-              delta(k) = T(1);
-            } else {
-              delta(k) = T(1) / (aux + machine_eps);
-            }
+          case HessianType::Diagonal:
+            h_norm = std::fabs(H(k, 0));
             break;
-          }
-          case Symmetry::general: {
-
-            T aux = sqrt(std::max({
-              infty_norm(H.col(k)),
-              n_eq > 0 ? infty_norm(A.col(k)) : T(0),
-              n_in > 0 ? infty_norm(C.col(k)) : T(0),
-            }));
-            if (aux == T(0)) {
-              delta(k) = T(1);
-            } else {
-              delta(k) = T(1) / (aux + machine_eps);
-            }
+          case HessianType::Zero:
             break;
-          }
         }
-      }
-
-      for (isize k = 0; k < n_eq; ++k) {
-        T aux = sqrt(infty_norm(A.row(k)));
+        T aux = sqrt(std::max({
+          h_norm,
+          col_norm[k],
+          box_norm,
+        }));
         if (aux == T(0)) {
-          delta(n + k) = T(1);
+          delta(k) = T(1);
         } else {
-          delta(n + k) = T(1) / (aux + machine_eps);
+          delta(k) = T(1) / (aux + machine_eps);
         }
       }
-      for (isize k = 0; k < n_in; ++k) {
-        T aux = sqrt(infty_norm(C.row(k)));
+
+      for (isize k = 0; k < n_eq + n_in; ++k) {
+        T aux = sqrt(row_norm[k]);
         if (aux == T(0)) {
-          delta(k + n + n_eq) = T(1);
+          delta(n + k) = T(1);
         } else {
-          delta(k + n + n_eq) = T(1) / (aux + machine_eps);
+          delta(n + k) = T(1) / (aux + machine_eps);
         }
       }
     }
     {
+      // normalize H, A and C
+      ruiz_scale_rows_and_norms(qp,
+                                static_cast<T const*>(delta.data()),
+                                gamma,
+                                sym,
+                                hessian_type,
+                                h_col_norm,
+                                h_row_norm,
+                                col_norm,
+                                row_norm,
+                                local_norms.data(),
+                                num_threads);
+      if (hessian_type == HessianType::Diagonal) {
+        H.col(0).array() *= delta.head(n).array().square();
+      }
 
-      // normalize A and C
-      A = delta.segment(n, n_eq).asDiagonal() * A * delta.head(n).asDiagonal();
-      C = delta.tail(n_in).asDiagonal() * C * delta.head(n).asDiagonal();
       // normalize vectors
       g.array() *= delta.head(n).array();
       b.array() *= delta.middleRows(n, n_eq).array();
       u.array() *= delta.tail(n_in).array();
       l.array() *= delta.tail(n_in).array();
 
-      // normalize H
-      switch (sym) {
-        case Symmetry::upper: {
-          // upper triangular part
-          for (isize j = 0; j < n; ++j) {
-            H.col(j).head(j + 1) *= delta(j);
-          }
-          // normalisation des lignes
-          for (isize i = 0; i < n; ++i) {
-            H.row(i).tail(n - i) *= delta(i);
-          }
-          break;
-        }
-        case Symmetry::lower: {
-          // lower triangular part
-          for (isize j = 0; j < n; ++j) {
-            H.col(j).tail(n - j) *= delta(j);
-          }
-          // normalisation des lignes
-          for (isize i = 0; i < n; ++i) {
-            H.row(i).head(i + 1) *= delta(i);
-          }
-          break;
-        }
-        case Symmetry::general: {
-          // all matrix
-          H = delta.head(n).asDiagonal() * H * delta.head(n).asDiagonal();
-          break;
-        }
-        default:
-          break;
-      }
-
       // additional normalization for the cost function
-      switch (sym) {
-        case Symmetry::upper: {
-          // upper triangular part
-          T tmp = T(0);
-          for (isize j = 0; j < n; ++j) {
-            tmp += proxqp::dense::infty_norm(H.row(j).tail(n - j));
+      switch (hessian_type) {
+        case HessianType::Dense:
+          switch (sym) {
+            case Symmetry::upper: {
+              // upper triangular part
+              T tmp = T(0);
+              for (isize j = 0; j < n; ++j) {
+                tmp += h_row_norm[j];
+              }
+              gamma = 1 / std::max(tmp / T(n), T(1));
+              break;
+            }
+            case Symmetry::lower: {
+              // lower triangular part
+              T tmp = T(0);
+              for (isize j = 0; j < n; ++j) {
+                tmp += h_col_norm[j];
+              }
+              gamma = 1 / std::max(tmp / T(n), T(1));
+              break;
+            }
+            case Symmetry::general: {
+              // all matrix
+              T tmp = T(0);
+              for (isize j = 0; j < n; ++j) {
+                tmp += h_col_norm[j];
+              }
+              gamma = 1 / std::max(T(1), tmp / T(n));
+              break;
+            }
+            default:
+              break;
           }
-          gamma = 1 / std::max(tmp / T(n), T(1));
-          break;
-        }
-        case Symmetry::lower: {
-          // lower triangular part
-          T tmp = T(0);
+          // H is scaled by gamma at the next pass
           for (isize j = 0; j < n; ++j) {
-            tmp += proxqp::dense::infty_norm(H.col(j).tail(n - j));
+            h_col_norm[j] *= gamma;
+            h_row_norm[j] *= gamma;
           }
-          gamma = 1 / std::max(tmp / T(n), T(1));
           break;
-        }
-        case Symmetry::general: {
-          // all matrix
-          gamma =
-            1 /
-            std::max(T(1),
-                     (H.colwise().template lpNorm<Eigen::Infinity>()).mean());
+        case HessianType::Diagonal:
+          gamma = 1 / std::max(T(1), H.col(0).cwiseAbs().mean());
+          H *= gamma;
           break;
-        }
-        default:
+        case HessianType::Zero:
+          gamma = T(1);
           break;
       }
 
       g *= gamma;
-      H *= gamma;
 
       S.array() *= delta.array(); // coefficientwise product
       c *= gamma;
     }
   }
+  if (hessian_type == HessianType::Dense && gamma != T(1)) {
+    H *= gamma;
+  }
   return c;
 }
+
+// equilibration of a qp with a dense hessian and without box constraints
+template<typename T>
+auto
+ruiz_scale_qp_in_place( //
+  VectorViewMut<T> delta_,
+  std::ostream* logger_ptr,
+  QpViewBoxMut<T> qp,
+  T epsilon,
+  isize max_iter,
+  Symmetry sym,
+  proxsuite::linalg::veg::dynstack::DynStackMut stack) -> T
+{
+  return ruiz_scale_qp_in_place(delta_,
+                                logger_ptr,
+                                qp,
+                                epsilon,
+                                max_iter,
+                                sym,
+                                false,
+                                HessianType::Dense,
+                                stack);
+}
 } // namespace detail
 
 namespace preconditioner {
@@ -295,7 +474,34 @@ struct RuizEquilibration
                                     isize n_in)
     -> proxsuite::linalg::veg::dynstack::StackReq
   {
-    return proxsuite::linalg::dense::temp_vec_req(tag, n + n_eq + n_in);
+    isize num_threads = isize(proxsuite::helpers::get_default_num_threads());
+    return proxsuite::linalg::dense::temp_vec_req(tag, n + n_eq + n_in) &
+           proxsuite::linalg::dense::temp_vec_req(tag, 3 * n + n_eq + n_in) &
+           proxsuite::linalg::dense::temp_vec_req(tag, num_threads * 2 * n);
+  }
+
+  /*!
+   * Scales the qp performing the ruiz equilibrator algorithm, for a qp with a
+   * dense hessian and without box constraints.
+   * @param qp qp to be scaled (in place).
+   * @param execute_preconditioner bool variable specifying whether the qp is
+   * scaled using current equilibrator scaling variables, or performing anew the
+   * algorithm.
+   * @param stack stack variable used by the equilibrator.
+   */
+  void scale_qp_in_place(QpViewBoxMut<T> qp,
+                         bool execute_preconditioner,
+                         const isize max_iter,
+                         const T epsilon,
+                         proxsuite::linalg::veg::dynstack::DynStackMut stack)
+  {
+    scale_qp_in_place(qp,
+                      execute_preconditioner,
+                      max_iter,
+                      epsilon,
+                      false,
+                      HessianType::Dense,
+                      stack);
   }
 
   // H_new = c * head @ H @ head
@@ -310,12 +516,18 @@ struct RuizEquilibration
    * scaled using current equilibrator scaling variables, or performing anew the
    * algorithm.
    * @param settings solver's settings.
+   * @param box_constraints whether the qp has box constraints on the primal
+   * variable, which are scaled as the primal variable.
+   * @param hessian_type structure of the quadratic cost: qp.H is its diagonal
+   * (dim x 1) for a diagonal hessian, and is empty (dim x 0) for a zero one.
    * @param stack stack variable used by the equilibrator.
    */
   void scale_qp_in_place(QpViewBoxMut<T> qp,
                          bool execute_preconditioner,
                          const isize max_iter,
                          const T epsilon,
+                         bool box_constraints,
+                         HessianType hessian_type,
                          proxsuite::linalg::veg::dynstack::DynStackMut stack)
   {
     if (execute_preconditioner) {
@@ -326,6 +538,8 @@ struct RuizEquilibration
                                          epsilon,
                                          max_iter,
                                          sym,
+                                         box_constraints,
+                                         hessian_type,
                                          stack);
     } else {
 
@@ -345,35 +559,44 @@ struct RuizEquilibration
       C = delta.tail(n_in).asDiagonal() * C * delta.head(n).asDiagonal();
 
       // normalize H
-      switch (sym) {
-        case Symmetry::upper: {
-          // upper triangular part
-          for (isize j = 0; j < n; ++j) {
-            H.col(j).head(j + 1) *= delta(j);
-          }
-          // normalisation des lignes
-          for (isize i = 0; i < n; ++i) {
-            H.row(i).tail(n - i) *= delta(i);
-          }
-          break;
-        }
-        case Symmetry::lower: {
-          // lower triangular part
-          for (isize j = 0; j < n; ++j) {
-            H.col(j).tail(n - j) *= delta(j);
-          }
-          // normalisation des lignes
-          for (isize i = 0; i < n; ++i) {
-            H.row(i).head(i + 1) *= delta(i);
+      switch (hessian_type) {
+        case HessianType::Dense:
+          switch (sym) {
+            case Symmetry::upper: {
+              // upper triangular part
+              for (isize j = 0; j < n; ++j) {
+                H.col(j).head(j + 1) *= delta(j);
+              }
+              // normalisation des lignes
+              for (isize i = 0; i < n; ++i) {
+                H.row(i).tail(n - i) *= delta(i);
+              }
+              break;
+            }
+            case Symmetry::lower: {
+              // lower triangular part
+              for (isize j = 0; j < n; ++j) {
+                H.col(j).tail(n - j) *= delta(j);
+              }
+              // normalisation des lignes
+              for (isize i = 0; i < n; ++i) {
+                H.row(i).head(i + 1) *= delta(i);
+              }
+              break;
+            }
+            case Symmetry::general: {
+              // all matrix
+              H = delta.head(n).asDiagonal() * H * delta.head(n).asDiagonal();
+              break;
+            }
+            default:
+              break;
           }
           break;
-        }
-        case Symmetry::general: {
-          // all matrix
-          H = delta.head(n).asDiagonal() * H * delta.head(n).asDiagonal();
+        case HessianType::Diagonal:
+          H.col(0).array() *= delta.head(n).array().square();
           break;
-        }
-        default:
+        case HessianType::Zero:
           break;
       }
 
@@ -453,6 +676,15 @@ struct RuizEquilibration
     dual.to_eigen().array() = dual.as_const().to_eigen().array() /
                               delta.tail(dual.to_eigen().size()).array() * c;
   }
+  /*!
+   * Scales in place a dual variable of the box constraints, whose rows are
+   * scaled by the inverse of the primal scaling.
+   * @param dual dual variable (includes box constraints only).
+   */
+  void scale_box_dual_in_place(VectorViewMut<T> dual) const
+  {
+    dual.to_eigen().array() *= delta.head(dual.to_eigen().size()).array() * c;
+  }
   /*!
    * Unscales a primal variable in place.
    * @param primal primal variable.
@@ -489,6 +721,14 @@ struct RuizEquilibration
     dual.to_eigen().array() = dual.as_const().to_eigen().array() *
                               delta.tail(dual.to_eigen().size()).array() / c;
   }
+  /*!
+   * Unscales in place a dual variable of the box constraints.
+   * @param dual dual variable (includes box constraints only).
+   */
+  void unscale_box_dual_in_place(VectorViewMut<T> dual) const
+  {
+    dual.to_eigen().array() /= delta.head(dual.to_eigen().size()).array() * c;
+  }
   // modifies residuals in place
   /*!
    * Scales a primal residual in place.
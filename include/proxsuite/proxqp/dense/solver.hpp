@@ -46,18 +46,39 @@ refactorize(const Model<T>& qpmodel,
   if (!qpwork.constraints_changed && rho_new == qpresults.info.rho) {
     return;
   }
+  PROXSUITE_PROFILE_SCOPE(qpresults.info.profile.refactorization_time);
+  PROXSUITE_PROFILE_COUNT(qpresults.info.profile.refactorizations, 1);
 
   qpwork.dw_aug.setZero();
   qpwork.kkt.diagonal().head(qpmodel.dim).array() +=
     rho_new - qpresults.info.rho;
+
+  if (qpwork.dense_backend == DenseBackend::PrimalLDLT) {
+    primal_factorize(
+      qpmodel, qpwork, qpresults.info.mu_eq, qpresults.info.mu_in, true);
+    qpwork.constraints_changed = false;
+    return;
+  }
   qpwork.kkt.diagonal().segment(qpmodel.dim, qpmodel.n_eq).array() =
     -qpresults.info.mu_eq;
 
+  // the active box constraints are only stored in the factorization
+  T mu_in_inv = T(1) / qpresults.info.mu_in;
+  if (qpmodel.box_constraints) {
+    qpwork.kkt.diagonal().head(qpmodel.dim).array() +=
+      mu_in_inv * qpwork.factorized_box.template cast<T>().array();
+  }
+
   proxsuite::linalg::veg::dynstack::DynStackMut stack{
     proxsuite::linalg::veg::from_slice_mut, qpwork.ldl_stack.as_mut()
   };
   qpwork.ldl.factorize(qpwork.kkt.transpose(), stack);
 
+  if (qpmodel.box_constraints) {
+    qpwork.kkt.diagonal().head(qpmodel.dim).array() -=
+      mu_in_inv * qpwork.factorized_box.template cast<T>().array();
+  }
+
   isize n = qpmodel.dim;
   isize n_eq = qpmodel.n_eq;
   isize n_in = qpmodel.n_in;
@@ -107,18 +128,31 @@ mu_update(const Model<T>& qpmodel,
   isize n = qpmodel.dim;
   isize n_eq = qpmodel.n_eq;
   isize n_c = qpwork.n_c;
+  isize n_box = qpwork.factorized_box.count();
+
+  if ((n_eq + n_c + n_box) == 0) {
+    return;
+  }
+  PROXSUITE_PROFILE_SCOPE(qpresults.info.profile.mu_update_time);
 
-  if ((n_eq + n_c) == 0) {
+  if (qpwork.dense_backend == DenseBackend::PrimalLDLT) {
+    // the proximal parameters scale the constraint terms of the factorized
+    // matrix: it is formed again
+    primal_factorize(qpmodel, qpwork, mu_eq_new, mu_in_new, true);
     return;
   }
 
-  LDLT_TEMP_VEC_UNINIT(T, rank_update_alpha, n_eq + n_c, stack);
+  LDLT_TEMP_VEC_UNINIT(T, rank_update_alpha, n_eq + n_c + n_box, stack);
   rank_update_alpha.head(n_eq).setConstant(qpresults.info.mu_eq - mu_eq_new);
-  rank_update_alpha.tail(n_c).setConstant(qpresults.info.mu_in - mu_in_new);
+  rank_update_alpha.segment(n_eq, n_c).setConstant(qpresults.info.mu_in -
+                                                   mu_in_new);
+  // active box constraints contribute with 1/mu_in to the diagonal
+  rank_update_alpha.tail(n_box).setConstant(T(1) / mu_in_new -
+                                            T(1) / qpresults.info.mu_in);
 
   {
     auto _indices = stack.make_new_for_overwrite(
-      proxsuite::linalg::veg::Tag<isize>{}, n_eq + n_c);
+      proxsuite::linalg::veg::Tag<isize>{}, n_eq + n_c + n_box);
     isize* indices = _indices.ptr_mut();
     for (isize k = 0; k < n_eq; ++k) {
       indices[k] = n + k;
@@ -126,12 +160,194 @@ mu_update(const Model<T>& qpmodel,
     for (isize k = 0; k < n_c; ++k) {
       indices[n_eq + k] = n + n_eq + k;
     }
+    isize k_box = n_eq + n_c;
+    for (isize k = 0; k < qpwork.factorized_box.size(); ++k) {
+      if (qpwork.factorized_box(k)) {
+        indices[k_box] = k;
+        ++k_box;
+      }
+    }
     qpwork.ldl.diagonal_update_clobber_indices(
-      indices, n_eq + n_c, rank_update_alpha, stack);
+      indices, n_eq + n_c + n_box, rank_update_alpha, stack);
   }
+  PROXSUITE_PROFILE_COUNT(qpresults.info.profile.mu_update_rank,
+                          n_eq + n_c + n_box);
 
   qpwork.constraints_changed = true;
 }
+/*!
+ * Setups the active set predicted by the dual variables of a warm start (the
+ * constraints with nonzero multipliers) and the factorization of the
+ * corresponding regularized KKT matrix.
+ *
+ * The factorization is either computed at once with the predicted active
+ * constraints, or obtained by inserting them in the factorization without
+ * inequality constraints, depending on the estimated numbers of flops of both
+ * ways. The latter is only cheaper when the factorization without inequality
+ * constraints is restored from the copy kept in the workspace (see
+ * Settings::cache_scaled_model), which requires the same proximal parameters.
+ *
+ * @param qpmodel QP problem model as defined by the user (without any scaling
+ * performed).
+ * @param qpresults solver results.
+ * @param qpwork solver workspace.
+ */
+template<typename T>
+void
+setup_factorization_with_active_set(const Model<T>& qpmodel,
+                                    Results<T>& qpresults,
+                                    Workspace<T>& qpwork)
+{
+  isize n = qpmodel.dim;
+  isize n_eq = qpmodel.n_eq;
+  isize n_in = qpmodel.n_in;
+  bool primal_backend = qpwork.dense_backend == DenseBackend::PrimalLDLT;
+
+  isize n_c = 0;
+  for (isize i = 0; i < n_in; i++) {
+    qpwork.active_inequalities[i] = qpresults.z[i] != 0;
+    n_c += qpwork.active_inequalities[i] ? 1 : 0;
+  }
+  qpwork.active_box.array() = qpresults.z_box.array() != T(0);
+  isize n_box = qpwork.active_box.count();
+
+  // flops of the factorization without inequality constraints (of dimension
+  // n_kkt), and of the rank updates or the block insertion of the active
+  // constraints, against those of a factorization with the active constraints
+  T n_kkt = T(primal_backend ? n : n + n_eq);
+  T r = T(n_c);
+  T base_flops = n_kkt * n_kkt * n_kkt / T(3);
+  T insertion_flops = T(n_box) * n_kkt * n_kkt;
+  T direct_flops = T(0);
+  if (primal_backend) {
+    base_flops += T(n_eq) * n_kkt * n_kkt;
+    insertion_flops += r * n_kkt * n_kkt;
+    direct_flops = base_flops + r * n_kkt * n_kkt;
+  } else {
+    insertion_flops += r * n_kkt * n_kkt + r * r * n_kkt + r * r * r / T(3);
+    direct_flops = (n_kkt + r) * (n_kkt + r) * (n_kkt + r) / T(3);
+  }
+  if (!has_cached_factorization(qpwork, qpresults)) {
+    insertion_flops += base_flops;
+  }
+  if (insertion_flops < direct_flops) {
+    setup_factorization(qpwork, qpmodel, qpresults);
+    qpwork.n_c = 0;
+    linesearch::active_set_change(qpmodel, qpresults, qpwork);
+    return;
+  }
+
+  PROXSUITE_PROFILE_SCOPE(qpresults.info.profile.factorization_time);
+  PROXSUITE_PROFILE_COUNT(qpresults.info.profile.factorizations, 1);
+  PROXSUITE_PROFILE_COUNT(qpresults.info.profile.active_set_insertions,
+                          n_c + n_box);
+  setup_kkt(qpwork, qpmodel, qpresults);
+
+  // the active constraints are stored first, in increasing order
+  isize row = 0;
+  for (isize i = 0; i < n_in; i++) {
+    if (qpwork.active_inequalities[i]) {
+      qpwork.current_bijection_map(i) = row;
+      ++row;
+    }
+  }
+  for (isize i = 0; i < n_in; i++) {
+    if (!qpwork.active_inequalities[i]) {
+      qpwork.current_bijection_map(i) = row;
+      ++row;
+    }
+  }
+  qpwork.new_bijection_map = qpwork.current_bijection_map;
+  qpwork.n_c = n_c;
+  qpwork.factorized_box = qpwork.active_box;
+
+  if (primal_backend) {
+    primal_factorize(
+      qpmodel, qpwork, qpresults.info.mu_eq, qpresults.info.mu_in, true);
+  } else {
+    proxsuite::linalg::veg::dynstack::DynStackMut stack{
+      proxsuite::linalg::veg::from_slice_mut, qpwork.ldl_stack.as_mut()
+    };
+    isize n_kkt_active = n + n_eq + n_c;
+    // only the lower triangular part is accessed by the factorization
+    LDLT_TEMP_MAT(T, kkt_active, n_kkt_active, n_kkt_active, stack);
+    kkt_active.topLeftCorner(n + n_eq, n + n_eq) = qpwork.kkt;
+    if (qpmodel.box_constraints) {
+      kkt_active.diagonal().head(n).array() +=
+        qpwork.factorized_box.template cast<T>().array() /
+        qpresults.info.mu_in;
+    }
+    for (isize i = 0; i < n_in; ++i) {
+      isize j = qpwork.current_bijection_map(i);
+      if (j < n_c) {
+        kkt_active.row(n + n_eq + j).head(n) = qpwork.C_scaled.row(i);
+        kkt_active(n + n_eq + j, n + n_eq + j) = -qpresults.info.mu_in;
+      }
+    }
+    qpwork.ldl.factorize(kkt_active, stack);
+  }
+  qpwork.constraints_changed = false;
+  qpwork.dw_aug.setZero();
+}
+/*!
+ * Solves in place the linear system of the regularized KKT matrix (of dimension
+ * dim + n_eq + n_c) with the factorization of the solver.
+ *
+ * With the PrimalLDLT backend, the dual components are eliminated: the primal
+ * component solves (H + rho I + A.T A / mu_eq + C_act.T C_act / mu_in) dx =
+ * rhs_x + A.T rhs_y / mu_eq + C_act.T rhs_z / mu_in, and the dual components
+ * are then recovered as dy = (A dx - rhs_y) / mu_eq and
+ * dz = (C_act dx - rhs_z) / mu_in.
+ *
+ * @param qpmodel QP problem model as defined by the user (without any scaling
+ * performed).
+ * @param qpresults solver results.
+ * @param qpwork solver workspace.
+ * @param rhs right hand side of the linear system, overwritten by the solution.
+ * @param stack workspace memory stack.
+ */
+template<typename T>
+void
+solve_kkt_in_place(const Model<T>& qpmodel,
+                   const Results<T>& qpresults,
+                   Workspace<T>& qpwork,
+                   Eigen::Ref<Vec<T>> rhs,
+                   proxsuite::linalg::veg::dynstack::DynStackMut stack)
+{
+  if (qpwork.dense_backend != DenseBackend::PrimalLDLT) {
+    qpwork.ldl.solve_in_place(rhs, stack);
+    return;
+  }
+
+  isize n = qpmodel.dim;
+  isize n_eq = qpmodel.n_eq;
+  isize n_c = rhs.rows() - n - n_eq;
+  T mu_eq_inv = T(1) / qpresults.info.mu_eq;
+  T mu_in_inv = T(1) / qpresults.info.mu_in;
+
+  auto rhs_x = rhs.head(n);
+  auto rhs_y = rhs.segment(n, n_eq);
+  auto rhs_z = rhs.tail(n_c);
+
+  rhs_x.noalias() += mu_eq_inv * (qpwork.A_scaled.transpose() * rhs_y);
+  for (isize i = 0; i < qpmodel.n_in; ++i) {
+    isize j = qpwork.current_bijection_map(i);
+    if (j < n_c) {
+      rhs_x += (mu_in_inv * rhs_z(j)) * qpwork.C_scaled.row(i).transpose();
+    }
+  }
+  qpwork.ldl.solve_in_place(rhs_x, stack);
+
+  LDLT_TEMP_VEC_UNINIT(T, Adx, n_eq, stack);
+  Adx.noalias() = qpwork.A_scaled * rhs_x;
+  rhs_y = (Adx - rhs_y) * mu_eq_inv;
+  for (isize i = 0; i < qpmodel.n_in; ++i) {
+    isize j = qpwork.current_bijection_map(i);
+    if (j < n_c) {
+      rhs_z(j) = (qpwork.C_scaled.row(i).dot(rhs_x) - rhs_z(j)) * mu_in_inv;
+    }
+  }
+}
 /*!
  * Derives the residual of the iterative refinement algorithm used for solving
  * associated linear systems of PROXQP algorithm.
@@ -152,11 +368,19 @@ iterative_residual(const Model<T>& qpmodel,
 
   qpwork.err.head(inner_pb_dim) = qpwork.rhs.head(inner_pb_dim);
 
-  qpwork.err.head(qpmodel.dim).noalias() -=
-    qpwork.H_scaled.template selfadjointView<Eigen::Lower>() *
-    qpwork.dw_aug.head(qpmodel.dim);
+  hessian_mul_add(qpmodel.hessian_type,
+                  qpwork.H_scaled,
+                  T(-1),
+                  qpwork.err.head(qpmodel.dim),
+                  qpwork.dw_aug.head(qpmodel.dim));
   qpwork.err.head(qpmodel.dim) -=
     qpresults.info.rho * qpwork.dw_aug.head(qpmodel.dim);
+  if (qpmodel.box_constraints) {
+    qpwork.err.head(qpmodel.dim).array() -=
+      qpwork.factorized_box.select(qpwork.dw_aug.head(qpmodel.dim), T(0.))
+        .array() /
+      qpresults.info.mu_in;
+  }
 
   // PERF: fuse {A, C}_scaled multiplication operations
   qpwork.err.head(qpmodel.dim).noalias() -=
@@ -199,6 +423,7 @@ iterative_solve_with_permut_fact( //
   T eps,
   isize inner_pb_dim)
 {
+  PROXSUITE_PROFILE_SCOPE(qpresults.info.profile.iterative_refinement_time);
 
   qpwork.err.setZero();
   i32 it = 0;
@@ -208,7 +433,8 @@ iterative_solve_with_permut_fact( //
   proxsuite::linalg::veg::dynstack::DynStackMut stack{
     proxsuite::linalg::veg::from_slice_mut, qpwork.ldl_stack.as_mut()
   };
-  qpwork.ldl.solve_in_place(qpwork.dw_aug.head(inner_pb_dim), stack);
+  solve_kkt_in_place<T>(
+    qpmodel, qpresults, qpwork, qpwork.dw_aug.head(inner_pb_dim), stack);
 
   iterative_residual<T>(qpmodel, qpresults, qpwork, inner_pb_dim);
 
@@ -228,7 +454,8 @@ iterative_solve_with_permut_fact( //
     }
 
     ++it;
-    qpwork.ldl.solve_in_place(qpwork.err.head(inner_pb_dim), stack);
+    solve_kkt_in_place<T>(
+      qpmodel, qpresults, qpwork, qpwork.err.head(inner_pb_dim), stack);
     qpwork.dw_aug.head(inner_pb_dim) += qpwork.err.head(inner_pb_dim);
 
     qpwork.err.head(inner_pb_dim).setZero();
@@ -255,12 +482,20 @@ iterative_solve_with_permut_fact( //
 
   if (infty_norm(qpwork.err.head(inner_pb_dim)) >=
       std::max(eps, qpsettings.eps_refact)) {
+    if (qpwork.ldl.is_low_precision()) {
+      // the iterative refinement stalls with the single precision
+      // factorization: fall back to a full precision one
+      qpwork.ldl.set_low_precision(false);
+      qpwork.constraints_changed = true;
+      qpresults.info.mixed_precision_fallback = true;
+    }
     refactorize(qpmodel, qpresults, qpwork, qpresults.info.rho);
     it = 0;
     it_stability = 0;
 
     qpwork.dw_aug.head(inner_pb_dim) = qpwork.rhs.head(inner_pb_dim);
-    qpwork.ldl.solve_in_place(qpwork.dw_aug.head(inner_pb_dim), stack);
+    solve_kkt_in_place<T>(
+      qpmodel, qpresults, qpwork, qpwork.dw_aug.head(inner_pb_dim), stack);
 
     iterative_residual<T>(qpmodel, qpresults, qpwork, inner_pb_dim);
 
@@ -279,7 +514,8 @@ iterative_solve_with_permut_fact( //
         break;
       }
       ++it;
-      qpwork.ldl.solve_in_place(qpwork.err.head(inner_pb_dim), stack);
+      solve_kkt_in_place<T>(
+        qpmodel, qpresults, qpwork, qpwork.err.head(inner_pb_dim), stack);
       qpwork.dw_aug.head(inner_pb_dim) += qpwork.err.head(inner_pb_dim);
 
       qpwork.err.head(inner_pb_dim).setZero();
@@ -304,6 +540,10 @@ iterative_solve_with_permut_fact( //
       */
     }
   }
+  qpresults.info.iterative_refinement_steps =
+    std::max(qpresults.info.iterative_refinement_steps, isize(it - 1));
+  PROXSUITE_PROFILE_COUNT(qpresults.info.profile.iterative_refinement_steps,
+                          isize(it - 1));
   qpwork.rhs.head(inner_pb_dim).setZero();
 }
 /*!
@@ -364,6 +604,7 @@ bcl_update(const Settings<T>& qpsettings,
     */
     qpresults.y = qpwork.y_prev;
     qpresults.z = qpwork.z_prev;
+    qpresults.z_box = qpwork.z_box_prev;
 
     new_bcl_mu_in = std::max(qpresults.info.mu_in * qpsettings.mu_update_factor,
                              qpsettings.mu_min_in);
@@ -465,6 +706,14 @@ compute_inner_loop_saddle_point(const Model<T>& qpmodel,
                                         // + [Cx-l+z_prev*mu_in]- - z*mu_in
 
   T err = infty_norm(qpwork.active_part_z);
+  if (qpmodel.box_constraints) {
+    // [x-u_box+z_box_prev*mu_in]+ + [x-l_box+z_box_prev*mu_in]- - z_box*mu_in
+    err = std::max(
+      err,
+      infty_norm(helpers::positive_part(qpwork.primal_residual_box_scaled_up) +
+                 helpers::negative_part(qpwork.primal_residual_box_scaled_low) -
+                 qpresults.z_box * qpresults.info.mu_in));
+  }
   qpwork.err.segment(qpmodel.dim, qpmodel.n_eq) =
     qpwork.primal_residual_eq_scaled; // contains now Ax-b-(y-y_prev)/mu
 
@@ -510,6 +759,13 @@ primal_dual_semi_smooth_newton_step(const Settings<T>& qpsettings,
     (qpwork.primal_residual_in_scaled_low.array() <= 0);
   qpwork.active_inequalities = qpwork.active_set_up || qpwork.active_set_low;
   isize numactive_inequalities = qpwork.active_inequalities.count();
+  if (qpmodel.box_constraints) {
+    qpwork.active_set_up_box.array() =
+      (qpwork.primal_residual_box_scaled_up.array() >= 0);
+    qpwork.active_set_low_box.array() =
+      (qpwork.primal_residual_box_scaled_low.array() <= 0);
+    qpwork.active_box = qpwork.active_set_up_box || qpwork.active_set_low_box;
+  }
 
   isize inner_pb_dim = qpmodel.dim + qpmodel.n_eq + numactive_inequalities;
   qpwork.rhs.setZero();
@@ -538,6 +794,25 @@ primal_dual_semi_smooth_newton_step(const Settings<T>& qpsettings,
         qpresults.z(i) * qpwork.C_scaled.row(i); // unactive unrelevant columns
     }
   }
+  // the box constraints are eliminated from the system:
+  // dz_box = (dx - rhs_box) / mu_in for the active ones, and dz_box = -z_box
+  // otherwise. dz_box contains rhs_box until the system is solved.
+  if (qpmodel.box_constraints) {
+    T mu_in_inv = T(1) / qpresults.info.mu_in;
+    for (isize i = 0; i < qpmodel.dim; i++) {
+      if (qpwork.active_set_up_box(i)) {
+        qpwork.dz_box(i) = -qpwork.primal_residual_box_scaled_up(i) +
+                           qpresults.z_box(i) * qpresults.info.mu_in;
+        qpwork.rhs(i) += qpwork.dz_box(i) * mu_in_inv;
+      } else if (qpwork.active_set_low_box(i)) {
+        qpwork.dz_box(i) = -qpwork.primal_residual_box_scaled_low(i) +
+                           qpresults.z_box(i) * qpresults.info.mu_in;
+        qpwork.rhs(i) += qpwork.dz_box(i) * mu_in_inv;
+      } else {
+        qpwork.rhs(i) += qpresults.z_box(i);
+      }
+    }
+  }
 
   iterative_solve_with_permut_fact( //
     qpsettings,
@@ -557,6 +832,17 @@ primal_dual_semi_smooth_newton_step(const Settings<T>& qpsettings,
     }
   }
   qpwork.dw_aug.tail(qpmodel.n_in) = qpwork.active_part_z;
+
+  if (qpmodel.box_constraints) {
+    T mu_in_inv = T(1) / qpresults.info.mu_in;
+    for (isize i = 0; i < qpmodel.dim; i++) {
+      if (qpwork.active_box(i)) {
+        qpwork.dz_box(i) = (qpwork.dw_aug(i) - qpwork.dz_box(i)) * mu_in_inv;
+      } else {
+        qpwork.dz_box(i) = -qpresults.z_box(i);
+      }
+    }
+  }
 }
 /*!
  * Performs the Newton semismooth algorithm to minimize the primal-dual
@@ -621,16 +907,18 @@ primal_dual_newton_semi_smooth(const Settings<T>& qpsettings,
     Adx.setZero();
     Cdx.setZero();
 
-    Hdx.noalias() +=
-      qpwork.H_scaled.template selfadjointView<Eigen::Lower>() * dx;
+    hessian_mul_add(qpmodel.hessian_type, qpwork.H_scaled, T(1), Hdx, dx);
 
     Adx.noalias() += qpwork.A_scaled * dx;
     ATdy.noalias() += qpwork.A_scaled.transpose() * dy;
 
     Cdx.noalias() += qpwork.C_scaled * dx;
     CTdz.noalias() += qpwork.C_scaled.transpose() * dz;
+    if (qpmodel.box_constraints) {
+      CTdz += qpwork.dz_box;
+    }
 
-    if (qpmodel.n_in > 0) {
+    if (qpmodel.n_in > 0 || qpmodel.box_constraints) {
       linesearch::primal_dual_ls(qpmodel, qpresults, qpwork);
     }
     auto alpha = qpwork.alpha;
@@ -661,6 +949,13 @@ primal_dual_newton_semi_smooth(const Settings<T>& qpsettings,
     qpresults.y += alpha * dy;
     qpresults.z += alpha * dz;
 
+    if (qpmodel.box_constraints) {
+      // contains now :  x+alpha dx-u_box + z_box_prev * mu_in (and l_box)
+      qpwork.primal_residual_box_scaled_up += alpha * dx;
+      qpwork.primal_residual_box_scaled_low += alpha * dx;
+      qpresults.z_box += alpha * qpwork.dz_box;
+    }
+
     qpwork.dual_residual_scaled +=
       alpha * (qpresults.info.rho * dx + Hdx + ATdy + CTdz);
 
@@ -766,6 +1061,10 @@ qp_solve( //
   RowMat test(2,2); // test it is full of nan for debug
   std::cout << "test " << test << std::endl;
   */
+  // takes effect at the next factorization of the kkt matrix. the storage of
+  // the single precision factorization is reserved here, before any
+  // allocation is forbidden
+  qpwork.ldl.set_low_precision(qpsettings.mixed_precision);
   PROXSUITE_EIGEN_MALLOC_NOT_ALLOWED();
 
   if (qpsettings.compute_timings) {
@@ -775,6 +1074,14 @@ qp_solve( //
   if (qpsettings.verbose) {
     dense::print_setup_header(qpsettings, qpresults, qpmodel);
   }
+  qpresults.info.mixed_precision_fallback = false;
+  qpresults.info.iterative_refinement_steps = 0;
+  if (qpwork.dirty) {
+    // the problem is equilibrated again by this solve
+    qpresults.info.profile.clear();
+  } else {
+    qpresults.info.profile.clear_solve_statistics();
+  }
   if (qpwork.dirty) { // the following is used when a solve has already been
                       // executed (and without any intermediary model update)
     switch (qpsettings.initial_guess) {
@@ -793,6 +1100,8 @@ qp_solve( //
           { proxsuite::proxqp::from_eigen, qpresults.y });
         ruiz.scale_dual_in_place_in(
           { proxsuite::proxqp::from_eigen, qpresults.z });
+        ruiz.scale_box_dual_in_place(
+          { proxsuite::proxqp::from_eigen, qpresults.z_box });
         break;
       }
       case InitialGuessStatus::NO_INITIAL_GUESS: {
@@ -813,6 +1122,8 @@ qp_solve( //
           { proxsuite::proxqp::from_eigen, qpresults.y });
         ruiz.scale_dual_in_place_in(
           { proxsuite::proxqp::from_eigen, qpresults.z });
+        ruiz.scale_box_dual_in_place(
+          { proxsuite::proxqp::from_eigen, qpresults.z_box });
         break;
       }
       case InitialGuessStatus::WARM_START_WITH_PREVIOUS_RESULT: {
@@ -824,55 +1135,64 @@ qp_solve( //
           { proxsuite::proxqp::from_eigen, qpresults.y });
         ruiz.scale_dual_in_place_in(
           { proxsuite::proxqp::from_eigen, qpresults.z });
+        ruiz.scale_box_dual_in_place(
+          { proxsuite::proxqp::from_eigen, qpresults.z_box });
         break;
       }
     }
     if (qpsettings.initial_guess !=
         InitialGuessStatus::WARM_START_WITH_PREVIOUS_RESULT) {
-      qpwork.H_scaled = qpmodel.H;
-      qpwork.g_scaled = qpmodel.g;
-      qpwork.A_scaled = qpmodel.A;
-      qpwork.b_scaled = qpmodel.b;
-      qpwork.C_scaled = qpmodel.C;
-      qpwork.u_scaled = qpmodel.u;
-      qpwork.l_scaled = qpmodel.l;
-      proxsuite::proxqp::dense::setup_equilibration(
-        qpwork, qpsettings, ruiz, false); // reuse previous equilibration
-      proxsuite::proxqp::dense::setup_factorization(qpwork, qpmodel, qpresults);
+      if (qpsettings.cache_scaled_model && qpwork.scaled_model_cached) {
+        // the model has not been updated since its copy was stored
+        PROXSUITE_PROFILE_SCOPE(qpresults.info.profile.equilibration_time);
+        qpwork.restore_scaled_model();
+      } else {
+        qpwork.scaled_model_cached = false;
+        qpwork.ldl_cached = false;
+        qpwork.H_scaled = qpmodel.H;
+        qpwork.g_scaled = qpmodel.g;
+        qpwork.A_scaled = qpmodel.A;
+        qpwork.b_scaled = qpmodel.b;
+        qpwork.C_scaled = qpmodel.C;
+        qpwork.u_scaled = qpmodel.u;
+        qpwork.l_scaled = qpmodel.l;
+        qpwork.u_box_scaled = helpers::at_most(qpmodel.u_box, T(1.E20));
+        qpwork.l_box_scaled = helpers::at_least(qpmodel.l_box, T(-1.E20));
+        PROXSUITE_PROFILE_SCOPE(qpresults.info.profile.equilibration_time);
+        proxsuite::proxqp::dense::setup_equilibration(
+          qpwork,
+          qpsettings,
+          ruiz,
+          false,
+          qpmodel.box_constraints,
+          qpmodel.hessian_type); // reuse previous equilibration
+        if (qpsettings.cache_scaled_model) {
+          // the setting was enabled after the last init or update
+          PROXSUITE_EIGEN_MALLOC_ALLOWED();
+          qpwork.store_scaled_model();
+          PROXSUITE_EIGEN_MALLOC_NOT_ALLOWED();
+        }
+      }
     }
     switch (qpsettings.initial_guess) {
       case InitialGuessStatus::EQUALITY_CONSTRAINED_INITIAL_GUESS: {
+        proxsuite::proxqp::dense::setup_factorization(
+          qpwork, qpmodel, qpresults);
         compute_equality_constrained_initial_guess(
           qpwork, qpsettings, qpmodel, qpresults);
         break;
       }
       case InitialGuessStatus::COLD_START_WITH_PREVIOUS_RESULT: {
-        //!\ TODO in a quicker way
-        qpwork.n_c = 0;
-        for (isize i = 0; i < qpmodel.n_in; i++) {
-          if (qpresults.z[i] != 0) {
-            qpwork.active_inequalities[i] = true;
-          } else {
-            qpwork.active_inequalities[i] = false;
-          }
-        }
-        linesearch::active_set_change(qpmodel, qpresults, qpwork);
+        setup_factorization_with_active_set(qpmodel, qpresults, qpwork);
         break;
       }
       case InitialGuessStatus::NO_INITIAL_GUESS: {
+        proxsuite::proxqp::dense::setup_factorization(
+          qpwork, qpmodel, qpresults);
         break;
       }
       case InitialGuessStatus::WARM_START: {
-        //!\ TODO in a quicker way
-        qpwork.n_c = 0;
-        for (isize i = 0; i < qpmodel.n_in; i++) {
-          if (qpresults.z[i] != 0) {
-            qpwork.active_inequalities[i] = true;
-          } else {
-            qpwork.active_inequalities[i] = false;
-          }
-        }
-        linesearch::active_set_change(qpmodel, qpresults, qpwork);
+        setup_factorization_with_active_set(qpmodel, qpresults, qpwork);
         break;
       }
       case InitialGuessStatus::WARM_START_WITH_PREVIOUS_RESULT: {
@@ -885,6 +1205,12 @@ qp_solve( //
     }
   } else { // the following is used for a first solve after initializing or
            // updating the Qp object
+    if (qpsettings.cache_scaled_model && !qpwork.scaled_model_cached) {
+      // the setting was enabled after the last init or update
+      PROXSUITE_EIGEN_MALLOC_ALLOWED();
+      qpwork.store_scaled_model();
+      PROXSUITE_EIGEN_MALLOC_NOT_ALLOWED();
+    }
     switch (qpsettings.initial_guess) {
       case InitialGuessStatus::EQUALITY_CONSTRAINED_INITIAL_GUESS: {
         proxsuite::proxqp::dense::setup_factorization(
@@ -894,7 +1220,6 @@ qp_solve( //
         break;
       }
       case InitialGuessStatus::COLD_START_WITH_PREVIOUS_RESULT: {
-        //!\ TODO in a quicker way
         ruiz.scale_primal_in_place(
           { proxsuite::proxqp::from_eigen,
             qpresults
@@ -904,16 +1229,9 @@ qp_solve( //
           { proxsuite::proxqp::from_eigen, qpresults.y });
         ruiz.scale_dual_in_place_in(
           { proxsuite::proxqp::from_eigen, qpresults.z });
-        setup_factorization(qpwork, qpmodel, qpresults);
-        qpwork.n_c = 0;
-        for (isize i = 0; i < qpmodel.n_in; i++) {
-          if (qpresults.z[i] != 0) {
-            qpwork.active_inequalities[i] = true;
-          } else {
-            qpwork.active_inequalities[i] = false;
-          }
-        }
-        linesearch::active_set_change(qpmodel, qpresults, qpwork);
+        ruiz.scale_box_dual_in_place(
+          { proxsuite::proxqp::from_eigen, qpresults.z_box });
+        setup_factorization_with_active_set(qpmodel, qpresults, qpwork);
         break;
       }
       case InitialGuessStatus::NO_INITIAL_GUESS: {
@@ -921,23 +1239,15 @@ qp_solve( //
         break;
       }
       case InitialGuessStatus::WARM_START: {
-        //!\ TODO in a quicker way
         ruiz.scale_primal_in_place(
           { proxsuite::proxqp::from_eigen, qpresults.x });
         ruiz.scale_dual_in_place_eq(
           { proxsuite::proxqp::from_eigen, qpresults.y });
         ruiz.scale_dual_in_place_in(
           { proxsuite::proxqp::from_eigen, qpresults.z });
-        setup_factorization(qpwork, qpmodel, qpresults);
-        qpwork.n_c = 0;
-        for (isize i = 0; i < qpmodel.n_in; i++) {
-          if (qpresults.z[i] != 0) {
-            qpwork.active_inequalities[i] = true;
-          } else {
-            qpwork.active_inequalities[i] = false;
-          }
-        }
-        linesearch::active_set_change(qpmodel, qpresults, qpwork);
+        ruiz.scale_box_dual_in_place(
+          { proxsuite::proxqp::from_eigen, qpresults.z_box });
+        setup_factorization_with_active_set(qpmodel, qpresults, qpwork);
         break;
       }
       case InitialGuessStatus::WARM_START_WITH_PREVIOUS_RESULT: {
@@ -951,19 +1261,12 @@ qp_solve( //
           { proxsuite::proxqp::from_eigen, qpresults.y });
         ruiz.scale_dual_in_place_in(
           { proxsuite::proxqp::from_eigen, qpresults.z });
+        ruiz.scale_box_dual_in_place(
+          { proxsuite::proxqp::from_eigen, qpresults.z_box });
         if (qpwork.refactorize) { // refactorization only when one of the
                                   // matrices has changed or one proximal
                                   // parameter has changed
-          setup_factorization(qpwork, qpmodel, qpresults);
-          qpwork.n_c = 0;
-          for (isize i = 0; i < qpmodel.n_in; i++) {
-            if (qpresults.z[i] != 0) {
-              qpwork.active_inequalities[i] = true;
-            } else {
-              qpwork.active_inequalities[i] = false;
-            }
-          }
-          linesearch::active_set_change(qpmodel, qpresults, qpwork);
+          setup_factorization_with_active_set(qpmodel, qpresults, qpwork);
           break;
         }
       }
@@ -993,26 +1296,30 @@ qp_solve( //
     // compute primal residual
 
     // PERF: fuse matrix product computations in global_{primal, dual}_residual
-    global_primal_residual(qpmodel,
-                           qpresults,
+    {
+      PROXSUITE_PROFILE_SCOPE(qpresults.info.profile.residual_time);
+      PROXSUITE_PROFILE_COUNT(qpresults.info.profile.residual_evaluations, 2);
+      global_primal_residual(qpmodel,
+                             qpresults,
+                             qpwork,
+                             ruiz,
+                             primal_feasibility_lhs,
+                             primal_feasibility_eq_rhs_0,
+                             primal_feasibility_in_rhs_0,
+                             primal_feasibility_eq_lhs,
+                             primal_feasibility_in_lhs);
+
+      global_dual_residual(qpresults,
                            qpwork,
+                           qpmodel,
                            ruiz,
-                           primal_feasibility_lhs,
-                           primal_feasibility_eq_rhs_0,
-                           primal_feasibility_in_rhs_0,
-                           primal_feasibility_eq_lhs,
-                           primal_feasibility_in_lhs);
-
-    global_dual_residual(qpresults,
-                         qpwork,
-                         qpmodel,
-                         ruiz,
-                         dual_feasibility_lhs,
-                         dual_feasibility_rhs_0,
-                         dual_feasibility_rhs_1,
-                         dual_feasibility_rhs_3,
-                         rhs_duality_gap,
-                         duality_gap);
+                           dual_feasibility_lhs,
+                           dual_feasibility_rhs_0,
+                           dual_feasibility_rhs_1,
+                           dual_feasibility_rhs_3,
+                           rhs_duality_gap,
+                           duality_gap);
+    }
     qpresults.info.pri_res = primal_feasibility_lhs;
     qpresults.info.dua_res = dual_feasibility_lhs;
     qpresults.info.duality_gap = duality_gap;
@@ -1047,18 +1354,13 @@ qp_solve( //
         VectorViewMut<T>{ from_eigen, qpresults.y });
       ruiz.unscale_dual_in_place_in(
         VectorViewMut<T>{ from_eigen, qpresults.z });
+      ruiz.unscale_box_dual_in_place(
+        VectorViewMut<T>{ from_eigen, qpresults.z_box });
 
       {
         // EigenAllowAlloc _{};
-        qpresults.info.objValue = 0;
-        for (Eigen::Index j = 0; j < qpmodel.dim; ++j) {
-          qpresults.info.objValue +=
-            0.5 * (qpresults.x(j) * qpresults.x(j)) * qpmodel.H(j, j);
-          qpresults.info.objValue +=
-            qpresults.x(j) * T(qpmodel.H.col(j)
-                                 .tail(qpmodel.dim - j - 1)
-                                 .dot(qpresults.x.tail(qpmodel.dim - j - 1)));
-        }
+        qpresults.info.objValue = hessian_quadratic_form(
+          qpmodel.hessian_type, qpmodel.H, qpresults.x);
         qpresults.info.objValue += (qpmodel.g).dot(qpresults.x);
       }
       std::cout << "\033[1;32m[outer iteration " << iter + 1 << "]\033[0m"
@@ -1072,6 +1374,8 @@ qp_solve( //
       ruiz.scale_primal_in_place(VectorViewMut<T>{ from_eigen, qpresults.x });
       ruiz.scale_dual_in_place_eq(VectorViewMut<T>{ from_eigen, qpresults.y });
       ruiz.scale_dual_in_place_in(VectorViewMut<T>{ from_eigen, qpresults.z });
+      ruiz.scale_box_dual_in_place(
+        VectorViewMut<T>{ from_eigen, qpresults.z_box });
     }
     if (is_primal_feasible && is_dual_feasible) {
       if (qpsettings.check_duality_gap) {
@@ -1091,6 +1395,7 @@ qp_solve( //
     qpwork.x_prev = qpresults.x;
     qpwork.y_prev = qpresults.y;
     qpwork.z_prev = qpresults.z;
+    qpwork.z_box_prev = qpresults.z_box;
 
     // primal dual version from gill and robinson
 
@@ -1106,6 +1411,15 @@ qp_solve( //
     qpwork.primal_residual_in_scaled_low -=
       qpwork.l_scaled; // contains now scaled(Cx-l+z_prev*mu_in)
 
+    if (qpmodel.box_constraints) {
+      // contains now scaled(x-u_box+z_box_prev*mu_in) (and l_box)
+      qpwork.primal_residual_box_scaled_up =
+        qpresults.x + qpwork.z_box_prev * qpresults.info.mu_in;
+      qpwork.primal_residual_box_scaled_low =
+        qpwork.primal_residual_box_scaled_up - qpwork.l_box_scaled;
+      qpwork.primal_residual_box_scaled_up -= qpwork.u_box_scaled;
+    }
+
     primal_dual_newton_semi_smooth(
       qpsettings, qpmodel, qpresults, qpwork, ruiz, bcl_eta_in);
 
@@ -1115,20 +1429,25 @@ qp_solve( //
       qpresults.x = qpwork.dw_aug.head(qpmodel.dim);
       qpresults.y = qpwork.dw_aug.segment(qpmodel.dim, qpmodel.n_eq);
       qpresults.z = qpwork.dw_aug.tail(qpmodel.n_in);
+      qpresults.z_box = qpwork.dz_box;
       break;
     }
 
     T primal_feasibility_lhs_new(primal_feasibility_lhs);
 
-    global_primal_residual(qpmodel,
-                           qpresults,
-                           qpwork,
-                           ruiz,
-                           primal_feasibility_lhs_new,
-                           primal_feasibility_eq_rhs_0,
-                           primal_feasibility_in_rhs_0,
-                           primal_feasibility_eq_lhs,
-                           primal_feasibility_in_lhs);
+    {
+      PROXSUITE_PROFILE_SCOPE(qpresults.info.profile.residual_time);
+      PROXSUITE_PROFILE_COUNT(qpresults.info.profile.residual_evaluations, 1);
+      global_primal_residual(qpmodel,
+                             qpresults,
+                             qpwork,
+                             ruiz,
+                             primal_feasibility_lhs_new,
+                             primal_feasibility_eq_rhs_0,
+                             primal_feasibility_in_rhs_0,
+                             primal_feasibility_eq_lhs,
+                             primal_feasibility_in_lhs);
+    }
 
     is_primal_feasible =
       primal_feasibility_lhs_new <=
@@ -1139,16 +1458,20 @@ qp_solve( //
     if (is_primal_feasible) {
       T dual_feasibility_lhs_new(dual_feasibility_lhs);
 
-      global_dual_residual(qpresults,
-                           qpwork,
-                           qpmodel,
-                           ruiz,
-                           dual_feasibility_lhs_new,
-                           dual_feasibility_rhs_0,
-                           dual_feasibility_rhs_1,
-                           dual_feasibility_rhs_3,
-                           rhs_duality_gap,
-                           duality_gap);
+      {
+        PROXSUITE_PROFILE_SCOPE(qpresults.info.profile.residual_time);
+        PROXSUITE_PROFILE_COUNT(qpresults.info.profile.residual_evaluations, 1);
+        global_dual_residual(qpresults,
+                             qpwork,
+                             qpmodel,
+                             ruiz,
+                             dual_feasibility_lhs_new,
+                             dual_feasibility_rhs_0,
+                             dual_feasibility_rhs_1,
+                             dual_feasibility_rhs_3,
+                             rhs_duality_gap,
+                             duality_gap);
+      }
       qpresults.info.dua_res = dual_feasibility_lhs_new;
       qpresults.info.duality_gap = duality_gap;
 
@@ -1204,16 +1527,20 @@ qp_solve( //
 
     T dual_feasibility_lhs_new(dual_feasibility_lhs);
 
-    global_dual_residual(qpresults,
-                         qpwork,
-                         qpmodel,
-                         ruiz,
-                         dual_feasibility_lhs_new,
-                         dual_feasibility_rhs_0,
-                         dual_feasibility_rhs_1,
-                         dual_feasibility_rhs_3,
-                         rhs_duality_gap,
-                         duality_gap);
+    {
+      PROXSUITE_PROFILE_SCOPE(qpresults.info.profile.residual_time);
+      PROXSUITE_PROFILE_COUNT(qpresults.info.profile.residual_evaluations, 1);
+      global_dual_residual(qpresults,
+                           qpwork,
+                           qpmodel,
+                           ruiz,
+                           dual_feasibility_lhs_new,
+                           dual_feasibility_rhs_0,
+                           dual_feasibility_rhs_1,
+                           dual_feasibility_rhs_3,
+                           rhs_duality_gap,
+                           duality_gap);
+    }
     qpresults.info.dua_res = dual_feasibility_lhs_new;
     qpresults.info.duality_gap = duality_gap;
 
@@ -1251,18 +1578,13 @@ qp_solve( //
   ruiz.unscale_primal_in_place(VectorViewMut<T>{ from_eigen, qpresults.x });
   ruiz.unscale_dual_in_place_eq(VectorViewMut<T>{ from_eigen, qpresults.y });
   ruiz.unscale_dual_in_place_in(VectorViewMut<T>{ from_eigen, qpresults.z });
+  ruiz.unscale_box_dual_in_place(
+    VectorViewMut<T>{ from_eigen, qpresults.z_box });
 
   {
     // EigenAllowAlloc _{};
-    qpresults.info.objValue = 0;
-    for (Eigen::Index j = 0; j < qpmodel.dim; ++j) {
-      qpresults.info.objValue +=
-        0.5 * (qpresults.x(j) * qpresults.x(j)) * qpmodel.H(j, j);
-      qpresults.info.objValue +=
-        qpresults.x(j) * T(qpmodel.H.col(j)
-                             .tail(qpmodel.dim - j - 1)
-                             .dot(qpresults.x.tail(qpmodel.dim - j - 1)));
-    }
+    qpresults.info.objValue =
+      hessian_quadratic_form(qpmodel.hessian_type, qpmodel.H, qpresults.x);
     qpresults.info.objValue += (qpmodel.g).dot(qpresults.x);
   }
 
@@ -43,6 +43,9 @@ print_setup_header(const Settings<T>& settings,
             << ", equality constraints n_eq = " << model.n_eq << ",\n"
             << "          inequality constraints n_in = " << model.n_in
             << std::endl;
+  if (model.box_constraints) {
+    std::cout << "          box constraints on the variables" << std::endl;
+  }
 
   // Print Settings
   std::cout << "settings: " << std::endl;
@@ -113,6 +116,66 @@ save_data(const std::string& filename, const ::Eigen::MatrixBase<Derived>& mat)
   }
 }
 
+/*!
+ * Adds factor * H * x to out, where H is stored with the given hessian type
+ * (lower triangular part of the full matrix, diagonal, or nothing).
+ *
+ * @param hessian_type structure of the hessian.
+ * @param H hessian storage.
+ * @param factor scalar multiplying the product.
+ * @param out output vector.
+ * @param x input vector.
+ */
+template<typename T, typename Out, typename In>
+void
+hessian_mul_add(HessianType hessian_type,
+                const Mat<T>& H,
+                T factor,
+                Out&& out,
+                In const& x)
+{
+  switch (hessian_type) {
+    case HessianType::Dense:
+      out.noalias() +=
+        factor * (H.template selfadjointView<Eigen::Lower>() * x);
+      break;
+    case HessianType::Diagonal:
+      out.array() += factor * H.col(0).array() * x.array();
+      break;
+    case HessianType::Zero:
+      break;
+  }
+}
+/*!
+ * Returns 0.5 * x.T * H * x, where H is stored with the given hessian type.
+ *
+ * @param hessian_type structure of the hessian.
+ * @param H hessian storage.
+ * @param x input vector.
+ */
+template<typename T>
+T
+hessian_quadratic_form(HessianType hessian_type,
+                       const Mat<T>& H,
+                       const Vec<T>& x)
+{
+  T value(0);
+  isize dim = x.size();
+  switch (hessian_type) {
+    case HessianType::Dense:
+      for (Eigen::Index j = 0; j < dim; ++j) {
+        value += 0.5 * (x(j) * x(j)) * H(j, j);
+        value += x(j) * T(H.col(j).tail(dim - j - 1).dot(x.tail(dim - j - 1)));
+      }
+      break;
+    case HessianType::Diagonal:
+      value = 0.5 * (H.col(0).array() * x.array().square()).sum();
+      break;
+    case HessianType::Zero:
+      break;
+  }
+  return value;
+}
 /*!
  * Derives the global primal residual of the QP problem.
  *
@@ -173,6 +236,16 @@ global_primal_residual(const Model<T>& qpmodel,
 
   primal_feasibility_in_lhs = infty_norm(qpwork.primal_residual_in_scaled_low);
   primal_feasibility_eq_lhs = infty_norm(qpwork.primal_residual_eq_scaled);
+  if (qpmodel.box_constraints) {
+    // the box constraints are identity rows acting on unscaled(x)
+    auto x_unscaled = qpresults.x.cwiseProduct(ruiz.delta.head(qpmodel.dim));
+    primal_feasibility_in_rhs_0 =
+      std::max(primal_feasibility_in_rhs_0, infty_norm(x_unscaled));
+    primal_feasibility_in_lhs = std::max(
+      primal_feasibility_in_lhs,
+      infty_norm(helpers::positive_part(x_unscaled - qpmodel.u_box) +
+                 helpers::negative_part(x_unscaled - qpmodel.l_box)));
+  }
   primal_feasibility_lhs =
     std::max(primal_feasibility_eq_lhs, primal_feasibility_in_lhs);
 
@@ -214,9 +287,13 @@ global_primal_residual_infeasibility(
   // ||unscaled(C^Tdz)|| <= eps_p_inf ||unscaled(dz)||
   // u^T [dz]_+ - l^T[-dz]_+ <= -eps_p_inf ||unscaled(dz)||
   //
+  // where C^Tdz and u^T [dz]_+ - l^T[-dz]_+ also include the box constraints
+  // (with dual step dz_box) when the model has some.
+  //
   // the variables in entry are changed in place
 
-  bool res = infty_norm(dy.to_eigen()) != 0 && infty_norm(dz.to_eigen()) != 0;
+  bool res = infty_norm(dy.to_eigen()) != 0 &&
+             (infty_norm(dz.to_eigen()) != 0 || infty_norm(qpwork.dz_box) != 0);
   if (!res) {
     return res;
   }
@@ -224,12 +301,23 @@ global_primal_residual_infeasibility(
   ruiz.unscale_dual_residual_in_place(CTdz);
   T eq_inf = dy.to_eigen().dot(qpwork.b_scaled);
   T in_inf = helpers::positive_part(dz.to_eigen()).dot(qpwork.u_scaled) -
-             helpers::negative_part(dz.to_eigen()).dot(qpwork.l_scaled);
+             helpers::negative_part(dz.to_eigen()).dot(qpwork.l_scaled) +
+             helpers::positive_part(qpwork.dz_box).dot(qpwork.u_box_scaled) -
+             helpers::negative_part(qpwork.dz_box).dot(qpwork.l_box_scaled);
   ruiz.unscale_dual_in_place_eq(dy);
   ruiz.unscale_dual_in_place_in(dz);
 
   T bound_y = qpsettings.eps_primal_inf * infty_norm(dy.to_eigen());
   T bound_z = qpsettings.eps_primal_inf * infty_norm(dz.to_eigen());
+  if (qpwork.dz_box.size() > 0) {
+    // unscaled(dz_box), without modifying dz_box
+    bound_z = std::max(
+      bound_z,
+      qpsettings.eps_primal_inf *
+        infty_norm((qpwork.dz_box.array() /
+                    (ruiz.delta.head(qpwork.dz_box.size()).array() * ruiz.c))
+                     .matrix()));
+  }
 
   res = infty_norm(ATdy.to_eigen()) <= bound_y && eq_inf <= -bound_y &&
         infty_norm(CTdz.to_eigen()) <= bound_z && in_inf <= -bound_z;
@@ -301,6 +389,17 @@ global_dual_residual_infeasibility(
       first_cond = first_cond && Cdx_i <= bound;
     }
   }
+  // same conditions for the box constraints, with dx in place of Cdx
+  for (isize i = 0; i < qpmodel.u_box.size(); ++i) {
+    T dx_i = dx.to_eigen()[i];
+    if (qpmodel.u_box[i] <= 1.E20 && qpmodel.l_box[i] >= -1.E20) {
+      first_cond = first_cond && dx_i <= bound && dx_i >= bound_neg;
+    } else if (qpmodel.u_box[i] > 1.E20) {
+      first_cond = first_cond && dx_i >= bound_neg;
+    } else if (qpmodel.l_box[i] < -1.E20) {
+      first_cond = first_cond && dx_i <= bound;
+    }
+  }
 
   bound *= ruiz.c;
   bound_neg *= ruiz.c;
@@ -349,8 +448,9 @@ global_dual_residual(Results<T>& qpresults,
   // dual_residual_scaled = scaled(Hx + g + ATy + CTz)
 
   qpwork.dual_residual_scaled = qpwork.g_scaled;
-  qpwork.CTz.noalias() =
-    qpwork.H_scaled.template selfadjointView<Eigen::Lower>() * qpresults.x;
+  qpwork.CTz.setZero();
+  hessian_mul_add(
+    qpmodel.hessian_type, qpwork.H_scaled, T(1), qpwork.CTz, qpresults.x);
   qpwork.dual_residual_scaled += qpwork.CTz;
   ruiz.unscale_dual_residual_in_place(
     VectorViewMut<T>{ from_eigen, qpwork.CTz }); // contains unscaled Hx
@@ -377,6 +477,15 @@ global_dual_residual(Results<T>& qpresults,
     VectorViewMut<T>{ from_eigen, qpwork.CTz });
   dual_feasibility_rhs_3 = infty_norm(qpwork.CTz);
 
+  if (qpmodel.box_constraints) {
+    qpwork.CTz = qpresults.z_box;
+    qpwork.dual_residual_scaled += qpwork.CTz;
+    ruiz.unscale_dual_residual_in_place(
+      VectorViewMut<T>{ from_eigen, qpwork.CTz });
+    dual_feasibility_rhs_3 =
+      std::max(dual_feasibility_rhs_3, infty_norm(qpwork.CTz));
+  }
+
   ruiz.unscale_dual_residual_in_place(
     VectorViewMut<T>{ from_eigen, qpwork.dual_residual_scaled });
 
@@ -406,6 +515,28 @@ global_dual_residual(Results<T>& qpresults,
   duality_gap += zl;
 
   ruiz.scale_dual_in_place_in(VectorViewMut<T>{ from_eigen, qpresults.z });
+
+  if (qpmodel.box_constraints) {
+    ruiz.unscale_box_dual_in_place(
+      VectorViewMut<T>{ from_eigen, qpresults.z_box });
+
+    const T zu_box =
+      helpers::select(qpwork.active_set_up_box, qpresults.z_box, 0)
+        .dot(
+          helpers::at_most(qpmodel.u_box, helpers::infinite_bound<T>::value()));
+    rhs_duality_gap = std::max(rhs_duality_gap, std::abs(zu_box));
+    duality_gap += zu_box;
+
+    const T zl_box =
+      helpers::select(qpwork.active_set_low_box, qpresults.z_box, 0)
+        .dot(helpers::at_least(qpmodel.l_box,
+                               -helpers::infinite_bound<T>::value()));
+    rhs_duality_gap = std::max(rhs_duality_gap, std::abs(zl_box));
+    duality_gap += zl_box;
+
+    ruiz.scale_box_dual_in_place(
+      VectorViewMut<T>{ from_eigen, qpresults.z_box });
+  }
 }
 
 } // namespace dense
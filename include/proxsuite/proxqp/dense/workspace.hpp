@@ -8,10 +8,10 @@
 #define PROXSUITE_PROXQP_DENSE_WORKSPACE_HPP
 
 #include <Eigen/Core>
-#include <proxsuite/linalg/dense/ldlt.hpp>
+#include <proxsuite/linalg/dense/mixed_ldlt.hpp>
 #include <proxsuite/proxqp/timings.hpp>
 #include <proxsuite/linalg/veg/vec.hpp>
-// #include <proxsuite/proxqp/dense/preconditioner/ruiz.hpp>
+#include <proxsuite/proxqp/dense/preconditioner/ruiz.hpp>
 
 namespace proxsuite {
 namespace proxqp {
@@ -27,7 +27,7 @@ struct Workspace
 {
 
   ///// Cholesky Factorization
-  proxsuite::linalg::dense::Ldlt<T> ldl{};
+  proxsuite::linalg::dense::MixedLdlt<T> ldl{};
   proxsuite::linalg::veg::Vec<unsigned char> ldl_stack;
   Timer<T> timer;
 
@@ -39,15 +39,39 @@ struct Workspace
   Vec<T> b_scaled;
   Vec<T> u_scaled;
   Vec<T> l_scaled;
+  Vec<T> u_box_scaled;
+  Vec<T> l_box_scaled;
+
+  ///// Copy of the scaled model and of the first factorization of its KKT
+  ///// matrix, kept when settings.cache_scaled_model is true so that the
+  ///// following solves of the same model restore them instead of
+  ///// equilibrating and factorizing it again
+  Mat<T> H_scaled_cache;
+  Vec<T> g_scaled_cache;
+  Mat<T> A_scaled_cache;
+  Mat<T> C_scaled_cache;
+  Vec<T> b_scaled_cache;
+  Vec<T> u_scaled_cache;
+  Vec<T> l_scaled_cache;
+  Vec<T> u_box_scaled_cache;
+  Vec<T> l_box_scaled_cache;
+  T correction_guess_rhs_g_cache;
+  proxsuite::linalg::dense::MixedLdlt<T> ldl_cache{};
+  T ldl_cache_rho;   // proximal parameters of the cached factorization
+  T ldl_cache_mu_eq; //
+  bool scaled_model_cached;
+  bool ldl_cached;
 
   ///// Initial variable loading
 
   Vec<T> x_prev;
   Vec<T> y_prev;
   Vec<T> z_prev;
+  Vec<T> z_box_prev;
 
   ///// KKT system storage
-  Mat<T> kkt;
+  DenseBackend dense_backend; // backend in use (never Automatic)
+  Mat<T> kkt; // H + rho I for the PrimalLDLT backend
 
   //// Active set & permutation vector
   VecISize current_bijection_map;
@@ -57,6 +81,14 @@ struct Workspace
   VecBool active_set_low;
   VecBool active_inequalities;
 
+  //// Active box constraints, which are eliminated from the KKT system: each
+  //// active bound adds 1/mu_in to the corresponding diagonal entry of the
+  //// factorized matrix
+  VecBool active_set_up_box;
+  VecBool active_set_low_box;
+  VecBool active_box;
+  VecBool factorized_box; // active box constraints of the factorization
+
   //// First order residuals for line search
 
   Vec<T> Hdx;
@@ -64,12 +96,19 @@ struct Workspace
   Vec<T> Adx;
 
   Vec<T> active_part_z;
+  // breakpoints of the linesearch, unsorted: the step at which the upper
+  // (resp. lower) side of bound i changes state is stored at alphas[i] (resp.
+  // alphas[n_in + n_box + i]), bounds [n_in, n_in + n_box) being the box
+  // constraints
   proxsuite::linalg::veg::Vec<T> alphas;
+  // indices in alphas of the positive breakpoints, sorted by increasing step
+  proxsuite::linalg::veg::Vec<isize> breakpoints;
 
   ///// Newton variables
   Vec<T> dw_aug;
   Vec<T> rhs;
   Vec<T> err;
+  Vec<T> dz_box;
 
   //// Relative residuals constants
 
@@ -82,6 +121,8 @@ struct Workspace
   Vec<T> primal_residual_eq_scaled;
   Vec<T> primal_residual_in_scaled_up;
   Vec<T> primal_residual_in_scaled_low;
+  Vec<T> primal_residual_box_scaled_up;
+  Vec<T> primal_residual_box_scaled_low;
 
   Vec<T> primal_residual_in_scaled_up_plus_alphaCdx;
   Vec<T> primal_residual_in_scaled_low_plus_alphaCdx;
@@ -99,28 +140,53 @@ struct Workspace
    * @param dim primal variable dimension.
    * @param n_eq number of equality constraints.
    * @param n_in number of inequality constraints.
+   * @param box_constraints whether the problem has box constraints on the
+   * primal variable.
+   * @param hessian_type structure of the hessian, which sets the storage of
+   * H_scaled.
+   * @param dense_backend factorization backend, which sets the size of the
+   * factorized matrix and of the memory stack.
    */
-  Workspace(isize dim = 0, isize n_eq = 0, isize n_in = 0)
+  Workspace(isize dim = 0,
+            isize n_eq = 0,
+            isize n_in = 0,
+            bool box_constraints = false,
+            HessianType hessian_type = HessianType::Dense,
+            DenseBackend dense_backend = DenseBackend::PrimalDualLDLT)
     : //
       // ruiz(preconditioner::RuizEquilibration<T>{dim, n_eq + n_in}),
     ldl{}
     , // old version with alloc
-    H_scaled(dim, dim)
+    H_scaled(dim, hessian_cols(dim, hessian_type))
     , g_scaled(dim)
     , A_scaled(n_eq, dim)
     , C_scaled(n_in, dim)
     , b_scaled(n_eq)
     , u_scaled(n_in)
     , l_scaled(n_in)
+    , u_box_scaled(box_constraints ? dim : 0)
+    , l_box_scaled(box_constraints ? dim : 0)
+    , correction_guess_rhs_g_cache(0)
+    , ldl_cache_rho(0)
+    , ldl_cache_mu_eq(0)
+    , scaled_model_cached(false)
+    , ldl_cached(false)
     , x_prev(dim)
     , y_prev(n_eq)
     , z_prev(n_in)
-    , kkt(dim + n_eq, dim + n_eq)
+    , z_box_prev(box_constraints ? dim : 0)
+    , dense_backend(dense_backend_choice(dense_backend, dim, n_eq, n_in))
+    , kkt(this->dense_backend == DenseBackend::PrimalLDLT ? dim : dim + n_eq,
+          this->dense_backend == DenseBackend::PrimalLDLT ? dim : dim + n_eq)
     , current_bijection_map(n_in)
     , new_bijection_map(n_in)
     , active_set_up(n_in)
     , active_set_low(n_in)
     , active_inequalities(n_in)
+    , active_set_up_box(box_constraints ? dim : 0)
+    , active_set_low_box(box_constraints ? dim : 0)
+    , active_box(box_constraints ? dim : 0)
+    , factorized_box(box_constraints ? dim : 0)
     , Hdx(dim)
     , Cdx(n_in)
     , Adx(n_eq)
@@ -128,12 +194,15 @@ struct Workspace
     , dw_aug(dim + n_eq + n_in)
     , rhs(dim + n_eq + n_in)
     , err(dim + n_eq + n_in)
+    , dz_box(box_constraints ? dim : 0)
     ,
 
     dual_residual_scaled(dim)
     , primal_residual_eq_scaled(n_eq)
     , primal_residual_in_scaled_up(n_in)
     , primal_residual_in_scaled_low(n_in)
+    , primal_residual_box_scaled_up(box_constraints ? dim : 0)
+    , primal_residual_box_scaled_low(box_constraints ? dim : 0)
     ,
 
     primal_residual_in_scaled_up_plus_alphaCdx(n_in)
@@ -146,30 +215,82 @@ struct Workspace
     , is_initialized(false)
 
   {
-    ldl.reserve_uninit(dim + n_eq + n_in);
-    ldl_stack.resize_for_overwrite(
-      proxsuite::linalg::veg::dynstack::StackReq(
-
-        proxsuite::linalg::dense::Ldlt<T>::factorize_req(dim + n_eq + n_in) |
-
-        (proxsuite::linalg::dense::temp_vec_req(
-           proxsuite::linalg::veg::Tag<T>{}, n_eq + n_in) &
-         proxsuite::linalg::veg::dynstack::StackReq{
-           isize{ sizeof(isize) } * (n_eq + n_in), alignof(isize) } &
-         proxsuite::linalg::dense::Ldlt<T>::diagonal_update_req(
-           dim + n_eq + n_in, n_eq + n_in)) |
-
-        (proxsuite::linalg::dense::temp_mat_req(
-           proxsuite::linalg::veg::Tag<T>{}, dim + n_eq + n_in, n_in) &
-         proxsuite::linalg::dense::Ldlt<T>::insert_block_at_req(
-           dim + n_eq + n_in, n_in)) |
-
-        proxsuite::linalg::dense::Ldlt<T>::solve_in_place_req(dim + n_eq +
-                                                              n_in))
-
-        .alloc_req());
+    isize n_box = box_constraints ? dim : 0;
+    if (this->dense_backend == DenseBackend::PrimalLDLT) {
+      ldl.reserve_uninit(dim);
+      ldl_stack.resize_for_overwrite(
+        proxsuite::linalg::veg::dynstack::StackReq(
+
+          (proxsuite::linalg::dense::temp_mat_req(
+             proxsuite::linalg::veg::Tag<T>{}, dim, dim) &
+           proxsuite::linalg::dense::temp_mat_req(
+             proxsuite::linalg::veg::Tag<T>{}, dim, n_in) &
+           proxsuite::linalg::dense::MixedLdlt<T>::factorize_req(dim)) |
+
+          (proxsuite::linalg::dense::temp_vec_req(
+             proxsuite::linalg::veg::Tag<T>{}, n_box) &
+           proxsuite::linalg::veg::dynstack::StackReq{
+             isize{ sizeof(isize) } * n_box, alignof(isize) } &
+           proxsuite::linalg::dense::MixedLdlt<T>::diagonal_update_req(
+             dim, n_box)) |
+
+          (proxsuite::linalg::veg::dynstack::StackReq{
+             isize{ sizeof(isize) } * n_in, alignof(isize) } &
+           proxsuite::linalg::dense::temp_mat_req(
+             proxsuite::linalg::veg::Tag<T>{}, dim, n_in) &
+           proxsuite::linalg::dense::temp_vec_req(
+             proxsuite::linalg::veg::Tag<T>{}, n_in) &
+           proxsuite::linalg::dense::MixedLdlt<T>::rank_r_update_req(dim,
+                                                                     n_in)) |
+
+          (proxsuite::linalg::dense::temp_vec_req(
+             proxsuite::linalg::veg::Tag<T>{}, n_eq) &
+           proxsuite::linalg::dense::MixedLdlt<T>::solve_in_place_req(dim)) |
+
+          // the ruiz equilibration
+          preconditioner::RuizEquilibration<T>::scale_qp_in_place_req(
+            proxsuite::linalg::veg::Tag<T>{}, dim, n_eq, n_in))
+
+          .alloc_req());
+    } else {
+      ldl.reserve_uninit(dim + n_eq + n_in);
+      ldl_stack.resize_for_overwrite(
+        proxsuite::linalg::veg::dynstack::StackReq(
+
+          // the KKT matrix with the active constraints of a warm start is
+          // formed before being factorized
+          (proxsuite::linalg::dense::temp_mat_req(
+             proxsuite::linalg::veg::Tag<T>{},
+             dim + n_eq + n_in,
+             dim + n_eq + n_in) &
+           proxsuite::linalg::dense::MixedLdlt<T>::factorize_req(dim + n_eq +
+                                                                 n_in)) |
+
+          (proxsuite::linalg::dense::temp_vec_req(
+             proxsuite::linalg::veg::Tag<T>{}, n_eq + n_in + n_box) &
+           proxsuite::linalg::veg::dynstack::StackReq{
+             isize{ sizeof(isize) } * (n_eq + n_in + n_box),
+             alignof(isize) } &
+           proxsuite::linalg::dense::MixedLdlt<T>::diagonal_update_req(
+             dim + n_eq + n_in, n_eq + n_in + n_box)) |
+
+          (proxsuite::linalg::dense::temp_mat_req(
+             proxsuite::linalg::veg::Tag<T>{}, dim + n_eq + n_in, n_in) &
+           proxsuite::linalg::dense::MixedLdlt<T>::insert_block_at_req(
+             dim + n_eq + n_in, n_in)) |
+
+          proxsuite::linalg::dense::MixedLdlt<T>::solve_in_place_req(
+            dim + n_eq + n_in) |
+
+          // the ruiz equilibration
+          preconditioner::RuizEquilibration<T>::scale_qp_in_place_req(
+            proxsuite::linalg::veg::Tag<T>{}, dim, n_eq, n_in))
+
+          .alloc_req());
+    }
 
-    alphas.reserve(2 * n_in);
+    alphas.reserve(2 * (n_in + n_box));
+    breakpoints.reserve(2 * (n_in + n_box));
     H_scaled.setZero();
     g_scaled.setZero();
     A_scaled.setZero();
@@ -177,14 +298,21 @@ struct Workspace
     b_scaled.setZero();
     u_scaled.setZero();
     l_scaled.setZero();
+    u_box_scaled.setZero();
+    l_box_scaled.setZero();
     x_prev.setZero();
     y_prev.setZero();
     z_prev.setZero();
+    z_box_prev.setZero();
     kkt.setZero();
     for (isize i = 0; i < n_in; i++) {
       current_bijection_map(i) = i;
       new_bijection_map(i) = i;
     }
+    active_set_up_box.setConstant(false);
+    active_set_low_box.setConstant(false);
+    active_box.setConstant(false);
+    factorized_box.setConstant(false);
     Hdx.setZero();
     Cdx.setZero();
     Adx.setZero();
@@ -192,6 +320,7 @@ struct Workspace
     dw_aug.setZero();
     rhs.setZero();
     err.setZero();
+    dz_box.setZero();
 
     dual_feasibility_rhs_2 = 0;
     correction_guess_rhs_g = 0;
@@ -202,6 +331,8 @@ struct Workspace
     primal_residual_eq_scaled.setZero();
     primal_residual_in_scaled_up.setZero();
     primal_residual_in_scaled_low.setZero();
+    primal_residual_box_scaled_up.setZero();
+    primal_residual_box_scaled_low.setZero();
 
     primal_residual_in_scaled_up_plus_alphaCdx.setZero();
     primal_residual_in_scaled_low_plus_alphaCdx.setZero();
@@ -221,6 +352,8 @@ struct Workspace
     b_scaled.setZero();
     u_scaled.setZero();
     l_scaled.setZero();
+    u_box_scaled.setZero();
+    l_box_scaled.setZero();
     Hdx.setZero();
     Cdx.setZero();
     Adx.setZero();
@@ -228,6 +361,7 @@ struct Workspace
     dw_aug.setZero();
     rhs.setZero();
     err.setZero();
+    dz_box.setZero();
 
     alpha = 1.;
 
@@ -235,6 +369,8 @@ struct Workspace
     primal_residual_eq_scaled.setZero();
     primal_residual_in_scaled_up.setZero();
     primal_residual_in_scaled_low.setZero();
+    primal_residual_box_scaled_up.setZero();
+    primal_residual_box_scaled_low.setZero();
 
     primal_residual_in_scaled_up_plus_alphaCdx.setZero();
     primal_residual_in_scaled_low_plus_alphaCdx.setZero();
@@ -243,12 +379,17 @@ struct Workspace
     x_prev.setZero();
     y_prev.setZero();
     z_prev.setZero();
+    z_box_prev.setZero();
 
     for (isize i = 0; i < n_in; i++) {
       current_bijection_map(i) = i;
       new_bijection_map(i) = i;
       active_inequalities(i) = false;
     }
+    active_set_up_box.setConstant(false);
+    active_set_low_box.setConstant(false);
+    active_box.setConstant(false);
+    factorized_box.setConstant(false);
     constraints_changed = false;
     dirty = false;
     refactorize = false;
@@ -256,6 +397,60 @@ struct Workspace
     is_initialized = false;
     n_c = 0;
   }
+  /*!
+   * Stores a copy of the scaled model, which invalidates the cached
+   * factorization.
+   */
+  void store_scaled_model()
+  {
+    H_scaled_cache = H_scaled;
+    g_scaled_cache = g_scaled;
+    A_scaled_cache = A_scaled;
+    C_scaled_cache = C_scaled;
+    b_scaled_cache = b_scaled;
+    u_scaled_cache = u_scaled;
+    l_scaled_cache = l_scaled;
+    u_box_scaled_cache = u_box_scaled;
+    l_box_scaled_cache = l_box_scaled;
+    correction_guess_rhs_g_cache = correction_guess_rhs_g;
+    scaled_model_cached = true;
+    ldl_cached = false;
+  }
+  /*!
+   * Restores the scaled model from its copy (which must have been stored).
+   */
+  void restore_scaled_model()
+  {
+    H_scaled = H_scaled_cache;
+    g_scaled = g_scaled_cache;
+    A_scaled = A_scaled_cache;
+    C_scaled = C_scaled_cache;
+    b_scaled = b_scaled_cache;
+    u_scaled = u_scaled_cache;
+    l_scaled = l_scaled_cache;
+    u_box_scaled = u_box_scaled_cache;
+    l_box_scaled = l_box_scaled_cache;
+    correction_guess_rhs_g = correction_guess_rhs_g_cache;
+  }
+  /*!
+   * Releases the memory of the copies of the scaled model and of its
+   * factorization.
+   */
+  void release_scaled_model_cache()
+  {
+    H_scaled_cache.resize(0, 0);
+    g_scaled_cache.resize(0);
+    A_scaled_cache.resize(0, 0);
+    C_scaled_cache.resize(0, 0);
+    b_scaled_cache.resize(0);
+    u_scaled_cache.resize(0);
+    l_scaled_cache.resize(0);
+    u_box_scaled_cache.resize(0);
+    l_box_scaled_cache.resize(0);
+    ldl_cache = proxsuite::linalg::dense::MixedLdlt<T>{};
+    scaled_model_cached = false;
+    ldl_cached = false;
+  }
 };
 } // namespace dense
 } // namespace proxqp
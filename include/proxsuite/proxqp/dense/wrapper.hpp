@@ -11,6 +11,7 @@
 #include <proxsuite/proxqp/dense/helpers.hpp>
 #include <proxsuite/proxqp/dense/preconditioner/ruiz.hpp>
 #include <chrono>
+#include <vector>
 
 namespace proxsuite {
 namespace proxqp {
@@ -90,12 +91,32 @@ struct QP
    * @param _dim primal variable dimension.
    * @param _n_eq number of equality constraints.
    * @param _n_in number of inequality constraints.
+   * @param _box_constraints whether the QP has box constraints
+   * l_box <= x <= u_box on the primal variable.
+   * @param _hessian_type structure of the hessian: Dense, Diagonal (only the
+   * diagonal is stored and H may be given as a dim x 1 matrix) or Zero (H is
+   * ignored, e.g., for linear programs).
+   * @param _dense_backend factorization backend: PrimalDualLDLT factorizes the
+   * primal-dual KKT matrix, PrimalLDLT the dim x dim matrix obtained by
+   * eliminating the dual variables (cheaper when there are many more
+   * constraints than variables). PrimalDualLDLT is the default, Automatic
+   * (opt-in) chooses the backend from the dimensions.
    */
-  QP(isize _dim, isize _n_eq, isize _n_in)
-    : results(_dim, _n_eq, _n_in)
+  QP(isize _dim,
+     isize _n_eq,
+     isize _n_in,
+     bool _box_constraints = false,
+     HessianType _hessian_type = HessianType::Dense,
+     DenseBackend _dense_backend = DenseBackend::PrimalDualLDLT)
+    : results(_dim, _n_eq, _n_in, _box_constraints)
     , settings()
-    , model(_dim, _n_eq, _n_in)
-    , work(_dim, _n_eq, _n_in)
+    , model(_dim, _n_eq, _n_in, _box_constraints, _hessian_type)
+    , work(_dim,
+           _n_eq,
+           _n_in,
+           _box_constraints,
+           _hessian_type,
+           _dense_backend)
     , ruiz(preconditioner::RuizEquilibration<T>{ _dim, _n_eq + _n_in })
   {
     work.timer.stop();
@@ -127,6 +148,52 @@ struct QP
             optional<T> rho = nullopt,
             optional<T> mu_eq = nullopt,
             optional<T> mu_in = nullopt)
+  {
+    init(H,
+         g,
+         A,
+         b,
+         C,
+         l,
+         u,
+         nullopt,
+         nullopt,
+         compute_preconditioner,
+         rho,
+         mu_eq,
+         mu_in);
+  }
+  /*!
+   * Setups the QP model (with dense matrix format) with box constraints on the
+   * primal variable and equilibrates it if specified by the user.
+   * @param H quadratic cost input defining the QP model.
+   * @param g linear cost input defining the QP model.
+   * @param A equality constraint matrix input defining the QP model.
+   * @param b equality constraint vector input defining the QP model.
+   * @param C inequality constraint matrix input defining the QP model.
+   * @param l lower inequality constraint vector input defining the QP model.
+   * @param u upper inequality constraint vector input defining the QP model.
+   * @param l_box lower box constraint vector input defining the QP model.
+   * @param u_box upper box constraint vector input defining the QP model.
+   * @param compute_preconditioner boolean parameter for executing or not the
+   * preconditioner.
+   * @param rho proximal step size wrt primal variable.
+   * @param mu_eq proximal step size wrt equality constrained multiplier.
+   * @param mu_in proximal step size wrt inequality constrained multiplier.
+   */
+  void init(optional<MatRef<T>> H,
+            optional<VecRef<T>> g,
+            optional<MatRef<T>> A,
+            optional<VecRef<T>> b,
+            optional<MatRef<T>> C,
+            optional<VecRef<T>> l,
+            optional<VecRef<T>> u,
+            optional<VecRef<T>> l_box,
+            optional<VecRef<T>> u_box,
+            bool compute_preconditioner = true,
+            optional<T> rho = nullopt,
+            optional<T> mu_eq = nullopt,
+            optional<T> mu_in = nullopt)
   {
     // dense case
     if (settings.compute_timings) {
@@ -170,14 +237,35 @@ struct QP
     } else {
       l.reset();
     }
+    if (u_box != nullopt && u_box.value().size() != 0) {
+      PROXSUITE_CHECK_ARGUMENT_SIZE(
+        u_box.value().size(),
+        model.u_box.size(),
+        "the dimension wrt box constrained variables for initializing u_box "
+        "is not valid.");
+    } else {
+      u_box.reset();
+    }
+    if (l_box != nullopt && l_box.value().size() != 0) {
+      PROXSUITE_CHECK_ARGUMENT_SIZE(
+        l_box.value().size(),
+        model.l_box.size(),
+        "the dimension wrt box constrained variables for initializing l_box "
+        "is not valid.");
+    } else {
+      l_box.reset();
+    }
     if (H != nullopt && H.value().size() != 0) {
       PROXSUITE_CHECK_ARGUMENT_SIZE(
         H.value().rows(),
         model.dim,
         "the row dimension for initializing H is not valid.");
+      // a diagonal hessian may also be given as its diagonal only
       PROXSUITE_CHECK_ARGUMENT_SIZE(
         H.value().cols(),
-        model.dim,
+        (model.hessian_type == HessianType::Diagonal && H.value().cols() == 1
+           ? 1
+           : model.dim),
         "the column dimension for initializing H is not valid.");
     } else {
       H.reset();
@@ -234,6 +322,8 @@ struct QP
                                     C,
                                     l,
                                     u,
+                                    l_box,
+                                    u_box,
                                     settings,
                                     model,
                                     work,
@@ -274,9 +364,69 @@ struct QP
               optional<T> rho = nullopt,
               optional<T> mu_eq = nullopt,
               optional<T> mu_in = nullopt)
+  {
+    update(H,
+           g,
+           A,
+           b,
+           C,
+           l,
+           u,
+           nullopt,
+           nullopt,
+           update_preconditioner,
+           rho,
+           mu_eq,
+           mu_in);
+  }
+  /*!
+   * Updates the QP model (with dense matrix format) with box constraints on
+   * the primal variable and re-equilibrates it if specified by the user.
+   * @param H quadratic cost input defining the QP model.
+   * @param g linear cost input defining the QP model.
+   * @param A equality constraint matrix input defining the QP model.
+   * @param b equality constraint vector input defining the QP model.
+   * @param C inequality constraint matrix input defining the QP model.
+   * @param l lower inequality constraint vector input defining the QP model.
+   * @param u upper inequality constraint vector input defining the QP model.
+   * @param l_box lower box constraint vector input defining the QP model.
+   * @param u_box upper box constraint vector input defining the QP model.
+   * @param update_preconditioner bool parameter for updating or not the
+   * preconditioner and the associated scaled model.
+   * @param rho proximal step size wrt primal variable.
+   * @param mu_eq proximal step size wrt equality constrained multiplier.
+   * @param mu_in proximal step size wrt inequality constrained multiplier.
+   * @note The init method should be called before update. If it has not been
+   * done before, init is called depending on the is_initialized flag.
+   */
+  void update(optional<MatRef<T>> H,
+              optional<VecRef<T>> g,
+              optional<MatRef<T>> A,
+              optional<VecRef<T>> b,
+              optional<MatRef<T>> C,
+              optional<VecRef<T>> l,
+              optional<VecRef<T>> u,
+              optional<VecRef<T>> l_box,
+              optional<VecRef<T>> u_box,
+              bool update_preconditioner = true,
+              optional<T> rho = nullopt,
+              optional<T> mu_eq = nullopt,
+              optional<T> mu_in = nullopt)
   {
     if (!work.is_initialized) {
-      init(H, g, A, b, C, l, u, update_preconditioner, rho, mu_eq, mu_in);
+      init(H,
+           g,
+           A,
+           b,
+           C,
+           l,
+           u,
+           l_box,
+           u_box,
+           update_preconditioner,
+           rho,
+           mu_eq,
+           mu_in);
       return;
     }
     // dense case
@@ -294,9 +444,11 @@ struct QP
     }
     const bool matrix_update =
       !(H == nullopt && g == nullopt && A == nullopt && b == nullopt &&
-        C == nullopt && u == nullopt && l == nullopt);
+        C == nullopt && u == nullopt && l == nullopt && u_box == nullopt &&
+        l_box == nullopt);
     if (matrix_update) {
-      proxsuite::proxqp::dense::update(H, g, A, b, C, l, u, model, work);
+      proxsuite::proxqp::dense::update(
+        H, g, A, b, C, l, u, l_box, u_box, model, work);
     }
     proxsuite::proxqp::dense::update_proximal_parameters(
       settings, results, work, rho, mu_eq, mu_in);
@@ -311,6 +463,8 @@ struct QP
                                     optional_MatRef(nullopt),
                                     optional_VecRef(nullopt),
                                     optional_VecRef(nullopt),
+                                    optional_VecRef(nullopt),
+                                    optional_VecRef(nullopt),
                                     settings,
                                     model,
                                     work,
@@ -397,6 +551,9 @@ struct QP
  * criterion.
  * @param eps_duality_gap_rel relative accuracy threshold for the duality-gap
  * criterion.
+ *
+ * The structure of H (zero, diagonal or dense) is detected and the matching
+ * hessian type is used by the solver.
  */
 template<typename T>
 proxqp::Results<T>
@@ -439,7 +596,13 @@ solve(
     n_in = C.value().rows();
   }
 
-  QP<T> Qp(n, n_eq, n_in);
+  HessianType hessian_type = HessianType::Zero;
+  if (H != nullopt && !H.value().isZero(T(0))) {
+    hessian_type = H.value().isDiagonal(T(0)) ? HessianType::Diagonal
+                                              : HessianType::Dense;
+  }
+
+  QP<T> Qp(n, n_eq, n_in, false, hessian_type);
   Qp.settings.initial_guess = initial_guess;
   Qp.settings.check_duality_gap = check_duality_gap;
 
@@ -484,6 +647,60 @@ operator!=(const QP<T>& qp1, const QP<T>& qp2)
   return !(qp1 == qp2);
 }
 
+///
+/// @brief This class stores a batch of dense QP problems, meant to be solved
+/// at once (see proxsuite::proxqp::parallel::solve_in_parallel).
+///
+/*!
+ * Each QP of the batch owns its model, workspace and results. The storage is
+ * reserved once at construction so that the QPs are never relocated when new
+ * problems are appended to the batch.
+ */
+template<typename T>
+struct BatchQP
+{
+  std::vector<QP<T>> qp_vector;
+  isize m_size;
+
+  /*!
+   * Default constructor.
+   * @param batch_size maximal number of QPs held by the batch.
+   */
+  explicit BatchQP(std::size_t batch_size)
+    : m_size(0)
+  {
+    qp_vector.reserve(batch_size);
+  }
+
+  /*!
+   * Constructs in place a new QP at the end of the batch and returns it.
+   * @param dim primal variable dimension.
+   * @param n_eq number of equality constraints.
+   * @param n_in number of inequality constraints.
+   */
+  QP<T>& init_qp_in_place(isize dim, isize n_eq, isize n_in)
+  {
+    PROXSUITE_THROW_PRETTY(qp_vector.size() == qp_vector.capacity(),
+                           std::length_error,
+                           "the batch is already full.");
+    qp_vector.emplace_back(dim, n_eq, n_in);
+    ++m_size;
+    return qp_vector.back();
+  }
+
+  /*!
+   * Returns the i-th QP of the batch.
+   * @param i index of the QP.
+   */
+  QP<T>& get(isize i) { return qp_vector.at(std::size_t(i)); }
+  const QP<T>& get(isize i) const { return qp_vector.at(std::size_t(i)); }
+
+  /*!
+   * Returns the number of QPs held by the batch.
+   */
+  isize size() const { return m_size; }
+};
+
 } // namespace dense
 } // namespace proxqp
 } // namespace proxsuite
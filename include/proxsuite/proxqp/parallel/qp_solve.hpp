@@ -0,0 +1,168 @@
+//
+// Copyright (c) 2022 INRIA
+//
+/**
+ * @file qp_solve.hpp
+ */
+
+#ifndef PROXSUITE_PROXQP_PARALLEL_QPSOLVE_HPP
+#define PROXSUITE_PROXQP_PARALLEL_QPSOLVE_HPP
+
+#include "proxsuite/helpers/parallel.hpp"
+#include "proxsuite/proxqp/dense/wrapper.hpp"
+#include "proxsuite/proxqp/sparse/wrapper.hpp"
+#include <vector>
+
+namespace proxsuite {
+namespace proxqp {
+namespace parallel {
+
+namespace detail {
+template<typename QPType>
+void
+solve_qp(QPType& qp)
+{
+  qp.solve();
+}
+template<typename QPType>
+void
+solve_qp(QPType* qp)
+{
+  qp->solve();
+}
+
+/*!
+ * Solves the QPs qps[0], ..., qps[batch_size-1], dispatching them dynamically
+ * over the threads of the team: as a QP may converge much faster than another
+ * one, each thread picks the next unsolved QP as soon as it is done with its
+ * current one. Every QP owns its preallocated workspace, hence no allocation
+ * nor synchronization is performed inside the parallel region.
+ */
+template<typename QPType>
+void
+solve_in_parallel_impl(QPType* qps,
+                       const std::ptrdiff_t batch_size,
+                       const optional<std::size_t> num_threads)
+{
+  std::size_t NUM_THREADS = helpers::get_default_num_threads();
+  if (num_threads != nullopt) {
+    NUM_THREADS = num_threads.value();
+  }
+  PROXSUITE_THROW_PRETTY(NUM_THREADS == 0,
+                         std::invalid_argument,
+                         "the number of threads should be positive.");
+
+  // the number of threads is given to this parallel region only, leaving the
+  // OpenMP settings of the caller untouched
+  std::ptrdiff_t i = 0;
+#ifdef PROXSUITE_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic, 1)                                  \
+  num_threads(static_cast<int>(NUM_THREADS))
+#endif
+  for (i = 0; i < batch_size; i++) {
+    detail::solve_qp(qps[i]);
+  }
+}
+} // namespace detail
+
+/*!
+ * Solves in parallel a vector of dense QPs, which must have been initialized
+ * beforehand. The results are stored in the results field of each QP.
+ * @param qps vector of dense QPs.
+ * @param num_threads number of threads used (by default, the number of
+ * threads returned by omp_get_max_threads).
+ */
+template<typename T>
+void
+solve_in_parallel(std::vector<proxqp::dense::QP<T>>& qps,
+                  const optional<std::size_t> num_threads = nullopt)
+{
+  detail::solve_in_parallel_impl(
+    qps.data(), static_cast<std::ptrdiff_t>(qps.size()), num_threads);
+}
+
+/*!
+ * Solves in parallel a vector of dense QPs, which must have been initialized
+ * beforehand, and are held by pointers (e.g., by the python bindings). The
+ * results are stored in the results field of each QP.
+ * @param qps vector of pointers to dense QPs.
+ * @param num_threads number of threads used (by default, the number of
+ * threads returned by omp_get_max_threads).
+ */
+template<typename T>
+void
+solve_in_parallel(std::vector<proxqp::dense::QP<T>*>& qps,
+                  const optional<std::size_t> num_threads = nullopt)
+{
+  detail::solve_in_parallel_impl(
+    qps.data(), static_cast<std::ptrdiff_t>(qps.size()), num_threads);
+}
+
+/*!
+ * Solves in parallel a batch of dense QPs, which must have been initialized
+ * beforehand. The results are stored in the results field of each QP.
+ * @param qps batch of dense QPs.
+ * @param num_threads number of threads used (by default, the number of
+ * threads returned by omp_get_max_threads).
+ */
+template<typename T>
+void
+solve_in_parallel(proxqp::dense::BatchQP<T>& qps,
+                  const optional<std::size_t> num_threads = nullopt)
+{
+  solve_in_parallel(qps.qp_vector, num_threads);
+}
+
+/*!
+ * Solves in parallel a vector of sparse QPs, which must have been initialized
+ * beforehand. The results are stored in the results field of each QP.
+ * @param qps vector of sparse QPs.
+ * @param num_threads number of threads used (by default, the number of
+ * threads returned by omp_get_max_threads).
+ */
+template<typename T, typename I>
+void
+solve_in_parallel(std::vector<proxqp::sparse::QP<T, I>>& qps,
+                  const optional<std::size_t> num_threads = nullopt)
+{
+  detail::solve_in_parallel_impl(
+    qps.data(), static_cast<std::ptrdiff_t>(qps.size()), num_threads);
+}
+
+/*!
+ * Solves in parallel a vector of sparse QPs, which must have been initialized
+ * beforehand, and are held by pointers (e.g., by the python bindings). The
+ * results are stored in the results field of each QP.
+ * @param qps vector of pointers to sparse QPs.
+ * @param num_threads number of threads used (by default, the number of
+ * threads returned by omp_get_max_threads).
+ */
+template<typename T, typename I>
+void
+solve_in_parallel(std::vector<proxqp::sparse::QP<T, I>*>& qps,
+                  const optional<std::size_t> num_threads = nullopt)
+{
+  detail::solve_in_parallel_impl(
+    qps.data(), static_cast<std::ptrdiff_t>(qps.size()), num_threads);
+}
+
+/*!
+ * Solves in parallel a batch of sparse QPs, which must have been initialized
+ * beforehand. The results are stored in the results field of each QP.
+ * @param qps batch of sparse QPs.
+ * @param num_threads number of threads used (by default, the number of
+ * threads returned by omp_get_max_threads).
+ */
+template<typename T, typename I>
+void
+solve_in_parallel(proxqp::sparse::BatchQP<T, I>& qps,
+                  const optional<std::size_t> num_threads = nullopt)
+{
+  solve_in_parallel(qps.qp_vector, num_threads);
+}
+
+} // namespace parallel
+} // namespace proxqp
+} // namespace proxsuite
+
+#endif /* end of include guard PROXSUITE_PROXQP_PARALLEL_QPSOLVE_HPP */
@@ -0,0 +1,168 @@
+//
+// Copyright (c) 2022 INRIA
+//
+/**
+ * @file profiling.hpp
+ */
+#ifndef PROXSUITE_PROXQP_PROFILING_HPP
+#define PROXSUITE_PROXQP_PROFILING_HPP
+
+#include <chrono>
+#include <type_traits>
+#include <proxsuite/linalg/veg/type_traits/core.hpp>
+
+namespace proxsuite {
+namespace proxqp {
+///
+/// @brief This class stores the breakdown of the time spent (in microseconds)
+/// and of the operations performed by the phases of the solver.
+///
+/*!
+ * Profile of the last setup and solve of the dense and sparse solvers. It is
+ * only filled when proxsuite is compiled with PROXSUITE_ENABLE_PROFILING
+ * (otherwise the instrumentation is compiled out and it remains zero).
+ * The equilibration statistics are those of the last setup (init or update),
+ * the others are those of the last solve.
+ */
+template<typename T>
+struct Profile
+{
+  T equilibration_time;
+  //// initial factorizations of the KKT matrix
+  T factorization_time;
+  linalg::veg::isize factorizations;
+  //// refactorizations of the KKT matrix (e.g., after a change of rho, or when
+  //// the iterative refinement stalls)
+  T refactorization_time;
+  linalg::veg::isize refactorizations;
+  //// updates of the factorization after a change of mu_eq or mu_in, and sum
+  //// of the ranks of the corresponding diagonal updates
+  T mu_update_time;
+  linalg::veg::isize mu_update_rank;
+  //// updates of the factorization after a change of the active set
+  T active_set_change_time;
+  linalg::veg::isize active_set_insertions;
+  linalg::veg::isize active_set_deletions;
+  T line_search_time;
+  linalg::veg::isize line_searches;
+  //// solves of the KKT system with iterative refinement, and total number of
+  //// refinement steps after the first solves
+  T iterative_refinement_time;
+  linalg::veg::isize iterative_refinement_steps;
+  //// evaluations of the primal and dual residuals of the outer iterations
+  T residual_time;
+  linalg::veg::isize residual_evaluations;
+
+  Profile() { clear(); }
+  /*!
+   * Resets all the statistics.
+   */
+  void clear()
+  {
+    equilibration_time = 0;
+    clear_solve_statistics();
+  }
+  /*!
+   * Resets the statistics of the solve, keeping those of the setup.
+   */
+  void clear_solve_statistics()
+  {
+    factorization_time = 0;
+    factorizations = 0;
+    refactorization_time = 0;
+    refactorizations = 0;
+    mu_update_time = 0;
+    mu_update_rank = 0;
+    active_set_change_time = 0;
+    active_set_insertions = 0;
+    active_set_deletions = 0;
+    line_search_time = 0;
+    line_searches = 0;
+    iterative_refinement_time = 0;
+    iterative_refinement_steps = 0;
+    residual_time = 0;
+    residual_evaluations = 0;
+  }
+};
+
+template<typename T>
+bool
+operator==(const Profile<T>& profile1, const Profile<T>& profile2)
+{
+  bool value =
+    profile1.equilibration_time == profile2.equilibration_time &&
+    profile1.factorization_time == profile2.factorization_time &&
+    profile1.factorizations == profile2.factorizations &&
+    profile1.refactorization_time == profile2.refactorization_time &&
+    profile1.refactorizations == profile2.refactorizations &&
+    profile1.mu_update_time == profile2.mu_update_time &&
+    profile1.mu_update_rank == profile2.mu_update_rank &&
+    profile1.active_set_change_time == profile2.active_set_change_time &&
+    profile1.active_set_insertions == profile2.active_set_insertions &&
+    profile1.active_set_deletions == profile2.active_set_deletions &&
+    profile1.line_search_time == profile2.line_search_time &&
+    profile1.line_searches == profile2.line_searches &&
+    profile1.iterative_refinement_time == profile2.iterative_refinement_time &&
+    profile1.iterative_refinement_steps ==
+      profile2.iterative_refinement_steps &&
+    profile1.residual_time == profile2.residual_time &&
+    profile1.residual_evaluations == profile2.residual_evaluations;
+  return value;
+}
+
+template<typename T>
+bool
+operator!=(const Profile<T>& profile1, const Profile<T>& profile2)
+{
+  return !(profile1 == profile2);
+}
+
+namespace detail {
+/*!
+ * Adds to the given counter the time (in microseconds) elapsed between its
+ * construction and its destruction.
+ */
+template<typename T>
+struct ProfileScope
+{
+  explicit ProfileScope(T& time_)
+    : time(time_)
+    , start(std::chrono::steady_clock::now())
+  {
+  }
+  ~ProfileScope()
+  {
+    time += static_cast<T>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::steady_clock::now() - start)
+                             .count()) *
+            T(1e-3);
+  }
+  ProfileScope(ProfileScope const&) = delete;
+  ProfileScope& operator=(ProfileScope const&) = delete;
+
+  T& time;
+  std::chrono::time_point<std::chrono::steady_clock> start;
+};
+} // namespace detail
+
+} // namespace proxqp
+} // namespace proxsuite
+
+#define PROXSUITE_PROFILE_CAT_IMPL(a, b) a##b
+#define PROXSUITE_PROFILE_CAT(a, b) PROXSUITE_PROFILE_CAT_IMPL(a, b)
+
+#ifdef PROXSUITE_ENABLE_PROFILING
+/// Accumulates into the time counter the time spent until the end of the
+/// enclosing scope.
+#define PROXSUITE_PROFILE_SCOPE(time)                                          \
+  ::proxsuite::proxqp::detail::ProfileScope<                                   \
+    typename std::decay<decltype(time)>::type>                                 \
+  PROXSUITE_PROFILE_CAT(proxsuite_profile_scope_, __LINE__)(time)
+/// Adds n to the counter.
+#define PROXSUITE_PROFILE_COUNT(counter, n) ((counter) += (n))
+#else
+#define PROXSUITE_PROFILE_SCOPE(time) static_cast<void>(0)
+#define PROXSUITE_PROFILE_COUNT(counter, n) static_cast<void>(0)
+#endif
+
+#endif /* end of include guard PROXSUITE_PROXQP_PROFILING_HPP */
@@ -12,6 +12,7 @@
 #include <proxsuite/linalg/veg/type_traits/core.hpp>
 #include <proxsuite/linalg/veg/vec.hpp>
 #include <proxsuite/proxqp/settings.hpp>
+#include <proxsuite/proxqp/profiling.hpp>
 #include "proxsuite/proxqp/status.hpp"
 #include "proxsuite/proxqp/sparse/fwd.hpp"
 
@@ -52,6 +53,22 @@ struct Info
   T duality_gap;
   //// sparse backend used by solver, either CholeskySparse or MatrixFree
   SparseBackend sparse_backend;
+  //// number of consecutive setups of the sparse solver which reused the
+  //// symbolic factorization of the KKT matrix (0 when it has just been
+  //// computed). It is not reset between solves.
+  sparse::isize symbolic_factorization_reuses;
+  //// number of non zeros of the LDLT factor of the KKT matrix with the chosen
+  //// sparse ordering (sparse backend only)
+  sparse::isize lnnz;
+  //// whether the solver fell back to a full precision factorization of the
+  //// KKT matrix during the last solve (mixed precision mode only)
+  bool mixed_precision_fallback;
+  //// maximal number of iterative refinement steps needed by a linear system
+  //// solve during the last solve (direct factorization backends only)
+  sparse::isize iterative_refinement_steps;
+  //// breakdown of the time spent in the phases of the last setup and solve
+  //// (only filled when compiled with PROXSUITE_ENABLE_PROFILING)
+  Profile<T> profile;
 };
 ///
 /// @brief This class stores all the results of PROXQP solvers with sparse and
@@ -69,6 +86,7 @@ struct Results
   sparse::Vec<T> x;
   sparse::Vec<T> y;
   sparse::Vec<T> z;
+  sparse::Vec<T> z_box; // dual solution of the box constraints (dense backend)
 
   Info<T> info;
 
@@ -78,16 +96,23 @@ struct Results
    * @param dim dimension of the primal variable.
    * @param n_eq dimension of the number of equality constraints.
    * @param n_in dimension of the number of inequality constraints.
+   * @param box_constraints whether the problem has box constraints on the
+   * primal variable.
    */
-  Results(isize dim = 0, isize n_eq = 0, isize n_in = 0)
+  Results(isize dim = 0,
+          isize n_eq = 0,
+          isize n_in = 0,
+          bool box_constraints = false)
     : x(dim)
     , y(n_eq)
     , z(n_in)
+    , z_box(box_constraints ? dim : 0)
   {
 
     x.setZero();
     y.setZero();
     z.setZero();
+    z_box.setZero();
 
     info.rho = 1e-6;
     info.mu_eq_inv = 1e3;
@@ -108,6 +133,10 @@ struct Results
     info.duality_gap = 0.;
     info.status = QPSolverOutput::PROXQP_NOT_RUN;
     info.sparse_backend = SparseBackend::Automatic;
+    info.symbolic_factorization_reuses = 0;
+    info.lnnz = 0;
+    info.mixed_precision_fallback = false;
+    info.iterative_refinement_steps = 0;
   }
   /*!
    * cleanups the Result variables and set the info variables to their initial
@@ -118,6 +147,7 @@ struct Results
     x.setZero();
     y.setZero();
     z.setZero();
+    z_box.setZero();
     cold_start(settings);
   }
   void cleanup_statistics()
@@ -135,6 +165,8 @@ struct Results
     info.duality_gap = 0.;
     info.status = QPSolverOutput::PROXQP_MAX_ITER_REACHED;
     info.sparse_backend = SparseBackend::Automatic;
+    info.mixed_precision_fallback = false;
+    info.iterative_refinement_steps = 0;
   }
   void cold_start(optional<Settings<T>> settings = nullopt)
   {
@@ -158,6 +190,7 @@ struct Results
     x.setZero();
     y.setZero();
     z.setZero();
+    z_box.setZero();
     cleanup_statistics();
   }
 };
@@ -166,6 +199,7 @@ template<typename T>
 bool
 operator==(const Info<T>& info1, const Info<T>& info2)
 {
+  // the profile is left out, as its timings differ between identical solves
   bool value =
     info1.mu_eq == info2.mu_eq && info1.mu_eq_inv == info2.mu_eq_inv &&
     info1.mu_in == info2.mu_in && info1.mu_in_inv == info2.mu_in_inv &&
@@ -177,7 +211,12 @@ operator==(const Info<T>& info1, const Info<T>& info2)
     info1.solve_time == info2.solve_time && info1.run_time == info2.run_time &&
     info1.objValue == info2.objValue && info1.pri_res == info2.pri_res &&
     info1.dua_res == info2.dua_res && info1.duality_gap == info2.duality_gap &&
-    info1.duality_gap == info2.duality_gap;
+    info1.duality_gap == info2.duality_gap &&
+    info1.symbolic_factorization_reuses ==
+      info2.symbolic_factorization_reuses &&
+    info1.lnnz == info2.lnnz &&
+    info1.mixed_precision_fallback == info2.mixed_precision_fallback &&
+    info1.iterative_refinement_steps == info2.iterative_refinement_steps;
   return value;
 }
 
@@ -195,7 +234,8 @@ operator==(const Results<T>& results1, const Results<T>& results2)
   bool value = results1.x == results2.x && results1.y == results2.y &&
                //  results1.z == results2.z && results1.active_constraints ==
                //  results2.active_constraints &&
-               results1.z == results2.z && results1.info == results2.info;
+               results1.z == results2.z && results1.z_box == results2.z_box &&
+               results1.info == results2.info;
   return value;
 }
 
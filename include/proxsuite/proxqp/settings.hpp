@@ -11,6 +11,7 @@
 #include <proxsuite/proxqp/status.hpp>
 #include <proxsuite/proxqp/dense/views.hpp>
 #include <proxsuite/proxqp/sparse/fwd.hpp>
+#include <proxsuite/linalg/sparse/core.hpp>
 
 namespace proxsuite {
 namespace proxqp {
@@ -18,9 +19,10 @@ namespace proxqp {
 // Sparse backend specifications
 enum struct SparseBackend
 {
-  Automatic,      // the solver will select the appropriate sparse backend.
-  SparseCholesky, // sparse cholesky backend.
-  MatrixFree,     // iterative matrix free sparse backend.
+  Automatic,          // the solver will select the appropriate sparse backend.
+  SparseCholesky,     // sparse cholesky backend.
+  MatrixFree,         // iterative matrix free sparse backend.
+  SupernodalCholesky, // supernodal cholesky backend, with dense panels.
 };
 
 inline std::ostream&
@@ -30,12 +32,37 @@ operator<<(std::ostream& os, const SparseBackend& sparse_backend)
     os << "Automatic";
   else if (sparse_backend == SparseBackend::SparseCholesky) {
     os << "SparseCholesky";
+  } else if (sparse_backend == SparseBackend::SupernodalCholesky) {
+    os << "SupernodalCholesky";
   } else {
     os << "MatrixFree";
   }
   return os;
 }
 
+// Preconditioner of the MINRES iterations of the MatrixFree sparse backend
+enum struct MatrixFreePreconditioner
+{
+  Identity,       // no preconditioning.
+  BlockJacobi,    // diagonal of H + rho I, and diagonal of the Schur complement
+                  // of the constraints.
+  IncompleteLdlt, // LDLT factorization of the KKT matrix without fill-in,
+                  // with the absolute value of D.
+};
+
+inline std::ostream&
+operator<<(std::ostream& os, const MatrixFreePreconditioner& preconditioner)
+{
+  if (preconditioner == MatrixFreePreconditioner::Identity)
+    os << "Identity";
+  else if (preconditioner == MatrixFreePreconditioner::BlockJacobi) {
+    os << "BlockJacobi";
+  } else {
+    os << "IncompleteLdlt";
+  }
+  return os;
+}
+
 ///
 /// @brief This class defines the settings of PROXQP solvers with sparse and
 /// dense backends.
@@ -96,6 +123,11 @@ struct Settings
   bool bcl_update;
 
   SparseBackend sparse_backend;
+  proxsuite::linalg::sparse::Ordering sparse_ordering;
+  MatrixFreePreconditioner matrix_free_preconditioner;
+  bool mixed_precision;
+  bool cache_scaled_model;
+  bool preconditioner_warm_start;
   /*!
    * Default constructor.
    * @param default_rho default rho parameter of result class
@@ -155,6 +187,28 @@ struct Settings
    * used.
    * @param sparse_backend Default automatic. User can choose between sparse
    * cholesky or iterative matrix free sparse backend.
+   * @param sparse_ordering Default amd. Fill-reducing ordering applied to the
+   * KKT matrix by the sparse factorization backends, either approximate
+   * minimum degree, nested dissection or natural (no permutation). The
+   * user_provided ordering is not supported and is rejected at setup.
+   * @param matrix_free_preconditioner Default BlockJacobi. Preconditioner of
+   * the MINRES iterations of the MatrixFree sparse backend.
+   * @param mixed_precision Default false. If set to true, the LDLT
+   * factorization of the KKT matrix is stored and updated in single precision
+   * while the iterative refinement is performed in the precision of the
+   * problem (dense backend and SparseCholesky sparse backend). The solver
+   * falls back to a full precision factorization when the iterative
+   * refinement stalls.
+   * @param cache_scaled_model Default false. Dense backend: if set to true,
+   * the workspace keeps a copy of the scaled model and of the first
+   * factorization of its KKT matrix, which the following solves of the same
+   * model restore instead of equilibrating and factorizing it again (at the
+   * cost of the memory of these copies). When it is enabled after init, the
+   * copies are stored by the next solve.
+   * @param preconditioner_warm_start Default false. Sparse backend: if set to
+   * true, the equilibration computed by an update of the preconditioner starts
+   * from the previous one instead of the identity, so that it needs few
+   * iterations when the matrices change slightly.
    */
 
   Settings(
@@ -199,7 +253,14 @@ struct Settings
     T eps_primal_inf = 1.E-4,
     T eps_dual_inf = 1.E-4,
     bool bcl_update = true,
-    SparseBackend sparse_backend = SparseBackend::Automatic)
+    SparseBackend sparse_backend = SparseBackend::Automatic,
+    proxsuite::linalg::sparse::Ordering sparse_ordering =
+      proxsuite::linalg::sparse::Ordering::amd,
+    MatrixFreePreconditioner matrix_free_preconditioner =
+      MatrixFreePreconditioner::BlockJacobi,
+    bool mixed_precision = false,
+    bool cache_scaled_model = false,
+    bool preconditioner_warm_start = false)
     : default_rho(default_rho)
     , default_mu_eq(default_mu_eq)
     , default_mu_in(default_mu_in)
@@ -238,6 +299,11 @@ struct Settings
     , eps_dual_inf(eps_dual_inf)
     , bcl_update(bcl_update)
     , sparse_backend(sparse_backend)
+    , sparse_ordering(sparse_ordering)
+    , matrix_free_preconditioner(matrix_free_preconditioner)
+    , mixed_precision(mixed_precision)
+    , cache_scaled_model(cache_scaled_model)
+    , preconditioner_warm_start(preconditioner_warm_start)
   {
   }
 };
@@ -285,7 +351,13 @@ operator==(const Settings<T>& settings1, const Settings<T>& settings2)
     settings1.eps_primal_inf == settings2.eps_primal_inf &&
     settings1.eps_dual_inf == settings2.eps_dual_inf &&
     settings1.bcl_update == settings2.bcl_update &&
-    settings1.sparse_backend == settings2.sparse_backend;
+    settings1.sparse_backend == settings2.sparse_backend &&
+    settings1.sparse_ordering == settings2.sparse_ordering &&
+    settings1.matrix_free_preconditioner ==
+      settings2.matrix_free_preconditioner &&
+    settings1.mixed_precision == settings2.mixed_precision &&
+    settings1.cache_scaled_model == settings2.cache_scaled_model &&
+    settings1.preconditioner_warm_start == settings2.preconditioner_warm_start;
   return value;
 }
 
@@ -180,13 +180,18 @@ qp_setup(QpView<T, I> qp,
       break;
   }
   // performs scaling according to options chosen + stored model value
+  results.info.profile.clear();
+  bool reuse_symbolic_factorization =
+    !work.internal.do_symbolic_fact &&
+    work.internal.ordering == settings.sparse_ordering;
   work.setup_impl(
     qp,
     data,
     settings,
     execute_preconditioner_or_not,
     precond,
-    P::scale_qp_in_place_req(proxsuite::linalg::veg::Tag<T>{}, n, n_eq, n_in));
+    P::scale_qp_in_place_req(proxsuite::linalg::veg::Tag<T>{}, n, n_eq, n_in),
+    results.info.profile);
   switch (settings.initial_guess) { // the following is used when initiliazing
                                     // the Qp object or updating it
     case InitialGuessStatus::EQUALITY_CONSTRAINED_INITIAL_GUESS: {
@@ -234,9 +239,18 @@ qp_setup(QpView<T, I> qp,
       break;
     }
   }
+  if (reuse_symbolic_factorization) {
+    ++results.info.symbolic_factorization_reuses;
+  } else {
+    results.info.symbolic_factorization_reuses = 0;
+  }
+  results.info.lnnz = work.lnnz;
   // if user chose Automatic as sparse backend, store in results which backend
   // of SparseCholesky or MatrixFree had been used
-  if (settings.sparse_backend == SparseBackend::Automatic) {
+  if (work.internal.linear_operator != nullptr) {
+    // only the MatrixFree backend applies to linear operators
+    results.info.sparse_backend = SparseBackend::MatrixFree;
+  } else if (settings.sparse_backend == SparseBackend::Automatic) {
     if (work.internal.do_ldlt) {
       results.info.sparse_backend = SparseBackend::SparseCholesky;
     } else {
@@ -277,6 +291,39 @@ have_same_structure(proxsuite::linalg::sparse::MatRef<T, I> a,
   }
   return true;
 }
+/*!
+ * Checks whether the matrices of the qp have the same sparsity structure as
+ * the KKT matrix stored in the model.
+ *
+ * @param qp view on the qp problem.
+ * @param data solver's model.
+ */
+template<typename T, typename I>
+auto
+have_same_structure(QpView<T, I> qp, Model<T, I> const& data) -> bool
+{
+  if (data.kkt_col_ptrs_unscaled.len() == 0 || qp.H.nrows() != data.dim ||
+      qp.AT.ncols() != data.n_eq || qp.CT.ncols() != data.n_in ||
+      qp.H.nnz() != data.H_nnz || qp.AT.nnz() != data.A_nnz ||
+      qp.CT.nnz() != data.C_nnz) {
+    return false;
+  }
+  isize n = data.dim;
+  auto kkt_top_n_rows =
+    detail::top_rows_unchecked(proxsuite::linalg::veg::unsafe,
+                               data.kkt_unscaled(),
+                               n);
+  return have_same_structure(
+           detail::middle_cols(kkt_top_n_rows, 0, n, data.H_nnz), qp.H) &&
+         have_same_structure(
+           detail::middle_cols(kkt_top_n_rows, n, data.n_eq, data.A_nnz),
+           qp.AT) &&
+         have_same_structure(detail::middle_cols(kkt_top_n_rows,
+                                                 n + data.n_eq,
+                                                 data.n_in,
+                                                 data.C_nnz),
+                             qp.CT);
+}
 /*!
  * Copies matrix b elements into matrix a.
  *
@@ -0,0 +1,182 @@
+//
+// Copyright (c) 2022-2023 INRIA
+//
+/** \file */
+#ifndef PROXSUITE_PROXQP_SPARSE_LINEAR_OPERATOR_HPP
+#define PROXSUITE_PROXQP_SPARSE_LINEAR_OPERATOR_HPP
+
+#include <algorithm>
+#include <functional>
+#include "proxsuite/proxqp/sparse/fwd.hpp"
+
+namespace proxsuite {
+namespace proxqp {
+namespace sparse {
+
+///
+/// @brief This class defines the matrices of a QP through their action on
+/// vectors.
+///
+/*!
+ * Linear operators defining the matrices H, A and C of a QP which are never
+ * assembled. Each callable writes the product of the matrix with its first
+ * argument in its second argument (e.g., out = H * in). The QP is then solved
+ * with the MatrixFree backend.
+ */
+template<typename T>
+struct LinearOperator
+{
+  using Apply =
+    std::function<void(VecRef<T> /*in*/, Eigen::Ref<Vec<T>> /*out*/)>;
+
+  Apply H;  // product with the quadratic cost (may be empty for LPs)
+  Apply A;  // product with the equality constraint matrix
+  Apply AT; // product with the transpose of the equality constraint matrix
+  Apply C;  // product with the inequality constraint matrix
+  Apply CT; // product with the transpose of the inequality constraint matrix
+  Vec<T> H_diagonal; // optional diagonal of H, used for equilibrating the
+                     // problem and preconditioning the MINRES iterations
+};
+
+namespace detail {
+
+/*!
+ * Linear operators of the scaled QP: given the equilibration delta = (D, E, F)
+ * and the cost scaling c, it applies c D H D, E A D, D A.T E, F C D and
+ * D C.T F. The products are accumulated in the output vector, as done by the
+ * sparse matrix vector products of the solver.
+ */
+template<typename T>
+struct ScaledLinearOperator
+{
+  LinearOperator<T> op;
+  Vec<T> delta;
+  T c;
+  isize n;
+  isize n_eq;
+  isize n_in;
+  Vec<T> H_diagonal_scaled; // empty when the diagonal of H is not provided
+
+  // buffers for the calls to the user operators
+  mutable Vec<T> in_work;
+  mutable Vec<T> out_work;
+  mutable Vec<T> z_work;
+
+  ScaledLinearOperator(LinearOperator<T> op_,
+                       Vec<T> const& delta_,
+                       T c_,
+                       isize n_,
+                       isize n_eq_,
+                       isize n_in_)
+    : op(std::move(op_))
+    , delta(delta_)
+    , c(c_)
+    , n(n_)
+    , n_eq(n_eq_)
+    , n_in(n_in_)
+  {
+    isize max_dim = std::max({ n, n_eq, n_in });
+    in_work.resize(max_dim);
+    out_work.resize(max_dim);
+    z_work.resize(n_in);
+    if (op.H_diagonal.rows() == n) {
+      H_diagonal_scaled =
+        c * delta.head(n).cwiseProduct(delta.head(n)).cwiseProduct(
+              op.H_diagonal);
+    }
+  }
+
+  template<typename Out, typename In>
+  void apply_add(typename LinearOperator<T>::Apply const& f,
+                 isize in_offset,
+                 isize in_dim,
+                 isize out_offset,
+                 isize out_dim,
+                 T factor,
+                 Out&& out,
+                 In const& in) const
+  {
+    if (!f || in_dim == 0 || out_dim == 0) {
+      return;
+    }
+    auto in_ = in_work.head(in_dim);
+    auto out_ = out_work.head(out_dim);
+    in_ = delta.segment(in_offset, in_dim).cwiseProduct(in);
+    out_.setZero();
+    f(in_, out_);
+    out += factor * delta.segment(out_offset, out_dim).cwiseProduct(out_);
+  }
+
+  // out += c D H D x
+  template<typename Out, typename In>
+  void H_add(Out&& out, In const& x) const
+  {
+    apply_add(op.H, 0, n, 0, n, c, out, x);
+  }
+  // out += E A D x
+  template<typename Out, typename In>
+  void A_add(Out&& out, In const& x) const
+  {
+    apply_add(op.A, 0, n, n, n_eq, T(1), out, x);
+  }
+  // out += D A.T E y
+  template<typename Out, typename In>
+  void AT_add(Out&& out, In const& y) const
+  {
+    apply_add(op.AT, n, n_eq, 0, n, T(1), out, y);
+  }
+  // out += F C D x
+  template<typename Out, typename In>
+  void C_add(Out&& out, In const& x) const
+  {
+    apply_add(op.C, 0, n, n + n_eq, n_in, T(1), out, x);
+  }
+  // out += D C.T F z
+  template<typename Out, typename In>
+  void CT_add(Out&& out, In const& z) const
+  {
+    apply_add(op.CT, n + n_eq, n_in, 0, n, T(1), out, z);
+  }
+  // out += D C.T F z_masked, where z_masked keeps the entries i of z such
+  // that keep(i) is true
+  template<typename Out, typename In, typename Keep>
+  void CT_add_masked(Out&& out, In const& z, Keep const& keep) const
+  {
+    for (isize i = 0; i < n_in; ++i) {
+      z_work[i] = keep(i) ? T(z[i]) : T(0);
+    }
+    CT_add(out, z_work);
+  }
+
+  /*!
+   * Adds the product of the active part of the kkt matrix (without the
+   * proximal terms) with rhs to dst.
+   */
+  template<typename Dst, typename Rhs, typename Active>
+  void kkt_add(Dst&& dst, Rhs const& rhs, Active const& active) const
+  {
+    auto rhs_x = rhs.head(n);
+    H_add(dst.head(n), rhs_x);
+    A_add(dst.segment(n, n_eq), rhs_x);
+    AT_add(dst.head(n), rhs.segment(n, n_eq));
+    if (n_in > 0) {
+      auto rhs_z = rhs.tail(n_in);
+      CT_add_masked(
+        dst.head(n), rhs_z, [&](isize i) -> bool { return active[i]; });
+      z_work.setZero();
+      C_add(z_work, rhs_x);
+      for (isize i = 0; i < n_in; ++i) {
+        if (active[i]) {
+          dst[n + n_eq + i] += z_work[i];
+        }
+      }
+    }
+  }
+};
+
+} // namespace detail
+} // namespace sparse
+} // namespace proxqp
+} // namespace proxsuite
+
+#endif /* end of include guard PROXSUITE_PROXQP_SPARSE_LINEAR_OPERATOR_HPP */
@@ -7,6 +7,7 @@
 #define PROXSUITE_PROXQP_SPARSE_PRECOND_RUIZ_HPP
 
 #include "proxsuite/proxqp/sparse/fwd.hpp"
+#include "proxsuite/helpers/parallel.hpp"
 
 namespace proxsuite {
 namespace proxqp {
@@ -20,106 +21,186 @@ enum struct Symmetry
 };
 
 namespace detail {
-template<typename T, typename I>
-void
-rowwise_infty_norm(T* row_norm, proxsuite::linalg::sparse::MatRef<T, I> m)
-{
-  using namespace proxsuite::linalg::sparse::util;
-
-  I const* mi = m.row_indices();
-  T const* mx = m.values();
-
-  for (usize j = 0; j < usize(m.ncols()); ++j) {
-    auto col_start = m.col_start(j);
-    auto col_end = m.col_end(j);
-
-    for (usize p = col_start; p < col_end; ++p) {
-      usize i = zero_extend(mi[p]);
-      T mij = fabs(mx[p]);
-      row_norm[i] = std::max(row_norm[i], mij);
-    }
-  }
-}
 
+/// Minimal number of nonzero entries for which the passes of the
+/// equilibration are split over the threads of OpenMP.
+static constexpr isize ruiz_parallel_min_nnz = isize(1) << 16;
+
+/*!
+ * Scales in place the columns of H, AT and CT with the equilibration factors
+ * delta, and computes in the same pass the infinity norms of the columns of
+ * the scaled symmetric H and of the rows and columns of the scaled A and C.
+ * H is multiplied beforehand by gamma, its scaling of the previous iteration.
+ * If delta is null, the matrices are not modified and only their norms are
+ * computed.
+ *
+ * The columns of the three matrices are distributed over at most num_threads
+ * threads. A row of AT (resp. CT, or of the stored triangle of H) spans the
+ * columns of several threads, hence each thread accumulates the norms of the
+ * rows in its own slice of local_norms before they are merged. Since the
+ * maximum is computed exactly, the norms do not depend on the number of
+ * threads.
+ *
+ * @param qp qp whose matrices are scaled.
+ * @param delta equilibration factors of the primal variable followed by those
+ * of the constraints, or nullptr.
+ * @param gamma scaling of H of the previous iteration.
+ * @param sym triangular part of H which is stored.
+ * @param h_norm norms of the columns of the scaled H (size n).
+ * @param col_norm norms of the columns of the scaled A and C (size n).
+ * @param row_norm norms of the rows of the scaled A, then C (size n_eq +
+ * n_in).
+ * @param local_norms norms accumulated by each thread (size num_threads * 2 *
+ * n).
+ * @param num_threads maximal number of threads.
+ */
 template<typename T, typename I>
 void
-colwise_infty_norm_symhi(T* col_norm, proxsuite::linalg::sparse::MatRef<T, I> h)
+ruiz_scale_columns_and_norms(QpViewMut<T, I> qp,
+                             T const* delta,
+                             T gamma,
+                             Symmetry sym,
+                             T* h_norm,
+                             T* col_norm,
+                             T* row_norm,
+                             T* local_norms,
+                             isize num_threads)
 {
   using namespace proxsuite::linalg::sparse::util;
 
-  I const* hi = h.row_indices();
-  T const* hx = h.values();
-
-  for (usize j = 0; j < usize(h.ncols()); ++j) {
-    auto col_start = h.col_start(j);
-    auto col_end = h.col_end(j);
-
-    T norm_j = 0;
-
-    for (usize p = col_start; p < col_end; ++p) {
-      usize i = zero_extend(hi[p]);
-      if (i > j) {
-        break;
-      }
-
-      T hij = fabs(hx[p]);
-      norm_j = std::max(norm_j, hij);
-      col_norm[i] = std::max(col_norm[i], hij);
-    }
-
-    col_norm[j] = norm_j;
-  }
-}
-
-template<typename T, typename I>
-void
-colwise_infty_norm_symlo(T* col_norm, proxsuite::linalg::sparse::MatRef<T, I> h)
-{
-  using namespace proxsuite::linalg::sparse::util;
+  isize n = qp.H.nrows();
+  isize n_eq = qp.AT.ncols();
+  isize n_in = qp.CT.ncols();
+  isize n_cols = n + n_eq + n_in;
 
-  I const* hi = h.row_indices();
-  T const* hx = h.values();
+  I const* Hi = qp.H.row_indices();
+  T* Hx = qp.H.values_mut();
+  I const* ATi = qp.AT.row_indices();
+  T* ATx = qp.AT.values_mut();
+  I const* CTi = qp.CT.row_indices();
+  T* CTx = qp.CT.values_mut();
 
-  for (usize j = 0; j < usize(h.ncols()); ++j) {
-    auto col_start = h.col_start(j);
-    auto col_end = h.col_end(j);
+  std::fill_n(h_norm, n, T(0));
+  std::fill_n(col_norm, n, T(0));
 
-    T norm_j = 0;
+  bool parallel =
+    qp.H.nnz() + qp.AT.nnz() + qp.CT.nnz() >= ruiz_parallel_min_nnz;
+  static_cast<void>(parallel);
+  static_cast<void>(num_threads);
 
-    if (col_end > col_start) {
-      usize p = col_end;
-      while (true) {
-        --p;
-        usize i = zero_extend(hi[p]);
-        if (i < j) {
-          break;
+#ifdef PROXSUITE_ENABLE_OPENMP
+#pragma omp parallel if (parallel) num_threads(int(num_threads))
+#endif
+  {
+    isize thread = 0;
+#ifdef PROXSUITE_ENABLE_OPENMP
+    thread = isize(omp_get_thread_num());
+#endif
+    T* h_norm_local = local_norms + 2 * n * thread;
+    T* col_norm_local = h_norm_local + n;
+    std::fill_n(h_norm_local, n, T(0));
+    std::fill_n(col_norm_local, n, T(0));
+
+    isize r = 0;
+#ifdef PROXSUITE_ENABLE_OPENMP
+#pragma omp for schedule(dynamic, 256)
+#endif
+    for (r = 0; r < n_cols; ++r) {
+      if (r < n) {
+        usize j = usize(r);
+        usize col_start = qp.H.col_start(j);
+        usize col_end = qp.H.col_end(j);
+        T norm_j = 0;
+
+        // entries of the stored triangle of the j-th column of H
+        usize p_begin = col_start;
+        usize p_end = col_start;
+        switch (sym) {
+          case Symmetry::LOWER: {
+            p_begin = col_end;
+            p_end = col_end;
+            while (p_begin > col_start && zero_extend(Hi[p_begin - 1]) >= j) {
+              --p_begin;
+            }
+            break;
+          }
+          case Symmetry::UPPER: {
+            while (p_end < col_end && zero_extend(Hi[p_end]) <= j) {
+              ++p_end;
+            }
+            break;
+          }
         }
 
-        T hij = fabs(hx[p]);
-        norm_j = std::max(norm_j, hij);
-        col_norm[i] = std::max(col_norm[i], hij);
+        for (usize p = p_begin; p < p_end; ++p) {
+          usize i = zero_extend(Hi[p]);
+          if (delta != nullptr) {
+            Hx[p] = delta[j] * (Hx[p] * gamma) * delta[i];
+          }
+          T hij = fabs(Hx[p]);
+          norm_j = std::max(norm_j, hij);
+          h_norm_local[isize(i)] = std::max(h_norm_local[isize(i)], hij);
+        }
+        h_norm_local[isize(j)] = std::max(h_norm_local[isize(j)], norm_j);
+      } else {
+        isize k = r - n;
+        bool is_eq = k < n_eq;
+        usize j = usize(is_eq ? k : k - n_eq);
+        usize col_start = is_eq ? qp.AT.col_start(j) : qp.CT.col_start(j);
+        usize col_end = is_eq ? qp.AT.col_end(j) : qp.CT.col_end(j);
+        I const* Mi = is_eq ? ATi : CTi;
+        T* Mx = is_eq ? ATx : CTx;
+        T norm_k = 0;
 
-        if (p <= col_start) {
-          break;
+        for (usize p = col_start; p < col_end; ++p) {
+          usize i = zero_extend(Mi[p]);
+          if (delta != nullptr) {
+            Mx[p] = delta[i] * (Mx[p] * delta[n + k]);
+          }
+          T mki = fabs(Mx[p]);
+          norm_k = std::max(norm_k, mki);
+          col_norm_local[isize(i)] = std::max(col_norm_local[isize(i)], mki);
         }
+        row_norm[k] = norm_k;
+      }
+    }
+
+#ifdef PROXSUITE_ENABLE_OPENMP
+#pragma omp critical
+#endif
+    {
+      for (isize i = 0; i < n; ++i) {
+        h_norm[i] = std::max(h_norm[i], h_norm_local[i]);
+        col_norm[i] = std::max(col_norm[i], col_norm_local[i]);
       }
     }
-    col_norm[j] = std::max(col_norm[j], norm_j);
   }
 }
 
+/*!
+ * Equilibrates the qp in place with the Ruiz algorithm. delta_ and c hold the
+ * initial scaling of the qp, which is applied first and then refined by the
+ * iterations: the identity scaling gives the usual equilibration, while the
+ * scaling of a previous equilibration of close matrices (warm start) makes the
+ * iterations converge in a few passes.
+ *
+ * Each iteration performs a single pass over the matrices, which scales them
+ * and computes the norms used by the next iteration. The scaling gamma of H
+ * is applied lazily at the beginning of the next pass.
+ *
+ * @return the scaling of the cost.
+ */
 template<typename T, typename I>
 auto
 ruiz_scale_qp_in_place( //
   VectorViewMut<T> delta_,
+  T c,
   QpViewMut<T, I> qp,
   T epsilon,
   isize max_iter,
   Symmetry sym,
   proxsuite::linalg::veg::dynstack::DynStackMut stack) -> T
 {
-
-  T c = 1;
   auto S = delta_.to_eigen();
 
   isize n = qp.H.nrows();
@@ -130,18 +211,50 @@ ruiz_scale_qp_in_place( //
   i64 iter = 1;
 
   LDLT_TEMP_VEC(T, delta, n + n_eq + n_in, stack);
-
-  I* Hi = qp.H.row_indices_mut();
-  T* Hx = qp.H.values_mut();
-
-  I* ATi = qp.AT.row_indices_mut();
-  T* ATx = qp.AT.values_mut();
-
-  I* CTi = qp.CT.row_indices_mut();
-  T* CTx = qp.CT.values_mut();
+  LDLT_TEMP_VEC_UNINIT(T, norms, 2 * n + n_eq + n_in, stack);
+  T* h_infty_norm = norms.data();
+  T* ac_infty_norm = h_infty_norm + n;
+  T* row_infty_norm = ac_infty_norm + n;
+  // the number of threads is bounded by the scratch space of their norms,
+  // reserved by scale_qp_in_place_req for the default number of threads
+  isize num_threads = isize(proxsuite::helpers::get_default_num_threads());
+  if (n > 0) {
+    isize n_fit = (stack.remaining_bytes() -
+                   proxsuite::linalg::dense::_detail::align<T>()) /
+                  (2 * n * isize{ sizeof(T) });
+    num_threads = std::max(isize(1), std::min(num_threads, n_fit));
+  }
+  LDLT_TEMP_VEC_UNINIT(T, local_norms, num_threads * 2 * n, stack);
 
   T const machine_eps = std::numeric_limits<T>::epsilon();
 
+  if (c == T(1) && (S.array() == T(1)).all()) {
+    detail::ruiz_scale_columns_and_norms(qp,
+                                         static_cast<T const*>(nullptr),
+                                         gamma,
+                                         sym,
+                                         h_infty_norm,
+                                         ac_infty_norm,
+                                         row_infty_norm,
+                                         local_norms.data(),
+                                         num_threads);
+  } else {
+    // starts from the given scaling
+    detail::ruiz_scale_columns_and_norms(qp,
+                                         static_cast<T const*>(S.data()),
+                                         c,
+                                         sym,
+                                         h_infty_norm,
+                                         ac_infty_norm,
+                                         row_infty_norm,
+                                         local_norms.data(),
+                                         num_threads);
+    qp.g.to_eigen().array() *= S.head(n).array() * c;
+    qp.b.to_eigen().array() *= S.segment(n, n_eq).array();
+    qp.l.to_eigen().array() *= S.tail(n_in).array();
+    qp.u.to_eigen().array() *= S.tail(n_in).array();
+  }
+
   while (infty_norm((1 - delta.array()).matrix()) > epsilon) {
     if (iter == max_iter) {
       break;
@@ -149,138 +262,26 @@ ruiz_scale_qp_in_place( //
       ++iter;
     }
 
-    // norm_infty of each column of A (resp. C), i.e.,
-    // each row of AT (resp. CT)
-    {
-      auto _a_infty_norm = stack.make_new(proxsuite::linalg::veg::Tag<T>{}, n);
-      auto _c_infty_norm = stack.make_new(proxsuite::linalg::veg::Tag<T>{}, n);
-      auto _h_infty_norm = stack.make_new(proxsuite::linalg::veg::Tag<T>{}, n);
-      T* a_infty_norm = _a_infty_norm.ptr_mut();
-      T* c_infty_norm = _c_infty_norm.ptr_mut();
-      T* h_infty_norm = _h_infty_norm.ptr_mut();
-
-      detail::rowwise_infty_norm(a_infty_norm, qp.AT.as_const());
-      detail::rowwise_infty_norm(c_infty_norm, qp.CT.as_const());
-      switch (sym) {
-        case Symmetry::LOWER: {
-          detail::colwise_infty_norm_symlo(h_infty_norm, qp.H.as_const());
-          break;
-        }
-        case Symmetry::UPPER: {
-          detail::colwise_infty_norm_symhi(h_infty_norm, qp.H.as_const());
-          break;
-        }
-      }
-
-      for (isize j = 0; j < n; ++j) {
-        delta(j) = T(1) / (machine_eps + sqrt(std::max({
-                                           h_infty_norm[j],
-                                           a_infty_norm[j],
-                                           c_infty_norm[j],
-                                         })));
-      }
-    }
-    using namespace proxsuite::linalg::sparse::util;
-    for (usize j = 0; j < usize(n_eq); ++j) {
-      T a_row_norm = 0;
-      qp.AT.to_eigen();
-      usize col_start = qp.AT.col_start(j);
-      usize col_end = qp.AT.col_end(j);
-
-      for (usize p = col_start; p < col_end; ++p) {
-        T aji = fabs(ATx[p]);
-        a_row_norm = std::max(a_row_norm, aji);
-      }
-
-      delta(n + isize(j)) = T(1) / (machine_eps + sqrt(a_row_norm));
-    }
-
-    for (usize j = 0; j < usize(n_in); ++j) {
-      T c_row_norm = 0;
-      usize col_start = qp.CT.col_start(j);
-      usize col_end = qp.CT.col_end(j);
-
-      for (usize p = col_start; p < col_end; ++p) {
-        T cji = fabs(CTx[p]);
-        c_row_norm = std::max(c_row_norm, cji);
-      }
-
-      delta(n + n_eq + isize(j)) = T(1) / (machine_eps + sqrt(c_row_norm));
-    }
-
-    // normalize A
-    for (usize j = 0; j < usize(n_eq); ++j) {
-      usize col_start = qp.AT.col_start(j);
-      usize col_end = qp.AT.col_end(j);
-
-      T delta_j = delta(n + isize(j));
-
-      for (usize p = col_start; p < col_end; ++p) {
-        usize i = zero_extend(ATi[p]);
-        T& aji = ATx[p];
-        T delta_i = delta(isize(i));
-        aji = delta_i * (aji * delta_j);
-      }
+    for (isize j = 0; j < n; ++j) {
+      delta(j) = T(1) / (machine_eps + sqrt(std::max({
+                                         h_infty_norm[j],
+                                         ac_infty_norm[j],
+                                       })));
     }
-
-    // normalize C
-    for (usize j = 0; j < usize(n_in); ++j) {
-      usize col_start = qp.CT.col_start(j);
-      usize col_end = qp.CT.col_end(j);
-
-      T delta_j = delta(n + n_eq + isize(j));
-
-      for (usize p = col_start; p < col_end; ++p) {
-        usize i = zero_extend(CTi[p]);
-        T& cji = CTx[p];
-        T delta_i = delta(isize(i));
-        cji = delta_i * (cji * delta_j);
-      }
+    for (isize j = 0; j < n_eq + n_in; ++j) {
+      delta(n + j) = T(1) / (machine_eps + sqrt(row_infty_norm[j]));
     }
 
-    // normalize H
-    switch (sym) {
-      case Symmetry::LOWER: {
-        for (usize j = 0; j < usize(n); ++j) {
-          usize col_start = qp.H.col_start(j);
-          usize col_end = qp.H.col_end(j);
-          T delta_j = delta(isize(j));
-
-          if (col_end > col_start) {
-            usize p = col_end;
-            while (true) {
-              --p;
-              usize i = zero_extend(Hi[p]);
-              if (i < j) {
-                break;
-              }
-              Hx[p] = delta_j * Hx[p] * delta(isize(i));
-
-              if (p <= col_start) {
-                break;
-              }
-            }
-          }
-        }
-        break;
-      }
-      case Symmetry::UPPER: {
-        for (usize j = 0; j < usize(n); ++j) {
-          usize col_start = qp.H.col_start(j);
-          usize col_end = qp.H.col_end(j);
-          T delta_j = delta(isize(j));
-
-          for (usize p = col_start; p < col_end; ++p) {
-            usize i = zero_extend(Hi[p]);
-            if (i > j) {
-              break;
-            }
-            Hx[p] = delta_j * Hx[p] * delta(isize(i));
-          }
-        }
-        break;
-      }
-    }
+    // normalize H, A and C
+    detail::ruiz_scale_columns_and_norms(qp,
+                                         static_cast<T const*>(delta.data()),
+                                         gamma,
+                                         sym,
+                                         h_infty_norm,
+                                         ac_infty_norm,
+                                         row_infty_norm,
+                                         local_norms.data(),
+                                         num_threads);
 
     // normalize vectors
     qp.g.to_eigen().array() *= delta.head(n).array();
@@ -289,20 +290,6 @@ ruiz_scale_qp_in_place( //
     qp.u.to_eigen().array() *= delta.tail(n_in).array();
 
     // additional normalization
-    auto _h_infty_norm = stack.make_new(proxsuite::linalg::veg::Tag<T>{}, n);
-    T* h_infty_norm = _h_infty_norm.ptr_mut();
-
-    switch (sym) {
-      case Symmetry::LOWER: {
-        detail::colwise_infty_norm_symlo(h_infty_norm, qp.H.as_const());
-        break;
-      }
-      case Symmetry::UPPER: {
-        detail::colwise_infty_norm_symhi(h_infty_norm, qp.H.as_const());
-        break;
-      }
-    }
-
     T avg = 0;
     for (isize i = 0; i < n; ++i) {
       avg += h_infty_norm[i];
@@ -311,12 +298,18 @@ ruiz_scale_qp_in_place( //
 
     gamma = 1 / std::max(avg, T(1));
 
+    // H is scaled by gamma at the next pass
+    for (isize i = 0; i < n; ++i) {
+      h_infty_norm[i] *= gamma;
+    }
     qp.g.to_eigen() *= gamma;
-    qp.H.to_eigen() *= gamma;
 
     S.array() *= delta.array();
     c *= gamma;
   }
+  if (gamma != T(1)) {
+    qp.H.to_eigen() *= gamma;
+  }
   return c;
 }
 } // namespace detail
@@ -356,8 +349,10 @@ struct RuizEquilibration
                                     isize n_in)
     -> proxsuite::linalg::veg::dynstack::StackReq
   {
+    isize num_threads = isize(proxsuite::helpers::get_default_num_threads());
     return proxsuite::linalg::dense::temp_vec_req(tag, n + n_eq + n_in) &
-           proxsuite::linalg::veg::dynstack::StackReq::with_len(tag, 3 * n);
+           proxsuite::linalg::dense::temp_vec_req(tag, 2 * n + n_eq + n_in) &
+           proxsuite::linalg::dense::temp_vec_req(tag, num_threads * 2 * n);
   }
 
   void scale_qp_in_place(QpViewMut<T, I> qp,
@@ -365,11 +360,39 @@ struct RuizEquilibration
                          const isize max_iter,
                          const T epsilon,
                          proxsuite::linalg::veg::dynstack::DynStackMut stack)
+  {
+    scale_qp_in_place(
+      qp, execute_preconditioner, max_iter, epsilon, false, stack);
+  }
+
+  /*!
+   * Scales the qp in place, computing anew the equilibration or using the
+   * current one.
+   * @param qp qp to be scaled (in place).
+   * @param execute_preconditioner whether the equilibration is computed anew.
+   * @param max_iter maximum number of ruiz equilibration iterations.
+   * @param epsilon accuracy required for stopping the ruiz equilibration
+   * algorithm.
+   * @param warm_start whether the equilibration starts from the current
+   * scaling instead of the identity, which requires few iterations when the
+   * matrices of the qp are close to the previously equilibrated ones.
+   * @param stack stack variable used by the equilibrator.
+   */
+  void scale_qp_in_place(QpViewMut<T, I> qp,
+                         bool execute_preconditioner,
+                         const isize max_iter,
+                         const T epsilon,
+                         const bool warm_start,
+                         proxsuite::linalg::veg::dynstack::DynStackMut stack)
   {
     if (execute_preconditioner) {
-      delta.setOnes();
+      if (!warm_start) {
+        delta.setOnes();
+        c = 1;
+      }
       c = detail::ruiz_scale_qp_in_place( //
         { proxqp::from_eigen, delta },
+        c,
         qp,
         epsilon,
         max_iter,
@@ -475,6 +498,32 @@ struct RuizEquilibration
     }
   }
 
+  /*!
+   * Equilibrates a QP whose matrices are only known through their action on
+   * vectors: the primal variables are scaled so that the scaled H has a unit
+   * diagonal (within [1e-4, 1e4]), the constraints and the cost being left
+   * unscaled.
+   * @param H_diagonal diagonal of H, the identity scaling is used if it is
+   * empty.
+   */
+  void scale_from_hessian_diagonal(Vec<T> const& H_diagonal)
+  {
+    using std::abs;
+    using std::sqrt;
+    delta.setOnes();
+    c = 1;
+    if (H_diagonal.rows() != n) {
+      return;
+    }
+    T const machine_eps = std::numeric_limits<T>::epsilon();
+    for (isize i = 0; i < n; ++i) {
+      T hii = abs(H_diagonal[i]);
+      if (hii > machine_eps) {
+        delta[i] = T(1) / sqrt(std::min(std::max(hii, T(1e-4)), T(1e4)));
+      }
+    }
+  }
+
   // modifies variables in place
   void scale_primal_in_place(VectorViewMut<T> primal) const
   {
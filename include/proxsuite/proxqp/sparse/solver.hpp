@@ -14,6 +14,7 @@
 #include <proxsuite/linalg/sparse/factorize.hpp>
 #include <proxsuite/linalg/sparse/update.hpp>
 #include <proxsuite/linalg/sparse/rowmod.hpp>
+#include <proxsuite/linalg/sparse/supernodal.hpp>
 #include <proxsuite/proxqp/dense/views.hpp>
 #include <proxsuite/proxqp/settings.hpp>
 #include <proxsuite/linalg/veg/vec.hpp>
@@ -43,20 +44,46 @@ ldl_solve(VectorViewMut<T> sol,
           proxsuite::linalg::sparse::MatMut<T, I> ldl,
           Eigen::MINRES<detail::AugmentedKkt<T, I>,
                         Eigen::Upper | Eigen::Lower,
-                        Eigen::IdentityPreconditioner>& iterative_solver,
+                        detail::KktPreconditioner<T, I>>& iterative_solver,
           bool do_ldlt,
+          proxsuite::linalg::sparse::SupernodalLdlt<T, I> const* supernodal,
           proxsuite::linalg::veg::dynstack::DynStackMut stack,
           T* ldl_values,
           I* perm,
           I* ldl_col_ptrs,
-          I const* perm_inv)
+          I const* perm_inv,
+          proxsuite::linalg::sparse::MatMut<float, I> const* ldl_low = nullptr)
 {
   LDLT_TEMP_VEC_UNINIT(T, work_, n_tot, stack);
   auto rhs_e = rhs.to_eigen();
   auto sol_e = sol.to_eigen();
   auto zx = proxsuite::linalg::sparse::util::zero_extend;
 
-  if (do_ldlt) {
+  if (do_ldlt && ldl_low != nullptr) {
+    // the factors are stored in single precision
+    LDLT_TEMP_VEC_UNINIT(float, work_low, n_tot, stack);
+    float const* ldl_values_low = ldl_low->values();
+
+    for (isize i = 0; i < n_tot; ++i) {
+      work_low[i] = float(rhs_e[isize(zx(perm[i]))]);
+    }
+
+    proxsuite::linalg::sparse::dense_lsolve<float, I>( //
+      { proxsuite::linalg::sparse::from_eigen, work_low },
+      ldl_low->as_const());
+
+    for (isize i = 0; i < n_tot; ++i) {
+      work_low[i] /= ldl_values_low[isize(zx(ldl_col_ptrs[i]))];
+    }
+
+    proxsuite::linalg::sparse::dense_ltsolve<float, I>( //
+      { proxsuite::linalg::sparse::from_eigen, work_low },
+      ldl_low->as_const());
+
+    for (isize i = 0; i < n_tot; ++i) {
+      sol_e[i] = T(work_low[isize(zx(perm_inv[i]))]);
+    }
+  } else if (do_ldlt) {
 
     for (isize i = 0; i < n_tot; ++i) {
       work_[i] = rhs_e[isize(zx(perm[i]))];
@@ -77,14 +104,28 @@ ldl_solve(VectorViewMut<T> sol,
     for (isize i = 0; i < n_tot; ++i) {
       sol_e[i] = work_[isize(zx(perm_inv[i]))];
     }
+  } else if (supernodal != nullptr) {
+    sol_e = rhs_e;
+    proxsuite::linalg::sparse::solve_supernodal_in_place<T, I>(
+      { proxsuite::linalg::sparse::from_eigen, sol_e }, *supernodal, stack);
   } else {
     work_ = iterative_solver.solve(rhs_e);
     sol_e = work_;
   }
 }
 
+///
+/// @brief Statistics of the iterative refinement of a linear system solve.
+///
+struct IterativeRefinementInfo
+{
+  isize steps;  // number of refinement steps after the first solve
+  bool stalled; // the residual stopped decreasing above the eps_refact
+                // threshold (relative to the right hand side)
+};
+
 template<typename T, typename I>
-void
+auto
 ldl_iter_solve_noalias(
   VectorViewMut<T> sol,
   VectorView<T> rhs,
@@ -95,8 +136,9 @@ ldl_iter_solve_noalias(
   proxsuite::linalg::sparse::MatMut<T, I> ldl,
   Eigen::MINRES<detail::AugmentedKkt<T, I>,
                 Eigen::Upper | Eigen::Lower,
-                Eigen::IdentityPreconditioner>& iterative_solver,
+                detail::KktPreconditioner<T, I>>& iterative_solver,
   bool do_ldlt,
+  proxsuite::linalg::sparse::SupernodalLdlt<T, I> const* supernodal,
   proxsuite::linalg::veg::dynstack::DynStackMut stack,
   T* ldl_values,
   I* perm,
@@ -104,10 +146,16 @@ ldl_iter_solve_noalias(
   I const* perm_inv,
   Settings<T> const& settings,
   proxsuite::linalg::sparse::MatMut<T, I> kkt_active,
-  proxsuite::linalg::veg::SliceMut<bool> active_constraints)
+  proxsuite::linalg::veg::SliceMut<bool> active_constraints,
+  detail::ScaledLinearOperator<T> const* linear_operator = nullptr,
+  proxsuite::linalg::sparse::MatMut<float, I> const* ldl_low = nullptr)
+  -> IterativeRefinementInfo
 {
   auto rhs_e = rhs.to_eigen();
   auto sol_e = sol.to_eigen();
+  IterativeRefinementInfo info{ -1, false };
+  T const stall_threshold =
+    settings.eps_refact * std::max(T(1), infty_norm(rhs_e));
 
   if (init_guess.dim == sol.dim) {
     sol_e = init_guess.to_eigen();
@@ -136,6 +184,9 @@ ldl_iter_solve_noalias(
       T mu_eq_neg = -results.info.mu_eq;
       T mu_in_neg = -results.info.mu_in;
       detail::noalias_symhiv_add(err, kkt_active.to_eigen(), sol_e);
+      if (linear_operator != nullptr) {
+        linear_operator->kkt_add(err, sol_e, active_constraints.as_const());
+      }
       err_x += results.info.rho * sol_x;
       err_y += mu_eq_neg * sol_y;
       for (isize i = 0; i < data.n_in; ++i) {
@@ -145,9 +196,11 @@ ldl_iter_solve_noalias(
 
     T err_norm = infty_norm(err);
     if (err_norm > prev_err_norm / T(2)) {
+      info.stalled = err_norm > stall_threshold;
       break;
     }
     prev_err_norm = err_norm;
+    ++info.steps;
 
     ldl_solve({ proxqp::from_eigen, err },
               { proxqp::from_eigen, err },
@@ -155,14 +208,18 @@ ldl_iter_solve_noalias(
               ldl,
               iterative_solver,
               do_ldlt,
+              supernodal,
               stack,
               ldl_values,
               perm,
               ldl_col_ptrs,
-              perm_inv);
+              perm_inv,
+              ldl_low);
 
     sol_e -= err;
   }
+  info.steps = std::max(info.steps, isize(0));
+  return info;
 }
 /*!
  * Solves in place a linear system.
@@ -172,6 +229,8 @@ ldl_iter_solve_noalias(
  * @param ldl current ldlt.
  * @param do_ldlt boolean variable for doing the ldlt (rather than MinRes
  * algorithm).
+ * @param supernodal supernodal factorization of the kkt, used instead of the
+ * MinRes algorithm when not null and do_ldlt is false.
  * @param perm_inv pointer to the inverse of the permutation.
  * @param results solver results.
  * @param data model of the QP.
@@ -187,9 +246,14 @@ ldl_iter_solve_noalias(
  * @param perm_inv pointor the inverse permutation.
  * @param settings solver's settings.
  * @param kkt_active active part of the kkt.
+ * @param linear_operator linear operators defining the matrices of the QP, or
+ * null if they are stored in the kkt.
+ * @param ldl_low ldlt stored in single precision, used instead of ldl when not
+ * null.
+ * @return statistics of the iterative refinement.
  */
 template<typename T, typename I>
-void
+auto
 ldl_solve_in_place(
   VectorViewMut<T> rhs,
   VectorView<T> init_guess,
@@ -199,8 +263,9 @@ ldl_solve_in_place(
   proxsuite::linalg::sparse::MatMut<T, I> ldl,
   Eigen::MINRES<detail::AugmentedKkt<T, I>,
                 Eigen::Upper | Eigen::Lower,
-                Eigen::IdentityPreconditioner>& iterative_solver,
+                detail::KktPreconditioner<T, I>>& iterative_solver,
   bool do_ldlt,
+  proxsuite::linalg::sparse::SupernodalLdlt<T, I> const* supernodal,
   proxsuite::linalg::veg::dynstack::DynStackMut stack,
   T* ldl_values,
   I* perm,
@@ -208,27 +273,34 @@ ldl_solve_in_place(
   I const* perm_inv,
   Settings<T> const& settings,
   proxsuite::linalg::sparse::MatMut<T, I> kkt_active,
-  proxsuite::linalg::veg::SliceMut<bool> active_constraints)
+  proxsuite::linalg::veg::SliceMut<bool> active_constraints,
+  detail::ScaledLinearOperator<T> const* linear_operator = nullptr,
+  proxsuite::linalg::sparse::MatMut<float, I> const* ldl_low = nullptr)
+  -> IterativeRefinementInfo
 {
   LDLT_TEMP_VEC_UNINIT(T, tmp, n_tot, stack);
-  ldl_iter_solve_noalias({ proxqp::from_eigen, tmp },
-                         rhs.as_const(),
-                         init_guess,
-                         results,
-                         data,
-                         n_tot,
-                         ldl,
-                         iterative_solver,
-                         do_ldlt,
-                         stack,
-                         ldl_values,
-                         perm,
-                         ldl_col_ptrs,
-                         perm_inv,
-                         settings,
-                         kkt_active,
-                         active_constraints);
+  auto info = ldl_iter_solve_noalias({ proxqp::from_eigen, tmp },
+                                     rhs.as_const(),
+                                     init_guess,
+                                     results,
+                                     data,
+                                     n_tot,
+                                     ldl,
+                                     iterative_solver,
+                                     do_ldlt,
+                                     supernodal,
+                                     stack,
+                                     ldl_values,
+                                     perm,
+                                     ldl_col_ptrs,
+                                     perm_inv,
+                                     settings,
+                                     kkt_active,
+                                     active_constraints,
+                                     linear_operator,
+                                     ldl_low);
   rhs.to_eigen() = tmp;
+  return info;
 }
 /*!
  * Reconstructs manually the permutted matrix.
@@ -343,6 +415,12 @@ qp_solve(Results<T>& results,
     work.timer.stop();
     work.timer.start();
   }
+  if (work.internal.dirty) {
+    // the problem is equilibrated again by this solve
+    results.info.profile.clear();
+  } else {
+    results.info.profile.clear_solve_statistics();
+  }
 
   if (work.internal
         .dirty) // the following is used when a solve has already been executed
@@ -364,14 +442,15 @@ qp_solve(Results<T>& results,
       detail::middle_cols_mut(
         kkt_top_n_rows, data.dim + data.n_eq, data.n_in, data.C_nnz);
 
-    SparseMat<T, I> H_triu =
-      H_unscaled.to_eigen().template triangularView<Eigen::Upper>();
+    // the unscaled KKT matrix (whose H block is already upper triangular) is
+    // used directly: the cached symbolic factorization is reused and only a
+    // numerical refresh is performed by the setup
     sparse::QpView<T, I> qp = {
-      { proxsuite::linalg::sparse::from_eigen, H_triu },
+      H_unscaled.as_const(),
       { proxsuite::linalg::sparse::from_eigen, data.g },
-      { proxsuite::linalg::sparse::from_eigen, AT_unscaled.to_eigen() },
+      AT_unscaled.as_const(),
       { proxsuite::linalg::sparse::from_eigen, data.b },
-      { proxsuite::linalg::sparse::from_eigen, CT_unscaled.to_eigen() },
+      CT_unscaled.as_const(),
       { proxsuite::linalg::sparse::from_eigen, data.l },
       { proxsuite::linalg::sparse::from_eigen, data.u }
     };
@@ -421,6 +500,12 @@ qp_solve(Results<T>& results,
         break;
       }
     }
+    if (work.internal.do_symbolic_fact ||
+        work.internal.ordering != settings.sparse_ordering) {
+      results.info.symbolic_factorization_reuses = 0;
+    } else {
+      ++results.info.symbolic_factorization_reuses;
+    }
     work.setup_impl(
       qp,
       data,
@@ -428,7 +513,8 @@ qp_solve(Results<T>& results,
       false,
       precond,
       P::scale_qp_in_place_req(
-        proxsuite::linalg::veg::Tag<T>{}, data.dim, data.n_eq, data.n_in));
+        proxsuite::linalg::veg::Tag<T>{}, data.dim, data.n_eq, data.n_in),
+      results.info.profile);
 
   } else {
     // the following is used for a first solve after initializing or updating
@@ -529,6 +615,9 @@ qp_solve(Results<T>& results,
   proxsuite::linalg::veg::Tag<T> xtag;
 
   bool do_ldlt = work.internal.do_ldlt;
+  bool do_supernodal = work.internal.do_supernodal;
+  proxsuite::linalg::sparse::SupernodalLdlt<T, I> const* supernodal =
+    do_supernodal ? &work.internal.supernodal : nullptr;
 
   isize ldlt_ntot = do_ldlt ? n_tot : 0;
 
@@ -547,6 +636,9 @@ qp_solve(Results<T>& results,
   I* kkt_nnz_counts = work.internal.kkt_nnz_counts.ptr_mut();
 
   auto& iterative_solver = *work.internal.matrix_free_solver.get();
+  detail::ScaledLinearOperator<T> const* linear_operator =
+    work.internal.linear_operator.get();
+  iterative_solver.preconditioner().kind = settings.matrix_free_preconditioner;
   isize C_active_nnz = 0;
   switch (settings.initial_guess) {
     case InitialGuessStatus::EQUALITY_CONSTRAINED_INITIAL_GUESS: {
@@ -651,6 +743,18 @@ qp_solve(Results<T>& results,
     kkt.values_mut(),
   };
 
+  // in mixed precision mode, the ldlt values are stored in single precision
+  // until the iterative refinement stalls
+  isize ldlt_lnnz = do_ldlt ? isize(zx(ldl_col_ptrs[n_tot])) : 0;
+  work.internal.mixed_precision = do_ldlt && settings.mixed_precision;
+  if (work.internal.mixed_precision) {
+    work.internal.ldl.values_low.resize_for_overwrite(ldlt_lnnz);
+  } else {
+    work.internal.ldl.values.resize_for_overwrite(ldlt_lnnz);
+  }
+  results.info.mixed_precision_fallback = false;
+  results.info.iterative_refinement_steps = 0;
+
   I* etree = work.internal.ldl.etree.ptr_mut();
   I* ldl_nnz_counts = work.internal.ldl.nnz_counts.ptr_mut();
   I* ldl_row_indices = work.internal.ldl.row_indices.ptr_mut();
@@ -668,6 +772,16 @@ qp_solve(Results<T>& results,
     ldl_row_indices,
     ldl_values,
   };
+  proxsuite::linalg::sparse::MatMut<float, I> ldl_low = {
+    proxsuite::linalg::sparse::from_raw_parts,
+    n_tot,
+    n_tot,
+    0,
+    ldl_col_ptrs,
+    do_ldlt ? ldl_nnz_counts : nullptr,
+    ldl_row_indices,
+    work.internal.ldl.values_low.ptr_mut(),
+  };
 
   T bcl_eta_ext_init = pow(T(0.1), settings.alpha_bcl);
   T bcl_eta_ext = bcl_eta_ext_init;
@@ -677,8 +791,73 @@ qp_solve(Results<T>& results,
   auto x_e = x.to_eigen();
   auto y_e = y.to_eigen();
   auto z_e = z.to_eigen();
-  sparse::refactorize<T, I>(
-    work, results, kkt_active, active_constraints, data, stack, xtag);
+  {
+    PROXSUITE_PROFILE_SCOPE(results.info.profile.factorization_time);
+    PROXSUITE_PROFILE_COUNT(results.info.profile.factorizations, 1);
+    sparse::refactorize<T, I>(
+      work, results, kkt_active, active_constraints, data, stack, xtag);
+  }
+
+  // solves in place the linear system defined by the active part of the kkt
+  // matrix, and falls back to a full precision factorization when the
+  // iterative refinement stalls in mixed precision mode
+  auto solve_kkt_in_place = [&](VectorViewMut<T> rhs,
+                                VectorView<T> init_guess) -> void {
+    PROXSUITE_PROFILE_SCOPE(results.info.profile.iterative_refinement_time);
+    LDLT_TEMP_VEC_UNINIT(T, tmp, n_tot, stack);
+    auto solve = [&]() -> IterativeRefinementInfo {
+      return ldl_iter_solve_noalias(
+        { proxqp::from_eigen, tmp },
+        rhs.as_const(),
+        init_guess,
+        results,
+        data,
+        n_tot,
+        ldl,
+        iterative_solver,
+        do_ldlt,
+        supernodal,
+        stack,
+        ldl_values,
+        perm,
+        ldl_col_ptrs,
+        perm_inv,
+        settings,
+        kkt_active,
+        active_constraints,
+        linear_operator,
+        work.internal.mixed_precision ? &ldl_low : nullptr);
+    };
+    IterativeRefinementInfo info = solve();
+    if (info.stalled && work.internal.mixed_precision) {
+      work.internal.mixed_precision = false;
+      results.info.mixed_precision_fallback = true;
+      work.internal.ldl.values.resize_for_overwrite(ldlt_lnnz);
+      ldl_values = work.internal.ldl.values.ptr_mut();
+      ldl = {
+        proxsuite::linalg::sparse::from_raw_parts,
+        n_tot,
+        n_tot,
+        0,
+        ldl_col_ptrs,
+        ldl_nnz_counts,
+        ldl_row_indices,
+        ldl_values,
+      };
+      {
+        PROXSUITE_PROFILE_SCOPE(results.info.profile.refactorization_time);
+        PROXSUITE_PROFILE_COUNT(results.info.profile.refactorizations, 1);
+        refactorize(
+          work, results, kkt_active, active_constraints, data, stack, xtag);
+      }
+      info = solve();
+    }
+    results.info.iterative_refinement_steps =
+      std::max(results.info.iterative_refinement_steps, info.steps);
+    PROXSUITE_PROFILE_COUNT(results.info.profile.iterative_refinement_steps,
+                            info.steps);
+    rhs.to_eigen() = tmp;
+  };
   switch (settings.initial_guess) {
     case InitialGuessStatus::EQUALITY_CONSTRAINED_INITIAL_GUESS: {
       LDLT_TEMP_VEC_UNINIT(T, rhs, n_tot, stack);
@@ -688,22 +867,8 @@ qp_solve(Results<T>& results,
       rhs.segment(n, n_eq) = b_scaled_e;
       rhs.segment(n + n_eq, n_in).setZero();
 
-      ldl_solve_in_place({ proxqp::from_eigen, rhs },
-                         { proxqp::from_eigen, no_guess },
-                         results,
-                         data,
-                         n_tot,
-                         ldl,
-                         iterative_solver,
-                         do_ldlt,
-                         stack,
-                         ldl_values,
-                         perm,
-                         ldl_col_ptrs,
-                         perm_inv,
-                         settings,
-                         kkt_active,
-                         active_constraints);
+      solve_kkt_in_place({ proxqp::from_eigen, rhs },
+                         { proxqp::from_eigen, no_guess });
       x_e = rhs.head(n);
       y_e = rhs.segment(n, n_eq);
       z_e = rhs.segment(n + n_eq, n_in);
@@ -818,6 +983,9 @@ qp_solve(Results<T>& results,
         LDLT_TEMP_VEC_UNINIT(T, tmp, n, stack);
         tmp.setZero();
         detail::noalias_symhiv_add(tmp, qp_scaled.H.to_eigen(), x_e);
+        if (linear_operator != nullptr) {
+          linear_operator->H_add(tmp, x_e);
+        }
         precond.unscale_dual_residual_in_place({ proxqp::from_eigen, tmp });
 
         precond.unscale_primal_in_place({ proxqp::from_eigen, x_e });
@@ -902,6 +1070,8 @@ qp_solve(Results<T>& results,
 
             // active set change
             if (n_in > 0) {
+              PROXSUITE_PROFILE_SCOPE(
+                results.info.profile.active_set_change_time);
               bool removed = false;
               bool added = false;
 
@@ -916,11 +1086,36 @@ qp_solve(Results<T>& results,
 
                 if (is_active && !was_active) {
                   added = true;
+                  PROXSUITE_PROFILE_COUNT(
+                    results.info.profile.active_set_insertions, 1);
 
                   kkt_active.nnz_per_col_mut()[idx] = I(col_nnz);
                   kkt_active._set_nnz(kkt_active.nnz() + isize(col_nnz));
 
-                  if (do_ldlt) {
+                  if (do_ldlt && work.internal.mixed_precision) {
+                    LDLT_TEMP_VEC_UNINIT(
+                      float, new_col_values, isize(col_nnz), stack);
+                    for (usize p = 0; p < col_nnz; ++p) {
+                      new_col_values[isize(p)] =
+                        float(kkt.values()[zx(kkt.col_start(usize(idx))) + p]);
+                    }
+                    proxsuite::linalg::sparse::VecRef<float, I> new_col{
+                      proxsuite::linalg::sparse::from_raw_parts,
+                      n_tot,
+                      isize(col_nnz),
+                      kkt.row_indices() + zx(kkt.col_start(usize(idx))),
+                      new_col_values.data(),
+                    };
+
+                    ldl_low = proxsuite::linalg::sparse::add_row(
+                      ldl_low,
+                      etree,
+                      perm_inv,
+                      idx,
+                      new_col,
+                      float(-results.info.mu_in),
+                      stack);
+                  } else if (do_ldlt) {
                     proxsuite::linalg::sparse::VecRef<T, I> new_col{
                       proxsuite::linalg::sparse::from_raw_parts,
                       n_tot,
@@ -937,22 +1132,48 @@ qp_solve(Results<T>& results,
                                                          new_col,
                                                          -results.info.mu_in,
                                                          stack);
+                  } else if (do_supernodal) {
+                    proxsuite::linalg::sparse::add_row_supernodal(
+                      work.internal.supernodal,
+                      idx,
+                      { proxsuite::linalg::sparse::from_raw_parts,
+                        n_tot,
+                        isize(col_nnz),
+                        kkt.row_indices() + zx(kkt.col_start(usize(idx))),
+                        kkt.values() + zx(kkt.col_start(usize(idx))) },
+                      -results.info.mu_in,
+                      stack);
                   }
                   active_constraints[i] = new_active_constraints[i];
 
                 } else if (!is_active && was_active) {
                   removed = true;
+                  PROXSUITE_PROFILE_COUNT(
+                    results.info.profile.active_set_deletions, 1);
                   kkt_active.nnz_per_col_mut()[idx] = 0;
                   kkt_active._set_nnz(kkt_active.nnz() - isize(col_nnz));
-                  if (do_ldlt) {
+                  if (do_ldlt && work.internal.mixed_precision) {
+                    ldl_low = proxsuite::linalg::sparse::delete_row(
+                      ldl_low, etree, perm_inv, idx, stack);
+                  } else if (do_ldlt) {
                     ldl = proxsuite::linalg::sparse::delete_row(
                       ldl, etree, perm_inv, idx, stack);
+                  } else if (do_supernodal) {
+                    proxsuite::linalg::sparse::delete_row_supernodal(
+                      work.internal.supernodal,
+                      idx,
+                      { proxsuite::linalg::sparse::from_raw_parts,
+                        n_tot,
+                        isize(col_nnz),
+                        kkt.row_indices() + zx(kkt.col_start(usize(idx))),
+                        kkt.values() + zx(kkt.col_start(usize(idx))) },
+                      stack);
                   }
                   active_constraints[i] = new_active_constraints[i];
                 }
               }
 
-              if (!do_ldlt) {
+              if (!do_ldlt && !do_supernodal) {
                 if (removed || added) {
                   refactorize(work,
                               results,
@@ -980,26 +1201,18 @@ qp_solve(Results<T>& results,
                 rhs.head(n) += z_e(i) * CT_scaled.to_eigen().col(i);
               }
             }
+            if (linear_operator != nullptr) {
+              linear_operator->CT_add_masked(
+                rhs.head(n), z_e, [&](isize i) -> bool {
+                  return !work.active_set_up(i) && !work.active_set_low(i);
+                });
+            }
 
-            ldl_solve_in_place(
+            solve_kkt_in_place(
               { proxqp::from_eigen, rhs },
               { proxqp::from_eigen,
-                dw_prev }, // todo: MAJ dw_prev avec dw pour avoir meilleur
-                           // guess sur les solve in place
-              results,
-              data,
-              n_tot,
-              ldl,
-              iterative_solver,
-              do_ldlt,
-              stack,
-              ldl_values,
-              perm,
-              ldl_col_ptrs,
-              perm_inv,
-              settings,
-              kkt_active,
-              active_constraints);
+                dw_prev }); // todo: MAJ dw_prev avec dw pour avoir meilleur
+                            // guess sur les solve in place
           }
           auto dx = dw.head(n);
           auto dy = dw.segment(n, n_eq);
@@ -1015,10 +1228,19 @@ qp_solve(Results<T>& results,
           detail::noalias_symhiv_add(Hdx, H_scaled.to_eigen(), dx);
           detail::noalias_gevmmv_add(Adx, ATdy, AT_scaled.to_eigen(), dx, dy);
           detail::noalias_gevmmv_add(Cdx, CTdz, CT_scaled.to_eigen(), dx, dz);
+          if (linear_operator != nullptr) {
+            linear_operator->H_add(Hdx, dx);
+            linear_operator->A_add(Adx, dx);
+            linear_operator->AT_add(ATdy, dy);
+            linear_operator->C_add(Cdx, dx);
+            linear_operator->CT_add(CTdz, dz);
+          }
 
           T alpha = 1;
           // primal dual line search
           if (n_in > 0) {
+            PROXSUITE_PROFILE_SCOPE(results.info.profile.line_search_time);
+            PROXSUITE_PROFILE_COUNT(results.info.profile.line_searches, 1);
             auto primal_dual_gradient_norm =
               [&](T alpha_cur) -> PrimalDualGradResult<T> {
               LDLT_TEMP_VEC_UNINIT(T, Cdx_active, n_in, stack);
@@ -1322,8 +1544,10 @@ qp_solve(Results<T>& results,
         new_bcl_mu_eq_inv = settings.cold_reset_mu_eq_inv;
       }
     }
-    if (results.info.mu_in != new_bcl_mu_in ||
-        results.info.mu_eq != new_bcl_mu_eq) {
+    bool mu_updated = results.info.mu_in != new_bcl_mu_in ||
+                      results.info.mu_eq != new_bcl_mu_eq;
+    if (mu_updated) {
+      PROXSUITE_PROFILE_SCOPE(results.info.profile.mu_update_time);
       {
         ++results.info.mu_updates;
       }
@@ -1351,6 +1575,20 @@ qp_solve(Results<T>& results,
             }
             alpha = results.info.mu_in - new_bcl_mu_in;
           }
+          if (work.internal.mixed_precision) {
+            float value = 1;
+            proxsuite::linalg::sparse::VecRef<float, I> w{
+              proxsuite::linalg::veg::from_raw_parts,
+              n + n_eq + n_in,
+              w_values,
+              &row_index,
+              &value,
+            };
+            ldl_low =
+              rank1_update(ldl_low, etree, perm_inv, w, float(alpha), stack);
+            PROXSUITE_PROFILE_COUNT(results.info.profile.mu_update_rank, 1);
+            continue;
+          }
           T value = 1;
           proxsuite::linalg::sparse::VecRef<T, I> w{
             proxsuite::linalg::veg::from_raw_parts,
@@ -1360,6 +1598,27 @@ qp_solve(Results<T>& results,
             &value,
           };
           ldl = rank1_update(ldl, etree, perm_inv, w, alpha, stack);
+          PROXSUITE_PROFILE_COUNT(results.info.profile.mu_update_rank, 1);
+        }
+      } else if (do_supernodal) {
+        T value = 1;
+        for (isize j = 0; j < n_eq + n_in; ++j) {
+          if (j >= n_eq && !work.active_inequalities[j - n_eq]) {
+            continue;
+          }
+          I row_index = I(j + n);
+          T alpha = j < n_eq ? results.info.mu_eq - new_bcl_mu_eq
+                             : results.info.mu_in - new_bcl_mu_in;
+          proxsuite::linalg::sparse::rank1_update_supernodal(
+            work.internal.supernodal,
+            { proxsuite::linalg::veg::from_raw_parts,
+              n + n_eq + n_in,
+              1,
+              &row_index,
+              &value },
+            alpha,
+            stack);
+          PROXSUITE_PROFILE_COUNT(results.info.profile.mu_update_rank, 1);
         }
       } else {
         refactorize(
@@ -1375,6 +1634,9 @@ qp_solve(Results<T>& results,
   LDLT_TEMP_VEC_UNINIT(T, tmp, n, stack);
   tmp.setZero();
   detail::noalias_symhiv_add(tmp, qp_scaled.H.to_eigen(), x_e);
+  if (linear_operator != nullptr) {
+    linear_operator->H_add(tmp, x_e);
+  }
   precond.unscale_dual_residual_in_place({ proxqp::from_eigen, tmp });
 
   precond.unscale_primal_in_place({ proxqp::from_eigen, x_e });
@@ -24,6 +24,7 @@
 #include "proxsuite/proxqp/utils/prints.hpp"
 #include "proxsuite/proxqp/sparse/views.hpp"
 #include "proxsuite/proxqp/sparse/model.hpp"
+#include "proxsuite/proxqp/sparse/linear_operator.hpp"
 #include "proxsuite/proxqp/sparse/preconditioner/ruiz.hpp"
 #include "proxsuite/proxqp/sparse/preconditioner/identity.hpp"
 
@@ -297,6 +298,8 @@ struct AugmentedKkt : Eigen::EigenBase<AugmentedKkt<T, I>>
     T rho;
     T mu_eq;
     T mu_in;
+    // not null when the matrices of the QP are given as linear operators
+    ScaledLinearOperator<T> const* linear_operator;
   } _;
 
   AugmentedKkt /* NOLINT */ (Raw raw) noexcept
@@ -330,6 +333,205 @@ struct AugmentedKkt : Eigen::EigenBase<AugmentedKkt<T, I>>
   }
 };
 
+/*!
+ * Symmetric positive definite preconditioner of the augmented KKT matrix, used
+ * by the MINRES iterations of the MatrixFree sparse backend. It follows the
+ * interface of the Eigen preconditioners, the kind of preconditioner being
+ * selected at runtime (see MatrixFreePreconditioner).
+ */
+template<typename T, typename I>
+struct KktPreconditioner
+{
+  using Scalar = T;
+  using StorageIndex = I;
+  enum
+  {
+    ColsAtCompileTime = Eigen::Dynamic,
+    MaxColsAtCompileTime = Eigen::Dynamic,
+  };
+
+  MatrixFreePreconditioner kind = MatrixFreePreconditioner::Identity;
+
+  // inverse of the diagonal for BlockJacobi, inverse of |D| for IncompleteLdlt
+  Eigen::Matrix<T, Eigen::Dynamic, 1> inv_diag;
+  // strictly lower part of the incomplete factor, stored by rows, row j having
+  // the off-diagonal structure of the column j of the upper triangular kkt
+  proxsuite::linalg::veg::Vec<I> l_row_ptrs;
+  proxsuite::linalg::veg::Vec<I> l_col_indices;
+  proxsuite::linalg::veg::Vec<T> l_values;
+  Eigen::Matrix<T, Eigen::Dynamic, 1> d;
+  Eigen::Matrix<T, Eigen::Dynamic, 1> work;
+
+  auto rows() const noexcept -> isize { return inv_diag.rows(); }
+  auto cols() const noexcept -> isize { return inv_diag.rows(); }
+
+  template<typename MatType>
+  auto analyzePattern(MatType const& /*mat*/) -> KktPreconditioner&
+  {
+    return *this;
+  }
+
+  auto factorize(AugmentedKkt<T, I> const& mat) -> KktPreconditioner&
+  {
+    using std::abs;
+    auto zx = proxsuite::linalg::sparse::util::zero_extend;
+
+    auto kkt = mat._.kkt_active;
+    isize n = mat._.n;
+    isize n_eq = mat._.n_eq;
+    isize n_tot = mat.rows();
+    I const* ki = kkt.row_indices();
+    T const* kx = kkt.values();
+
+    // diagonal of the augmented kkt: rho for the primal variables, -mu_eq and
+    // -mu_in for the active constraints and 1 for the inactive ones
+    d.resize(n_tot);
+    for (isize j = 0; j < n_tot; ++j) {
+      if (j < n) {
+        d[j] = mat._.rho;
+      } else if (j < n + n_eq) {
+        d[j] = -1 / mat._.mu_eq;
+      } else {
+        d[j] = mat._.active_constraints[j - n - n_eq] ? -1 / mat._.mu_in : T(1);
+      }
+      for (usize p = kkt.col_start(usize(j)); p < kkt.col_end(usize(j)); ++p) {
+        if (isize(zx(ki[p])) == j) {
+          d[j] += kx[p];
+        }
+      }
+    }
+    if (mat._.linear_operator != nullptr &&
+        mat._.linear_operator->H_diagonal_scaled.rows() == n) {
+      d.head(n) += mat._.linear_operator->H_diagonal_scaled;
+    }
+    inv_diag.resize(n_tot);
+
+    switch (kind) {
+      case MatrixFreePreconditioner::Identity: {
+        inv_diag.setOnes();
+        break;
+      }
+      case MatrixFreePreconditioner::BlockJacobi: {
+        // primal block, then diagonal of the schur complement of the
+        // constraints
+        for (isize j = 0; j < n_tot; ++j) {
+          T dj = abs(d[j]);
+          if (j >= n) {
+            for (usize p = kkt.col_start(usize(j)); p < kkt.col_end(usize(j));
+                 ++p) {
+              isize i = isize(zx(ki[p]));
+              if (i < n) {
+                dj += kx[p] * kx[p] * inv_diag[i];
+              }
+            }
+          }
+          inv_diag[j] = dj > T(0) ? T(1) / dj : T(1);
+        }
+        break;
+      }
+      case MatrixFreePreconditioner::IncompleteLdlt: {
+        // up-looking factorization, restricted to the structure of the kkt
+        isize nnz = 0;
+        for (usize j = 0; j < usize(n_tot); ++j) {
+          nnz += isize(kkt.col_end(j) - kkt.col_start(j));
+        }
+        l_row_ptrs.resize_for_overwrite(n_tot + 1);
+        l_col_indices.resize_for_overwrite(nnz);
+        l_values.resize_for_overwrite(nnz);
+        work.setZero(n_tot);
+
+        I* lp = l_row_ptrs.ptr_mut();
+        I* li = l_col_indices.ptr_mut();
+        T* lx = l_values.ptr_mut();
+
+        T eps = std::numeric_limits<T>::epsilon();
+        lp[0] = I(0);
+        usize pos = 0;
+        for (isize j = 0; j < n_tot; ++j) {
+          T dj = d[j];
+          T scale = abs(d[j]);
+          usize row_start = pos;
+          for (usize p = kkt.col_start(usize(j)); p < kkt.col_end(usize(j));
+               ++p) {
+            isize i = isize(zx(ki[p]));
+            if (i >= j) {
+              continue;
+            }
+            // work[k] holds l_jk * d_k for the entries k < i of the row j
+            T s = kx[p];
+            for (usize q = usize(zx(lp[i])); q < usize(zx(lp[i + 1])); ++q) {
+              s -= lx[q] * work[isize(zx(li[q]))];
+            }
+            work[i] = s;
+            li[pos] = I(i);
+            lx[pos] = s / d[i];
+            dj -= s * lx[pos];
+            scale += abs(s * lx[pos]);
+            ++pos;
+          }
+          for (usize q = row_start; q < pos; ++q) {
+            work[isize(zx(li[q]))] = T(0);
+          }
+          // breakdown of the incomplete factorization
+          if (abs(dj) <= eps * scale) {
+            dj = scale > T(0) ? (d[j] < T(0) ? -scale : scale) : T(1);
+          }
+          d[j] = dj;
+          inv_diag[j] = T(1) / abs(dj);
+          lp[j + 1] = I(pos);
+        }
+        break;
+      }
+    }
+    return *this;
+  }
+
+  auto compute(AugmentedKkt<T, I> const& mat) -> KktPreconditioner&
+  {
+    return factorize(mat);
+  }
+
+  template<typename Rhs, typename Dest>
+  void _solve_impl(Rhs const& b, Dest& x) const
+  {
+    if (kind != MatrixFreePreconditioner::IncompleteLdlt) {
+      x = inv_diag.array() * b.array();
+      return;
+    }
+    // solves L |D| L.T x = b
+    auto zx = proxsuite::linalg::sparse::util::zero_extend;
+    isize n_tot = rows();
+    I const* lp = l_row_ptrs.ptr();
+    I const* li = l_col_indices.ptr();
+    T const* lx = l_values.ptr();
+
+    x = b;
+    for (isize j = 0; j < n_tot; ++j) {
+      T xj = x[j];
+      for (usize q = usize(zx(lp[j])); q < usize(zx(lp[j + 1])); ++q) {
+        xj -= lx[q] * x[isize(zx(li[q]))];
+      }
+      x[j] = xj;
+    }
+    x.array() *= inv_diag.array();
+    for (isize j = n_tot - 1; j >= 0; --j) {
+      T xj = x[j];
+      for (usize q = usize(zx(lp[j])); q < usize(zx(lp[j + 1])); ++q) {
+        x[isize(zx(li[q]))] -= lx[q] * xj;
+      }
+    }
+  }
+
+  template<typename Rhs>
+  auto solve(Eigen::MatrixBase<Rhs> const& b) const
+    -> Eigen::Solve<KktPreconditioner, Rhs> const
+  {
+    return Eigen::Solve<KktPreconditioner, Rhs>(*this, b.derived());
+  }
+
+  auto info() -> Eigen::ComputationInfo { return Eigen::Success; }
+};
+
 template<typename T>
 using VecMapMut = Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, 1>,
                              Eigen::Unaligned,
@@ -635,6 +837,8 @@ unscaled_primal_dual_residual(
   proxsuite::linalg::veg::dynstack::DynStackMut stack)
   -> proxsuite::linalg::veg::Tuple<T, T>
 {
+  PROXSUITE_PROFILE_SCOPE(results.info.profile.residual_time);
+  PROXSUITE_PROFILE_COUNT(results.info.profile.residual_evaluations, 1);
   isize n = x_e.rows();
 
   LDLT_TEMP_VEC_UNINIT(T, tmp, n, stack);
@@ -642,6 +846,9 @@ unscaled_primal_dual_residual(
   {
     tmp.setZero();
     noalias_symhiv_add(tmp, qp_scaled.H.to_eigen(), x_e);
+    if (work.internal.linear_operator != nullptr) {
+      work.internal.linear_operator->H_add(tmp, x_e);
+    }
     dual_residual_scaled += tmp;
 
     precond.unscale_dual_residual_in_place(
@@ -687,6 +894,10 @@ unscaled_primal_dual_residual(
 
     detail::noalias_gevmmv_add(
       primal_residual_eq_scaled, ATy, qp_scaled.AT.to_eigen(), x_e, y_e);
+    if (work.internal.linear_operator != nullptr) {
+      work.internal.linear_operator->A_add(primal_residual_eq_scaled, x_e);
+      work.internal.linear_operator->AT_add(ATy, y_e);
+    }
 
     dual_residual_scaled += ATy;
 
@@ -701,6 +912,10 @@ unscaled_primal_dual_residual(
 
     detail::noalias_gevmmv_add(
       primal_residual_in_scaled_up, CTz, qp_scaled.CT.to_eigen(), x_e, z_e);
+    if (work.internal.linear_operator != nullptr) {
+      work.internal.linear_operator->C_add(primal_residual_in_scaled_up, x_e);
+      work.internal.linear_operator->CT_add(CTz, z_e);
+    }
 
     dual_residual_scaled += CTz;
 
@@ -786,6 +1001,9 @@ struct generic_product_impl<
     VEG_ASSERT(alpha == Scalar(1));
     proxsuite::proxqp::sparse::detail::noalias_symhiv_add(
       dst, lhs._.kkt_active.to_eigen(), rhs);
+    if (lhs._.linear_operator != nullptr) {
+      lhs._.linear_operator->kkt_add(dst, rhs, lhs._.active_constraints);
+    }
 
     {
       isize n = lhs._.n;
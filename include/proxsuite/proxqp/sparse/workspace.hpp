@@ -11,6 +11,7 @@
 #include <proxsuite/linalg/sparse/factorize.hpp>
 #include <proxsuite/linalg/sparse/update.hpp>
 #include <proxsuite/linalg/sparse/rowmod.hpp>
+#include <proxsuite/linalg/sparse/supernodal.hpp>
 #include <proxsuite/proxqp/timings.hpp>
 #include <proxsuite/proxqp/settings.hpp>
 #include <proxsuite/proxqp/dense/views.hpp>
@@ -42,21 +43,23 @@ refactorize(Workspace<T, I>& work,
   T mu_eq_neg = -results.info.mu_eq;
   T mu_in_neg = -results.info.mu_in;
 
-  if (work.internal.do_ldlt) {
-    proxsuite::linalg::sparse::factorize_symbolic_non_zeros(
-      work.internal.ldl.nnz_counts.ptr_mut(),
-      work.internal.ldl.etree.ptr_mut(),
-      work.internal.ldl.perm_inv.ptr_mut(),
-      work.internal.ldl.perm.ptr_mut(),
-      kkt_active.symbolic(),
-      stack);
-
-    isize nnz = 0;
-    VEG_ONLY_USED_FOR_DEBUG(nnz);
-    for (usize j = 0; j < usize(kkt_active.ncols()); ++j) {
-      nnz += usize(kkt_active.col_end(j) - kkt_active.col_start(j));
+  if (work.internal.do_ldlt || work.internal.do_supernodal) {
+    if (work.internal.do_ldlt) {
+      proxsuite::linalg::sparse::factorize_symbolic_non_zeros(
+        work.internal.ldl.nnz_counts.ptr_mut(),
+        work.internal.ldl.etree.ptr_mut(),
+        work.internal.ldl.perm_inv.ptr_mut(),
+        work.internal.ldl.perm.ptr_mut(),
+        kkt_active.symbolic(),
+        stack);
+
+      isize nnz = 0;
+      VEG_ONLY_USED_FOR_DEBUG(nnz);
+      for (usize j = 0; j < usize(kkt_active.ncols()); ++j) {
+        nnz += usize(kkt_active.col_end(j) - kkt_active.col_start(j));
+      }
+      VEG_ASSERT(kkt_active.nnz() == nnz);
     }
-    VEG_ASSERT(kkt_active.nnz() == nnz);
     auto _diag = stack.make_new_for_overwrite(xtag, n_tot);
     T* diag = _diag.ptr_mut();
 
@@ -71,25 +74,84 @@ refactorize(Workspace<T, I>& work,
         active_constraints[i] ? mu_in_neg : T(1);
     }
 
-    proxsuite::linalg::sparse::factorize_numeric(
-      work.internal.ldl.values.ptr_mut(),
-      work.internal.ldl.row_indices.ptr_mut(),
-      diag,
-      work.internal.ldl.perm.ptr_mut(),
-      work.internal.ldl.col_ptrs.ptr(),
-      work.internal.ldl.etree.ptr_mut(),
-      work.internal.ldl.perm_inv.ptr_mut(),
-      kkt_active.as_const(),
-      stack);
+    if (work.internal.do_supernodal) {
+      // the supernodal structure is the one of the full kkt matrix, inactive
+      // constraints are decoupled through their unit diagonal
+      proxsuite::linalg::sparse::factorize_numeric_supernodal(
+        work.internal.supernodal, diag, kkt_active.as_const(), stack);
+    } else if (work.internal.mixed_precision) {
+      // the active part of the kkt matrix and the diagonal are converted to
+      // single precision before the factorization
+      proxsuite::linalg::veg::Tag<float> ftag;
+      auto zx = proxsuite::linalg::sparse::util::zero_extend;
+      auto _diag_low = stack.make_new_for_overwrite(ftag, n_tot);
+      auto _kkt_values_low = stack.make_new_for_overwrite(
+        ftag, isize(zx(kkt_active.col_ptrs()[n_tot])));
+      float* diag_low = _diag_low.ptr_mut();
+      float* kkt_values_low = _kkt_values_low.ptr_mut();
+      for (isize i = 0; i < n_tot; ++i) {
+        diag_low[i] = float(diag[i]);
+      }
+      for (usize j = 0; j < usize(n_tot); ++j) {
+        for (usize p = kkt_active.col_start(j); p < kkt_active.col_end(j);
+             ++p) {
+          kkt_values_low[p] = float(kkt_active.values()[p]);
+        }
+      }
+      proxsuite::linalg::sparse::factorize_numeric(
+        work.internal.ldl.values_low.ptr_mut(),
+        work.internal.ldl.row_indices.ptr_mut(),
+        diag_low,
+        work.internal.ldl.perm.ptr_mut(),
+        work.internal.ldl.col_ptrs.ptr(),
+        work.internal.ldl.etree.ptr_mut(),
+        work.internal.ldl.perm_inv.ptr_mut(),
+        proxsuite::linalg::sparse::MatRef<float, I>{
+          proxsuite::linalg::sparse::from_raw_parts,
+          n_tot,
+          n_tot,
+          kkt_active.nnz(),
+          kkt_active.col_ptrs(),
+          kkt_active.nnz_per_col(),
+          kkt_active.row_indices(),
+          kkt_values_low,
+        },
+        stack);
+    } else {
+      proxsuite::linalg::sparse::factorize_numeric(
+        work.internal.ldl.values.ptr_mut(),
+        work.internal.ldl.row_indices.ptr_mut(),
+        diag,
+        work.internal.ldl.perm.ptr_mut(),
+        work.internal.ldl.col_ptrs.ptr(),
+        work.internal.ldl.etree.ptr_mut(),
+        work.internal.ldl.perm_inv.ptr_mut(),
+        kkt_active.as_const(),
+        stack);
+    }
   } else {
-    *work.internal.matrix_free_kkt = { { kkt_active.as_const(),
-                                         active_constraints.as_const(),
-                                         data.dim,
-                                         data.n_eq,
-                                         data.n_in,
-                                         results.info.rho,
-                                         results.info.mu_eq_inv,
-                                         results.info.mu_in_inv } };
+    typename detail::AugmentedKkt<T, I>::Raw raw = {
+      kkt_active.as_const(),
+      active_constraints.as_const(),
+      data.dim,
+      data.n_eq,
+      data.n_in,
+      results.info.rho,
+      results.info.mu_eq_inv,
+      results.info.mu_in_inv,
+      work.internal.linear_operator.get()
+    };
+    if (work.internal.matrix_free_kkt == nullptr) {
+      // the workspace has been loaded from an archive
+      using MatrixFreeSolver = Eigen::MINRES<detail::AugmentedKkt<T, I>,
+                                             Eigen::Upper | Eigen::Lower,
+                                             detail::KktPreconditioner<T, I>>;
+      work.internal.matrix_free_kkt.reset(
+        new detail::AugmentedKkt<T, I>{ raw });
+      work.internal.matrix_free_solver.reset(new MatrixFreeSolver);
+    } else {
+      *work.internal.matrix_free_kkt = { raw };
+    }
     (*work.internal.matrix_free_solver).compute(*work.internal.matrix_free_kkt);
   }
 }
@@ -104,110 +166,85 @@ struct Ldlt
   proxsuite::linalg::veg::Vec<I> nnz_counts;
   proxsuite::linalg::veg::Vec<I> row_indices;
   proxsuite::linalg::veg::Vec<T> values;
+  proxsuite::linalg::veg::Vec<float>
+    values_low; // values in single precision, used instead of values in
+                // mixed precision mode
 };
 
-template<typename T, typename I>
-struct Workspace
+///
+/// @brief This class stores the symbolic factorization of the KKT matrix of a
+/// QP problem.
+///
+/*!
+ * The symbolic factorization (fill-reducing ordering, elimination tree and
+ * column counts of the LDLT factor of the KKT matrix) only depends on the
+ * sparsity structure of the QP. It can hence be computed once and then used
+ * read-only for setting up any number of QPs sharing the same structure (see
+ * BatchQP).
+ */
+template<typename I>
+struct SymbolicFactorization
 {
+  isize dim;
+  isize n_eq;
+  isize n_in;
 
-  struct /* NOLINT */
-  {
-    // temporary allocations
-    proxsuite::linalg::veg::Vec<proxsuite::linalg::veg::mem::byte>
-      storage; // memory of the stack with the requirements req which determines
-               // its size.
-    Ldlt<T, I> ldl;
-    bool do_ldlt;
-    bool do_symbolic_fact;
-    // persistent allocations
+  isize H_nnz;
+  isize A_nnz;
+  isize C_nnz;
 
-    Eigen::Matrix<T, Eigen::Dynamic, 1> g_scaled;
-    Eigen::Matrix<T, Eigen::Dynamic, 1> b_scaled;
-    Eigen::Matrix<T, Eigen::Dynamic, 1> l_scaled;
-    Eigen::Matrix<T, Eigen::Dynamic, 1> u_scaled;
-    proxsuite::linalg::veg::Vec<I> kkt_nnz_counts;
-
-    // stored in unique_ptr because we need a stable address
-    std::unique_ptr<detail::AugmentedKkt<T, I>>
-      matrix_free_kkt; // view on active part of the KKT which includes the
-                       // regularizations
-    std::unique_ptr<Eigen::MINRES<detail::AugmentedKkt<T, I>,
-                                  Eigen::Upper | Eigen::Lower,
-                                  Eigen::IdentityPreconditioner>>
-      matrix_free_solver; // eigen based method which takes in entry vector, and
-                          // performs matrix vector products
-
-    auto stack_mut() -> proxsuite::linalg::veg::dynstack::DynStackMut
-    {
-      return {
-        proxsuite::linalg::veg::from_slice_mut,
-        storage.as_mut(),
-      };
-    } // exploits all available memory in storage
+  proxsuite::linalg::veg::Vec<I> kkt_col_ptrs;
+  proxsuite::linalg::veg::Vec<I> kkt_row_indices;
 
-    // Whether the workspace is dirty
-    bool dirty;
-    bool proximal_parameter_update;
-    bool is_initialized;
+  proxsuite::linalg::veg::Vec<I> etree;
+  proxsuite::linalg::veg::Vec<I> perm_inv;
+  proxsuite::linalg::veg::Vec<I> col_ptrs; // column pointers of the LDLT factor
 
-  } internal;
-  VecBool active_set_up;
-  VecBool active_set_low;
-  proxsuite::linalg::veg::Vec<bool> active_inequalities;
   isize lnnz;
+  bool overflow;
+  proxsuite::linalg::sparse::Ordering ordering;
+
   /*!
-   * Constructor using the symbolic factorization.
-   * @param results solver's results.
-   * @param data solver's model.
-   * @param settings solver's settings.
-   * @param precond_req storage requirements for the solver's preconditioner.
-   * @param H symbolic structure of the quadratic cost input defining the QP
-   * model.
-   * @param A symbolic structure of the equality constraint matrix input
-   * defining the QP model.
-   * @param C symbolic structure of the inequality constraint matrix input
-   * defining the QP model.
+   * Computes the symbolic factorization of the KKT matrix.
+   * @param H symbolic structure of the upper triangular part of the quadratic
+   * cost.
+   * @param AT symbolic structure of the transposed equality constraint matrix.
+   * @param CT symbolic structure of the transposed inequality constraint
+   * matrix.
+   * @param ordering fill-reducing ordering applied to the KKT matrix, it must
+   * match the sparse_ordering setting of the QPs using this factorization.
    */
-  void setup_symbolic_factorizaton(
-    Model<T, I>& data,
-    proxsuite::linalg::sparse::SymbolicMatRef<I> H,
-    proxsuite::linalg::sparse::SymbolicMatRef<I> AT,
-    proxsuite::linalg::sparse::SymbolicMatRef<I> CT)
+  SymbolicFactorization(proxsuite::linalg::sparse::SymbolicMatRef<I> H,
+                        proxsuite::linalg::sparse::SymbolicMatRef<I> AT,
+                        proxsuite::linalg::sparse::SymbolicMatRef<I> CT,
+                        proxsuite::linalg::sparse::Ordering ordering =
+                          proxsuite::linalg::sparse::Ordering::amd)
+    : dim(H.nrows())
+    , n_eq(AT.ncols())
+    , n_in(CT.ncols())
+    , H_nnz(H.nnz())
+    , A_nnz(AT.nnz())
+    , C_nnz(CT.nnz())
+    , lnnz(0)
+    , overflow(false)
+    , ordering(ordering)
   {
-    auto& ldl = internal.ldl;
-
-    auto& storage = internal.storage;
-    auto& do_ldlt = internal.do_ldlt;
-    // persistent allocations
-
-    data.dim = H.nrows();
-    data.n_eq = AT.ncols();
-    data.n_in = CT.ncols();
-    data.H_nnz = H.nnz();
-    data.A_nnz = AT.nnz();
-    data.C_nnz = CT.nnz();
-
     using namespace proxsuite::linalg::veg::dynstack;
     using namespace proxsuite::linalg::sparse::util;
     proxsuite::linalg::veg::Tag<I> itag;
 
-    isize n = H.nrows();
-    isize n_eq = AT.ncols();
-    isize n_in = CT.ncols();
-    isize n_tot = n + n_eq + n_in;
-
-    isize nnz_tot = H.nnz() + AT.nnz() + CT.nnz();
+    isize n_tot = dim + n_eq + n_in;
+    isize nnz_tot = H_nnz + A_nnz + C_nnz;
 
     // form the full kkt matrix
     // assuming H, AT, CT are sorted
     // and H is upper triangular
     {
-      data.kkt_col_ptrs.resize_for_overwrite(n_tot + 1); //
-      data.kkt_row_indices.resize_for_overwrite(nnz_tot);
-      data.kkt_values.resize_for_overwrite(nnz_tot);
+      kkt_col_ptrs.resize_for_overwrite(n_tot + 1);
+      kkt_row_indices.resize_for_overwrite(nnz_tot);
 
-      I* kktp = data.kkt_col_ptrs.ptr_mut();
-      I* kkti = data.kkt_row_indices.ptr_mut();
+      I* kktp = kkt_col_ptrs.ptr_mut();
+      I* kkti = kkt_row_indices.ptr_mut();
 
       kktp[0] = 0;
       usize col = 0;
@@ -245,68 +282,186 @@ struct Workspace
       insert_submatrix(CT, false);
     }
 
-    data.kkt_col_ptrs_unscaled = data.kkt_col_ptrs;
-    data.kkt_row_indices_unscaled = data.kkt_row_indices;
-
+    proxsuite::linalg::veg::Vec<proxsuite::linalg::veg::mem::byte> storage;
     storage.resize_for_overwrite( //
       (StackReq::with_len(itag, n_tot) &
        proxsuite::linalg::sparse::factorize_symbolic_req( //
          itag,                                            //
          n_tot,                                           //
          nnz_tot,                                         //
-         proxsuite::linalg::sparse::Ordering::amd))       //
+         ordering))                                       //
         .alloc_req()                                      //
     );
+    DynStackMut stack{ proxsuite::linalg::veg::from_slice_mut,
+                       storage.as_mut() };
 
-    ldl.col_ptrs.resize_for_overwrite(n_tot + 1);
-    ldl.perm_inv.resize_for_overwrite(n_tot);
+    col_ptrs.resize_for_overwrite(n_tot + 1);
+    perm_inv.resize_for_overwrite(n_tot);
+    etree.resize_for_overwrite(n_tot);
 
-    DynStackMut stack = stack_mut();
+    auto kkt_sym = proxsuite::linalg::sparse::SymbolicMatRef<I>{
+      proxsuite::linalg::sparse::from_raw_parts,
+      n_tot,
+      n_tot,
+      nnz_tot,
+      kkt_col_ptrs.ptr(),
+      nullptr,
+      kkt_row_indices.ptr(),
+    };
+    proxsuite::linalg::sparse::factorize_symbolic_non_zeros( //
+      col_ptrs.ptr_mut() +
+        1, // reimplements col counts to get the matrix free version as well
+      etree.ptr_mut(),
+      perm_inv.ptr_mut(),
+      static_cast<I const*>(nullptr),
+      kkt_sym,
+      stack,
+      ordering);
+
+    auto pcol_ptrs = col_ptrs.ptr_mut();
+    pcol_ptrs[0] = I(0);
+
+    using proxsuite::linalg::veg::u64;
+    u64 acc = 0;
+
+    for (usize i = 0; i < usize(n_tot); ++i) {
+      acc += u64(zero_extend(pcol_ptrs[i + 1]));
+      if (acc != u64(I(acc))) {
+        overflow = true;
+      }
+      pcol_ptrs[(i + 1)] = I(acc);
+    }
+
+    lnnz = isize(zero_extend(col_ptrs[n_tot]));
+  }
+};
+
+template<typename T, typename I>
+struct Workspace
+{
+
+  struct /* NOLINT */
+  {
+    // temporary allocations
+    proxsuite::linalg::veg::Vec<proxsuite::linalg::veg::mem::byte>
+      storage; // memory of the stack with the requirements req which determines
+               // its size.
+    Ldlt<T, I> ldl;
+    proxsuite::linalg::sparse::SupernodalLdlt<T, I>
+      supernodal; // supernodal factorization of the kkt matrix, used by the
+                  // SupernodalCholesky backend
+    bool do_ldlt;
+    bool do_supernodal;
+    bool mixed_precision; // the ldlt values are stored in single precision
+    bool do_symbolic_fact; // false when the cached symbolic factorization
+                           // (ordering, etree, column counts) can be reused
+    bool lnnz_overflow;
+    proxsuite::linalg::sparse::Ordering
+      ordering; // fill-reducing ordering of the cached symbolic factorization
+    // persistent allocations
+
+    Eigen::Matrix<T, Eigen::Dynamic, 1> g_scaled;
+    Eigen::Matrix<T, Eigen::Dynamic, 1> b_scaled;
+    Eigen::Matrix<T, Eigen::Dynamic, 1> l_scaled;
+    Eigen::Matrix<T, Eigen::Dynamic, 1> u_scaled;
+    proxsuite::linalg::veg::Vec<I> kkt_nnz_counts;
+    // position in the unscaled kkt values of each stored entry of the CSC
+    // matrices given to init (-1 for the entries of H below the diagonal),
+    // used by update_values for refreshing the values in place
+    proxsuite::linalg::veg::Vec<I> H_values_map;
+    proxsuite::linalg::veg::Vec<I> A_values_map;
+    proxsuite::linalg::veg::Vec<I> C_values_map;
 
-    bool overflow = false;
+    // stored in unique_ptr because we need a stable address
+    std::unique_ptr<detail::AugmentedKkt<T, I>>
+      matrix_free_kkt; // view on active part of the KKT which includes the
+                       // regularizations
+    std::unique_ptr<Eigen::MINRES<detail::AugmentedKkt<T, I>,
+                                  Eigen::Upper | Eigen::Lower,
+                                  detail::KktPreconditioner<T, I>>>
+      matrix_free_solver; // eigen based method which takes in entry vector, and
+                          // performs matrix vector products
+    std::unique_ptr<detail::ScaledLinearOperator<T>>
+      linear_operator; // not null when the matrices of the QP are given as
+                       // linear operators, the kkt then only stores their
+                       // (empty) sparsity structure
+
+    auto stack_mut() -> proxsuite::linalg::veg::dynstack::DynStackMut
     {
-      ldl.etree.resize_for_overwrite(n_tot);
-      auto etree_ptr = ldl.etree.ptr_mut();
-
-      using namespace proxsuite::linalg::veg::literals;
-      auto kkt_sym = proxsuite::linalg::sparse::SymbolicMatRef<I>{
-        proxsuite::linalg::sparse::from_raw_parts,
-        n_tot,
-        n_tot,
-        nnz_tot,
-        data.kkt_col_ptrs.ptr(),
-        nullptr,
-        data.kkt_row_indices.ptr(),
+      return {
+        proxsuite::linalg::veg::from_slice_mut,
+        storage.as_mut(),
       };
-      proxsuite::linalg::sparse::factorize_symbolic_non_zeros( //
-        ldl.col_ptrs.ptr_mut() +
-          1, // reimplements col counts to get the matrix free version as well
-        etree_ptr,
-        ldl.perm_inv.ptr_mut(),
-        static_cast<I const*>(nullptr),
-        kkt_sym,
-        stack);
-
-      auto pcol_ptrs = ldl.col_ptrs.ptr_mut();
-      pcol_ptrs[0] = I(0);
+    } // exploits all available memory in storage
 
-      using proxsuite::linalg::veg::u64;
-      u64 acc = 0;
+    // Whether the workspace is dirty
+    bool dirty;
+    bool proximal_parameter_update;
+    bool is_initialized;
 
-      for (usize i = 0; i < usize(n_tot); ++i) {
-        acc += u64(zero_extend(pcol_ptrs[i + 1]));
-        if (acc != u64(I(acc))) {
-          overflow = true;
-        }
-        pcol_ptrs[(i + 1)] = I(acc);
-      }
-    }
+  } internal;
+  VecBool active_set_up;
+  VecBool active_set_low;
+  proxsuite::linalg::veg::Vec<bool> active_inequalities;
+  isize lnnz;
+  /*!
+   * Constructor using the symbolic factorization.
+   * @param results solver's results.
+   * @param data solver's model.
+   * @param settings solver's settings.
+   * @param precond_req storage requirements for the solver's preconditioner.
+   * @param H symbolic structure of the quadratic cost input defining the QP
+   * model.
+   * @param A symbolic structure of the equality constraint matrix input
+   * defining the QP model.
+   * @param C symbolic structure of the inequality constraint matrix input
+   * defining the QP model.
+   */
+  void setup_symbolic_factorizaton(
+    Model<T, I>& data,
+    proxsuite::linalg::sparse::SymbolicMatRef<I> H,
+    proxsuite::linalg::sparse::SymbolicMatRef<I> AT,
+    proxsuite::linalg::sparse::SymbolicMatRef<I> CT)
+  {
+    setup_symbolic_factorizaton(data, SymbolicFactorization<I>(H, AT, CT));
+  }
+  /*!
+   * Constructor using a symbolic factorization computed beforehand, which may
+   * be shared by several QPs with the same sparsity structure.
+   * @param data solver's model.
+   * @param symbolic symbolic factorization of the KKT matrix of the QP.
+   */
+  void setup_symbolic_factorizaton(Model<T, I>& data,
+                                   SymbolicFactorization<I> const& symbolic)
+  {
+    auto& ldl = internal.ldl;
 
-    lnnz = isize(zero_extend(ldl.col_ptrs[n_tot]));
+    data.dim = symbolic.dim;
+    data.n_eq = symbolic.n_eq;
+    data.n_in = symbolic.n_in;
+    data.H_nnz = symbolic.H_nnz;
+    data.A_nnz = symbolic.A_nnz;
+    data.C_nnz = symbolic.C_nnz;
+
+    data.kkt_col_ptrs = symbolic.kkt_col_ptrs;
+    data.kkt_row_indices = symbolic.kkt_row_indices;
+    data.kkt_values.resize_for_overwrite(symbolic.kkt_row_indices.len());
+    data.kkt_col_ptrs_unscaled = symbolic.kkt_col_ptrs;
+    data.kkt_row_indices_unscaled = symbolic.kkt_row_indices;
+
+    ldl.col_ptrs = symbolic.col_ptrs;
+    ldl.perm_inv = symbolic.perm_inv;
+    ldl.etree = symbolic.etree;
+    // the supernodal structure is recomputed lazily from the new ordering
+    internal.supernodal = {};
+
+    lnnz = symbolic.lnnz;
+    internal.lnnz_overflow = symbolic.overflow;
+    internal.ordering = symbolic.ordering;
 
     // if ldlt is too sparse
     // do_ldlt = !overflow && lnnz < (10000000);
-    do_ldlt = !overflow && lnnz < 10000000;
+    internal.do_ldlt = !symbolic.overflow && lnnz < 10000000;
 
     internal.do_symbolic_fact = false;
   }
@@ -319,6 +474,8 @@ struct Workspace
    * preconditioner for scaling the problem (and reduce its ill conditioning).
    * @param precond preconditioner chosen for the solver.
    * @param precond_req storage requirements for the solver's preconditioner.
+   * @param profile solver's profile, in which the equilibration time is
+   * accumulated.
    */
   template<typename P>
   void setup_impl(const QpView<T, I> qp,
@@ -326,7 +483,8 @@ struct Workspace
                   const Settings<T>& settings,
                   bool execute_or_not,
                   P& precond,
-                  proxsuite::linalg::veg::dynstack::StackReq precond_req)
+                  proxsuite::linalg::veg::dynstack::StackReq precond_req,
+                  PROXSUITE_MAYBE_UNUSED Profile<T>& profile)
   {
 
     auto& ldl = internal.ldl;
@@ -363,6 +521,7 @@ struct Workspace
     using SR = StackReq;
     proxsuite::linalg::veg::Tag<I> itag;
     proxsuite::linalg::veg::Tag<T> xtag;
+    proxsuite::linalg::veg::Tag<float> ftag;
 
     isize n = qp.H.nrows();
     isize n_eq = qp.AT.ncols();
@@ -371,6 +530,20 @@ struct Workspace
 
     isize nnz_tot = qp.H.nnz() + qp.AT.nnz() + qp.CT.nnz();
 
+    PROXSUITE_THROW_PRETTY(
+      settings.sparse_ordering ==
+        proxsuite::linalg::sparse::Ordering::user_provided,
+      std::invalid_argument,
+      "the user_provided ordering is not supported by the sparse backends, "
+      "choose amd, nested_dissection or natural instead.");
+
+    // the cached symbolic factorization is only valid for the ordering it was
+    // computed with
+    if (!internal.do_symbolic_fact &&
+        internal.ordering != settings.sparse_ordering) {
+      internal.do_symbolic_fact = true;
+    }
+
     if (internal.do_symbolic_fact) {
 
       // form the full kkt matrix
@@ -432,7 +605,7 @@ struct Workspace
            itag,                                            //
            n_tot,                                           //
            nnz_tot,                                         //
-           proxsuite::linalg::sparse::Ordering::amd))       //
+           settings.sparse_ordering))                       //
           .alloc_req()                                      //
       );
 
@@ -462,7 +635,8 @@ struct Workspace
           ldl.perm_inv.ptr_mut(),
           static_cast<I const*>(nullptr),
           kkt_sym,
-          stack);
+          stack,
+          settings.sparse_ordering);
 
         auto pcol_ptrs = ldl.col_ptrs.ptr_mut();
         pcol_ptrs[0] = I(0); // pcol_ptrs +1: pointor towards the nbr of non
@@ -482,19 +656,18 @@ struct Workspace
         }
       }
 
-      auto lnnz = isize(zero_extend(ldl.col_ptrs[n_tot]));
+      lnnz = isize(zero_extend(ldl.col_ptrs[n_tot]));
+      internal.lnnz_overflow = overflow;
+      internal.ordering = settings.sparse_ordering;
+      internal.supernodal = {};
 
-      // if ldlt is too sparse
-      // do_ldlt = !overflow && lnnz < (10000000);
-      if (settings.sparse_backend == SparseBackend::Automatic) {
-        do_ldlt = !overflow && lnnz < 10000000;
-      } else if (settings.sparse_backend == SparseBackend::SparseCholesky) {
-        do_ldlt = true;
-      } else {
-        do_ldlt = false;
-      }
+      // the symbolic factorization only depends on the sparsity structure of
+      // the problem, it is reused as long as the structure does not change
+      internal.do_symbolic_fact = false;
 
     } else {
+      // numeric-only refresh: the sparsity structure is unchanged, hence the
+      // cached ordering, etree and column pointers of the ldlt are reused
       T* kktx = data.kkt_values.ptr_mut();
       usize pos = 0;
       auto insert_submatrix =
@@ -519,6 +692,53 @@ struct Workspace
       insert_submatrix(qp.CT);
       data.kkt_values_unscaled = data.kkt_values;
     }
+
+    // if ldlt is too sparse
+    // do_ldlt = !overflow && lnnz < (10000000);
+    if (internal.linear_operator != nullptr) {
+      // only matrix vector products are available
+      do_ldlt = false;
+    } else if (settings.sparse_backend == SparseBackend::Automatic) {
+      do_ldlt = !internal.lnnz_overflow && lnnz < 10000000;
+    } else if (settings.sparse_backend == SparseBackend::SparseCholesky) {
+      do_ldlt = true;
+    } else {
+      do_ldlt = false;
+    }
+    internal.do_supernodal =
+      internal.linear_operator == nullptr &&
+      settings.sparse_backend == SparseBackend::SupernodalCholesky;
+
+    if (internal.do_supernodal && internal.supernodal.n != n_tot) {
+      // the supernodes are computed once for the full kkt matrix, using the
+      // same fill-reducing ordering as the simplicial factorization
+      storage.resize_for_overwrite( //
+        (StackReq::with_len(itag, n_tot) &
+         proxsuite::linalg::sparse::factorize_symbolic_supernodal_req( //
+           itag,
+           n_tot,
+           nnz_tot))
+          .alloc_req());
+      DynStackMut stack = stack_mut();
+      auto _perm = stack.make_new_for_overwrite(itag, n_tot);
+      I* perm = _perm.ptr_mut();
+      for (isize i = 0; i < n_tot; ++i) {
+        perm[isize(zero_extend(ldl.perm_inv[i]))] = I(i);
+      }
+      proxsuite::linalg::sparse::factorize_symbolic_supernodal(
+        internal.supernodal,
+        perm,
+        proxsuite::linalg::sparse::SymbolicMatRef<I>{
+          proxsuite::linalg::sparse::from_raw_parts,
+          n_tot,
+          n_tot,
+          nnz_tot,
+          data.kkt_col_ptrs.ptr(),
+          nullptr,
+          data.kkt_row_indices.ptr(),
+        },
+        stack);
+    }
 #define PROX_QP_ALL_OF(...)                                                    \
   ::proxsuite::linalg::veg::dynstack::StackReq::and_(                          \
     ::proxsuite::linalg::veg::init_list(__VA_ARGS__))
@@ -536,6 +756,8 @@ struct Workspace
               proxsuite::linalg::sparse::Ordering::user_provided),
             PROX_QP_ALL_OF({
               SR::with_len(xtag, n_tot),                        // diag
+              SR::with_len(ftag, n_tot),   // diag in single precision
+              SR::with_len(ftag, nnz_tot), // kkt in single precision
               proxsuite::linalg::sparse::factorize_numeric_req( // numeric ldl
                 xtag,
                 itag,
@@ -544,6 +766,12 @@ struct Workspace
                 proxsuite::linalg::sparse::Ordering::user_provided),
             }),
           })
+      : internal.do_supernodal
+        ? PROX_QP_ALL_OF({
+            SR::with_len(xtag, n_tot), // diag
+            proxsuite::linalg::sparse::factorize_numeric_supernodal_req(
+              internal.supernodal, nnz_tot),
+          })
         : PROX_QP_ALL_OF({
             SR::with_len(itag, 0), // compute necessary space for storing n elts
                                    // of type I (n = 0 here)
@@ -557,8 +785,21 @@ struct Workspace
 
     auto ldl_solve_in_place_req = PROX_QP_ALL_OF({
       x_vec(n_tot), // tmp
-      x_vec(n_tot), // err
-      x_vec(n_tot), // work
+      PROX_QP_ANY_OF({
+        PROX_QP_ALL_OF({
+          x_vec(n_tot), // err
+          x_vec(n_tot), // work
+          do_ldlt ? SR::with_len(ftag, n_tot) // work in single precision
+                  : SR::with_len(ftag, 0),
+          internal.do_supernodal
+            ? proxsuite::linalg::sparse::solve_supernodal_req(
+                internal.supernodal)
+            : SR::with_len(xtag, 0),
+        }),
+        // full precision refactorization when the iterative refinement
+        // stalls in mixed precision mode
+        do_ldlt ? refactorize_req : SR::with_len(xtag, 0),
+      }),
     });
 
     auto unscaled_primal_dual_residual_req = x_vec(n); // Hx
@@ -583,13 +824,20 @@ struct Workspace
                        n_in), // active_set_up
           SR::with_len(proxsuite::linalg::veg::Tag<bool>{},
                        n_in), // new_active_constraints
-          (do_ldlt && n_in > 0) ? PROX_QP_ANY_OF({
-                                    proxsuite::linalg::sparse::add_row_req(
-                                      xtag, itag, n_tot, false, n, n_tot),
-                                    proxsuite::linalg::sparse::delete_row_req(
-                                      xtag, itag, n_tot, n_tot),
-                                  })
-                                : refactorize_req,
+          (do_ldlt && n_in > 0)
+            ? PROX_QP_ANY_OF({
+                PROX_QP_ALL_OF({
+                  SR::with_len(ftag, n), // new column in single precision
+                  proxsuite::linalg::sparse::add_row_req(
+                    xtag, itag, n_tot, false, n, n_tot),
+                }),
+                proxsuite::linalg::sparse::delete_row_req(
+                  xtag, itag, n_tot, n_tot),
+              })
+          : internal.do_supernodal
+            ? proxsuite::linalg::sparse::update_supernodal_req(
+                internal.supernodal, n_tot)
+            : refactorize_req,
         }),
         PROX_QP_ALL_OF({
           x_vec(n),    // Hdx
@@ -617,7 +865,10 @@ struct Workspace
                            primal_dual_newton_semi_smooth_req,
                          }),
                        }) }),
-      refactorize_req, // mu_update
+      internal.do_supernodal
+        ? proxsuite::linalg::sparse::update_supernodal_req(internal.supernodal,
+                                                           1) // mu_update
+        : refactorize_req,                                    // mu_update
     });
 
     auto req = //
@@ -709,11 +960,18 @@ struct Workspace
     };
 
     DynStackMut stack = stack_mut();
-    precond.scale_qp_in_place(qp_scaled,
-                              execute_or_not,
-                              settings.preconditioner_max_iter,
-                              settings.preconditioner_accuracy,
-                              stack);
+    // the equilibration of linear operators is computed once at their
+    // initialization, from the diagonal of H
+    {
+      PROXSUITE_PROFILE_SCOPE(profile.equilibration_time);
+      precond.scale_qp_in_place(qp_scaled,
+                                execute_or_not &&
+                                  internal.linear_operator == nullptr,
+                                settings.preconditioner_max_iter,
+                                settings.preconditioner_accuracy,
+                                settings.preconditioner_warm_start,
+                                stack);
+    }
     kkt_nnz_counts.resize_for_overwrite(n_tot);
 
     proxsuite::linalg::sparse::MatMut<T, I> kkt_active = {
@@ -732,7 +990,7 @@ struct Workspace
 
     using MatrixFreeSolver = Eigen::MINRES<detail::AugmentedKkt<T, I>,
                                            Eigen::Upper | Eigen::Lower,
-                                           Eigen::IdentityPreconditioner>;
+                                           detail::KktPreconditioner<T, I>>;
     matrix_free_solver = std::unique_ptr<MatrixFreeSolver>{
       new MatrixFreeSolver,
     };
@@ -747,6 +1005,7 @@ struct Workspace
           {},
           {},
           {},
+          internal.linear_operator.get(),
         },
       }
     };
@@ -758,7 +1017,11 @@ struct Workspace
 
     ldl.nnz_counts.resize_for_overwrite(ldlt_ntot);
     ldl.row_indices.resize_for_overwrite(ldlt_lnnz);
-    ldl.values.resize_for_overwrite(ldlt_lnnz);
+    // the values are allocated in the precision of the factorization
+    internal.mixed_precision = do_ldlt && settings.mixed_precision;
+    ldl.values.resize_for_overwrite(internal.mixed_precision ? 0 : ldlt_lnnz);
+    ldl.values_low.resize_for_overwrite(internal.mixed_precision ? ldlt_lnnz
+                                                                 : 0);
 
     ldl.perm.resize_for_overwrite(ldlt_ntot);
     if (do_ldlt) {
@@ -11,6 +11,8 @@
 #include <proxsuite/proxqp/settings.hpp>
 #include <proxsuite/proxqp/sparse/solver.hpp>
 #include <proxsuite/proxqp/sparse/helpers.hpp>
+#include <memory>
+#include <vector>
 
 namespace proxsuite {
 namespace proxqp {
@@ -173,6 +175,170 @@ struct QP
             optional<T> rho = nullopt,
             optional<T> mu_eq = nullopt,
             optional<T> mu_in = nullopt)
+  {
+    work.internal.H_values_map.clear();
+    work.internal.A_values_map.clear();
+    work.internal.C_values_map.clear();
+    init_impl(std::move(H),
+              g,
+              std::move(A),
+              b,
+              std::move(C),
+              l,
+              u,
+              compute_preconditioner_,
+              rho,
+              mu_eq,
+              mu_in);
+  };
+  /*!
+   * Setups the QP model from borrowed compressed sparse column matrices (e.g.,
+   * the buffers of scipy.sparse.csc_matrix objects), which are read in place
+   * instead of being copied into Eigen matrices. The matrices must be
+   * compressed, with sorted row indices in each column. The positions of
+   * their entries in the KKT matrix are recorded, so that their values can
+   * later be refreshed in place with update_values.
+   * @param H quadratic cost input defining the QP model.
+   * @param g linear cost input defining the QP model.
+   * @param A equality constraint matrix input defining the QP model.
+   * @param b equality constraint vector input defining the QP model.
+   * @param C inequality constraint matrix input defining the QP model.
+   * @param l lower inequality constraint vector input defining the QP model.
+   * @param u upper inequality constraint vector input defining the QP model.
+   * @param compute_preconditioner boolean parameter for executing or not the
+   * preconditioner.
+   * @param rho proximal step size wrt primal variable.
+   * @param mu_eq proximal step size wrt equality constrained multiplier.
+   * @param mu_in proximal step size wrt inequality constrained multiplier.
+   */
+  void init(optional<proxsuite::linalg::sparse::MatRef<T, I>> H,
+            optional<VecRef<T>> g,
+            optional<proxsuite::linalg::sparse::MatRef<T, I>> A,
+            optional<VecRef<T>> b,
+            optional<proxsuite::linalg::sparse::MatRef<T, I>> C,
+            optional<VecRef<T>> l,
+            optional<VecRef<T>> u,
+            bool compute_preconditioner_ = true,
+            optional<T> rho = nullopt,
+            optional<T> mu_eq = nullopt,
+            optional<T> mu_in = nullopt)
+  {
+    using MatMap = Eigen::Map<Eigen::SparseMatrix<T, Eigen::ColMajor, I> const>;
+    using proxsuite::linalg::sparse::util::zero_extend;
+
+    auto& H_map = work.internal.H_values_map;
+    auto& A_map = work.internal.A_values_map;
+    auto& C_map = work.internal.C_values_map;
+    H_map.clear();
+    A_map.clear();
+    C_map.clear();
+
+    auto check_csc = [](proxsuite::linalg::sparse::MatRef<T, I> m,
+                        char const* name) -> void {
+      PROXSUITE_THROW_PRETTY(m.nnz_per_col() != nullptr,
+                             std::invalid_argument,
+                             "the matrix " << name
+                                           << " should be compressed.");
+      I const* mp = m.col_ptrs();
+      I const* mi = m.row_indices();
+      for (isize j = 0; j < m.ncols(); ++j) {
+        for (usize p = zero_extend(mp[j]) + 1; p < zero_extend(mp[j + 1]);
+             ++p) {
+          PROXSUITE_THROW_PRETTY(
+            mi[p - 1] >= mi[p],
+            std::invalid_argument,
+            "the row indices of the matrix " << name
+                                             << " should be sorted.");
+        }
+      }
+    };
+    // the entries of A (resp. C) are stored in the transposed block of the kkt
+    // matrix: the entries of its i-th row are laid out contiguously, in
+    // increasing column order
+    auto transposed_map = [](proxsuite::linalg::sparse::MatRef<T, I> m,
+                             proxsuite::linalg::veg::Vec<I>& map,
+                             isize offset) -> void {
+      I const* mp = m.col_ptrs();
+      I const* mi = m.row_indices();
+      proxsuite::linalg::veg::Vec<I> row_pos;
+      row_pos.resize(m.nrows() + 1);
+      for (usize p = 0; p < zero_extend(mp[m.ncols()]); ++p) {
+        ++row_pos[isize(zero_extend(mi[p])) + 1];
+      }
+      row_pos[0] = I(offset);
+      for (isize i = 0; i < m.nrows(); ++i) {
+        row_pos[i + 1] += row_pos[i];
+      }
+      map.resize_for_overwrite(isize(zero_extend(mp[m.ncols()])));
+      for (usize p = 0; p < zero_extend(mp[m.ncols()]); ++p) {
+        I& pos = row_pos[isize(zero_extend(mi[p]))];
+        map[isize(p)] = pos;
+        ++pos;
+      }
+    };
+
+    optional<MatMap> H_eigen;
+    optional<MatMap> A_eigen;
+    optional<MatMap> C_eigen;
+    isize H_triu_nnz = 0;
+    isize A_nnz = 0;
+    if (H != nullopt) {
+      check_csc(H.value(), "H");
+      I const* hp = H.value().col_ptrs();
+      I const* hi = H.value().row_indices();
+      H_map.resize_for_overwrite(isize(zero_extend(hp[H.value().ncols()])));
+      for (isize j = 0; j < H.value().ncols(); ++j) {
+        for (usize p = zero_extend(hp[j]); p < zero_extend(hp[j + 1]); ++p) {
+          if (isize(zero_extend(hi[p])) <= j) {
+            H_map[isize(p)] = I(H_triu_nnz);
+            ++H_triu_nnz;
+          } else {
+            H_map[isize(p)] = I(-1);
+          }
+        }
+      }
+      H_eigen = H.value().to_eigen();
+    }
+    if (A != nullopt) {
+      check_csc(A.value(), "A");
+      transposed_map(A.value(), A_map, H_triu_nnz);
+      A_nnz = A_map.len();
+      A_eigen = A.value().to_eigen();
+    }
+    if (C != nullopt) {
+      check_csc(C.value(), "C");
+      transposed_map(C.value(), C_map, H_triu_nnz + A_nnz);
+      C_eigen = C.value().to_eigen();
+    }
+    init_impl(std::move(H_eigen),
+              g,
+              std::move(A_eigen),
+              b,
+              std::move(C_eigen),
+              l,
+              u,
+              compute_preconditioner_,
+              rho,
+              mu_eq,
+              mu_in);
+  };
+  /*!
+   * Setups the QP model (with sparse matrix format) and equilibrates it.
+   * Common implementation of the init methods, for Eigen sparse matrices or
+   * maps onto borrowed sparse matrices.
+   */
+  template<typename SparseMatType>
+  void init_impl(optional<SparseMatType> H,
+                 optional<VecRef<T>> g,
+                 optional<SparseMatType> A,
+                 optional<VecRef<T>> b,
+                 optional<SparseMatType> C,
+                 optional<VecRef<T>> l,
+                 optional<VecRef<T>> u,
+                 bool compute_preconditioner_,
+                 optional<T> rho,
+                 optional<T> mu_eq,
+                 optional<T> mu_in)
   {
     if (settings.compute_timings) {
       work.timer.stop();
@@ -251,6 +417,7 @@ struct QP
       C.reset();
     }
     work.internal.proximal_parameter_update = false;
+    work.internal.linear_operator.reset();
     PreconditionerStatus preconditioner_status;
     if (compute_preconditioner_) {
       preconditioner_status = proxsuite::proxqp::PreconditionerStatus::EXECUTE;
@@ -302,6 +469,10 @@ struct QP
         { proxsuite::linalg::sparse::from_eigen, model.l },
         { proxsuite::linalg::sparse::from_eigen, model.u }
       };
+      if (!work.internal.do_symbolic_fact && !have_same_structure(qp, model)) {
+        // the cached symbolic factorization is not valid anymore
+        work.internal.do_symbolic_fact = true;
+      }
       qp_setup(qp, results, model, work, settings, ruiz, preconditioner_status);
     } else {
       SparseMat<T, I> H_triu(model.dim, model.dim);
@@ -316,6 +487,10 @@ struct QP
         { proxsuite::linalg::sparse::from_eigen, model.l },
         { proxsuite::linalg::sparse::from_eigen, model.u }
       };
+      if (!work.internal.do_symbolic_fact && !have_same_structure(qp, model)) {
+        // the cached symbolic factorization is not valid anymore
+        work.internal.do_symbolic_fact = true;
+      }
       qp_setup(qp, results, model, work, settings, ruiz, preconditioner_status);
     }
     work.internal.is_initialized = true;
@@ -324,6 +499,135 @@ struct QP
       results.info.setup_time += work.timer.elapsed().user; // in microseconds
     }
   };
+  /*!
+   * Setups the QP model from linear operators defining its matrices, which are
+   * never assembled. The QP is solved with the MatrixFree backend, and
+   * equilibrated from the diagonal of H when it is provided.
+   * @param op linear operators defining H, A and C of the QP model.
+   * @param g linear cost input defining the QP model.
+   * @param b equality constraint vector input defining the QP model.
+   * @param l lower inequality constraint vector input defining the QP model.
+   * @param u upper inequality constraint vector input defining the QP model.
+   * @param compute_preconditioner boolean parameter for executing or not the
+   * preconditioner.
+   * @param rho proximal step size wrt primal variable.
+   * @param mu_eq proximal step size wrt equality constrained multiplier.
+   * @param mu_in proximal step size wrt inequality constrained multiplier.
+   */
+  void init(LinearOperator<T> op,
+            optional<VecRef<T>> g,
+            optional<VecRef<T>> b,
+            optional<VecRef<T>> l,
+            optional<VecRef<T>> u,
+            bool compute_preconditioner_ = true,
+            optional<T> rho = nullopt,
+            optional<T> mu_eq = nullopt,
+            optional<T> mu_in = nullopt)
+  {
+    if (settings.compute_timings) {
+      work.timer.stop();
+      work.timer.start();
+    }
+    PROXSUITE_THROW_PRETTY(model.n_eq > 0 && (!op.A || !op.AT),
+                           std::invalid_argument,
+                           "the products with A and A.T should be provided "
+                           "when there are equality constraints.");
+    PROXSUITE_THROW_PRETTY(model.n_in > 0 && (!op.C || !op.CT),
+                           std::invalid_argument,
+                           "the products with C and C.T should be provided "
+                           "when there are inequality constraints.");
+    if (op.H_diagonal.size() != 0) {
+      PROXSUITE_CHECK_ARGUMENT_SIZE(
+        op.H_diagonal.size(),
+        model.dim,
+        "the dimension wrt the primal variable x for the diagonal of H is not "
+        "valid.");
+    }
+    if (g != nullopt && g.value().size() != 0) {
+      PROXSUITE_CHECK_ARGUMENT_SIZE(
+        g.value().size(),
+        model.dim,
+        "the dimension wrt the primal variable x variable for initializing g "
+        "is not valid.");
+      model.g = g.value();
+    }
+    if (b != nullopt && b.value().size() != 0) {
+      PROXSUITE_CHECK_ARGUMENT_SIZE(
+        b.value().size(),
+        model.n_eq,
+        "the dimension wrt equality constrained variables for initializing b "
+        "is not valid.");
+      model.b = b.value();
+    }
+    if (u != nullopt && u.value().size() != 0) {
+      PROXSUITE_CHECK_ARGUMENT_SIZE(
+        u.value().size(),
+        model.n_in,
+        "the dimension wrt inequality constrained variables for initializing u "
+        "is not valid.");
+      model.u = u.value();
+    }
+    if (l != nullopt && l.value().size() != 0) {
+      PROXSUITE_CHECK_ARGUMENT_SIZE(
+        l.value().size(),
+        model.n_in,
+        "the dimension wrt inequality constrained variables for initializing l "
+        "is not valid.");
+      model.l = l.value();
+    }
+    if (model.g.size() != model.dim) {
+      model.g.setZero(model.dim);
+    }
+    if (model.b.size() != model.n_eq) {
+      model.b.setZero(model.n_eq);
+    }
+    if (model.u.size() != model.n_in) {
+      model.u.setConstant(model.n_in, helpers::infinite_bound<T>::value());
+    }
+    if (model.l.size() != model.n_in) {
+      model.l.setConstant(model.n_in, -helpers::infinite_bound<T>::value());
+    }
+    work.internal.proximal_parameter_update = false;
+    proxsuite::proxqp::sparse::update_proximal_parameters(
+      settings, results, work, rho, mu_eq, mu_in);
+
+    // the equilibration is computed here, the setup keeping it unchanged
+    if (compute_preconditioner_) {
+      ruiz.scale_from_hessian_diagonal(op.H_diagonal);
+    } else {
+      ruiz.scale_from_hessian_diagonal(Vec<T>{});
+    }
+    work.internal.linear_operator =
+      std::unique_ptr<detail::ScaledLinearOperator<T>>{
+        new detail::ScaledLinearOperator<T>{
+          std::move(op), ruiz.delta, ruiz.c, model.dim, model.n_eq, model.n_in }
+      };
+
+    // the kkt matrix only stores the (empty) sparsity structure of the problem
+    SparseMat<T, I> H_triu(model.dim, model.dim);
+    SparseMat<T, I> AT(model.dim, model.n_eq);
+    SparseMat<T, I> CT(model.dim, model.n_in);
+    sparse::QpView<T, I> qp = {
+      { proxsuite::linalg::sparse::from_eigen, H_triu },
+      { proxsuite::linalg::sparse::from_eigen, model.g },
+      { proxsuite::linalg::sparse::from_eigen, AT },
+      { proxsuite::linalg::sparse::from_eigen, model.b },
+      { proxsuite::linalg::sparse::from_eigen, CT },
+      { proxsuite::linalg::sparse::from_eigen, model.l },
+      { proxsuite::linalg::sparse::from_eigen, model.u }
+    };
+    if (!work.internal.do_symbolic_fact && !have_same_structure(qp, model)) {
+      work.internal.do_symbolic_fact = true;
+    }
+    PreconditionerStatus preconditioner_status =
+      proxsuite::proxqp::PreconditionerStatus::KEEP;
+    qp_setup(qp, results, model, work, settings, ruiz, preconditioner_status);
+    work.internal.is_initialized = true;
+
+    if (settings.compute_timings) {
+      results.info.setup_time += work.timer.elapsed().user; // in microseconds
+    }
+  }
   /*!
    * Updates the QP model (with sparse matrix format) and re-equilibrates it if
    * specified by the user. If matrices in entry are not null, the update is
@@ -594,14 +898,174 @@ struct QP
       }
     }
 
-    SparseMat<T, I> H_triu =
-      H_unscaled.to_eigen().template triangularView<Eigen::Upper>();
+    // the structure is unchanged: the unscaled KKT matrix (whose H block is
+    // already upper triangular) is used directly, so that only a numerical
+    // refresh is performed by the setup
     sparse::QpView<T, I> qp = {
-      { proxsuite::linalg::sparse::from_eigen, H_triu },
+      H_unscaled.as_const(),
+      { proxsuite::linalg::sparse::from_eigen, model.g },
+      AT_unscaled.as_const(),
+      { proxsuite::linalg::sparse::from_eigen, model.b },
+      CT_unscaled.as_const(),
+      { proxsuite::linalg::sparse::from_eigen, model.l },
+      { proxsuite::linalg::sparse::from_eigen, model.u }
+    };
+    proxsuite::proxqp::sparse::update_proximal_parameters(
+      settings, results, work, rho, mu_eq, mu_in);
+    qp_setup(qp,
+             results,
+             model,
+             work,
+             settings,
+             ruiz,
+             preconditioner_status); // store model value + performs scaling
+                                     // according to chosen options
+    if (settings.compute_timings) {
+      results.info.setup_time = work.timer.elapsed().user; // in microseconds
+    }
+  };
+  /*!
+   * Updates the QP model values when its sparsity structure is unchanged.
+   * The matrices are given by the values of their stored entries, in the
+   * order of the compressed sparse column matrices passed to the last init
+   * method (e.g., the data buffer of a scipy.sparse.csc_matrix), and are
+   * written in place into the KKT matrix without any structural work.
+   * @param H_values values of the quadratic cost.
+   * @param g linear cost input defining the QP model.
+   * @param A_values values of the equality constraint matrix.
+   * @param b equality constraint vector input defining the QP model.
+   * @param C_values values of the inequality constraint matrix.
+   * @param l lower inequality constraint vector input defining the QP model.
+   * @param u upper inequality constraint vector input defining the QP model.
+   * @param update_preconditioner bool parameter for updating or not the
+   * preconditioner and the associated scaled model.
+   * @param rho proximal step size wrt primal variable.
+   * @param mu_eq proximal step size wrt equality constrained multiplier.
+   * @param mu_in proximal step size wrt inequality constrained multiplier.
+   * @note The init method taking compressed sparse column matrices must have
+   * been called before update_values.
+   */
+  void update_values(optional<VecRef<T>> H_values,
+                     optional<VecRef<T>> g,
+                     optional<VecRef<T>> A_values,
+                     optional<VecRef<T>> b,
+                     optional<VecRef<T>> C_values,
+                     optional<VecRef<T>> l,
+                     optional<VecRef<T>> u,
+                     bool update_preconditioner = true,
+                     optional<T> rho = nullopt,
+                     optional<T> mu_eq = nullopt,
+                     optional<T> mu_in = nullopt)
+  {
+    PROXSUITE_THROW_PRETTY(!work.internal.is_initialized,
+                           std::runtime_error,
+                           "the QP should be initialized before updating its "
+                           "values.");
+    if (settings.compute_timings) {
+      work.timer.stop();
+      work.timer.start();
+    }
+    work.internal.dirty = false;
+    work.internal.proximal_parameter_update = false;
+    PreconditionerStatus preconditioner_status;
+    if (update_preconditioner) {
+      preconditioner_status = proxsuite::proxqp::PreconditionerStatus::EXECUTE;
+    } else {
+      preconditioner_status = proxsuite::proxqp::PreconditionerStatus::KEEP;
+    }
+
+    // check the model is valid
+    if (H_values != nullopt) {
+      PROXSUITE_CHECK_ARGUMENT_SIZE(
+        H_values.value().size(),
+        work.internal.H_values_map.len(),
+        "the number of values for updating H does not match the sparsity "
+        "structure given to init.");
+    }
+    if (A_values != nullopt) {
+      PROXSUITE_CHECK_ARGUMENT_SIZE(
+        A_values.value().size(),
+        work.internal.A_values_map.len(),
+        "the number of values for updating A does not match the sparsity "
+        "structure given to init.");
+    }
+    if (C_values != nullopt) {
+      PROXSUITE_CHECK_ARGUMENT_SIZE(
+        C_values.value().size(),
+        work.internal.C_values_map.len(),
+        "the number of values for updating C does not match the sparsity "
+        "structure given to init.");
+    }
+    if (g != nullopt) {
+      PROXSUITE_CHECK_ARGUMENT_SIZE(g.value().size(),
+                                    model.dim,
+                                    "the dimension wrt the primal variable x "
+                                    "variable for updating g is not valid.");
+    }
+    if (b != nullopt) {
+      PROXSUITE_CHECK_ARGUMENT_SIZE(b.value().size(),
+                                    model.n_eq,
+                                    "the dimension wrt equality constrained "
+                                    "variables for updating b is not valid.");
+    }
+    if (u != nullopt) {
+      PROXSUITE_CHECK_ARGUMENT_SIZE(u.value().size(),
+                                    model.n_in,
+                                    "the dimension wrt inequality constrained "
+                                    "variables for updating u is not valid.");
+    }
+    if (l != nullopt) {
+      PROXSUITE_CHECK_ARGUMENT_SIZE(l.value().size(),
+                                    model.n_in,
+                                    "the dimension wrt inequality constrained "
+                                    "variables for updating l is not valid.");
+    }
+
+    // update the model
+    T* kkt_values = model.kkt_values_unscaled.ptr_mut();
+    auto scatter = [&](VecRef<T> values,
+                       proxsuite::linalg::veg::Vec<I> const& map) -> void {
+      I const* positions = map.ptr();
+      for (isize p = 0; p < map.len(); ++p) {
+        if (positions[p] >= I(0)) {
+          kkt_values[positions[p]] = values[p];
+        }
+      }
+    };
+    if (H_values != nullopt) {
+      scatter(H_values.value(), work.internal.H_values_map);
+    }
+    if (A_values != nullopt) {
+      scatter(A_values.value(), work.internal.A_values_map);
+    }
+    if (C_values != nullopt) {
+      scatter(C_values.value(), work.internal.C_values_map);
+    }
+    if (g != nullopt) {
+      model.g = g.value();
+    }
+    if (b != nullopt) {
+      model.b = b.value();
+    }
+    if (u != nullopt) {
+      model.u = u.value();
+    }
+    if (l != nullopt) {
+      model.l = l.value();
+    }
+
+    isize n = model.dim;
+    isize n_eq = model.n_eq;
+    isize n_in = model.n_in;
+    auto kkt_top_n_rows = detail::top_rows_mut_unchecked(
+      proxsuite::linalg::veg::unsafe, model.kkt_mut_unscaled(), n);
+    sparse::QpView<T, I> qp = {
+      detail::middle_cols_mut(kkt_top_n_rows, 0, n, model.H_nnz).as_const(),
       { proxsuite::linalg::sparse::from_eigen, model.g },
-      { proxsuite::linalg::sparse::from_eigen, AT_unscaled.to_eigen() },
+      detail::middle_cols_mut(kkt_top_n_rows, n, n_eq, model.A_nnz).as_const(),
       { proxsuite::linalg::sparse::from_eigen, model.b },
-      { proxsuite::linalg::sparse::from_eigen, CT_unscaled.to_eigen() },
+      detail::middle_cols_mut(kkt_top_n_rows, n + n_eq, n_in, model.C_nnz)
+        .as_const(),
       { proxsuite::linalg::sparse::from_eigen, model.l },
       { proxsuite::linalg::sparse::from_eigen, model.u }
     };
@@ -765,6 +1229,119 @@ solve(
   return Qp.results;
 }
 
+///
+/// @brief This class stores a batch of sparse QP problems, meant to be solved
+/// at once (see proxsuite::proxqp::parallel::solve_in_parallel).
+///
+/*!
+ * Each QP of the batch owns its model, workspace and results. The storage is
+ * reserved once at construction so that the QPs are never relocated when new
+ * problems are appended to the batch.
+ *
+ * When the batch is constructed from a sparsity structure, the symbolic
+ * factorization of the KKT matrix (fill-reducing ordering, elimination tree
+ * and column counts) is computed once and used read-only for setting up all
+ * the QPs created with init_qp_in_place(), which then only pay for the
+ * numerical factorization. These QPs must be initialized with matrices having
+ * exactly the sparsity structure given to the batch.
+ */
+template<typename T, typename I>
+struct BatchQP
+{
+  std::vector<QP<T, I>> qp_vector;
+  isize m_size;
+  std::shared_ptr<const SymbolicFactorization<I>> symbolic;
+
+  /*!
+   * Default constructor.
+   * @param batch_size maximal number of QPs held by the batch.
+   */
+  explicit BatchQP(std::size_t batch_size)
+    : m_size(0)
+  {
+    qp_vector.reserve(batch_size);
+  }
+  /*!
+   * Constructor computing the symbolic factorization shared by the QPs of the
+   * batch.
+   * @param batch_size maximal number of QPs held by the batch.
+   * @param H boolean mask of the quadratic cost input defining the QP models.
+   * @param A boolean mask of the equality constraint matrix input defining the
+   * QP models.
+   * @param C boolean mask of the inequality constraint matrix input defining
+   * the QP models.
+   * @param ordering fill-reducing ordering of the KKT matrix, used as
+   * sparse_ordering setting of the QPs of the batch.
+   */
+  BatchQP(std::size_t batch_size,
+          const SparseMat<bool, I>& H,
+          const SparseMat<bool, I>& A,
+          const SparseMat<bool, I>& C,
+          proxsuite::linalg::sparse::Ordering ordering =
+            proxsuite::linalg::sparse::Ordering::amd)
+    : BatchQP(batch_size)
+  {
+    SparseMat<bool, I> H_triu = H.template triangularView<Eigen::Upper>();
+    SparseMat<bool, I> AT = A.transpose();
+    SparseMat<bool, I> CT = C.transpose();
+    proxsuite::linalg::sparse::MatRef<bool, I> Href = {
+      proxsuite::linalg::sparse::from_eigen, H_triu
+    };
+    proxsuite::linalg::sparse::MatRef<bool, I> ATref = {
+      proxsuite::linalg::sparse::from_eigen, AT
+    };
+    proxsuite::linalg::sparse::MatRef<bool, I> CTref = {
+      proxsuite::linalg::sparse::from_eigen, CT
+    };
+    symbolic = std::make_shared<const SymbolicFactorization<I>>(
+      Href.symbolic(), ATref.symbolic(), CTref.symbolic(), ordering);
+  }
+
+  /*!
+   * Constructs in place a new QP at the end of the batch and returns it.
+   * @param dim primal variable dimension.
+   * @param n_eq number of equality constraints.
+   * @param n_in number of inequality constraints.
+   */
+  QP<T, I>& init_qp_in_place(isize dim, isize n_eq, isize n_in)
+  {
+    PROXSUITE_THROW_PRETTY(qp_vector.size() == qp_vector.capacity(),
+                           std::length_error,
+                           "the batch is already full.");
+    qp_vector.emplace_back(dim, n_eq, n_in);
+    ++m_size;
+    return qp_vector.back();
+  }
+  /*!
+   * Constructs in place a new QP at the end of the batch, using the symbolic
+   * factorization shared by the batch, and returns it.
+   */
+  QP<T, I>& init_qp_in_place()
+  {
+    PROXSUITE_THROW_PRETTY(symbolic == nullptr,
+                           std::invalid_argument,
+                           "the batch has been constructed without sparsity "
+                           "structure.");
+    QP<T, I>& qp =
+      init_qp_in_place(symbolic->dim, symbolic->n_eq, symbolic->n_in);
+    qp.work.setup_symbolic_factorizaton(qp.model, *symbolic);
+    qp.settings.sparse_ordering = symbolic->ordering;
+    return qp;
+  }
+
+  /*!
+   * Returns the i-th QP of the batch.
+   * @param i index of the QP.
+   */
+  QP<T, I>& get(isize i) { return qp_vector.at(std::size_t(i)); }
+  const QP<T, I>& get(isize i) const { return qp_vector.at(std::size_t(i)); }
+
+  /*!
+   * Returns the number of QPs held by the batch.
+   */
+  isize size() const { return m_size; }
+};
+
 } // namespace sparse
 } // namespace proxqp
 } // namespace proxsuite
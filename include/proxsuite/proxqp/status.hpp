@@ -39,6 +39,22 @@ enum struct PreconditionerStatus
   IDENTITY // do not execute, hence use identity preconditioner (for init
            // method)
 };
+// HESSIAN STRUCTURE (dense backend)
+enum struct HessianType
+{
+  Dense,   // H is stored as a dim x dim matrix
+  Zero,    // H = 0 (linear program), nothing is stored
+  Diagonal // only the diagonal of H is stored, as a dim x 1 matrix
+};
+// DENSE BACKEND
+enum struct DenseBackend
+{
+  Automatic,      // chosen from the problem dimensions
+  PrimalDualLDLT, // factorizes the primal-dual KKT matrix of size
+                  // dim + n_eq + n_c
+  PrimalLDLT      // factorizes the dim x dim matrix
+                  // H + rho I + A.T A / mu_eq + C_act.T C_act / mu_in
+};
 
 } // namespace proxqp
 } // namespace proxsuite
@@ -13,6 +13,61 @@
 
 #include <cereal/cereal.hpp>
 
+namespace proxsuite {
+namespace serialization {
+namespace detail {
+
+// contiguous arrays of arithmetic values are written as a single block by the
+// archives supporting binary data (with the same layout as element-wise
+// writes), and element-wise by the other ones
+template<class Archive, typename T>
+inline typename std::enable_if<
+  cereal::traits::is_output_serializable<cereal::BinaryData<T>,
+                                         Archive>::value &&
+  std::is_arithmetic<T>::value>::type
+save_array(Archive& ar, T const* data, Eigen::Index size)
+{
+  ar(cereal::binary_data(static_cast<T const*>(data),
+                         static_cast<std::size_t>(size) * sizeof(T)));
+}
+
+template<class Archive, typename T>
+inline typename std::enable_if<
+  !(cereal::traits::is_output_serializable<cereal::BinaryData<T>,
+                                           Archive>::value &&
+    std::is_arithmetic<T>::value)>::type
+save_array(Archive& ar, T const* data, Eigen::Index size)
+{
+  for (Eigen::Index i = 0; i < size; i++)
+    ar(data[i]);
+}
+
+template<class Archive, typename T>
+inline typename std::enable_if<
+  cereal::traits::is_input_serializable<cereal::BinaryData<T>,
+                                        Archive>::value &&
+  std::is_arithmetic<T>::value>::type
+load_array(Archive& ar, T* data, Eigen::Index size)
+{
+  ar(cereal::binary_data(static_cast<T*>(data),
+                         static_cast<std::size_t>(size) * sizeof(T)));
+}
+
+template<class Archive, typename T>
+inline typename std::enable_if<
+  !(cereal::traits::is_input_serializable<cereal::BinaryData<T>,
+                                          Archive>::value &&
+    std::is_arithmetic<T>::value)>::type
+load_array(Archive& ar, T* data, Eigen::Index size)
+{
+  for (Eigen::Index i = 0; i < size; i++)
+    ar(data[i]);
+}
+
+} // namespace detail
+} // namespace serialization
+} // namespace proxsuite
+
 namespace cereal {
 
 // dense matrices
@@ -29,8 +84,7 @@ save(Archive& ar, Eigen::PlainObjectBase<Derived> const& m)
   bool is_row_major = PlainType::IsRowMajor;
   ar(CEREAL_NVP(is_row_major));
 
-  for (Eigen::Index i = 0; i < m.size(); i++)
-    ar(m.data()[i]);
+  proxsuite::serialization::detail::save_array(ar, m.data(), m.size());
 }
 
 template<class Archive, class Derived>
@@ -48,8 +102,7 @@ load(Archive& ar, Eigen::PlainObjectBase<Derived>& m)
 
   m.resize(rows, cols);
 
-  for (Eigen::Index i = 0; i < m.size(); i++)
-    ar(m.data()[i]);
+  proxsuite::serialization::detail::load_array(ar, m.data(), m.size());
 
   // Account for different storage orders
   if (is_row_major != PlainType::IsRowMajor) {
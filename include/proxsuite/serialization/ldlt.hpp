@@ -0,0 +1,87 @@
+//
+// Copyright (c) 2022 INRIA
+//
+/**
+ * @file ldlt.hpp
+ */
+
+#ifndef PROXSUITE_SERIALIZATION_LDLT_HPP
+#define PROXSUITE_SERIALIZATION_LDLT_HPP
+
+#include <cereal/cereal.hpp>
+#include <proxsuite/linalg/dense/mixed_ldlt.hpp>
+#include <proxsuite/serialization/veg.hpp>
+
+namespace cereal {
+
+template<class Archive, typename T>
+void
+save(Archive& ar, proxsuite::linalg::dense::Ldlt<T> const& ldl)
+{
+  using proxsuite::serialization::detail::save_array;
+
+  proxsuite::linalg::veg::isize dim = ldl.dim();
+  ar(CEREAL_NVP(dim));
+  save_array(ar, ldl.permutation().ptr(), dim);
+  save_array(ar, ldl.permuted_diagonal().ptr(), dim);
+  // only the lower triangular part of the storage holds the factors, each of
+  // its columns is contiguous
+  auto ld = ldl.ld_col();
+  for (proxsuite::linalg::veg::isize j = 0; j < dim; ++j) {
+    save_array(ar, ld.data() + j * ld.outerStride() + j, dim - j);
+  }
+}
+
+template<class Archive, typename T>
+void
+load(Archive& ar, proxsuite::linalg::dense::Ldlt<T>& ldl)
+{
+  using proxsuite::serialization::detail::load_array;
+
+  proxsuite::linalg::veg::isize dim;
+  ar(CEREAL_NVP(dim));
+  proxsuite::linalg::veg::Vec<proxsuite::linalg::veg::isize> perm;
+  perm.resize_for_overwrite(dim);
+  load_array(ar, perm.ptr_mut(), dim);
+  ldl.set_permutation(perm.ptr(), dim);
+  load_array(ar, ldl.permuted_diagonal_mut().ptr_mut(), dim);
+  auto ld = ldl.ld_col_mut();
+  for (proxsuite::linalg::veg::isize j = 0; j < dim; ++j) {
+    load_array(ar, ld.data() + j * ld.outerStride() + j, dim - j);
+  }
+}
+
+template<class Archive, typename T, typename Low>
+void
+save(Archive& ar, proxsuite::linalg::dense::MixedLdlt<T, Low> const& ldl)
+{
+  bool low_precision_requested = ldl.is_low_precision_requested();
+  bool low_precision = ldl.is_low_precision();
+  ar(CEREAL_NVP(low_precision_requested), CEREAL_NVP(low_precision));
+  // only the current decomposition is stored
+  if (low_precision) {
+    ar(cereal::make_nvp("ldl", ldl.low_precision_ldlt()));
+  } else {
+    ar(cereal::make_nvp("ldl", ldl.full_precision_ldlt()));
+  }
+}
+
+template<class Archive, typename T, typename Low>
+void
+load(Archive& ar, proxsuite::linalg::dense::MixedLdlt<T, Low>& ldl)
+{
+  bool low_precision_requested;
+  bool low_precision;
+  ar(CEREAL_NVP(low_precision_requested), CEREAL_NVP(low_precision));
+  ldl.set_low_precision(low_precision_requested);
+  ldl.set_current_precision(low_precision);
+  if (low_precision) {
+    ar(cereal::make_nvp("ldl", ldl.low_precision_ldlt_mut()));
+  } else {
+    ar(cereal::make_nvp("ldl", ldl.full_precision_ldlt_mut()));
+  }
+}
+
+} // namespace cereal
+
+#endif /* end of include guard PROXSUITE_SERIALIZATION_LDLT_HPP */
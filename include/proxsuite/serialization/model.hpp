@@ -10,6 +10,8 @@
 
 #include <cereal/cereal.hpp>
 #include <proxsuite/proxqp/dense/model.hpp>
+#include <proxsuite/proxqp/sparse/model.hpp>
+#include <proxsuite/serialization/veg.hpp>
 
 namespace cereal {
 
@@ -27,6 +29,32 @@ serialize(Archive& archive, proxsuite::proxqp::dense::Model<T>& model)
           CEREAL_NVP(model.b),
           CEREAL_NVP(model.C),
           CEREAL_NVP(model.l),
+          CEREAL_NVP(model.u),
+          CEREAL_NVP(model.box_constraints),
+          CEREAL_NVP(model.l_box),
+          CEREAL_NVP(model.u_box),
+          CEREAL_NVP(model.hessian_type));
+}
+
+template<class Archive, typename T, typename I>
+void
+serialize(Archive& archive, proxsuite::proxqp::sparse::Model<T, I>& model)
+{
+  archive(CEREAL_NVP(model.dim),
+          CEREAL_NVP(model.n_eq),
+          CEREAL_NVP(model.n_in),
+          CEREAL_NVP(model.H_nnz),
+          CEREAL_NVP(model.A_nnz),
+          CEREAL_NVP(model.C_nnz),
+          CEREAL_NVP(model.kkt_col_ptrs),
+          CEREAL_NVP(model.kkt_row_indices),
+          CEREAL_NVP(model.kkt_values),
+          CEREAL_NVP(model.kkt_col_ptrs_unscaled),
+          CEREAL_NVP(model.kkt_row_indices_unscaled),
+          CEREAL_NVP(model.kkt_values_unscaled),
+          CEREAL_NVP(model.g),
+          CEREAL_NVP(model.b),
+          CEREAL_NVP(model.l),
           CEREAL_NVP(model.u));
 }
 } // namespace cereal
@@ -0,0 +1,723 @@
+//
+// Copyright (c) 2022 INRIA
+//
+/**
+ * @file qp_file.hpp
+ */
+
+#ifndef PROXSUITE_SERIALIZATION_QP_FILE_HPP
+#define PROXSUITE_SERIALIZATION_QP_FILE_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <proxsuite/proxqp/dense/model.hpp>
+#include <proxsuite/proxqp/dense/views.hpp>
+#include <proxsuite/proxqp/sparse/model.hpp>
+#include <proxsuite/proxqp/sparse/views.hpp>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define PROXSUITE_QP_FILE_WITH_MMAP
+#endif
+
+/*!
+ * Binary container of QP problems, designed to be memory-mapped.
+ *
+ * A file starts with a QpFileHeader storing the kind of problem
+ * (dense or sparse), the sizes of its scalar and index types, its dimensions
+ * and numbers of non-zeros, and the offsets of its sections. Each section is
+ * a contiguous array aligned on 64 bytes:
+ * - dense problems: H, g, A, b, C, l, u, l_box, u_box, the matrices being
+ *   stored in row major order (as dense::Mat);
+ * - sparse problems: H, AT, CT in compressed column format (col_ptrs,
+ *   row_indices, values each), then g, b, l, u. These are the arrays of a
+ *   sparse::QpView, H storing the upper triangular part of the hessian.
+ * Data is stored in the native byte order, which is checked when loading.
+ *
+ * DenseQpFile and SparseQpFile map a file in memory and view its sections
+ * directly, without copies.
+ */
+namespace proxsuite {
+namespace serialization {
+
+using proxsuite::linalg::veg::isize;
+using proxsuite::linalg::veg::usize;
+
+enum struct QpFileKind : std::uint32_t
+{
+  Dense = 0,
+  Sparse = 1
+};
+
+///
+/// @brief Header of the binary QP files.
+///
+struct QpFileHeader
+{
+  static constexpr std::uint32_t current_version = 1;
+  static constexpr std::uint32_t endianness_marker = 0x01020304;
+  static constexpr std::uint64_t alignment = 64;
+  static constexpr std::size_t max_sections = 16;
+
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t endianness;
+  QpFileKind kind;
+  std::uint32_t scalar_size;
+  std::uint32_t index_size; // sparse problems only
+  std::uint32_t hessian_type;
+  std::uint32_t box_constraints;
+  std::uint32_t n_sections;
+  std::int64_t dim;
+  std::int64_t n_eq;
+  std::int64_t n_in;
+  std::int64_t H_nnz; // sparse problems only
+  std::int64_t A_nnz;
+  std::int64_t C_nnz;
+  std::uint64_t section_offsets[max_sections];
+  std::uint64_t section_sizes[max_sections]; // in bytes
+};
+static_assert(std::is_trivially_copyable<QpFileHeader>::value &&
+                sizeof(QpFileHeader) == 344,
+              "the layout of QpFileHeader is part of the file format.");
+
+namespace detail {
+
+static constexpr char qp_file_magic[8] = {
+  'P', 'R', 'O', 'X', 'Q', 'P', 'F', 0
+};
+
+inline std::uint64_t
+align_qp_file_offset(std::uint64_t offset)
+{
+  return (offset + QpFileHeader::alignment - 1) / QpFileHeader::alignment *
+         QpFileHeader::alignment;
+}
+
+/*!
+ * Writes a QP file from its header (whose section offsets are filled here)
+ * and the contents of its sections.
+ */
+inline void
+write_qp_file(const std::string& filename,
+              QpFileHeader header,
+              const std::vector<std::vector<char>>& sections)
+{
+  std::memcpy(header.magic, qp_file_magic, sizeof(header.magic));
+  header.version = QpFileHeader::current_version;
+  header.endianness = QpFileHeader::endianness_marker;
+  header.n_sections = std::uint32_t(sections.size());
+  std::uint64_t offset = align_qp_file_offset(sizeof(QpFileHeader));
+  for (std::size_t k = 0; k < sections.size(); ++k) {
+    header.section_offsets[k] = offset;
+    header.section_sizes[k] = sections[k].size();
+    offset = align_qp_file_offset(offset + sections[k].size());
+  }
+
+  std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+  PROXSUITE_THROW_PRETTY(!out,
+                         std::runtime_error,
+                         "cannot open " << filename << " for writing.");
+  char padding[QpFileHeader::alignment] = {};
+  out.write(reinterpret_cast<const char*>(&header), sizeof(QpFileHeader));
+  std::uint64_t position = sizeof(QpFileHeader);
+  for (std::size_t k = 0; k < sections.size(); ++k) {
+    out.write(padding, std::streamsize(header.section_offsets[k] - position));
+    out.write(sections[k].data(), std::streamsize(sections[k].size()));
+    position = header.section_offsets[k] + sections[k].size();
+  }
+  PROXSUITE_THROW_PRETTY(
+    !out, std::runtime_error, "error while writing " << filename << ".");
+}
+
+template<typename U>
+void
+append_section(std::vector<std::vector<char>>& sections,
+               const U* data,
+               isize size)
+{
+  const char* bytes = reinterpret_cast<const char*>(data);
+  sections.emplace_back(bytes, bytes + std::size_t(size) * sizeof(U));
+}
+
+/*!
+ * Appends the col_ptrs, row_indices and values sections of a compressed copy
+ * of the matrix.
+ */
+template<typename T, typename I>
+void
+append_csc_sections(std::vector<std::vector<char>>& sections,
+                    proxsuite::linalg::sparse::MatRef<T, I> mat)
+{
+  isize ncols = mat.ncols();
+  std::vector<I> col_ptrs(std::size_t(ncols + 1));
+  std::vector<I> row_indices;
+  std::vector<T> values;
+  row_indices.reserve(std::size_t(mat.nnz()));
+  values.reserve(std::size_t(mat.nnz()));
+  col_ptrs[0] = 0;
+  for (isize j = 0; j < ncols; ++j) {
+    for (isize p = isize(mat.col_start(usize(j)));
+         p < isize(mat.col_end(usize(j)));
+         ++p) {
+      row_indices.push_back(mat.row_indices()[p]);
+      values.push_back(mat.values()[p]);
+    }
+    col_ptrs[std::size_t(j + 1)] = I(row_indices.size());
+  }
+  append_section(sections, col_ptrs.data(), isize(col_ptrs.size()));
+  append_section(sections, row_indices.data(), isize(row_indices.size()));
+  append_section(sections, values.data(), isize(values.size()));
+}
+
+} // namespace detail
+
+///
+/// @brief Read-only memory mapping of a file.
+///
+/*!
+ * The file is memory-mapped on POSIX systems, and read into memory otherwise.
+ */
+class MappedFile
+{
+public:
+  MappedFile() = default;
+  /*!
+   * Maps the file in memory.
+   * @param filename path to the file.
+   */
+  explicit MappedFile(const std::string& filename)
+  {
+#ifdef PROXSUITE_QP_FILE_WITH_MMAP
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    PROXSUITE_THROW_PRETTY(
+      fd < 0, std::runtime_error, "cannot open " << filename << ".");
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+      ::close(fd);
+      PROXSUITE_THROW_PRETTY(
+        true, std::runtime_error, "cannot read " << filename << ".");
+    }
+    size_ = std::size_t(st.st_size);
+    void* ptr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping remains valid once the file is closed
+    ::close(fd);
+    PROXSUITE_THROW_PRETTY(
+      ptr == MAP_FAILED, std::runtime_error, "cannot map " << filename << ".");
+    data_ = static_cast<const unsigned char*>(ptr);
+#else
+    std::ifstream in(filename, std::ios::binary | std::ios::ate);
+    PROXSUITE_THROW_PRETTY(
+      !in, std::runtime_error, "cannot open " << filename << ".");
+    size_ = std::size_t(in.tellg());
+    // 8 bytes aligned storage, for the scalar and index types
+    buffer_.resize((size_ + sizeof(std::uint64_t) - 1) /
+                   sizeof(std::uint64_t));
+    in.seekg(0);
+    in.read(reinterpret_cast<char*>(buffer_.data()), std::streamsize(size_));
+    PROXSUITE_THROW_PRETTY(
+      !in, std::runtime_error, "cannot read " << filename << ".");
+    data_ = reinterpret_cast<const unsigned char*>(buffer_.data());
+#endif
+  }
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile(MappedFile&& other) noexcept { swap(other); }
+  MappedFile& operator=(MappedFile&& other) noexcept
+  {
+    MappedFile tmp(std::move(other));
+    swap(tmp);
+    return *this;
+  }
+  ~MappedFile()
+  {
+#ifdef PROXSUITE_QP_FILE_WITH_MMAP
+    if (data_ != nullptr) {
+      ::munmap(const_cast<unsigned char*>(data_), size_);
+    }
+#endif
+  }
+
+  const unsigned char* data() const noexcept { return data_; }
+  std::size_t size() const noexcept { return size_; }
+
+private:
+  void swap(MappedFile& other) noexcept
+  {
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+#ifndef PROXSUITE_QP_FILE_WITH_MMAP
+    buffer_.swap(other.buffer_);
+#endif
+  }
+
+  const unsigned char* data_ = nullptr;
+  std::size_t size_ = 0;
+#ifndef PROXSUITE_QP_FILE_WITH_MMAP
+  std::vector<std::uint64_t> buffer_;
+#endif
+};
+
+namespace detail {
+
+///
+/// @brief Memory-mapped QP file, whose header has been validated.
+///
+class QpFileBase
+{
+public:
+  const QpFileHeader& header() const noexcept { return header_; }
+
+protected:
+  QpFileBase(const std::string& filename,
+             QpFileKind kind,
+             std::uint32_t scalar_size,
+             std::uint32_t index_size,
+             std::uint32_t n_sections)
+    : file_(filename)
+  {
+    PROXSUITE_THROW_PRETTY(file_.size() < sizeof(QpFileHeader) ||
+                             std::memcmp(file_.data(),
+                                         qp_file_magic,
+                                         sizeof(qp_file_magic)) != 0,
+                           std::runtime_error,
+                           filename << " is not a QP file.");
+    std::memcpy(&header_, file_.data(), sizeof(QpFileHeader));
+    PROXSUITE_THROW_PRETTY(header_.version != QpFileHeader::current_version,
+                           std::runtime_error,
+                           "unsupported version " << header_.version
+                                                  << " of the QP file "
+                                                  << filename << ".");
+    PROXSUITE_THROW_PRETTY(
+      header_.endianness != QpFileHeader::endianness_marker,
+      std::runtime_error,
+      "the QP file " << filename << " was written with another byte order.");
+    PROXSUITE_THROW_PRETTY(header_.kind != kind,
+                           std::runtime_error,
+                           "the QP file " << filename << " stores a "
+                                          << (kind == QpFileKind::Dense
+                                                ? "sparse"
+                                                : "dense")
+                                          << " problem.");
+    PROXSUITE_THROW_PRETTY(header_.scalar_size != scalar_size ||
+                             header_.index_size != index_size,
+                           std::runtime_error,
+                           "the scalar or index types of the QP file "
+                             << filename << " do not match.");
+    PROXSUITE_THROW_PRETTY(header_.n_sections != n_sections,
+                           std::runtime_error,
+                           "wrong number of sections in the QP file "
+                             << filename << ".");
+    PROXSUITE_THROW_PRETTY(header_.dim <= 0 || header_.n_eq < 0 ||
+                             header_.n_in < 0 || header_.H_nnz < 0 ||
+                             header_.A_nnz < 0 || header_.C_nnz < 0,
+                           std::runtime_error,
+                           "wrong dimensions in the QP file " << filename
+                                                              << ".");
+    for (std::uint32_t k = 0; k < n_sections; ++k) {
+      std::uint64_t offset = header_.section_offsets[k];
+      std::uint64_t size = header_.section_sizes[k];
+      PROXSUITE_THROW_PRETTY(offset % QpFileHeader::alignment != 0 ||
+                               offset > file_.size() ||
+                               size > file_.size() - offset,
+                             std::runtime_error,
+                             "the QP file " << filename
+                                            << " is truncated or corrupted.");
+    }
+  }
+
+  /*!
+   * Returns a pointer to the given section, after checking that it stores
+   * size elements of type U.
+   */
+  template<typename U>
+  const U* section(std::uint32_t k, isize size) const
+  {
+    PROXSUITE_THROW_PRETTY(
+      header_.section_sizes[k] != std::uint64_t(size) * sizeof(U),
+      std::runtime_error,
+      "wrong size of the section " << k << " of the QP file.");
+    return reinterpret_cast<const U*>(file_.data() +
+                                      header_.section_offsets[k]);
+  }
+
+  MappedFile file_;
+  QpFileHeader header_;
+};
+
+} // namespace detail
+
+///
+/// @brief Dense QP problem viewed from a memory-mapped QP file.
+///
+template<typename T>
+class DenseQpFile : public detail::QpFileBase
+{
+public:
+  /*!
+   * Maps the QP file in memory and checks that it stores a dense problem with
+   * scalar type T.
+   * @param filename path to the QP file.
+   */
+  explicit DenseQpFile(const std::string& filename)
+    : detail::QpFileBase(filename, QpFileKind::Dense, sizeof(T), 0, 9)
+  {
+    PROXSUITE_THROW_PRETTY(header_.hessian_type > 2,
+                           std::runtime_error,
+                           "wrong hessian type in the QP file " << filename
+                                                                << ".");
+    isize n = dim();
+    isize n_box = box_constraints() ? n : 0;
+    H_ = section<T>(0, n * proxqp::dense::hessian_cols(n, hessian_type()));
+    g_ = section<T>(1, n);
+    A_ = section<T>(2, n_eq() * n);
+    b_ = section<T>(3, n_eq());
+    C_ = section<T>(4, n_in() * n);
+    l_ = section<T>(5, n_in());
+    u_ = section<T>(6, n_in());
+    l_box_ = section<T>(7, n_box);
+    u_box_ = section<T>(8, n_box);
+  }
+
+  isize dim() const noexcept { return isize(header_.dim); }
+  isize n_eq() const noexcept { return isize(header_.n_eq); }
+  isize n_in() const noexcept { return isize(header_.n_in); }
+  bool box_constraints() const noexcept
+  {
+    return header_.box_constraints != 0;
+  }
+  proxqp::HessianType hessian_type() const noexcept
+  {
+    return proxqp::HessianType(header_.hessian_type);
+  }
+
+  proxqp::dense::MatMap<T> H() const
+  {
+    return { H_, dim(), proxqp::dense::hessian_cols(dim(), hessian_type()) };
+  }
+  proxqp::dense::VecMap<T> g() const { return { g_, dim() }; }
+  proxqp::dense::MatMap<T> A() const { return { A_, n_eq(), dim() }; }
+  proxqp::dense::VecMap<T> b() const { return { b_, n_eq() }; }
+  proxqp::dense::MatMap<T> C() const { return { C_, n_in(), dim() }; }
+  proxqp::dense::VecMap<T> l() const { return { l_, n_in() }; }
+  proxqp::dense::VecMap<T> u() const { return { u_, n_in() }; }
+  proxqp::dense::VecMap<T> l_box() const
+  {
+    return { l_box_, box_constraints() ? dim() : 0 };
+  }
+  proxqp::dense::VecMap<T> u_box() const
+  {
+    return { u_box_, box_constraints() ? dim() : 0 };
+  }
+
+  /*!
+   * Returns a view on the problem (without its box constraints).
+   */
+  proxqp::dense::QpViewBox<T> as_view() const
+  {
+    using proxqp::from_ptr_rows_cols_stride;
+    using proxqp::from_ptr_size;
+    isize H_cols = proxqp::dense::hessian_cols(dim(), hessian_type());
+    return {
+      { from_ptr_rows_cols_stride, H_, dim(), H_cols, H_cols },
+      { from_ptr_size, g_, dim() },
+      { from_ptr_rows_cols_stride, A_, n_eq(), dim(), dim() },
+      { from_ptr_size, b_, n_eq() },
+      { from_ptr_rows_cols_stride, C_, n_in(), dim(), dim() },
+      { from_ptr_size, u_, n_in() },
+      { from_ptr_size, l_, n_in() },
+    };
+  }
+
+private:
+  const T* H_;
+  const T* g_;
+  const T* A_;
+  const T* b_;
+  const T* C_;
+  const T* l_;
+  const T* u_;
+  const T* l_box_;
+  const T* u_box_;
+};
+
+///
+/// @brief Sparse QP problem viewed from a memory-mapped QP file.
+///
+template<typename T, typename I>
+class SparseQpFile : public detail::QpFileBase
+{
+public:
+  using CsrMap =
+    Eigen::Map<const Eigen::SparseMatrix<T, Eigen::RowMajor, I>>;
+
+  /*!
+   * Maps the QP file in memory and checks that it stores a sparse problem with
+   * scalar type T and index type I.
+   * @param filename path to the QP file.
+   */
+  explicit SparseQpFile(const std::string& filename)
+    : detail::QpFileBase(filename,
+                         QpFileKind::Sparse,
+                         sizeof(T),
+                         sizeof(I),
+                         13)
+    , H_(load_csc(0, dim(), dim(), isize(header_.H_nnz), true))
+    , AT_(load_csc(3, dim(), n_eq(), isize(header_.A_nnz), false))
+    , CT_(load_csc(6, dim(), n_in(), isize(header_.C_nnz), false))
+  {
+    g_ = section<T>(9, dim());
+    b_ = section<T>(10, n_eq());
+    l_ = section<T>(11, n_in());
+    u_ = section<T>(12, n_in());
+  }
+
+  isize dim() const noexcept { return isize(header_.dim); }
+  isize n_eq() const noexcept { return isize(header_.n_eq); }
+  isize n_in() const noexcept { return isize(header_.n_in); }
+
+  /*!
+   * Upper triangular part of the hessian, in compressed column format.
+   */
+  proxsuite::linalg::sparse::MatRef<T, I> H() const { return H_; }
+  proxsuite::linalg::sparse::MatRef<T, I> AT() const { return AT_; }
+  proxsuite::linalg::sparse::MatRef<T, I> CT() const { return CT_; }
+  /*!
+   * Equality constraint matrix, viewed in compressed row format from the
+   * arrays of AT (e.g., to initialize a sparse::QP).
+   */
+  CsrMap A() const { return csr_map(AT_); }
+  /*!
+   * Inequality constraint matrix, viewed in compressed row format from the
+   * arrays of CT.
+   */
+  CsrMap C() const { return csr_map(CT_); }
+  proxqp::dense::VecMap<T> g() const { return { g_, dim() }; }
+  proxqp::dense::VecMap<T> b() const { return { b_, n_eq() }; }
+  proxqp::dense::VecMap<T> l() const { return { l_, n_in() }; }
+  proxqp::dense::VecMap<T> u() const { return { u_, n_in() }; }
+
+  /*!
+   * Returns a view on the problem.
+   */
+  proxqp::sparse::QpView<T, I> as_view() const
+  {
+    using proxsuite::linalg::sparse::DenseVecRef;
+    using proxsuite::linalg::sparse::from_raw_parts;
+    return {
+      H(),
+      DenseVecRef<T>{ from_raw_parts, g_, dim() },
+      AT(),
+      DenseVecRef<T>{ from_raw_parts, b_, n_eq() },
+      CT(),
+      DenseVecRef<T>{ from_raw_parts, l_, n_in() },
+      DenseVecRef<T>{ from_raw_parts, u_, n_in() },
+    };
+  }
+
+private:
+  proxsuite::linalg::sparse::MatRef<T, I> load_csc(std::uint32_t k,
+                                                   isize nrows,
+                                                   isize ncols,
+                                                   isize nnz,
+                                                   bool upper) const
+  {
+    const I* col_ptrs = section<I>(k, ncols + 1);
+    const I* row_indices = section<I>(k + 1, nnz);
+    const T* values = section<T>(k + 2, nnz);
+    // the column pointers and row indices are checked so that the views stay
+    // in bounds, and the hessian only stores its upper triangular part
+    bool valid = col_ptrs[0] == 0 && isize(col_ptrs[ncols]) == nnz;
+    for (isize j = 0; valid && j < ncols; ++j) {
+      valid = col_ptrs[j] <= col_ptrs[j + 1];
+      for (isize p = isize(col_ptrs[j]); valid && p < isize(col_ptrs[j + 1]);
+           ++p) {
+        isize row = isize(row_indices[p]);
+        valid = row >= 0 && row < nrows && (!upper || row <= j);
+      }
+    }
+    PROXSUITE_THROW_PRETTY(!valid,
+                           std::runtime_error,
+                           "wrong column pointers or row indices in the "
+                           "section "
+                             << k << " of the QP file.");
+    return {
+      proxsuite::linalg::sparse::from_raw_parts,
+      nrows,
+      ncols,
+      nnz,
+      col_ptrs,
+      nullptr,
+      row_indices,
+      values,
+    };
+  }
+
+  static CsrMap csr_map(proxsuite::linalg::sparse::MatRef<T, I> mat)
+  {
+    return { mat.ncols(), mat.nrows(),   mat.nnz(),
+             mat.col_ptrs(), mat.row_indices(), mat.values() };
+  }
+
+  proxsuite::linalg::sparse::MatRef<T, I> H_;
+  proxsuite::linalg::sparse::MatRef<T, I> AT_;
+  proxsuite::linalg::sparse::MatRef<T, I> CT_;
+  const T* g_;
+  const T* b_;
+  const T* l_;
+  const T* u_;
+};
+
+///
+/// \brief Saves a dense QP model to a binary QP file.
+///
+/// \param[in] model dense QP model.
+/// \param[in] filename path to the QP file.
+///
+template<typename T>
+void
+saveToQpFile(const proxqp::dense::Model<T>& model, const std::string& filename)
+{
+  QpFileHeader header = {};
+  header.kind = QpFileKind::Dense;
+  header.scalar_size = sizeof(T);
+  header.hessian_type = std::uint32_t(model.hessian_type);
+  header.box_constraints = model.box_constraints ? 1 : 0;
+  header.dim = model.dim;
+  header.n_eq = model.n_eq;
+  header.n_in = model.n_in;
+
+  std::vector<std::vector<char>> sections;
+  detail::append_section(sections, model.H.data(), isize(model.H.size()));
+  detail::append_section(sections, model.g.data(), model.dim);
+  detail::append_section(sections, model.A.data(), isize(model.A.size()));
+  detail::append_section(sections, model.b.data(), model.n_eq);
+  detail::append_section(sections, model.C.data(), isize(model.C.size()));
+  detail::append_section(sections, model.l.data(), model.n_in);
+  detail::append_section(sections, model.u.data(), model.n_in);
+  detail::append_section(
+    sections, model.l_box.data(), isize(model.l_box.size()));
+  detail::append_section(
+    sections, model.u_box.data(), isize(model.u_box.size()));
+  detail::write_qp_file(filename, header, sections);
+}
+
+///
+/// \brief Saves a sparse QP problem to a binary QP file.
+///
+/// \param[in] qp view on the problem, whose matrix H stores the upper
+/// triangular part of the hessian (the other entries are ignored).
+/// \param[in] filename path to the QP file.
+///
+template<typename T, typename I>
+void
+saveToQpFile(proxqp::sparse::QpView<T, I> qp, const std::string& filename)
+{
+  isize n = qp.H.nrows();
+  // only the upper triangular part of H is kept
+  std::vector<I> H_col_ptrs(std::size_t(n + 1));
+  std::vector<I> H_row_indices;
+  std::vector<T> H_values;
+  H_col_ptrs[0] = 0;
+  for (isize j = 0; j < n; ++j) {
+    for (isize p = isize(qp.H.col_start(usize(j)));
+         p < isize(qp.H.col_end(usize(j)));
+         ++p) {
+      if (isize(qp.H.row_indices()[p]) <= j) {
+        H_row_indices.push_back(qp.H.row_indices()[p]);
+        H_values.push_back(qp.H.values()[p]);
+      }
+    }
+    H_col_ptrs[std::size_t(j + 1)] = I(H_row_indices.size());
+  }
+  proxsuite::linalg::sparse::MatRef<T, I> H_triu = {
+    proxsuite::linalg::sparse::from_raw_parts,
+    n,
+    n,
+    isize(H_values.size()),
+    H_col_ptrs.data(),
+    nullptr,
+    H_row_indices.data(),
+    H_values.data(),
+  };
+
+  QpFileHeader header = {};
+  header.kind = QpFileKind::Sparse;
+  header.scalar_size = sizeof(T);
+  header.index_size = sizeof(I);
+  header.dim = n;
+  header.n_eq = qp.AT.ncols();
+  header.n_in = qp.CT.ncols();
+  header.H_nnz = H_triu.nnz();
+  header.A_nnz = qp.AT.nnz();
+  header.C_nnz = qp.CT.nnz();
+
+  std::vector<std::vector<char>> sections;
+  detail::append_csc_sections(sections, H_triu);
+  detail::append_csc_sections(sections, qp.AT);
+  detail::append_csc_sections(sections, qp.CT);
+  detail::append_section(sections, qp.g.as_slice().ptr(), n);
+  detail::append_section(sections, qp.b.as_slice().ptr(), qp.AT.ncols());
+  detail::append_section(sections, qp.l.as_slice().ptr(), qp.CT.ncols());
+  detail::append_section(sections, qp.u.as_slice().ptr(), qp.CT.ncols());
+  detail::write_qp_file(filename, header, sections);
+}
+
+///
+/// \brief Saves the (unscaled) problem of a sparse QP model to a binary QP
+/// file.
+///
+/// \param[in] model sparse QP model, which must have been initialized.
+/// \param[in] filename path to the QP file.
+///
+template<typename T, typename I>
+void
+saveToQpFile(const proxqp::sparse::Model<T, I>& model,
+             const std::string& filename)
+{
+  PROXSUITE_THROW_PRETTY(model.kkt_col_ptrs_unscaled.len() == 0,
+                         std::invalid_argument,
+                         "the sparse model has not been initialized.");
+  // the unscaled KKT matrix stores the columns of H (upper triangular part),
+  // AT and CT
+  proxsuite::linalg::sparse::MatRef<T, I> kkt = model.kkt_unscaled();
+  auto block = [&](isize first_col,
+                   isize ncols) -> proxsuite::linalg::sparse::MatRef<T, I> {
+    return {
+      proxsuite::linalg::sparse::from_raw_parts,
+      model.dim,
+      ncols,
+      isize(kkt.col_ptrs()[first_col + ncols] - kkt.col_ptrs()[first_col]),
+      kkt.col_ptrs() + first_col,
+      nullptr,
+      kkt.row_indices(),
+      kkt.values(),
+    };
+  };
+  using proxsuite::linalg::sparse::DenseVecRef;
+  using proxsuite::linalg::sparse::from_raw_parts;
+  proxqp::sparse::QpView<T, I> qp = {
+    block(0, model.dim),
+    DenseVecRef<T>{ from_raw_parts, model.g.data(), model.dim },
+    block(model.dim, model.n_eq),
+    DenseVecRef<T>{ from_raw_parts, model.b.data(), model.n_eq },
+    block(model.dim + model.n_eq, model.n_in),
+    DenseVecRef<T>{ from_raw_parts, model.l.data(), model.n_in },
+    DenseVecRef<T>{ from_raw_parts, model.u.data(), model.n_in },
+  };
+  saveToQpFile(qp, filename);
+}
+
+} // namespace serialization
+} // namespace proxsuite
+
+#endif /* end of include guard PROXSUITE_SERIALIZATION_QP_FILE_HPP */
@@ -13,6 +13,28 @@
 
 namespace cereal {
 
+template<class Archive, typename T>
+void
+serialize(Archive& archive, proxsuite::proxqp::Profile<T>& profile)
+{
+  archive(CEREAL_NVP(profile.equilibration_time),
+          CEREAL_NVP(profile.factorization_time),
+          CEREAL_NVP(profile.factorizations),
+          CEREAL_NVP(profile.refactorization_time),
+          CEREAL_NVP(profile.refactorizations),
+          CEREAL_NVP(profile.mu_update_time),
+          CEREAL_NVP(profile.mu_update_rank),
+          CEREAL_NVP(profile.active_set_change_time),
+          CEREAL_NVP(profile.active_set_insertions),
+          CEREAL_NVP(profile.active_set_deletions),
+          CEREAL_NVP(profile.line_search_time),
+          CEREAL_NVP(profile.line_searches),
+          CEREAL_NVP(profile.iterative_refinement_time),
+          CEREAL_NVP(profile.iterative_refinement_steps),
+          CEREAL_NVP(profile.residual_time),
+          CEREAL_NVP(profile.residual_evaluations));
+}
+
 template<class Archive, typename T>
 void
 serialize(Archive& archive, proxsuite::proxqp::Info<T>& info)
@@ -35,7 +57,12 @@ serialize(Archive& archive, proxsuite::proxqp::Info<T>& info)
           CEREAL_NVP(info.pri_res),
           CEREAL_NVP(info.dua_res),
           CEREAL_NVP(info.duality_gap),
-          CEREAL_NVP(info.sparse_backend));
+          CEREAL_NVP(info.sparse_backend),
+          CEREAL_NVP(info.symbolic_factorization_reuses),
+          CEREAL_NVP(info.lnnz),
+          CEREAL_NVP(info.mixed_precision_fallback),
+          CEREAL_NVP(info.iterative_refinement_steps),
+          CEREAL_NVP(info.profile));
 }
 
 template<class Archive, typename T>
@@ -45,6 +72,7 @@ serialize(Archive& archive, proxsuite::proxqp::Results<T>& results)
   archive(CEREAL_NVP(results.x),
           CEREAL_NVP(results.y),
           CEREAL_NVP(results.z),
+          CEREAL_NVP(results.z_box),
           CEREAL_NVP(results.info));
 }
 
@@ -64,7 +92,7 @@ load(Archive& ar, proxsuite::linalg::veg::Vec<bool>& vec_bool)
 {
   proxsuite::linalg::veg::isize len;
   ar(len);
-  vec_bool.reserve(len);
+  vec_bool.resize(len);
   for (proxsuite::linalg::veg::isize i = 0; i < len; i++)
     ar(vec_bool[i]);
 }
@@ -0,0 +1,47 @@
+//
+// Copyright (c) 2022 INRIA
+//
+/**
+ * @file ruiz.hpp
+ */
+
+#ifndef PROXSUITE_SERIALIZATION_RUIZ_HPP
+#define PROXSUITE_SERIALIZATION_RUIZ_HPP
+
+#include <cereal/cereal.hpp>
+#include <proxsuite/proxqp/dense/preconditioner/ruiz.hpp>
+#include <proxsuite/proxqp/sparse/preconditioner/ruiz.hpp>
+#include <proxsuite/serialization/eigen.hpp>
+
+namespace cereal {
+
+template<class Archive, typename T>
+void
+serialize(Archive& archive,
+          proxsuite::proxqp::dense::preconditioner::RuizEquilibration<T>& ruiz)
+{
+  archive(CEREAL_NVP(ruiz.delta),
+          CEREAL_NVP(ruiz.c),
+          CEREAL_NVP(ruiz.dim),
+          CEREAL_NVP(ruiz.epsilon),
+          CEREAL_NVP(ruiz.max_iter),
+          CEREAL_NVP(ruiz.sym));
+}
+
+template<class Archive, typename T, typename I>
+void
+serialize(
+  Archive& archive,
+  proxsuite::proxqp::sparse::preconditioner::RuizEquilibration<T, I>& ruiz)
+{
+  archive(CEREAL_NVP(ruiz.delta),
+          CEREAL_NVP(ruiz.n),
+          CEREAL_NVP(ruiz.c),
+          CEREAL_NVP(ruiz.epsilon),
+          CEREAL_NVP(ruiz.max_iter),
+          CEREAL_NVP(ruiz.sym));
+}
+
+} // namespace cereal
+
+#endif /* end of include guard PROXSUITE_SERIALIZATION_RUIZ_HPP */
@@ -53,7 +53,12 @@ serialize(Archive& archive, proxsuite::proxqp::Settings<T>& settings)
           CEREAL_NVP(settings.eps_primal_inf),
           CEREAL_NVP(settings.eps_dual_inf),
           CEREAL_NVP(settings.bcl_update),
-          CEREAL_NVP(settings.sparse_backend));
+          CEREAL_NVP(settings.sparse_backend),
+          CEREAL_NVP(settings.sparse_ordering),
+          CEREAL_NVP(settings.matrix_free_preconditioner),
+          CEREAL_NVP(settings.mixed_precision),
+          CEREAL_NVP(settings.cache_scaled_model),
+          CEREAL_NVP(settings.preconditioner_warm_start));
 }
 } // namespace cereal
 
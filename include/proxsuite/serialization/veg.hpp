@@ -0,0 +1,38 @@
+//
+// Copyright (c) 2022 INRIA
+//
+/**
+ * @file veg.hpp
+ */
+
+#ifndef PROXSUITE_SERIALIZATION_VEG_HPP
+#define PROXSUITE_SERIALIZATION_VEG_HPP
+
+#include <cereal/cereal.hpp>
+#include <proxsuite/linalg/veg/vec.hpp>
+#include <proxsuite/serialization/eigen.hpp>
+
+namespace cereal {
+
+template<class Archive, typename T, typename A>
+inline void
+save(Archive& ar, proxsuite::linalg::veg::Vec<T, A> const& vec)
+{
+  proxsuite::linalg::veg::isize len = vec.len();
+  ar(CEREAL_NVP(len));
+  proxsuite::serialization::detail::save_array(ar, vec.ptr(), len);
+}
+
+template<class Archive, typename T, typename A>
+inline void
+load(Archive& ar, proxsuite::linalg::veg::Vec<T, A>& vec)
+{
+  proxsuite::linalg::veg::isize len;
+  ar(CEREAL_NVP(len));
+  vec.resize_for_overwrite(len);
+  proxsuite::serialization::detail::load_array(ar, vec.ptr_mut(), len);
+}
+
+} // namespace cereal
+
+#endif /* end of include guard PROXSUITE_SERIALIZATION_VEG_HPP */
@@ -0,0 +1,336 @@
+//
+// Copyright (c) 2022 INRIA
+//
+/**
+ * @file workspace.hpp
+ */
+
+#ifndef PROXSUITE_SERIALIZATION_WORKSPACE_HPP
+#define PROXSUITE_SERIALIZATION_WORKSPACE_HPP
+
+#include <stdexcept>
+
+#include <cereal/cereal.hpp>
+#include <proxsuite/proxqp/dense/workspace.hpp>
+#include <proxsuite/proxqp/sparse/workspace.hpp>
+#include <proxsuite/serialization/eigen.hpp>
+#include <proxsuite/serialization/ldlt.hpp>
+#include <proxsuite/serialization/veg.hpp>
+
+namespace cereal {
+
+// The workspaces are stored with the state needed for resuming the solves
+// where they were left (equilibrated model, factorizations and active sets),
+// the temporary storage of the iterations is only reallocated when loaded.
+
+template<class Archive, typename T>
+void
+save(Archive& ar, proxsuite::proxqp::dense::Workspace<T> const& work)
+{
+  proxsuite::linalg::veg::isize dim = work.H_scaled.rows();
+  proxsuite::linalg::veg::isize n_eq = work.A_scaled.rows();
+  proxsuite::linalg::veg::isize n_in = work.C_scaled.rows();
+  bool box_constraints = work.u_box_scaled.size() > 0;
+  ar(CEREAL_NVP(dim),
+     CEREAL_NVP(n_eq),
+     CEREAL_NVP(n_in),
+     CEREAL_NVP(box_constraints),
+     CEREAL_NVP(work.dense_backend));
+
+  ar(CEREAL_NVP(work.ldl),
+     CEREAL_NVP(work.H_scaled),
+     CEREAL_NVP(work.g_scaled),
+     CEREAL_NVP(work.A_scaled),
+     CEREAL_NVP(work.C_scaled),
+     CEREAL_NVP(work.b_scaled),
+     CEREAL_NVP(work.u_scaled),
+     CEREAL_NVP(work.l_scaled),
+     CEREAL_NVP(work.u_box_scaled),
+     CEREAL_NVP(work.l_box_scaled));
+
+  ar(CEREAL_NVP(work.scaled_model_cached), CEREAL_NVP(work.ldl_cached));
+  if (work.scaled_model_cached) {
+    ar(CEREAL_NVP(work.H_scaled_cache),
+       CEREAL_NVP(work.g_scaled_cache),
+       CEREAL_NVP(work.A_scaled_cache),
+       CEREAL_NVP(work.C_scaled_cache),
+       CEREAL_NVP(work.b_scaled_cache),
+       CEREAL_NVP(work.u_scaled_cache),
+       CEREAL_NVP(work.l_scaled_cache),
+       CEREAL_NVP(work.u_box_scaled_cache),
+       CEREAL_NVP(work.l_box_scaled_cache),
+       CEREAL_NVP(work.correction_guess_rhs_g_cache));
+  }
+  if (work.ldl_cached) {
+    ar(CEREAL_NVP(work.ldl_cache),
+       CEREAL_NVP(work.ldl_cache_rho),
+       CEREAL_NVP(work.ldl_cache_mu_eq));
+  }
+
+  ar(CEREAL_NVP(work.x_prev),
+     CEREAL_NVP(work.y_prev),
+     CEREAL_NVP(work.z_prev),
+     CEREAL_NVP(work.z_box_prev),
+     CEREAL_NVP(work.kkt),
+     CEREAL_NVP(work.current_bijection_map),
+     CEREAL_NVP(work.new_bijection_map),
+     CEREAL_NVP(work.active_set_up),
+     CEREAL_NVP(work.active_set_low),
+     CEREAL_NVP(work.active_inequalities),
+     CEREAL_NVP(work.active_set_up_box),
+     CEREAL_NVP(work.active_set_low_box),
+     CEREAL_NVP(work.active_box),
+     CEREAL_NVP(work.factorized_box),
+     CEREAL_NVP(work.dual_feasibility_rhs_2),
+     CEREAL_NVP(work.correction_guess_rhs_g),
+     CEREAL_NVP(work.correction_guess_rhs_b),
+     CEREAL_NVP(work.alpha),
+     CEREAL_NVP(work.constraints_changed),
+     CEREAL_NVP(work.dirty),
+     CEREAL_NVP(work.refactorize),
+     CEREAL_NVP(work.proximal_parameter_update),
+     CEREAL_NVP(work.is_initialized),
+     CEREAL_NVP(work.n_c));
+}
+
+template<class Archive, typename T>
+void
+load(Archive& ar, proxsuite::proxqp::dense::Workspace<T>& work)
+{
+  proxsuite::linalg::veg::isize dim;
+  proxsuite::linalg::veg::isize n_eq;
+  proxsuite::linalg::veg::isize n_in;
+  bool box_constraints;
+  proxsuite::proxqp::DenseBackend dense_backend;
+  ar(CEREAL_NVP(dim),
+     CEREAL_NVP(n_eq),
+     CEREAL_NVP(n_in),
+     CEREAL_NVP(box_constraints),
+     CEREAL_NVP(dense_backend));
+  // allocates the temporary storage for these dimensions, H_scaled is resized
+  // when loaded
+  work = proxsuite::proxqp::dense::Workspace<T>(
+    dim,
+    n_eq,
+    n_in,
+    box_constraints,
+    proxsuite::proxqp::HessianType::Zero,
+    dense_backend);
+
+  ar(CEREAL_NVP(work.ldl),
+     CEREAL_NVP(work.H_scaled),
+     CEREAL_NVP(work.g_scaled),
+     CEREAL_NVP(work.A_scaled),
+     CEREAL_NVP(work.C_scaled),
+     CEREAL_NVP(work.b_scaled),
+     CEREAL_NVP(work.u_scaled),
+     CEREAL_NVP(work.l_scaled),
+     CEREAL_NVP(work.u_box_scaled),
+     CEREAL_NVP(work.l_box_scaled));
+
+  ar(CEREAL_NVP(work.scaled_model_cached), CEREAL_NVP(work.ldl_cached));
+  if (work.scaled_model_cached) {
+    ar(CEREAL_NVP(work.H_scaled_cache),
+       CEREAL_NVP(work.g_scaled_cache),
+       CEREAL_NVP(work.A_scaled_cache),
+       CEREAL_NVP(work.C_scaled_cache),
+       CEREAL_NVP(work.b_scaled_cache),
+       CEREAL_NVP(work.u_scaled_cache),
+       CEREAL_NVP(work.l_scaled_cache),
+       CEREAL_NVP(work.u_box_scaled_cache),
+       CEREAL_NVP(work.l_box_scaled_cache),
+       CEREAL_NVP(work.correction_guess_rhs_g_cache));
+  }
+  if (work.ldl_cached) {
+    ar(CEREAL_NVP(work.ldl_cache),
+       CEREAL_NVP(work.ldl_cache_rho),
+       CEREAL_NVP(work.ldl_cache_mu_eq));
+  }
+
+  ar(CEREAL_NVP(work.x_prev),
+     CEREAL_NVP(work.y_prev),
+     CEREAL_NVP(work.z_prev),
+     CEREAL_NVP(work.z_box_prev),
+     CEREAL_NVP(work.kkt),
+     CEREAL_NVP(work.current_bijection_map),
+     CEREAL_NVP(work.new_bijection_map),
+     CEREAL_NVP(work.active_set_up),
+     CEREAL_NVP(work.active_set_low),
+     CEREAL_NVP(work.active_inequalities),
+     CEREAL_NVP(work.active_set_up_box),
+     CEREAL_NVP(work.active_set_low_box),
+     CEREAL_NVP(work.active_box),
+     CEREAL_NVP(work.factorized_box),
+     CEREAL_NVP(work.dual_feasibility_rhs_2),
+     CEREAL_NVP(work.correction_guess_rhs_g),
+     CEREAL_NVP(work.correction_guess_rhs_b),
+     CEREAL_NVP(work.alpha),
+     CEREAL_NVP(work.constraints_changed),
+     CEREAL_NVP(work.dirty),
+     CEREAL_NVP(work.refactorize),
+     CEREAL_NVP(work.proximal_parameter_update),
+     CEREAL_NVP(work.is_initialized),
+     CEREAL_NVP(work.n_c));
+}
+
+// The numerical factorizations of the sparse backend are recomputed at the
+// start of each solve, hence only their symbolic structure is stored along
+// with the size of their values.
+
+template<class Archive, typename T, typename I>
+void
+save(Archive& ar, proxsuite::proxqp::sparse::Ldlt<T, I> const& ldl)
+{
+  proxsuite::linalg::veg::isize nnz_counts_len = ldl.nnz_counts.len();
+  proxsuite::linalg::veg::isize row_indices_len = ldl.row_indices.len();
+  proxsuite::linalg::veg::isize values_len = ldl.values.len();
+  proxsuite::linalg::veg::isize values_low_len = ldl.values_low.len();
+  ar(CEREAL_NVP(ldl.etree),
+     CEREAL_NVP(ldl.perm),
+     CEREAL_NVP(ldl.perm_inv),
+     CEREAL_NVP(ldl.col_ptrs),
+     CEREAL_NVP(nnz_counts_len),
+     CEREAL_NVP(row_indices_len),
+     CEREAL_NVP(values_len),
+     CEREAL_NVP(values_low_len));
+}
+
+template<class Archive, typename T, typename I>
+void
+load(Archive& ar, proxsuite::proxqp::sparse::Ldlt<T, I>& ldl)
+{
+  proxsuite::linalg::veg::isize nnz_counts_len;
+  proxsuite::linalg::veg::isize row_indices_len;
+  proxsuite::linalg::veg::isize values_len;
+  proxsuite::linalg::veg::isize values_low_len;
+  ar(CEREAL_NVP(ldl.etree),
+     CEREAL_NVP(ldl.perm),
+     CEREAL_NVP(ldl.perm_inv),
+     CEREAL_NVP(ldl.col_ptrs),
+     CEREAL_NVP(nnz_counts_len),
+     CEREAL_NVP(row_indices_len),
+     CEREAL_NVP(values_len),
+     CEREAL_NVP(values_low_len));
+  ldl.nnz_counts.resize_for_overwrite(nnz_counts_len);
+  ldl.row_indices.resize_for_overwrite(row_indices_len);
+  ldl.values.resize_for_overwrite(values_len);
+  ldl.values_low.resize_for_overwrite(values_low_len);
+}
+
+template<class Archive, typename T, typename I>
+void
+save(Archive& ar,
+     proxsuite::linalg::sparse::SupernodalLdlt<T, I> const& supernodal)
+{
+  proxsuite::linalg::veg::isize values_len = supernodal.values.len();
+  ar(CEREAL_NVP(supernodal.n),
+     CEREAL_NVP(supernodal.n_supernodes),
+     CEREAL_NVP(supernodal.max_rows),
+     CEREAL_NVP(supernodal.max_cols),
+     CEREAL_NVP(supernodal.perm),
+     CEREAL_NVP(supernodal.perm_inv),
+     CEREAL_NVP(supernodal.etree),
+     CEREAL_NVP(supernodal.super_ptr),
+     CEREAL_NVP(supernodal.col_to_super),
+     CEREAL_NVP(supernodal.row_ptr),
+     CEREAL_NVP(supernodal.row_indices),
+     CEREAL_NVP(supernodal.values_ptr),
+     CEREAL_NVP(values_len));
+}
+
+template<class Archive, typename T, typename I>
+void
+load(Archive& ar, proxsuite::linalg::sparse::SupernodalLdlt<T, I>& supernodal)
+{
+  proxsuite::linalg::veg::isize values_len;
+  ar(CEREAL_NVP(supernodal.n),
+     CEREAL_NVP(supernodal.n_supernodes),
+     CEREAL_NVP(supernodal.max_rows),
+     CEREAL_NVP(supernodal.max_cols),
+     CEREAL_NVP(supernodal.perm),
+     CEREAL_NVP(supernodal.perm_inv),
+     CEREAL_NVP(supernodal.etree),
+     CEREAL_NVP(supernodal.super_ptr),
+     CEREAL_NVP(supernodal.col_to_super),
+     CEREAL_NVP(supernodal.row_ptr),
+     CEREAL_NVP(supernodal.row_indices),
+     CEREAL_NVP(supernodal.values_ptr),
+     CEREAL_NVP(values_len));
+  supernodal.values.resize_for_overwrite(values_len);
+}
+
+template<class Archive, typename T, typename I>
+void
+save(Archive& ar, proxsuite::proxqp::sparse::Workspace<T, I> const& work)
+{
+  if (work.internal.linear_operator != nullptr) {
+    throw std::invalid_argument(
+      "the workspace of a QP defined by linear operators cannot be saved.");
+  }
+  // only the size of the memory stack is needed
+  proxsuite::linalg::veg::isize storage_len = work.internal.storage.len();
+  ar(CEREAL_NVP(storage_len),
+     CEREAL_NVP(work.internal.ldl),
+     CEREAL_NVP(work.internal.supernodal),
+     CEREAL_NVP(work.internal.do_ldlt),
+     CEREAL_NVP(work.internal.do_supernodal),
+     CEREAL_NVP(work.internal.mixed_precision),
+     CEREAL_NVP(work.internal.do_symbolic_fact),
+     CEREAL_NVP(work.internal.lnnz_overflow),
+     CEREAL_NVP(work.internal.ordering),
+     CEREAL_NVP(work.internal.g_scaled),
+     CEREAL_NVP(work.internal.b_scaled),
+     CEREAL_NVP(work.internal.l_scaled),
+     CEREAL_NVP(work.internal.u_scaled),
+     CEREAL_NVP(work.internal.kkt_nnz_counts),
+     CEREAL_NVP(work.internal.H_values_map),
+     CEREAL_NVP(work.internal.A_values_map),
+     CEREAL_NVP(work.internal.C_values_map),
+     CEREAL_NVP(work.internal.dirty),
+     CEREAL_NVP(work.internal.proximal_parameter_update),
+     CEREAL_NVP(work.internal.is_initialized),
+     CEREAL_NVP(work.active_set_up),
+     CEREAL_NVP(work.active_set_low),
+     CEREAL_NVP(work.active_inequalities),
+     CEREAL_NVP(work.lnnz));
+}
+
+template<class Archive, typename T, typename I>
+void
+load(Archive& ar, proxsuite::proxqp::sparse::Workspace<T, I>& work)
+{
+  proxsuite::linalg::veg::isize storage_len;
+  ar(CEREAL_NVP(storage_len),
+     CEREAL_NVP(work.internal.ldl),
+     CEREAL_NVP(work.internal.supernodal),
+     CEREAL_NVP(work.internal.do_ldlt),
+     CEREAL_NVP(work.internal.do_supernodal),
+     CEREAL_NVP(work.internal.mixed_precision),
+     CEREAL_NVP(work.internal.do_symbolic_fact),
+     CEREAL_NVP(work.internal.lnnz_overflow),
+     CEREAL_NVP(work.internal.ordering),
+     CEREAL_NVP(work.internal.g_scaled),
+     CEREAL_NVP(work.internal.b_scaled),
+     CEREAL_NVP(work.internal.l_scaled),
+     CEREAL_NVP(work.internal.u_scaled),
+     CEREAL_NVP(work.internal.kkt_nnz_counts),
+     CEREAL_NVP(work.internal.H_values_map),
+     CEREAL_NVP(work.internal.A_values_map),
+     CEREAL_NVP(work.internal.C_values_map),
+     CEREAL_NVP(work.internal.dirty),
+     CEREAL_NVP(work.internal.proximal_parameter_update),
+     CEREAL_NVP(work.internal.is_initialized),
+     CEREAL_NVP(work.active_set_up),
+     CEREAL_NVP(work.active_set_low),
+     CEREAL_NVP(work.active_inequalities),
+     CEREAL_NVP(work.lnnz));
+  work.internal.storage.resize_for_overwrite(storage_len);
+  // the matrix free solver is allocated again by the next factorization
+  work.internal.matrix_free_kkt.reset();
+  work.internal.matrix_free_solver.reset();
+  work.internal.linear_operator.reset();
+}
+
+} // namespace cereal
+
+#endif /* end of include guard PROXSUITE_SERIALIZATION_WORKSPACE_HPP */
@@ -10,15 +10,79 @@
 
 #include <cereal/cereal.hpp>
 #include <proxsuite/proxqp/dense/wrapper.hpp>
+#include <proxsuite/proxqp/sparse/wrapper.hpp>
+#include <proxsuite/serialization/eigen.hpp>
+#include <proxsuite/serialization/model.hpp>
+#include <proxsuite/serialization/results.hpp>
+#include <proxsuite/serialization/ruiz.hpp>
+#include <proxsuite/serialization/settings.hpp>
+#include <proxsuite/serialization/workspace.hpp>
 
 namespace cereal {
 
+// the workspace and the preconditioner are stored as well (from version 1 on
+// for dense QPs), so that a loaded QP resumes its solves without equilibrating
+// and factorizing its model again
+
 template<class Archive, typename T>
 void
-serialize(Archive& archive, proxsuite::proxqp::dense::QP<T>& qp)
+serialize(Archive& archive,
+          proxsuite::proxqp::dense::QP<T>& qp,
+          std::uint32_t const version)
 {
   archive(
     CEREAL_NVP(qp.model), CEREAL_NVP(qp.results), CEREAL_NVP(qp.settings));
+  if (version >= 1) {
+    archive(CEREAL_NVP(qp.work), CEREAL_NVP(qp.ruiz));
+    return;
+  }
+  // version 0 archives only store the problem: the workspace and the
+  // preconditioner are set up again for it, as by init, which equilibrates and
+  // factorizes the model before the next solve
+  using proxsuite::proxqp::dense::isize;
+  using proxsuite::nullopt;
+  using proxsuite::proxqp::dense::VecRef;
+  proxsuite::proxqp::dense::Model<T> model = qp.model;
+  isize n_eq = model.n_eq;
+  isize n_in = model.n_in;
+  qp.work = proxsuite::proxqp::dense::Workspace<T>(model.dim,
+                                                   n_eq,
+                                                   n_in,
+                                                   model.box_constraints,
+                                                   model.hessian_type,
+                                                   qp.work.dense_backend);
+  qp.ruiz = proxsuite::proxqp::dense::preconditioner::RuizEquilibration<T>{
+    model.dim, n_eq + n_in
+  };
+  using box_type = proxsuite::optional<VecRef<T>>;
+  box_type l_box =
+    model.box_constraints ? box_type(model.l_box) : box_type(nullopt);
+  box_type u_box =
+    model.box_constraints ? box_type(model.u_box) : box_type(nullopt);
+  qp.init(model.H,
+          model.g,
+          model.A,
+          model.b,
+          model.C,
+          model.l,
+          model.u,
+          l_box,
+          u_box);
+}
+
+template<class Archive, typename T, typename I>
+void
+serialize(Archive& archive, proxsuite::proxqp::sparse::QP<T, I>& qp)
+{
+  archive(CEREAL_NVP(qp.model),
+          CEREAL_NVP(qp.results),
+          CEREAL_NVP(qp.settings),
+          CEREAL_NVP(qp.work),
+          CEREAL_NVP(qp.ruiz));
 }
 } // namespace cereal
+
+CEREAL_CLASS_VERSION(proxsuite::proxqp::dense::QP<double>, 1)
+CEREAL_CLASS_VERSION(proxsuite::proxqp::dense::QP<float>, 1)
+
 #endif /* end of include guard PROXSUITE_SERIALIZATION_WRAPPER_HPP */
@@ -0,0 +1,101 @@
+//
+// Copyright (c) 2022 INRIA
+//
+#include <proxsuite/linalg/dense/update.hpp>
+#include <doctest.hpp>
+#include <Eigen/Core>
+
+using proxsuite::linalg::veg::isize;
+using proxsuite::linalg::veg::usize;
+
+template<typename T>
+using Mat = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>;
+template<typename T>
+using Vec = Eigen::Matrix<T, Eigen::Dynamic, 1>;
+
+template<typename T>
+auto
+reconstruct(Mat<T> const& ld) -> Mat<T>
+{
+  Mat<T> l = ld.template triangularView<Eigen::UnitLower>();
+  return l * ld.diagonal().asDiagonal() * l.transpose();
+}
+
+template<typename T>
+void
+check_rank_r_update(isize n, isize r, T eps)
+{
+  Mat<T> w = Mat<T>::Random(n, r);
+  Vec<T> alpha = Vec<T>::Random(r).cwiseAbs();
+  Mat<T> expected = Mat<T>::Identity(n, n) +
+                    w * alpha.asDiagonal() * w.transpose();
+
+  // the LDLT factorization of the identity is L = D = I
+  Mat<T> ld = Mat<T>::Identity(n, n);
+  proxsuite::linalg::dense::rank_r_update_clobber_inputs(ld, w, alpha);
+
+  CHECK((reconstruct(ld) - expected).norm() <= eps * expected.norm());
+}
+
+TEST_CASE("dense LDLT: rank r update")
+{
+  std::srand(1);
+  for (isize n : { 1, 7, 16, 37, 100 }) {
+    for (isize r : { 1, 3, 4, 9 }) {
+      check_rank_r_update<double>(n, r, 1e-12);
+      check_rank_r_update<float>(n, r, 1e-4F);
+    }
+  }
+}
+
+#ifdef PROXSUITE_DENSE_RUNTIME_DISPATCH
+template<usize R, typename T>
+void
+check_dispatched_kernels(isize n)
+{
+  using namespace proxsuite::linalg::dense::_detail;
+
+  isize w_stride = n + 3;
+  Vec<T> l0 = Vec<T>::Random(n);
+  Vec<T> w0 = Vec<T>::Random(w_stride * isize(R));
+  Vec<T> p = Vec<T>::Random(isize(R));
+  Vec<T> mu = Vec<T>::Random(isize(R));
+
+  Vec<T> l_ref = l0;
+  Vec<T> w_ref = w0;
+  RankRUpdateDispatch<T>::template fn<R>(n,
+                                         l_ref.data(),
+                                         w_ref.data(),
+                                         w_stride,
+                                         p.data(),
+                                         mu.data(),
+                                         SimdLevel::Generic);
+
+  SimdLevel levels[] = { SimdLevel::Avx2, SimdLevel::Avx512 };
+  for (SimdLevel level : levels) {
+    if (int(level) > int(runtime_simd_level())) {
+      continue;
+    }
+    Vec<T> l = l0;
+    Vec<T> w = w0;
+    RankRUpdateDispatch<T>::template fn<R>(
+      n, l.data(), w.data(), w_stride, p.data(), mu.data(), level);
+    T eps = std::numeric_limits<T>::epsilon() * 100;
+    CHECK((l - l_ref).template lpNorm<Eigen::Infinity>() <= eps);
+    CHECK((w - w_ref).template lpNorm<Eigen::Infinity>() <= eps);
+  }
+}
+
+TEST_CASE("dense LDLT: dispatched rank r update kernels")
+{
+  std::srand(2);
+  for (isize n : { 0, 1, 5, 8, 16, 23, 64, 101 }) {
+    check_dispatched_kernels<1, double>(n);
+    check_dispatched_kernels<2, double>(n);
+    check_dispatched_kernels<3, double>(n);
+    check_dispatched_kernels<4, double>(n);
+    check_dispatched_kernels<1, float>(n);
+    check_dispatched_kernels<4, float>(n);
+  }
+}
+#endif
@@ -0,0 +1,158 @@
+//
+// Copyright (c) 2022 INRIA
+//
+#include <proxsuite/proxqp/dense/linesearch.hpp>
+#include <doctest.hpp>
+#include <Eigen/Core>
+#include <cstdlib>
+#include <limits>
+
+using namespace proxsuite::proxqp;
+using proxsuite::linalg::veg::isize;
+
+template<typename T>
+using Mat = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>;
+template<typename T>
+using Vec = Eigen::Matrix<T, Eigen::Dynamic, 1>;
+
+/*!
+ * Fills the workspace with a random state of the primal-dual linesearch: a
+ * random convex problem, random iterates and a random Newton step.
+ */
+template<typename T>
+void
+random_linesearch_state(dense::Model<T>& model,
+                        Results<T>& results,
+                        dense::Workspace<T>& work)
+{
+  isize dim = model.dim;
+  isize n_eq = model.n_eq;
+  isize n_in = model.n_in;
+
+  Mat<T> h_half = Mat<T>::Random(dim, dim);
+  Mat<T> h = h_half * h_half.transpose();
+  Mat<T> a = Mat<T>::Random(n_eq, dim);
+  Mat<T> c = Mat<T>::Random(n_in, dim);
+
+  results.info.rho = T(1e-6);
+  results.info.mu_eq = T(1e-2);
+  results.info.mu_eq_inv = T(1) / results.info.mu_eq;
+  results.info.mu_in = T(1e-1);
+  results.info.mu_in_inv = T(1) / results.info.mu_in;
+  results.info.nu = T(1);
+
+  results.x.setRandom();
+  results.y.setRandom();
+  results.z.setRandom();
+  work.x_prev.setRandom();
+  work.g_scaled.setRandom();
+  work.primal_residual_eq_scaled.setRandom();
+  // l <= u, hence the lower residual is above the upper one
+  work.primal_residual_in_scaled_up.setRandom();
+  work.primal_residual_in_scaled_low =
+    work.primal_residual_in_scaled_up + Vec<T>::Random(n_in).cwiseAbs();
+
+  // large enough steps for several breakpoints to lie in (0, 1]
+  work.dw_aug.setRandom();
+  work.dw_aug *= T(4);
+  auto dx = work.dw_aug.head(dim);
+  work.Hdx = h * dx;
+  work.Adx = a * dx;
+  work.Cdx = c * dx;
+
+  if (model.box_constraints) {
+    results.z_box.setRandom();
+    work.dz_box = T(4) * Vec<T>::Random(dim);
+    work.primal_residual_box_scaled_up.setRandom();
+    work.primal_residual_box_scaled_low =
+      work.primal_residual_box_scaled_up + Vec<T>::Random(dim).cwiseAbs();
+  }
+}
+
+/*!
+ * Returns the smallest positive breakpoint of the piecewise quadratic merit
+ * function, i.e., the first step at which a bound changes state.
+ */
+template<typename T>
+T
+first_breakpoint(const dense::Model<T>& model, const dense::Workspace<T>& work)
+{
+  T first = std::numeric_limits<T>::infinity();
+  auto update = [&](T r, T c) {
+    if (c != T(0) && -r / c > T(0)) {
+      first = std::min(first, -r / c);
+    }
+  };
+  for (isize i = 0; i < model.n_in; ++i) {
+    update(work.primal_residual_in_scaled_up(i), work.Cdx(i));
+    update(work.primal_residual_in_scaled_low(i), work.Cdx(i));
+  }
+  if (model.box_constraints) {
+    for (isize i = 0; i < model.dim; ++i) {
+      update(work.primal_residual_box_scaled_up(i), work.dw_aug(i));
+      update(work.primal_residual_box_scaled_low(i), work.dw_aug(i));
+    }
+  }
+  return first;
+}
+
+/*!
+ * Checks that the step of the exact linesearch is the first step at which the
+ * derivative of the merit function becomes nonnegative, either by cancelling
+ * or by jumping at a breakpoint.
+ */
+template<typename T>
+void
+check_primal_dual_ls(isize dim, isize n_eq, isize n_in, bool box_constraints)
+{
+  dense::Model<T> model(dim, n_eq, n_in, box_constraints);
+  Results<T> results(dim, n_eq, n_in, box_constraints);
+  dense::Workspace<T> work(dim, n_eq, n_in, box_constraints);
+  auto derivative = [&](T t) -> T {
+    return dense::linesearch::primal_dual_derivative_results(
+             model, results, work, t)
+      .grad;
+  };
+  // as in the solver, the step is a descent direction of the merit function
+  do {
+    random_linesearch_state(model, results, work);
+  } while (derivative(T(0)) >= T(0));
+
+  dense::linesearch::primal_dual_ls(model, results, work);
+  T alpha = work.alpha;
+
+  if (first_breakpoint(model, work) > T(1)) {
+    // no bound changes state along the unit step
+    CHECK(alpha == T(1));
+    return;
+  }
+
+  T scale = T(1) + std::abs(derivative(T(0)));
+  T eps = T(1e-8) * scale;
+  CHECK(alpha > T(0));
+  // the derivative stays negative before alpha
+  isize n_samples = 200;
+  for (isize k = 1; k < n_samples; ++k) {
+    T t = alpha * T(k) / T(n_samples);
+    CHECK(derivative(t) < eps);
+  }
+  // and is nonnegative right after it
+  CHECK(derivative(alpha + T(1e-9) * std::max(T(1), alpha)) > -eps);
+}
+
+DOCTEST_TEST_CASE("linesearch: primal-dual linesearch step")
+{
+  std::srand(1);
+  for (isize k = 0; k < 50; ++k) {
+    check_primal_dual_ls<double>(10, 3, 20, false);
+  }
+}
+
+DOCTEST_TEST_CASE("linesearch: primal-dual linesearch step with box "
+                  "constraints")
+{
+  std::srand(1);
+  for (isize k = 0; k < 50; ++k) {
+    check_primal_dual_ls<double>(10, 3, 20, true);
+  }
+}
@@ -4,6 +4,7 @@
 #include <doctest.hpp>
 #include <Eigen/Core>
 #include <Eigen/Cholesky>
+#include <Eigen/QR>
 #include <proxsuite/proxqp/dense/dense.hpp>
 #include <proxsuite/linalg/veg/util/dbg.hpp>
 #include <proxsuite/proxqp/utils/random_qp_problems.hpp>
@@ -6798,4 +6799,746 @@ TEST_CASE("ProxQP::dense: init must be called before update")
               .lpNorm<Eigen::Infinity>();
   CHECK(dua_res <= eps_abs);
   CHECK(pri_res <= eps_abs);
-}
\ No newline at end of file
+}
+TEST_CASE("ProxQP::dense: test mixed precision factorization")
+{
+  double sparsity_factor = 0.15;
+  T eps_abs = T(1e-9);
+  utils::rand::set_seed(1);
+  dense::isize dim = 100;
+
+  dense::isize n_eq(dim / 4);
+  dense::isize n_in(dim / 4);
+  T strong_convexity_factor(1.e-2);
+  proxqp::dense::Model<T> qp_random = proxqp::utils::dense_strongly_convex_qp(
+    dim, n_eq, n_in, sparsity_factor, strong_convexity_factor);
+
+  dense::QP<T> qp(dim, n_eq, n_in);
+  qp.settings.eps_abs = eps_abs;
+  qp.settings.eps_rel = 0;
+  qp.init(qp_random.H,
+          qp_random.g,
+          qp_random.A,
+          qp_random.b,
+          qp_random.C,
+          qp_random.l,
+          qp_random.u);
+  qp.solve();
+
+  dense::QP<T> qp_mixed(dim, n_eq, n_in);
+  qp_mixed.settings.eps_abs = eps_abs;
+  qp_mixed.settings.eps_rel = 0;
+  qp_mixed.settings.mixed_precision = true;
+  qp_mixed.init(qp_random.H,
+                qp_random.g,
+                qp_random.A,
+                qp_random.b,
+                qp_random.C,
+                qp_random.l,
+                qp_random.u);
+  qp_mixed.solve();
+
+  T pri_res = std::max(
+    (qp_random.A * qp_mixed.results.x - qp_random.b)
+      .lpNorm<Eigen::Infinity>(),
+    (helpers::positive_part(qp_random.C * qp_mixed.results.x - qp_random.u) +
+     helpers::negative_part(qp_random.C * qp_mixed.results.x - qp_random.l))
+      .lpNorm<Eigen::Infinity>());
+  T dua_res = (qp_random.H * qp_mixed.results.x + qp_random.g +
+               qp_random.A.transpose() * qp_mixed.results.y +
+               qp_random.C.transpose() * qp_mixed.results.z)
+                .lpNorm<Eigen::Infinity>();
+  CHECK(dua_res <= eps_abs);
+  CHECK(pri_res <= eps_abs);
+  CHECK((qp_mixed.results.x - qp.results.x).lpNorm<Eigen::Infinity>() <=
+        1e-6);
+  CHECK(!qp_mixed.results.info.mixed_precision_fallback);
+
+  // the storage of both precisions is reserved ahead of the factorizations,
+  // whichever is requested first, so that neither the single precision
+  // factorization nor the fallback allocate during the solve
+  isize n_kkt = dim + n_eq + n_in;
+  proxsuite::linalg::dense::MixedLdlt<T> ldl_low_first;
+  ldl_low_first.set_low_precision(true);
+  ldl_low_first.reserve_uninit(n_kkt);
+  CHECK(ldl_low_first.low_precision_ldlt().ld_col().outerStride() >= n_kkt);
+  CHECK(ldl_low_first.full_precision_ldlt().ld_col().outerStride() >= n_kkt);
+  proxsuite::linalg::dense::MixedLdlt<T> ldl_full_first;
+  ldl_full_first.reserve_uninit(n_kkt);
+  ldl_full_first.set_low_precision(true);
+  CHECK(ldl_full_first.low_precision_ldlt().ld_col().outerStride() >= n_kkt);
+  CHECK(ldl_full_first.full_precision_ldlt().ld_col().outerStride() >= n_kkt);
+
+  // with a badly conditioned hessian, the iterative refinement stalls with the
+  // single precision factorization and the solver falls back to full
+  // precision
+  Eigen::MatrixXd Q = Eigen::HouseholderQR<Eigen::MatrixXd>(
+                        utils::rand::matrix_rand<T>(dim, dim))
+                        .householderQ();
+  Eigen::VectorXd eigenvalues(dim);
+  for (isize i = 0; i < dim; ++i) {
+    eigenvalues[i] = std::pow(10., -5. + 10. * T(i) / T(dim - 1));
+  }
+  qp_random.H = Q * eigenvalues.asDiagonal() * Q.transpose();
+  qp_random.H = (0.5 * (qp_random.H + qp_random.H.transpose())).eval();
+
+  dense::QP<T> qp_ill(dim, n_eq, n_in);
+  qp_ill.settings.eps_abs = eps_abs;
+  qp_ill.settings.eps_rel = 0;
+  qp_ill.settings.mixed_precision = true;
+  qp_ill.init(qp_random.H,
+              qp_random.g,
+              qp_random.A,
+              qp_random.b,
+              qp_random.C,
+              qp_random.l,
+              qp_random.u,
+              false);
+  qp_ill.solve();
+  CHECK(qp_ill.results.info.mixed_precision_fallback);
+  CHECK(qp_ill.results.info.status == QPSolverOutput::PROXQP_SOLVED);
+
+  pri_res = std::max(
+    (qp_random.A * qp_ill.results.x - qp_random.b).lpNorm<Eigen::Infinity>(),
+    (helpers::positive_part(qp_random.C * qp_ill.results.x - qp_random.u) +
+     helpers::negative_part(qp_random.C * qp_ill.results.x - qp_random.l))
+      .lpNorm<Eigen::Infinity>());
+  dua_res = (qp_random.H * qp_ill.results.x + qp_random.g +
+             qp_random.A.transpose() * qp_ill.results.y +
+             qp_random.C.transpose() * qp_ill.results.z)
+              .lpNorm<Eigen::Infinity>();
+  CHECK(dua_res <= eps_abs);
+  CHECK(pri_res <= eps_abs);
+}
+
+TEST_CASE("ProxQP::dense: test box constraints")
+{
+  double sparsity_factor = 0.15;
+  T eps_abs = T(1e-9);
+  utils::rand::set_seed(1);
+  dense::isize dim = 50;
+  dense::isize n_eq(dim / 5);
+  dense::isize n_in(dim / 2);
+  T strong_convexity_factor(1.e-2);
+  proxqp::dense::Model<T> qp_random = proxqp::utils::dense_strongly_convex_qp(
+    dim, n_eq, n_in, sparsity_factor, strong_convexity_factor);
+
+  dense::QP<T> qp(dim, n_eq, n_in);
+  qp.settings.eps_abs = eps_abs;
+  qp.settings.eps_rel = 0;
+  qp.init(qp_random.H,
+          qp_random.g,
+          qp_random.A,
+          qp_random.b,
+          qp_random.C,
+          qp_random.l,
+          qp_random.u);
+  qp.solve();
+
+  // bounds cutting the unconstrained solution on a third of the variables
+  Eigen::VectorXd u_box =
+    Eigen::VectorXd::Constant(dim, helpers::infinite_bound<T>::value());
+  Eigen::VectorXd l_box = qp.results.x.array() - 1.;
+  for (isize i = 0; i < dim; i += 3) {
+    u_box[i] = qp.results.x[i] - 0.05;
+  }
+
+  dense::QP<T> qp_box(dim, n_eq, n_in, true);
+  qp_box.settings.eps_abs = eps_abs;
+  qp_box.settings.eps_rel = 0;
+  qp_box.init(qp_random.H,
+              qp_random.g,
+              qp_random.A,
+              qp_random.b,
+              qp_random.C,
+              qp_random.l,
+              qp_random.u,
+              l_box,
+              u_box);
+  qp_box.solve();
+  CHECK(qp_box.results.info.status == QPSolverOutput::PROXQP_SOLVED);
+
+  T pri_res = std::max(
+    (qp_random.A * qp_box.results.x - qp_random.b).lpNorm<Eigen::Infinity>(),
+    (helpers::positive_part(qp_random.C * qp_box.results.x - qp_random.u) +
+     helpers::negative_part(qp_random.C * qp_box.results.x - qp_random.l))
+      .lpNorm<Eigen::Infinity>());
+  pri_res =
+    std::max(pri_res,
+             (helpers::positive_part(qp_box.results.x - u_box) +
+              helpers::negative_part(qp_box.results.x - l_box))
+               .lpNorm<Eigen::Infinity>());
+  T dua_res = (qp_random.H * qp_box.results.x + qp_random.g +
+               qp_random.A.transpose() * qp_box.results.y +
+               qp_random.C.transpose() * qp_box.results.z +
+               qp_box.results.z_box)
+                .lpNorm<Eigen::Infinity>();
+  CHECK(pri_res <= eps_abs);
+  CHECK(dua_res <= eps_abs);
+
+  // same problem with the box constraints stacked below C
+  dense::isize n_in_stacked = n_in + dim;
+  Eigen::MatrixXd C_stacked(n_in_stacked, dim);
+  C_stacked << qp_random.C, Eigen::MatrixXd::Identity(dim, dim);
+  Eigen::VectorXd l_stacked(n_in_stacked);
+  l_stacked << qp_random.l, l_box;
+  Eigen::VectorXd u_stacked(n_in_stacked);
+  u_stacked << qp_random.u, u_box;
+
+  dense::QP<T> qp_stacked(dim, n_eq, n_in_stacked);
+  qp_stacked.settings.eps_abs = eps_abs;
+  qp_stacked.settings.eps_rel = 0;
+  qp_stacked.init(qp_random.H,
+                  qp_random.g,
+                  qp_random.A,
+                  qp_random.b,
+                  C_stacked,
+                  l_stacked,
+                  u_stacked);
+  qp_stacked.solve();
+
+  CHECK((qp_box.results.x - qp_stacked.results.x).lpNorm<Eigen::Infinity>() <=
+        1e-6);
+  CHECK((qp_box.results.z_box - qp_stacked.results.z.tail(dim))
+          .lpNorm<Eigen::Infinity>() <= 1e-6);
+  CHECK(qp_box.results.z_box.cwiseAbs().maxCoeff() > 0);
+
+  // the bounds can be updated without re-initializing the problem
+  l_box.array() -= 1.;
+  u_box.setConstant(helpers::infinite_bound<T>::value());
+  qp_box.update(nullopt,
+                nullopt,
+                nullopt,
+                nullopt,
+                nullopt,
+                nullopt,
+                nullopt,
+                l_box,
+                u_box);
+  qp_box.solve();
+  CHECK(qp_box.results.info.status == QPSolverOutput::PROXQP_SOLVED);
+  CHECK((qp_box.results.x - qp.results.x).lpNorm<Eigen::Infinity>() <= 1e-6);
+}
+
+TEST_CASE("ProxQP::dense: test diagonal and zero hessian types")
+{
+  double sparsity_factor = 0.15;
+  T eps_abs = T(1e-9);
+  utils::rand::set_seed(1);
+  dense::isize dim = 50;
+  dense::isize n_eq(dim / 5);
+  dense::isize n_in(dim / 2);
+  T strong_convexity_factor(1.e-2);
+  proxqp::dense::Model<T> qp_random = proxqp::utils::dense_strongly_convex_qp(
+    dim, n_eq, n_in, sparsity_factor, strong_convexity_factor);
+
+  // diagonal hessian: given fully to a dense QP, and as its diagonal to a
+  // QP with a diagonal hessian type
+  Eigen::VectorXd H_diag = qp_random.H.diagonal().cwiseAbs().array() + 1.;
+  Eigen::MatrixXd H_full = H_diag.asDiagonal();
+
+  dense::QP<T> qp_dense(dim, n_eq, n_in);
+  qp_dense.settings.eps_abs = eps_abs;
+  qp_dense.settings.eps_rel = 0;
+  qp_dense.init(H_full,
+                qp_random.g,
+                qp_random.A,
+                qp_random.b,
+                qp_random.C,
+                qp_random.l,
+                qp_random.u);
+  qp_dense.solve();
+
+  dense::QP<T> qp_diag(dim, n_eq, n_in, false, HessianType::Diagonal);
+  qp_diag.settings.eps_abs = eps_abs;
+  qp_diag.settings.eps_rel = 0;
+  qp_diag.init(Eigen::MatrixXd(H_diag),
+               qp_random.g,
+               qp_random.A,
+               qp_random.b,
+               qp_random.C,
+               qp_random.l,
+               qp_random.u);
+  qp_diag.solve();
+  CHECK(qp_diag.model.H.cols() == 1);
+  CHECK(qp_diag.results.info.status == QPSolverOutput::PROXQP_SOLVED);
+
+  T pri_res = std::max(
+    (qp_random.A * qp_diag.results.x - qp_random.b).lpNorm<Eigen::Infinity>(),
+    (helpers::positive_part(qp_random.C * qp_diag.results.x - qp_random.u) +
+     helpers::negative_part(qp_random.C * qp_diag.results.x - qp_random.l))
+      .lpNorm<Eigen::Infinity>());
+  T dua_res = (H_full * qp_diag.results.x + qp_random.g +
+               qp_random.A.transpose() * qp_diag.results.y +
+               qp_random.C.transpose() * qp_diag.results.z)
+                .lpNorm<Eigen::Infinity>();
+  CHECK(pri_res <= eps_abs);
+  CHECK(dua_res <= eps_abs);
+  CHECK((qp_diag.results.x - qp_dense.results.x).lpNorm<Eigen::Infinity>() <=
+        1e-6);
+  CHECK(std::abs(qp_diag.results.info.objValue -
+                 qp_dense.results.info.objValue) <= 1e-6);
+
+  // the full matrix is also accepted by a QP with a diagonal hessian type
+  qp_diag.update(H_full, nullopt, nullopt, nullopt, nullopt, nullopt, nullopt);
+  qp_diag.solve();
+  CHECK((qp_diag.results.x - qp_dense.results.x).lpNorm<Eigen::Infinity>() <=
+        1e-6);
+
+  // zero hessian: a linear program bounded by box constraints
+  Eigen::VectorXd l_box = Eigen::VectorXd::Constant(dim, -10.);
+  Eigen::VectorXd u_box = Eigen::VectorXd::Constant(dim, 10.);
+  Eigen::MatrixXd H_zero = Eigen::MatrixXd::Zero(dim, dim);
+
+  dense::QP<T> qp_lp_dense(dim, n_eq, n_in, true);
+  qp_lp_dense.settings.eps_abs = eps_abs;
+  qp_lp_dense.settings.eps_rel = 0;
+  qp_lp_dense.init(H_zero,
+                   qp_random.g,
+                   qp_random.A,
+                   qp_random.b,
+                   qp_random.C,
+                   qp_random.l,
+                   qp_random.u,
+                   l_box,
+                   u_box);
+  qp_lp_dense.solve();
+
+  dense::QP<T> qp_lp(dim, n_eq, n_in, true, HessianType::Zero);
+  qp_lp.settings.eps_abs = eps_abs;
+  qp_lp.settings.eps_rel = 0;
+  qp_lp.init(nullopt,
+             qp_random.g,
+             qp_random.A,
+             qp_random.b,
+             qp_random.C,
+             qp_random.l,
+             qp_random.u,
+             l_box,
+             u_box);
+  qp_lp.solve();
+  CHECK(qp_lp.model.H.size() == 0);
+  CHECK(qp_lp.results.info.status == QPSolverOutput::PROXQP_SOLVED);
+  CHECK(qp_lp_dense.results.info.status == QPSolverOutput::PROXQP_SOLVED);
+  CHECK((qp_lp.results.x - qp_lp_dense.results.x).lpNorm<Eigen::Infinity>() <=
+        1e-6);
+  CHECK(std::abs(qp_lp.results.info.objValue -
+                 qp_lp_dense.results.info.objValue) <= 1e-6);
+
+  // the free solve function detects the diagonal structure
+  Results<T> results = dense::solve<T>(H_full,
+                                       qp_random.g,
+                                       qp_random.A,
+                                       qp_random.b,
+                                       qp_random.C,
+                                       qp_random.l,
+                                       qp_random.u,
+                                       nullopt,
+                                       nullopt,
+                                       nullopt,
+                                       eps_abs,
+                                       T(0));
+  CHECK((results.x - qp_dense.results.x).lpNorm<Eigen::Infinity>() <= 1e-6);
+}
+
+TEST_CASE("ProxQP::dense: test PrimalLDLT backend with many inequalities")
+{
+  double sparsity_factor = 0.15;
+  T eps_abs = T(1e-9);
+  utils::rand::set_seed(1);
+  dense::isize dim = 20;
+  dense::isize n_eq(5);
+  dense::isize n_in(200);
+  T strong_convexity_factor(1.e-2);
+  proxqp::dense::Model<T> qp_random = proxqp::utils::dense_strongly_convex_qp(
+    dim, n_eq, n_in, sparsity_factor, strong_convexity_factor);
+
+  dense::QP<T> qp_primal_dual(
+    dim, n_eq, n_in, false, HessianType::Dense, DenseBackend::PrimalDualLDLT);
+  qp_primal_dual.settings.eps_abs = eps_abs;
+  qp_primal_dual.settings.eps_rel = 0;
+  qp_primal_dual.init(qp_random.H,
+                      qp_random.g,
+                      qp_random.A,
+                      qp_random.b,
+                      qp_random.C,
+                      qp_random.l,
+                      qp_random.u);
+  qp_primal_dual.solve();
+
+  // the primal-dual factorization stays the default backend
+  dense::QP<T> qp_default(dim, n_eq, n_in);
+  CHECK(qp_default.work.dense_backend == DenseBackend::PrimalDualLDLT);
+
+  // the automatic choice selects the primal factorization for this problem
+  dense::QP<T> qp(
+    dim, n_eq, n_in, false, HessianType::Dense, DenseBackend::Automatic);
+  CHECK(qp.work.dense_backend == DenseBackend::PrimalLDLT);
+  CHECK(qp.work.kkt.rows() == dim);
+  qp.settings.eps_abs = eps_abs;
+  qp.settings.eps_rel = 0;
+  qp.init(qp_random.H,
+          qp_random.g,
+          qp_random.A,
+          qp_random.b,
+          qp_random.C,
+          qp_random.l,
+          qp_random.u);
+  qp.solve();
+  CHECK(qp.results.info.status == QPSolverOutput::PROXQP_SOLVED);
+
+  T pri_res = std::max(
+    (qp_random.A * qp.results.x - qp_random.b).lpNorm<Eigen::Infinity>(),
+    (helpers::positive_part(qp_random.C * qp.results.x - qp_random.u) +
+     helpers::negative_part(qp_random.C * qp.results.x - qp_random.l))
+      .lpNorm<Eigen::Infinity>());
+  T dua_res = (qp_random.H * qp.results.x + qp_random.g +
+               qp_random.A.transpose() * qp.results.y +
+               qp_random.C.transpose() * qp.results.z)
+                .lpNorm<Eigen::Infinity>();
+  CHECK(pri_res <= eps_abs);
+  CHECK(dua_res <= eps_abs);
+  CHECK((qp.results.x - qp_primal_dual.results.x).lpNorm<Eigen::Infinity>() <=
+        1e-6);
+
+  // warm start from the previous solution: the active set is set up with
+  // rank updates of the primal factorization
+  qp.settings.initial_guess = InitialGuessStatus::WARM_START;
+  qp.solve(qp.results.x, qp.results.y, qp.results.z);
+  CHECK(qp.results.info.status == QPSolverOutput::PROXQP_SOLVED);
+  CHECK((qp.results.x - qp_primal_dual.results.x).lpNorm<Eigen::Infinity>() <=
+        1e-6);
+}
+
+TEST_CASE("ProxQP::dense: test the per-phase profile of the solver")
+{
+  double sparsity_factor = 0.15;
+  T eps_abs = T(1e-9);
+  utils::rand::set_seed(1);
+  dense::isize dim = 50;
+  dense::isize n_eq(dim / 4);
+  dense::isize n_in(dim / 2);
+  T strong_convexity_factor(1.e-2);
+  proxqp::dense::Model<T> qp_random = proxqp::utils::dense_strongly_convex_qp(
+    dim, n_eq, n_in, sparsity_factor, strong_convexity_factor);
+
+  dense::QP<T> qp(dim, n_eq, n_in);
+  qp.settings.eps_abs = eps_abs;
+  qp.settings.eps_rel = 0;
+  qp.init(qp_random.H,
+          qp_random.g,
+          qp_random.A,
+          qp_random.b,
+          qp_random.C,
+          qp_random.l,
+          qp_random.u);
+  qp.solve();
+  CHECK(qp.results.info.status == QPSolverOutput::PROXQP_SOLVED);
+
+  const Profile<T>& profile = qp.results.info.profile;
+#ifdef PROXSUITE_ENABLE_PROFILING
+  CHECK(profile.equilibration_time > 0);
+  CHECK(profile.factorizations == 1);
+  CHECK(profile.factorization_time > 0);
+  CHECK(profile.line_searches > 0);
+  CHECK(profile.active_set_insertions > 0);
+  CHECK(profile.residual_evaluations >= 2 * qp.results.info.iter_ext);
+  CHECK(profile.iterative_refinement_time > 0);
+
+  // the timings of the profile do not make identical solves compare unequal
+  dense::QP<T> qp2(dim, n_eq, n_in);
+  qp2.settings.eps_abs = eps_abs;
+  qp2.settings.eps_rel = 0;
+  qp2.init(qp_random.H,
+           qp_random.g,
+           qp_random.A,
+           qp_random.b,
+           qp_random.C,
+           qp_random.l,
+           qp_random.u);
+  qp2.solve();
+  CHECK(qp2.results.info == qp.results.info);
+  CHECK(qp2.results.info.profile.factorizations == profile.factorizations);
+
+  // a second solve equilibrates the stored problem again, and its profile
+  // does not accumulate on the previous one
+  qp.solve();
+  CHECK(profile.equilibration_time > 0);
+  CHECK(profile.factorizations == 1);
+#else
+  CHECK(profile == Profile<T>());
+#endif
+}
+
+TEST_CASE("ProxQP::dense: test the cache of the scaled model")
+{
+  double sparsity_factor = 0.15;
+  T eps_abs = T(1e-9);
+  utils::rand::set_seed(1);
+  dense::isize dim = 50;
+  dense::isize n_eq(dim / 4);
+  dense::isize n_in(dim / 2);
+  T strong_convexity_factor(1.e-2);
+  proxqp::dense::Model<T> qp_random = proxqp::utils::dense_strongly_convex_qp(
+    dim, n_eq, n_in, sparsity_factor, strong_convexity_factor);
+
+  for (DenseBackend dense_backend :
+       { DenseBackend::PrimalDualLDLT, DenseBackend::PrimalLDLT }) {
+    for (InitialGuessStatus initial_guess :
+         { InitialGuessStatus::NO_INITIAL_GUESS,
+           InitialGuessStatus::EQUALITY_CONSTRAINED_INITIAL_GUESS,
+           InitialGuessStatus::COLD_START_WITH_PREVIOUS_RESULT,
+           InitialGuessStatus::WARM_START }) {
+      dense::QP<T> qp(
+        dim, n_eq, n_in, false, HessianType::Dense, dense_backend);
+      dense::QP<T> qp_cached(
+        dim, n_eq, n_in, false, HessianType::Dense, dense_backend);
+      for (dense::QP<T>* p : { &qp, &qp_cached }) {
+        p->settings.eps_abs = eps_abs;
+        p->settings.eps_rel = 0;
+        p->settings.initial_guess = initial_guess;
+      }
+      qp_cached.settings.cache_scaled_model = true;
+      qp.init(qp_random.H,
+              qp_random.g,
+              qp_random.A,
+              qp_random.b,
+              qp_random.C,
+              qp_random.l,
+              qp_random.u);
+      qp_cached.init(qp_random.H,
+                     qp_random.g,
+                     qp_random.A,
+                     qp_random.b,
+                     qp_random.C,
+                     qp_random.l,
+                     qp_random.u);
+      CHECK(!qp.work.scaled_model_cached);
+      CHECK(qp_cached.work.scaled_model_cached);
+
+      // the following solves restore the copies of the scaled model and of
+      // its factorization, stored by the init and the first solve (the
+      // factorization is not stored by the solves factorizing the KKT matrix
+      // with the active set predicted by their initial guess)
+      bool active_set_guess =
+        initial_guess == InitialGuessStatus::COLD_START_WITH_PREVIOUS_RESULT ||
+        initial_guess == InitialGuessStatus::WARM_START;
+      for (isize k = 0; k < 3; ++k) {
+        if (initial_guess == InitialGuessStatus::WARM_START) {
+          qp.solve(qp.results.x, qp.results.y, qp.results.z);
+          qp_cached.solve(
+            qp_cached.results.x, qp_cached.results.y, qp_cached.results.z);
+        } else {
+          qp.solve();
+          qp_cached.solve();
+        }
+        CHECK(qp_cached.work.ldl_cached == !active_set_guess);
+        CHECK(qp_cached.results.info.status == QPSolverOutput::PROXQP_SOLVED);
+        CHECK((qp_cached.results.x - qp.results.x).lpNorm<Eigen::Infinity>() <=
+              1e-7);
+        CHECK((qp_cached.results.y - qp.results.y).lpNorm<Eigen::Infinity>() <=
+              1e-7);
+        CHECK((qp_cached.results.z - qp.results.z).lpNorm<Eigen::Infinity>() <=
+              1e-7);
+#ifdef PROXSUITE_ENABLE_PROFILING
+        if (k > 0 && initial_guess == InitialGuessStatus::NO_INITIAL_GUESS) {
+          CHECK(qp_cached.results.info.profile.factorizations == 0);
+        }
+#endif
+      }
+
+      // an update of the model refreshes the copies
+      qp_random.g = utils::rand::vector_rand<T>(dim);
+      qp.update(
+        nullopt, qp_random.g, nullopt, nullopt, nullopt, nullopt, nullopt);
+      qp_cached.update(
+        nullopt, qp_random.g, nullopt, nullopt, nullopt, nullopt, nullopt);
+      for (isize k = 0; k < 2; ++k) {
+        qp.solve();
+        qp_cached.solve();
+        CHECK(qp_cached.results.info.status == QPSolverOutput::PROXQP_SOLVED);
+        CHECK((qp_cached.results.x - qp.results.x).lpNorm<Eigen::Infinity>() <=
+              1e-7);
+      }
+      T pri_res = std::max(
+        (qp_random.A * qp_cached.results.x - qp_random.b)
+          .lpNorm<Eigen::Infinity>(),
+        (helpers::positive_part(qp_random.C * qp_cached.results.x -
+                                qp_random.u) +
+         helpers::negative_part(qp_random.C * qp_cached.results.x -
+                                qp_random.l))
+          .lpNorm<Eigen::Infinity>());
+      T dua_res = (qp_random.H * qp_cached.results.x + qp_random.g +
+                   qp_random.A.transpose() * qp_cached.results.y +
+                   qp_random.C.transpose() * qp_cached.results.z)
+                    .lpNorm<Eigen::Infinity>();
+      CHECK(pri_res <= eps_abs);
+      CHECK(dua_res <= eps_abs);
+    }
+  }
+}
+
+TEST_CASE("ProxQP::dense: test the cache of the scaled model enabled after "
+          "init")
+{
+  double sparsity_factor = 0.15;
+  T eps_abs = T(1e-9);
+  utils::rand::set_seed(1);
+  dense::isize dim = 50;
+  dense::isize n_eq(dim / 4);
+  dense::isize n_in(dim / 2);
+  T strong_convexity_factor(1.e-2);
+  proxqp::dense::Model<T> qp_random = proxqp::utils::dense_strongly_convex_qp(
+    dim, n_eq, n_in, sparsity_factor, strong_convexity_factor);
+
+  // the setting is enabled before the first solve, or between two solves
+  for (isize n_solves_before : { 0, 1 }) {
+    dense::QP<T> qp(dim, n_eq, n_in);
+    dense::QP<T> qp_cached(dim, n_eq, n_in);
+    for (dense::QP<T>* p : { &qp, &qp_cached }) {
+      p->settings.eps_abs = eps_abs;
+      p->settings.eps_rel = 0;
+      p->settings.initial_guess = InitialGuessStatus::NO_INITIAL_GUESS;
+      p->init(qp_random.H,
+              qp_random.g,
+              qp_random.A,
+              qp_random.b,
+              qp_random.C,
+              qp_random.l,
+              qp_random.u);
+    }
+    for (isize k = 0; k < n_solves_before; ++k) {
+      qp_cached.solve();
+    }
+    CHECK(!qp_cached.work.scaled_model_cached);
+
+    // the next solve stores the copies, which the following ones restore
+    qp_cached.settings.cache_scaled_model = true;
+    qp.solve();
+    for (isize k = 0; k < 3; ++k) {
+      qp_cached.solve();
+      CHECK(qp_cached.work.scaled_model_cached);
+      CHECK(qp_cached.work.ldl_cached);
+      CHECK(qp_cached.results.info.status == QPSolverOutput::PROXQP_SOLVED);
+      CHECK(qp_cached.results.info.iter == qp.results.info.iter);
+      CHECK((qp_cached.results.x - qp.results.x).lpNorm<Eigen::Infinity>() <=
+            1e-7);
+      CHECK((qp_cached.results.z - qp.results.z).lpNorm<Eigen::Infinity>() <=
+            1e-7);
+#ifdef PROXSUITE_ENABLE_PROFILING
+      CHECK(qp_cached.results.info.profile.factorizations == (k > 0 ? 0 : 1));
+#endif
+    }
+  }
+}
+
+TEST_CASE("ProxQP::dense: test the factorization with the active set of a "
+          "warm start")
+{
+  double sparsity_factor = 0.15;
+  T eps_abs = T(1e-9);
+  utils::rand::set_seed(1);
+  dense::isize dim = 40;
+  dense::isize n_eq(dim / 4);
+  dense::isize n_in(4 * dim);
+  T strong_convexity_factor(1.e-2);
+  proxqp::dense::Model<T> qp_random = proxqp::utils::dense_strongly_convex_qp(
+    dim, n_eq, n_in, sparsity_factor, strong_convexity_factor);
+  // many constraints are active at the solution
+  utils::Vec<T> x_feasible = utils::rand::vector_rand<T>(dim);
+  qp_random.b = qp_random.A * x_feasible;
+  qp_random.u = qp_random.C * x_feasible;
+  qp_random.l.setConstant(-1.e20);
+
+  for (DenseBackend dense_backend :
+       { DenseBackend::PrimalDualLDLT, DenseBackend::PrimalLDLT }) {
+    dense::QP<T> qp(dim, n_eq, n_in, false, HessianType::Dense, dense_backend);
+    qp.settings.eps_abs = eps_abs;
+    qp.settings.eps_rel = 0;
+    qp.init(qp_random.H,
+            qp_random.g,
+            qp_random.A,
+            qp_random.b,
+            qp_random.C,
+            qp_random.l,
+            qp_random.u);
+    qp.solve();
+    CHECK(qp.results.info.status == QPSolverOutput::PROXQP_SOLVED);
+    isize n_active = (qp.results.z.array() != 0).count();
+    CHECK(n_active > 0);
+
+    // the KKT matrix with the predicted active set is factorized at once,
+    // unless its factorization without inequality constraints is cached
+    for (bool cache_scaled_model : { false, true }) {
+      dense::QP<T> qp_warm(
+        dim, n_eq, n_in, false, HessianType::Dense, dense_backend);
+      qp_warm.settings.eps_abs = eps_abs;
+      qp_warm.settings.eps_rel = 0;
+      qp_warm.settings.cache_scaled_model = cache_scaled_model;
+      qp_warm.init(qp_random.H,
+                   qp_random.g,
+                   qp_random.A,
+                   qp_random.b,
+                   qp_random.C,
+                   qp_random.l,
+                   qp_random.u);
+      // a first solve stores the factorization without inequality
+      // constraints in the cache
+      qp_warm.settings.initial_guess = InitialGuessStatus::NO_INITIAL_GUESS;
+      qp_warm.solve();
+      qp_warm.settings.initial_guess = InitialGuessStatus::WARM_START;
+      for (isize k = 0; k < 2; ++k) {
+        qp_warm.solve(qp.results.x, qp.results.y, qp.results.z);
+        CHECK(qp_warm.results.info.status == QPSolverOutput::PROXQP_SOLVED);
+        CHECK(qp_warm.results.info.iter <= qp.results.info.iter);
+        CHECK((qp_warm.results.x - qp.results.x).lpNorm<Eigen::Infinity>() <=
+              1e-7);
+        CHECK((qp_warm.results.z - qp.results.z).lpNorm<Eigen::Infinity>() <=
+              1e-7);
+#ifdef PROXSUITE_ENABLE_PROFILING
+        CHECK(qp_warm.results.info.profile.active_set_insertions >= n_active);
+        if (!cache_scaled_model) {
+          CHECK(qp_warm.results.info.profile.factorizations == 1);
+        } else {
+          // the cached factorization is restored and the active constraints
+          // are inserted in it
+          CHECK(qp_warm.results.info.profile.factorizations == 0);
+        }
+#endif
+      }
+
+      if (cache_scaled_model) {
+        // with another rho, the cached factorization cannot be restored and
+        // the KKT matrix with the active set is factorized at once, keeping
+        // the cached factorization for the previous rho
+        T rho = qp_warm.settings.default_rho;
+        for (T new_rho : { T(10) * rho, rho }) {
+          qp_warm.settings.default_rho = new_rho;
+          qp_warm.solve(qp.results.x, qp.results.y, qp.results.z);
+          CHECK(qp_warm.results.info.status == QPSolverOutput::PROXQP_SOLVED);
+          CHECK((qp_warm.results.x - qp.results.x)
+                  .lpNorm<Eigen::Infinity>() <= 1e-7);
+#ifdef PROXSUITE_ENABLE_PROFILING
+          CHECK(qp_warm.results.info.profile.factorizations ==
+                (new_rho != rho ? 1 : 0));
+#endif
+        }
+      }
+
+      T pri_res = std::max(
+        (qp_random.A * qp_warm.results.x - qp_random.b)
+          .lpNorm<Eigen::Infinity>(),
+        (helpers::positive_part(qp_random.C * qp_warm.results.x -
+                                qp_random.u) +
+         helpers::negative_part(qp_random.C * qp_warm.results.x -
+                                qp_random.l))
+          .lpNorm<Eigen::Infinity>());
+      T dua_res = (qp_random.H * qp_warm.results.x + qp_random.g +
+                   qp_random.A.transpose() * qp_warm.results.y +
+                   qp_random.C.transpose() * qp_warm.results.z)
+                    .lpNorm<Eigen::Infinity>();
+      CHECK(pri_res <= eps_abs);
+      CHECK(dua_res <= eps_abs);
+    }
+  }
+}
@@ -2,6 +2,8 @@
 #include <Eigen/Core>
 #include <Eigen/Cholesky>
 #include <proxsuite/proxqp/dense/dense.hpp>
+#include <proxsuite/helpers/parallel.hpp>
+#include <proxsuite/linalg/veg/util/dynstack_alloc.hpp>
 #include <proxsuite/linalg/veg/util/dbg.hpp>
 #include <proxsuite/proxqp/utils/random_qp_problems.hpp>
 
@@ -65,3 +67,191 @@ DOCTEST_TEST_CASE("ruiz preconditioner")
   DOCTEST_CHECK((A_new - qp.work.A_scaled).norm() <= Scalar(1e-10));
   DOCTEST_CHECK((b_new - qp.work.b_scaled).norm() <= Scalar(1e-10));
 }
+
+DOCTEST_TEST_CASE(
+  "ruiz preconditioner does not depend on the number of threads")
+{
+  int dim = 200;
+  int n_eq = 50;
+  int n_in = 100;
+
+  Scalar sparsity_factor(0.15);
+  Scalar strong_convexity_factor(0.01);
+  proxqp::dense::Model<Scalar> qp_random =
+    proxqp::utils::dense_strongly_convex_qp(
+      dim, n_eq, n_in, sparsity_factor, strong_convexity_factor);
+
+  std::size_t num_threads = proxsuite::helpers::get_default_num_threads();
+  for (auto sym : { proxqp::Symmetry::general,
+                    proxqp::Symmetry::upper,
+                    proxqp::Symmetry::lower }) {
+    Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> H =
+      qp_random.H;
+    switch (sym) {
+      case proxqp::Symmetry::upper: {
+        H = qp_random.H.triangularView<Eigen::Upper>();
+        break;
+      }
+      case proxqp::Symmetry::lower: {
+        H = qp_random.H.triangularView<Eigen::Lower>();
+        break;
+      }
+      default: {
+      }
+    }
+
+    Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      H_scaled[2];
+    Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      A_scaled[2];
+    Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      C_scaled[2];
+    proxqp::dense::Vec<Scalar> delta[2];
+    Scalar c[2];
+
+    for (std::size_t k = 0; k < 2; ++k) {
+      // the first run is sequential, the second one uses all the threads
+      proxsuite::helpers::set_default_omp_options(k == 0 ? 1 : num_threads);
+
+      H_scaled[k] = H;
+      A_scaled[k] = qp_random.A;
+      C_scaled[k] = qp_random.C;
+      proxqp::dense::Vec<Scalar> g = qp_random.g;
+      proxqp::dense::Vec<Scalar> b = qp_random.b;
+      proxqp::dense::Vec<Scalar> u = qp_random.u;
+      proxqp::dense::Vec<Scalar> l = qp_random.l;
+
+      proxqp::dense::preconditioner::RuizEquilibration<Scalar> ruiz{
+        dim, n_eq + n_in, 1e-3, 10, sym
+      };
+      VEG_MAKE_STACK(stack,
+                     ruiz.scale_qp_in_place_req(
+                       proxsuite::linalg::veg::Tag<Scalar>{}, dim, n_eq, n_in));
+      ruiz.scale_qp_in_place(
+        {
+          { proxqp::from_eigen, H_scaled[k] },
+          { proxqp::from_eigen, g },
+          { proxqp::from_eigen, A_scaled[k] },
+          { proxqp::from_eigen, b },
+          { proxqp::from_eigen, C_scaled[k] },
+          { proxqp::from_eigen, u },
+          { proxqp::from_eigen, l },
+        },
+        true,
+        10,
+        1e-3,
+        false,
+        proxqp::HessianType::Dense,
+        stack);
+      delta[k] = ruiz.delta;
+      c[k] = ruiz.c;
+    }
+    proxsuite::helpers::set_default_omp_options(num_threads);
+
+    DOCTEST_CHECK(delta[0] == delta[1]);
+    DOCTEST_CHECK(c[0] == c[1]);
+    DOCTEST_CHECK(H_scaled[0] == H_scaled[1]);
+    DOCTEST_CHECK(A_scaled[0] == A_scaled[1]);
+    DOCTEST_CHECK(C_scaled[0] == C_scaled[1]);
+
+    // the scaled matrices are the equilibration of the original ones
+    auto head = delta[0].head(dim).asDiagonal();
+    Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> H_new =
+      c[0] * (head * H * head);
+    Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> A_new =
+      delta[0].segment(dim, n_eq).asDiagonal() * qp_random.A * head;
+    Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> C_new =
+      delta[0].tail(n_in).asDiagonal() * qp_random.C * head;
+    switch (sym) {
+      case proxqp::Symmetry::upper: {
+        H_new = H_new.triangularView<Eigen::Upper>();
+        break;
+      }
+      case proxqp::Symmetry::lower: {
+        H_new = H_new.triangularView<Eigen::Lower>();
+        break;
+      }
+      default: {
+      }
+    }
+    DOCTEST_CHECK((H_new - H_scaled[0]).norm() <= Scalar(1e-10));
+    DOCTEST_CHECK((A_new - A_scaled[0]).norm() <= Scalar(1e-10));
+    DOCTEST_CHECK((C_new - C_scaled[0]).norm() <= Scalar(1e-10));
+  }
+}
+
+DOCTEST_TEST_CASE("ruiz preconditioner: overloads for a dense hessian without "
+                  "box constraints")
+{
+  int dim = 20;
+  int n_eq = 5;
+  int n_in = 8;
+  proxqp::utils::rand::set_seed(1);
+  proxqp::dense::Model<Scalar> qp_random =
+    proxqp::utils::dense_strongly_convex_qp(dim, n_eq, n_in, 0.15, 0.01);
+
+  // the equilibration is computed with the explicit arguments, the overload of
+  // the preconditioner and the one of the detail function
+  Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+    H_scaled[3];
+  Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+    A_scaled[3];
+  Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+    C_scaled[3];
+  proxqp::dense::Vec<Scalar> delta[3];
+  Scalar c[3];
+  for (std::size_t k = 0; k < 3; ++k) {
+    H_scaled[k] = qp_random.H;
+    A_scaled[k] = qp_random.A;
+    C_scaled[k] = qp_random.C;
+    proxqp::dense::Vec<Scalar> g = qp_random.g;
+    proxqp::dense::Vec<Scalar> b = qp_random.b;
+    proxqp::dense::Vec<Scalar> u = qp_random.u;
+    proxqp::dense::Vec<Scalar> l = qp_random.l;
+    proxqp::dense::QpViewBoxMut<Scalar> qp{
+      { proxqp::from_eigen, H_scaled[k] },
+      { proxqp::from_eigen, g },
+      { proxqp::from_eigen, A_scaled[k] },
+      { proxqp::from_eigen, b },
+      { proxqp::from_eigen, C_scaled[k] },
+      { proxqp::from_eigen, u },
+      { proxqp::from_eigen, l },
+    };
+
+    proxqp::dense::preconditioner::RuizEquilibration<Scalar> ruiz{
+      dim, n_eq + n_in, 1e-3, 10, proxqp::Symmetry::general
+    };
+    VEG_MAKE_STACK(stack,
+                   ruiz.scale_qp_in_place_req(
+                     proxsuite::linalg::veg::Tag<Scalar>{}, dim, n_eq, n_in));
+    switch (k) {
+      case 0:
+        ruiz.scale_qp_in_place(
+          qp, true, 10, 1e-3, false, proxqp::HessianType::Dense, stack);
+        break;
+      case 1:
+        ruiz.scale_qp_in_place(qp, true, 10, 1e-3, stack);
+        break;
+      default:
+        ruiz.delta.setOnes();
+        ruiz.c = proxqp::dense::detail::ruiz_scale_qp_in_place(
+          { proxqp::from_eigen, ruiz.delta },
+          nullptr,
+          qp,
+          Scalar(1e-3),
+          10,
+          proxqp::Symmetry::general,
+          stack);
+        break;
+    }
+    delta[k] = ruiz.delta;
+    c[k] = ruiz.c;
+  }
+  for (std::size_t k = 1; k < 3; ++k) {
+    DOCTEST_CHECK(delta[k] == delta[0]);
+    DOCTEST_CHECK(c[k] == c[0]);
+    DOCTEST_CHECK(H_scaled[k] == H_scaled[0]);
+    DOCTEST_CHECK(A_scaled[k] == A_scaled[0]);
+    DOCTEST_CHECK(C_scaled[k] == C_scaled[0]);
+  }
+}
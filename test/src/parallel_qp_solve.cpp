@@ -0,0 +1,180 @@
+//
+// Copyright (c) 2022 INRIA
+//
+#include <doctest.hpp>
+#include <Eigen/Core>
+#include <proxsuite/proxqp/dense/dense.hpp>
+#include <proxsuite/proxqp/sparse/sparse.hpp>
+#include <proxsuite/proxqp/parallel/qp_solve.hpp>
+#include <proxsuite/proxqp/utils/random_qp_problems.hpp>
+
+using T = double;
+using namespace proxsuite;
+using namespace proxsuite::proxqp;
+
+DOCTEST_TEST_CASE("ProxQP::dense: solve a batch of qps in parallel")
+{
+  double sparsity_factor = 0.15;
+  T eps_abs = T(1e-9);
+  T strong_convexity_factor(1.e-2);
+  utils::rand::set_seed(1);
+
+  const std::size_t num_qps = 16;
+  std::vector<dense::Model<T>> models;
+  std::vector<dense::QP<T>> qps;
+  qps.reserve(num_qps);
+  // QPs held by pointers (as done by the python bindings)
+  std::vector<dense::QP<T>> pointed_qps;
+  pointed_qps.reserve(num_qps);
+  std::vector<dense::QP<T>*> qp_ptrs;
+  dense::BatchQP<T> batch(num_qps);
+
+  for (std::size_t i = 0; i < num_qps; ++i) {
+    dense::isize dim = 10 + 5 * dense::isize(i % 4);
+    dense::isize n_eq(dim / 4);
+    dense::isize n_in(dim / 4);
+    models.push_back(utils::dense_strongly_convex_qp(
+      dim, n_eq, n_in, sparsity_factor, strong_convexity_factor));
+    const dense::Model<T>& model = models.back();
+
+    qps.emplace_back(dim, n_eq, n_in);
+    dense::QP<T>& qp = qps.back();
+    qp.settings.eps_abs = eps_abs;
+    qp.settings.eps_rel = 0;
+    qp.init(model.H, model.g, model.A, model.b, model.C, model.l, model.u);
+
+    pointed_qps.emplace_back(dim, n_eq, n_in);
+    dense::QP<T>& pointed_qp = pointed_qps.back();
+    pointed_qp.settings.eps_abs = eps_abs;
+    pointed_qp.settings.eps_rel = 0;
+    pointed_qp.init(
+      model.H, model.g, model.A, model.b, model.C, model.l, model.u);
+    qp_ptrs.push_back(&pointed_qp);
+
+    dense::QP<T>& qp_batch = batch.init_qp_in_place(dim, n_eq, n_in);
+    qp_batch.settings.eps_abs = eps_abs;
+    qp_batch.settings.eps_rel = 0;
+    qp_batch.init(
+      model.H, model.g, model.A, model.b, model.C, model.l, model.u);
+  }
+  DOCTEST_CHECK(batch.size() == dense::isize(num_qps));
+  DOCTEST_CHECK_THROWS(batch.init_qp_in_place(10, 2, 2));
+
+  std::size_t num_threads = helpers::get_default_num_threads();
+  parallel::solve_in_parallel(qps, 2);
+  parallel::solve_in_parallel(qp_ptrs, 2);
+  parallel::solve_in_parallel(batch);
+  // the OpenMP settings of the caller are left untouched
+  DOCTEST_CHECK(helpers::get_default_num_threads() == num_threads);
+
+  for (std::size_t i = 0; i < num_qps; ++i) {
+    const dense::Model<T>& model = models[i];
+    dense::QP<T> qp_sequential(model.dim, model.n_eq, model.n_in);
+    qp_sequential.settings.eps_abs = eps_abs;
+    qp_sequential.settings.eps_rel = 0;
+    qp_sequential.init(
+      model.H, model.g, model.A, model.b, model.C, model.l, model.u);
+    qp_sequential.solve();
+
+    for (const Results<T>* results : { &qps[i].results,
+                                       &pointed_qps[i].results,
+                                       &batch.get(dense::isize(i)).results }) {
+      T pri_res = std::max(
+        (model.A * results->x - model.b).lpNorm<Eigen::Infinity>(),
+        (helpers::positive_part(model.C * results->x - model.u) +
+         helpers::negative_part(model.C * results->x - model.l))
+          .lpNorm<Eigen::Infinity>());
+      T dua_res = (model.H * results->x + model.g +
+                   model.A.transpose() * results->y +
+                   model.C.transpose() * results->z)
+                    .lpNorm<Eigen::Infinity>();
+      DOCTEST_CHECK(pri_res <= eps_abs);
+      DOCTEST_CHECK(dua_res <= eps_abs);
+      // each problem is solved independently of the others, hence the same
+      // iterates as the sequential solve are obtained
+      DOCTEST_CHECK(results->info.iter == qp_sequential.results.info.iter);
+      DOCTEST_CHECK((results->x - qp_sequential.results.x)
+                      .lpNorm<Eigen::Infinity>() <= T(1e-12));
+    }
+  }
+}
+
+DOCTEST_TEST_CASE("ProxQP::sparse: solve in parallel a batch of qps sharing "
+                  "the same sparsity structure")
+{
+  using I = utils::c_int;
+  T sparsity_factor = 0.15;
+  T eps_abs = T(1e-9);
+  T strong_convexity_factor(1.e-2);
+  utils::rand::set_seed(1);
+
+  sparse::isize n(40), n_eq(10), n_in(10);
+  sparse::SparseModel<T> qp_random = utils::sparse_strongly_convex_qp(
+    n, n_eq, n_in, sparsity_factor, strong_convexity_factor);
+
+  const std::size_t num_qps = 8;
+  sparse::BatchQP<T, I> batch(num_qps,
+                              qp_random.H.cast<bool>(),
+                              qp_random.A.cast<bool>(),
+                              qp_random.C.cast<bool>());
+  std::vector<sparse::SparseModel<T>> models;
+  // QPs held by pointers (as done by the python bindings)
+  std::vector<sparse::QP<T, I>> pointed_qps;
+  pointed_qps.reserve(num_qps);
+  std::vector<sparse::QP<T, I>*> qp_ptrs;
+
+  for (std::size_t i = 0; i < num_qps; ++i) {
+    // same sparsity structure, different values
+    sparse::SparseModel<T> model = qp_random;
+    model.H *= T(1) + T(i) / T(num_qps);
+    model.A *= T(1) + T(2 * i) / T(num_qps);
+    model.b *= T(1) + T(2 * i) / T(num_qps);
+    model.g = utils::rand::vector_rand<T>(n);
+    models.push_back(model);
+
+    sparse::QP<T, I>& qp = batch.init_qp_in_place();
+    qp.settings.eps_abs = eps_abs;
+    qp.settings.eps_rel = 0;
+    qp.init(model.H, model.g, model.A, model.b, model.C, model.l, model.u);
+
+    pointed_qps.emplace_back(n, n_eq, n_in);
+    sparse::QP<T, I>& pointed_qp = pointed_qps.back();
+    pointed_qp.settings.eps_abs = eps_abs;
+    pointed_qp.settings.eps_rel = 0;
+    pointed_qp.init(
+      model.H, model.g, model.A, model.b, model.C, model.l, model.u);
+    qp_ptrs.push_back(&pointed_qp);
+  }
+  DOCTEST_CHECK(batch.size() == sparse::isize(num_qps));
+
+  parallel::solve_in_parallel(batch, 2);
+  parallel::solve_in_parallel(qp_ptrs, 2);
+
+  for (std::size_t i = 0; i < num_qps; ++i) {
+    const sparse::SparseModel<T>& model = models[i];
+
+    sparse::QP<T, I> qp_sequential(n, n_eq, n_in);
+    qp_sequential.settings.eps_abs = eps_abs;
+    qp_sequential.settings.eps_rel = 0;
+    qp_sequential.init(
+      model.H, model.g, model.A, model.b, model.C, model.l, model.u);
+    qp_sequential.solve();
+
+    for (const Results<T>* results : { &batch.get(sparse::isize(i)).results,
+                                       &pointed_qps[i].results }) {
+      T pri_res = std::max(
+        dense::infty_norm(model.A * results->x - model.b),
+        dense::infty_norm(
+          helpers::positive_part(model.C * results->x - model.u) +
+          helpers::negative_part(model.C * results->x - model.l)));
+      T dua_res = dense::infty_norm(
+        model.H.selfadjointView<Eigen::Upper>() * results->x + model.g +
+        model.A.transpose() * results->y + model.C.transpose() * results->z);
+      DOCTEST_CHECK(pri_res <= eps_abs);
+      DOCTEST_CHECK(dua_res <= eps_abs);
+      DOCTEST_CHECK(results->info.iter == qp_sequential.results.info.iter);
+      DOCTEST_CHECK(dense::infty_norm(results->x - qp_sequential.results.x) <=
+                    T(1e-12));
+    }
+  }
+}
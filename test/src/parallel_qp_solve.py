@@ -0,0 +1,107 @@
+#
+# Copyright (c) 2022, INRIA
+#
+import proxsuite
+import numpy as np
+import scipy.sparse as spa
+import unittest
+
+
+def normInf(x):
+    if x.shape[0] == 0:
+        return 0.0
+    else:
+        return np.linalg.norm(x, np.inf)
+
+
+def generate_mixed_qp(n, seed=1):
+    """
+    Generate sparse problem in dense QP format
+    """
+    np.random.seed(seed)
+
+    m = int(n / 4) + int(n / 4)
+    n_eq = int(n / 4)
+    n_in = int(n / 4)
+
+    P = spa.random(
+        n, n, density=0.075, data_rvs=np.random.randn, format="csc"
+    ).toarray()
+    P = (P + P.T) / 2.0
+
+    s = max(np.absolute(np.linalg.eigvals(P)))
+    P += (abs(s) + 1e-02) * np.eye(n)
+    q = np.random.randn(n)
+    A = spa.random(m, n, density=0.15, data_rvs=np.random.randn, format="csc").toarray()
+    v = np.random.randn(n)  # Fictitious solution
+    u = A @ v
+    l = -1.0e20 * np.ones(m)
+
+    return P, q, A[:n_eq, :], u[:n_eq], A[n_in:, :], l[n_in:], u[n_in:]
+
+
+class ParallelQpSolve(unittest.TestCase):
+    def test_solve_batch(self):
+        print("------------------------dense: solve a stacked batch of qps")
+        n = 10
+        batch_size = 8
+        problems = [generate_mixed_qp(n, seed) for seed in range(batch_size)]
+        H, g, A, b, C, l, u = [
+            np.stack([problem[k] for problem in problems]) for k in range(7)
+        ]
+
+        x, y, z = proxsuite.proxqp.dense.solve_batch(
+            H, g, A, b, C, l, u, eps_abs=1.0e-9, eps_rel=0, num_threads=2
+        )
+        self.assertEqual(x.shape, (batch_size, n))
+        self.assertEqual(y.shape, (batch_size, A.shape[1]))
+        self.assertEqual(z.shape, (batch_size, C.shape[1]))
+
+        for i in range(batch_size):
+            dua_res = normInf(
+                H[i] @ x[i] + g[i] + A[i].transpose() @ y[i] + C[i].transpose() @ z[i]
+            )
+            pri_res = max(
+                normInf(A[i] @ x[i] - b[i]),
+                normInf(
+                    np.maximum(C[i] @ x[i] - u[i], 0)
+                    + np.minimum(C[i] @ x[i] - l[i], 0)
+                ),
+            )
+            assert dua_res <= 1e-9
+            assert pri_res <= 1e-9
+
+    def test_solve_in_parallel(self):
+        print("------------------------dense: solve a list of qps in parallel")
+        n = 10
+        batch_size = 8
+        qps = []
+        batch = proxsuite.proxqp.dense.BatchQP(batch_size)
+        for seed in range(batch_size):
+            H, g, A, b, C, l, u = generate_mixed_qp(n, seed)
+            qp = proxsuite.proxqp.dense.QP(n, A.shape[0], C.shape[0])
+            qp.settings.eps_abs = 1.0e-9
+            qp.init(H, g, A, b, C, l, u)
+            qps.append(qp)
+            qp_batch = batch.init_qp_in_place(n, A.shape[0], C.shape[0])
+            qp_batch.settings.eps_abs = 1.0e-9
+            qp_batch.init(H, g, A, b, C, l, u)
+
+        proxsuite.proxqp.dense.solve_in_parallel(qps, num_threads=2)
+        proxsuite.proxqp.dense.solve_in_parallel(batch)
+
+        for i in range(batch_size):
+            qp_sequential = proxsuite.proxqp.dense.QP(
+                n, qps[i].model.n_eq, qps[i].model.n_in
+            )
+            qp_sequential.settings.eps_abs = 1.0e-9
+            H, g, A, b, C, l, u = generate_mixed_qp(n, i)
+            qp_sequential.init(H, g, A, b, C, l, u)
+            qp_sequential.solve()
+            for results in [qps[i].results, batch.get(i).results]:
+                assert results.info.iter == qp_sequential.results.info.iter
+                assert normInf(results.x - qp_sequential.results.x) <= 1e-12
+
+
+if __name__ == "__main__":
+    unittest.main()
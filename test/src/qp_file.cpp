@@ -0,0 +1,264 @@
+//
+// Copyright (c) 2022 INRIA
+//
+#include <cstdio>
+#include <doctest.hpp>
+#include <proxsuite/proxqp/dense/dense.hpp>
+#include <proxsuite/proxqp/sparse/sparse.hpp>
+#include <proxsuite/proxqp/utils/random_qp_problems.hpp>
+#include <proxsuite/serialization/qp_file.hpp>
+
+using namespace proxsuite;
+using namespace proxsuite::proxqp;
+using T = double;
+using I = utils::c_int;
+using DenseQpFile = serialization::DenseQpFile<T>;
+using SparseQpFile = serialization::SparseQpFile<T, I>;
+using SparseQpFileInt32 = serialization::SparseQpFile<T, std::int32_t>;
+
+DOCTEST_TEST_CASE("qp file: save and map a dense problem")
+{
+  utils::rand::set_seed(1);
+  dense::isize dim = 30;
+  dense::isize n_eq = dim / 4;
+  dense::isize n_in = dim / 4;
+  dense::Model<T> model =
+    utils::dense_strongly_convex_qp(dim, n_eq, n_in, T(0.15), T(1e-2));
+
+  std::string filename = "qp_file_dense.bin";
+  serialization::saveToQpFile(model, filename);
+  {
+    DenseQpFile file(filename);
+    DOCTEST_CHECK(file.dim() == dim);
+    DOCTEST_CHECK(file.n_eq() == n_eq);
+    DOCTEST_CHECK(file.n_in() == n_in);
+    DOCTEST_CHECK(!file.box_constraints());
+    DOCTEST_CHECK(file.H() == model.H);
+    DOCTEST_CHECK(file.g() == model.g);
+    DOCTEST_CHECK(file.A() == model.A);
+    DOCTEST_CHECK(file.b() == model.b);
+    DOCTEST_CHECK(file.C() == model.C);
+    DOCTEST_CHECK(file.l() == model.l);
+    DOCTEST_CHECK(file.u() == model.u);
+    DOCTEST_CHECK(file.as_view().H.data == file.H().data());
+
+    // the mapped sections are given to the solver without copies
+    dense::QP<T> qp(dim, n_eq, n_in);
+    qp.settings.eps_abs = 1e-9;
+    qp.settings.eps_rel = 0;
+    qp.init(
+      file.H(), file.g(), file.A(), file.b(), file.C(), file.l(), file.u());
+    qp.solve();
+    DOCTEST_CHECK(qp.results.info.status == QPSolverOutput::PROXQP_SOLVED);
+    DOCTEST_CHECK(qp.model == model);
+
+    // the file stores a dense problem with double scalars
+    DOCTEST_CHECK_THROWS_AS(serialization::DenseQpFile<float>{ filename },
+                            std::runtime_error);
+    DOCTEST_CHECK_THROWS_AS(SparseQpFile{ filename },
+                            std::runtime_error);
+  }
+  std::remove(filename.c_str());
+}
+
+DOCTEST_TEST_CASE("qp file: save and map a dense problem with box constraints")
+{
+  utils::rand::set_seed(1);
+  dense::isize dim = 20;
+  dense::isize n_eq = 2;
+  dense::isize n_in = 3;
+  dense::Model<T> model(dim, n_eq, n_in, true, HessianType::Diagonal);
+  model.H.setRandom();
+  model.A.setRandom();
+  model.l_box.setConstant(-1);
+  model.u_box.setConstant(2);
+
+  std::string filename = "qp_file_dense_box.bin";
+  serialization::saveToQpFile(model, filename);
+  {
+    DenseQpFile file(filename);
+    DOCTEST_CHECK(file.box_constraints());
+    DOCTEST_CHECK(file.hessian_type() == HessianType::Diagonal);
+    DOCTEST_CHECK(file.H().cols() == 1);
+    DOCTEST_CHECK(file.H() == model.H);
+    DOCTEST_CHECK(file.A() == model.A);
+    DOCTEST_CHECK(file.l_box() == model.l_box);
+    DOCTEST_CHECK(file.u_box() == model.u_box);
+  }
+  std::remove(filename.c_str());
+}
+
+DOCTEST_TEST_CASE("qp file: save and map a sparse problem")
+{
+  utils::rand::set_seed(1);
+  sparse::isize dim = 40;
+  sparse::isize n_eq = dim / 4;
+  sparse::isize n_in = dim / 4;
+  sparse::SparseModel<T> qp_random =
+    utils::sparse_strongly_convex_qp(dim, n_eq, n_in, T(0.15), T(1e-2));
+
+  sparse::QP<T, I> qp_ref(dim, n_eq, n_in);
+  qp_ref.settings.eps_abs = 1e-9;
+  qp_ref.settings.eps_rel = 0;
+  qp_ref.init(qp_random.H,
+              qp_random.g,
+              qp_random.A,
+              qp_random.b,
+              qp_random.C,
+              qp_random.l,
+              qp_random.u);
+  qp_ref.solve();
+
+  // a view with the full hessian, whose lower triangular part is dropped
+  sparse::SparseMat<T, I> H_triu = qp_random.H;
+  sparse::SparseMat<T, I> H = H_triu.selfadjointView<Eigen::Upper>();
+  sparse::SparseMat<T, I> AT = qp_random.A.transpose();
+  sparse::SparseMat<T, I> CT = qp_random.C.transpose();
+  H.makeCompressed();
+  AT.makeCompressed();
+  CT.makeCompressed();
+  using linalg::sparse::DenseVecRef;
+  using linalg::sparse::MatRef;
+  sparse::QpView<T, I> view = {
+    MatRef<T, I>(linalg::sparse::from_eigen, H),
+    DenseVecRef<T>(linalg::sparse::from_eigen, qp_random.g),
+    MatRef<T, I>(linalg::sparse::from_eigen, AT),
+    DenseVecRef<T>(linalg::sparse::from_eigen, qp_random.b),
+    MatRef<T, I>(linalg::sparse::from_eigen, CT),
+    DenseVecRef<T>(linalg::sparse::from_eigen, qp_random.l),
+    DenseVecRef<T>(linalg::sparse::from_eigen, qp_random.u),
+  };
+
+  std::string filename = "qp_file_sparse.bin";
+  std::string filename_model = "qp_file_sparse_model.bin";
+  serialization::saveToQpFile(view, filename);
+  // the unscaled problem stored in the model of the solver is the same
+  serialization::saveToQpFile(qp_ref.model, filename_model);
+  {
+    SparseQpFile file(filename);
+    SparseQpFile file_model(filename_model);
+    DOCTEST_CHECK(file.dim() == dim);
+    DOCTEST_CHECK(file.n_eq() == n_eq);
+    DOCTEST_CHECK(file.n_in() == n_in);
+    DOCTEST_CHECK(file.H().nnz() == H_triu.nonZeros());
+    sparse::SparseMat<T, I> H_file = file.H().to_eigen();
+    sparse::SparseMat<T, I> H_file_model = file_model.H().to_eigen();
+    DOCTEST_CHECK((H_file - H_triu).norm() == 0);
+    DOCTEST_CHECK((H_file_model - H_triu).norm() == 0);
+    sparse::SparseMat<T, I> A_file = file.A();
+    sparse::SparseMat<T, I> A_file_model = file_model.A();
+    sparse::SparseMat<T, I> A = AT.transpose();
+    sparse::SparseMat<T, I> C = CT.transpose();
+    DOCTEST_CHECK((A_file - A).norm() == 0);
+    DOCTEST_CHECK((A_file_model - A).norm() == 0);
+    sparse::SparseMat<T, I> C_file = file.C();
+    DOCTEST_CHECK((C_file - C).norm() == 0);
+    DOCTEST_CHECK(file.g() == qp_random.g);
+    DOCTEST_CHECK(file.b() == qp_random.b);
+    DOCTEST_CHECK(file.l() == qp_random.l);
+    DOCTEST_CHECK(file.u() == qp_random.u);
+    DOCTEST_CHECK(file_model.u() == qp_random.u);
+    DOCTEST_CHECK(file.as_view().AT.row_indices() == file.AT().row_indices());
+
+    // the hessian is borrowed from the mapping by the solver
+    sparse::QP<T, I> qp(dim, n_eq, n_in);
+    qp.settings.eps_abs = 1e-9;
+    qp.settings.eps_rel = 0;
+    qp.init(file.H(),
+            file.g(),
+            MatRef<T, I>(linalg::sparse::from_eigen, A_file),
+            file.b(),
+            MatRef<T, I>(linalg::sparse::from_eigen, C_file),
+            file.l(),
+            file.u());
+    qp.solve();
+    DOCTEST_CHECK(qp.results.info.status == QPSolverOutput::PROXQP_SOLVED);
+    DOCTEST_CHECK(qp.results.info.iter == qp_ref.results.info.iter);
+    DOCTEST_CHECK((qp.results.x - qp_ref.results.x).lpNorm<Eigen::Infinity>() <=
+                  1e-12);
+
+    DOCTEST_CHECK_THROWS_AS(SparseQpFileInt32{ filename },
+                            std::runtime_error);
+    DOCTEST_CHECK_THROWS_AS(DenseQpFile{ filename },
+                            std::runtime_error);
+  }
+  std::remove(filename.c_str());
+  std::remove(filename_model.c_str());
+}
+
+DOCTEST_TEST_CASE("qp file: reject truncated files")
+{
+  utils::rand::set_seed(1);
+  dense::Model<T> model =
+    utils::dense_strongly_convex_qp(dense::isize(10), 2, 2, T(0.15), T(1e-2));
+  std::string filename = "qp_file_truncated.bin";
+  serialization::saveToQpFile(model, filename);
+  std::string content;
+  {
+    std::ifstream in(filename, std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(in),
+                   std::istreambuf_iterator<char>());
+  }
+  {
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    out.write(content.data(), std::streamsize(content.size() - 8));
+  }
+  DOCTEST_CHECK_THROWS_AS(DenseQpFile{ filename },
+                          std::runtime_error);
+  std::remove(filename.c_str());
+  DOCTEST_CHECK_THROWS_AS(DenseQpFile{ filename },
+                          std::runtime_error);
+}
+
+DOCTEST_TEST_CASE("qp file: reject out of range row indices")
+{
+  utils::rand::set_seed(1);
+  sparse::isize dim = 20;
+  sparse::SparseModel<T> qp_random =
+    utils::sparse_strongly_convex_qp(dim, dim / 4, dim / 4, T(0.15), T(1e-2));
+  sparse::QP<T, I> qp(dim, dim / 4, dim / 4);
+  qp.init(qp_random.H,
+          qp_random.g,
+          qp_random.A,
+          qp_random.b,
+          qp_random.C,
+          qp_random.l,
+          qp_random.u);
+  std::string filename = "qp_file_row_indices.bin";
+  serialization::saveToQpFile(qp.model, filename);
+  std::string content;
+  {
+    std::ifstream in(filename, std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(in),
+                   std::istreambuf_iterator<char>());
+  }
+  serialization::QpFileHeader header;
+  std::memcpy(&header, content.data(), sizeof(header));
+
+  // sets the first row index of the matrix stored from the section k
+  auto check_corrupted = [&](std::uint32_t k, I row) {
+    std::string corrupted = content;
+    std::memcpy(&corrupted[header.section_offsets[k + 1]], &row, sizeof(I));
+    {
+      std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+      out.write(corrupted.data(), std::streamsize(corrupted.size()));
+    }
+    DOCTEST_CHECK_THROWS_AS(SparseQpFile{ filename }, std::runtime_error);
+  };
+  // the first column of H stores its diagonal entry, and is checked to stay
+  // in its upper triangular part
+  check_corrupted(0, I(1));
+  check_corrupted(0, I(dim));
+  check_corrupted(0, I(-1));
+  check_corrupted(3, I(dim));
+  check_corrupted(6, I(dim));
+
+  // the unmodified file is accepted
+  {
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    out.write(content.data(), std::streamsize(content.size()));
+  }
+  SparseQpFile file(filename);
+  DOCTEST_CHECK(file.H().nnz() == sparse::isize(header.H_nnz));
+  std::remove(filename.c_str());
+}
@@ -0,0 +1,143 @@
+#
+# Copyright (c) 2022, INRIA
+#
+import proxsuite
+import numpy as np
+import scipy.sparse as spa
+import os
+import tempfile
+import unittest
+
+
+def generate_mixed_qp(n, seed=1):
+    """
+    Generate sparse problem in dense QP format
+    """
+    np.random.seed(seed)
+
+    m = int(n / 4) + int(n / 4)
+    n_eq = int(n / 4)
+    n_in = int(n / 4)
+
+    P = spa.random(
+        n, n, density=0.075, data_rvs=np.random.randn, format="csc"
+    ).toarray()
+    P = (P + P.T) / 2.0
+
+    s = max(np.absolute(np.linalg.eigvals(P)))
+    P += (abs(s) + 1e-02) * spa.eye(n)
+    P = spa.coo_matrix(P)
+    q = np.random.randn(n)
+    A = spa.random(m, n, density=0.15, data_rvs=np.random.randn, format="csc").toarray()
+    v = np.random.randn(n)  # Fictitious solution
+    u = A @ v
+    l = -1.0e20 * np.ones(m)
+
+    return P.toarray(), q, A[:n_eq, :], u[:n_eq], A[n_in:, :], u[n_in:], l[n_in:]
+
+
+class QpFile(unittest.TestCase):
+    def setUp(self):
+        self.directory = tempfile.TemporaryDirectory()
+        self.filename = os.path.join(self.directory.name, "qp_file.bin")
+
+    def tearDown(self):
+        self.directory.cleanup()
+
+    def test_dense_qp_file(self):
+        print("------------------------test dense qp file")
+        n = 10
+        H, g, A, b, C, u, l = generate_mixed_qp(n)
+        n_eq = A.shape[0]
+        n_in = C.shape[0]
+
+        qp = proxsuite.proxqp.dense.QP(n, n_eq, n_in)
+        qp.settings.eps_abs = 1.0e-9
+        qp.init(H, g, A, b, C, l, u)
+        qp.solve()
+        proxsuite.proxqp.dense.save_qp_file(qp.model, self.filename)
+
+        qp_file = proxsuite.proxqp.dense.QpFile(self.filename)
+        assert qp_file.dim == n
+        assert qp_file.n_eq == n_eq
+        assert qp_file.n_in == n_in
+        assert np.array_equal(qp_file.H, H)
+        assert np.array_equal(qp_file.g, g)
+        assert np.array_equal(qp_file.A, A)
+        assert np.array_equal(qp_file.b, b)
+        assert np.array_equal(qp_file.C, C)
+        assert np.array_equal(qp_file.l, l)
+        assert np.array_equal(qp_file.u, u)
+        # the arrays are read-only views on the mapping
+        assert not qp_file.H.flags.writeable
+
+        qp2 = proxsuite.proxqp.dense.QP(n, n_eq, n_in)
+        qp2.settings.eps_abs = 1.0e-9
+        qp2.init(
+            qp_file.H,
+            qp_file.g,
+            qp_file.A,
+            qp_file.b,
+            qp_file.C,
+            qp_file.l,
+            qp_file.u,
+        )
+        qp2.solve()
+        assert qp2.results.info.status.name == "PROXQP_SOLVED"
+        assert np.linalg.norm(qp2.results.x - qp.results.x, np.inf) <= 1e-8
+
+    def test_sparse_qp_file(self):
+        print("------------------------test sparse qp file")
+        n = 10
+        H, g, A, b, C, u, l = generate_mixed_qp(n)
+        n_eq = A.shape[0]
+        n_in = C.shape[0]
+        H = spa.csc_matrix(H)
+        A = spa.csc_matrix(A)
+        C = spa.csc_matrix(C)
+
+        proxsuite.proxqp.sparse.save_qp_file(H, g, A, b, C, l, u, self.filename)
+
+        qp_file = proxsuite.proxqp.sparse.QpFile(self.filename)
+        assert qp_file.dim == n
+        assert qp_file.n_eq == n_eq
+        assert qp_file.n_in == n_in
+        # only the upper triangular part of H is stored
+        assert (qp_file.H - spa.triu(H)).count_nonzero() == 0
+        assert (qp_file.A - A).count_nonzero() == 0
+        assert (qp_file.C - C).count_nonzero() == 0
+        assert np.array_equal(qp_file.g, g)
+        assert np.array_equal(qp_file.b, b)
+        assert np.array_equal(qp_file.l, l)
+        assert np.array_equal(qp_file.u, u)
+
+        qp = proxsuite.proxqp.sparse.QP(n, n_eq, n_in)
+        qp.settings.eps_abs = 1.0e-9
+        qp.init(H, g, A, b, C, l, u)
+        qp.solve()
+
+        qp2 = proxsuite.proxqp.sparse.QP(n, n_eq, n_in)
+        qp2.settings.eps_abs = 1.0e-9
+        qp2.init(
+            qp_file.H,
+            qp_file.g,
+            qp_file.A,
+            qp_file.b,
+            qp_file.C,
+            qp_file.l,
+            qp_file.u,
+        )
+        qp2.solve()
+        assert qp2.results.info.status.name == "PROXQP_SOLVED"
+        assert np.linalg.norm(qp2.results.x - qp.results.x, np.inf) <= 1e-8
+
+        # the model of an initialized solver can also be saved
+        proxsuite.proxqp.sparse.save_qp_file(qp.model, self.filename)
+        del qp_file
+        qp_file = proxsuite.proxqp.sparse.QpFile(self.filename)
+        assert (qp_file.A - A).count_nonzero() == 0
+        assert np.array_equal(qp_file.u, u)
+
+
+if __name__ == "__main__":
+    unittest.main()
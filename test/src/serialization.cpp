@@ -3,6 +3,7 @@
 //
 #include <doctest.hpp>
 #include <proxsuite/proxqp/dense/dense.hpp>
+#include <proxsuite/proxqp/sparse/sparse.hpp>
 #include <proxsuite/proxqp/utils/random_qp_problems.hpp>
 #include <proxsuite/serialization/archive.hpp>
 #include <proxsuite/serialization/eigen.hpp>
@@ -105,6 +106,22 @@ generic_test(const T& object, const std::string& filename)
   }
 }
 
+template<typename QP>
+void
+save_and_load(const QP& qp, QP& qp_loaded, const std::string& filename)
+{
+  using namespace proxsuite::serialization;
+
+  // the binary archive stores the arrays as contiguous blocks
+  saveToBinary(qp, filename + ".bin");
+  loadFromBinary(qp_loaded, filename + ".bin");
+
+  QP qp_loaded_json(1, 0, 0);
+  saveToJSON(qp, filename + ".json");
+  loadFromJSON(qp_loaded_json, filename + ".json");
+  DOCTEST_CHECK(qp_loaded_json.results.x == qp_loaded.results.x);
+}
+
 using T = double;
 using namespace proxsuite;
 using namespace proxsuite::proxqp;
@@ -154,4 +171,160 @@ DOCTEST_TEST_CASE(
 
   DOCTEST_CHECK(row_matrix_loaded == row_matrix);
   DOCTEST_CHECK(col_matrix_loaded == row_matrix);
-}
\ No newline at end of file
+}
+DOCTEST_TEST_CASE("test serialization of the workspace of a dense qp for "
+                  "resuming its solves")
+{
+  double sparsity_factor = 0.15;
+  utils::rand::set_seed(1);
+  dense::isize dim = 30;
+  dense::isize n_eq(dim / 4);
+  dense::isize n_in(dim);
+  T strong_convexity_factor(1.e-2);
+  proxqp::dense::Model<T> qp_random = proxqp::utils::dense_strongly_convex_qp(
+    dim, n_eq, n_in, sparsity_factor, strong_convexity_factor);
+
+  for (DenseBackend dense_backend :
+       { DenseBackend::PrimalDualLDLT, DenseBackend::PrimalLDLT }) {
+    dense::QP<T> qp(dim, n_eq, n_in, false, HessianType::Dense, dense_backend);
+    qp.settings.eps_abs = 1.e-9;
+    qp.settings.eps_rel = 0;
+    qp.settings.initial_guess =
+      InitialGuessStatus::WARM_START_WITH_PREVIOUS_RESULT;
+    qp.init(qp_random.H,
+            qp_random.g,
+            qp_random.A,
+            qp_random.b,
+            qp_random.C,
+            qp_random.l,
+            qp_random.u);
+    // stop before convergence, so that the next solve continues from the
+    // iterates and the factorization stored in the workspace
+    isize max_iter = qp.settings.max_iter;
+    qp.settings.max_iter = 3;
+    qp.solve();
+
+    dense::QP<T> qp_loaded(1, 0, 0);
+    save_and_load(qp, qp_loaded, TEST_SERIALIZATION_FOLDER "/qp_dense_hot");
+    DOCTEST_CHECK(qp_loaded == qp);
+    DOCTEST_CHECK(qp_loaded.work.dense_backend == dense_backend);
+    qp.settings.max_iter = max_iter;
+    qp_loaded.settings.max_iter = max_iter;
+
+    // the loaded qp resumes from the equilibrated model and the factorization
+    // of the saved one, hence both follow the same iterates
+    for (isize k = 0; k < 2; ++k) {
+      if (k > 0) {
+        utils::Vec<T> g = utils::rand::vector_rand<T>(dim);
+        qp.update(nullopt, g, nullopt, nullopt, nullopt, nullopt, nullopt);
+        qp_loaded.update(
+          nullopt, g, nullopt, nullopt, nullopt, nullopt, nullopt);
+      }
+      qp.solve();
+      qp_loaded.solve();
+      DOCTEST_CHECK(qp.results.info.status == QPSolverOutput::PROXQP_SOLVED);
+      DOCTEST_CHECK(qp_loaded.results.info.iter == qp.results.info.iter);
+      DOCTEST_CHECK(qp_loaded.results.x == qp.results.x);
+      DOCTEST_CHECK(qp_loaded.results.y == qp.results.y);
+      DOCTEST_CHECK(qp_loaded.results.z == qp.results.z);
+    }
+  }
+}
+
+DOCTEST_TEST_CASE("test loading a dense qp archive of version 0")
+{
+  double sparsity_factor = 0.15;
+  utils::rand::set_seed(1);
+  dense::isize dim = 30;
+  dense::isize n_eq(dim / 4);
+  dense::isize n_in(dim);
+  T strong_convexity_factor(1.e-2);
+  proxqp::dense::Model<T> qp_random = proxqp::utils::dense_strongly_convex_qp(
+    dim, n_eq, n_in, sparsity_factor, strong_convexity_factor);
+
+  dense::QP<T> qp(dim, n_eq, n_in);
+  qp.settings.eps_abs = 1.e-9;
+  qp.settings.eps_rel = 0;
+  qp.init(qp_random.H,
+          qp_random.g,
+          qp_random.A,
+          qp_random.b,
+          qp_random.C,
+          qp_random.l,
+          qp_random.u);
+  qp.solve();
+
+  // archives of version 0 only store the model, the results and the settings
+  const std::string filename = TEST_SERIALIZATION_FOLDER "/qp_dense_v0.bin";
+  {
+    std::ofstream ofs(filename.c_str(), std::ios::binary);
+    cereal::BinaryOutputArchive oa(ofs);
+    oa(std::uint32_t(0), qp.model, qp.results, qp.settings);
+  }
+  dense::QP<T> qp_loaded(1, 0, 0);
+  proxsuite::serialization::loadFromBinary(qp_loaded, filename);
+  DOCTEST_CHECK(qp_loaded.model == qp.model);
+  DOCTEST_CHECK(qp_loaded.work.H_scaled.rows() == dim);
+
+  // the model is equilibrated and factorized again before the first solve
+  qp_loaded.solve();
+  DOCTEST_CHECK(qp_loaded.results.info.status ==
+                QPSolverOutput::PROXQP_SOLVED);
+  DOCTEST_CHECK(qp_loaded.results.info.iter == qp.results.info.iter);
+  DOCTEST_CHECK((qp_loaded.results.x - qp.results.x)
+                  .lpNorm<Eigen::Infinity>() <= 1e-12);
+}
+
+DOCTEST_TEST_CASE("test serialization of the workspace of a sparse qp for "
+                  "resuming its solves")
+{
+  using I = utils::c_int;
+  T sparsity_factor = 0.15;
+  T strong_convexity_factor = 0.01;
+  utils::rand::set_seed(1);
+  isize n = 30;
+  isize n_eq = n / 4;
+  isize n_in = n;
+  proxqp::sparse::SparseModel<T> qp_random = utils::sparse_strongly_convex_qp(
+    n, n_eq, n_in, sparsity_factor, strong_convexity_factor);
+
+  for (SparseBackend sparse_backend : { SparseBackend::SparseCholesky,
+                                        SparseBackend::SupernodalCholesky,
+                                        SparseBackend::MatrixFree }) {
+    proxqp::sparse::QP<T, I> qp(n, n_eq, n_in);
+    qp.settings.eps_abs = 1.e-9;
+    qp.settings.eps_rel = 0;
+    qp.settings.sparse_backend = sparse_backend;
+    qp.init(qp_random.H,
+            qp_random.g,
+            qp_random.A,
+            qp_random.b,
+            qp_random.C,
+            qp_random.l,
+            qp_random.u);
+    qp.solve();
+
+    proxqp::sparse::QP<T, I> qp_loaded(1, 0, 0);
+    save_and_load(qp, qp_loaded, TEST_SERIALIZATION_FOLDER "/qp_sparse_hot");
+    DOCTEST_CHECK(qp_loaded.results.x == qp.results.x);
+    DOCTEST_CHECK(qp_loaded.ruiz.delta == qp.ruiz.delta);
+
+    // the loaded qp reuses the equilibration and the symbolic factorization of
+    // the saved one
+    for (isize k = 0; k < 2; ++k) {
+      if (k > 0) {
+        utils::Vec<T> g = utils::rand::vector_rand<T>(n);
+        qp.update(nullopt, g, nullopt, nullopt, nullopt, nullopt, nullopt);
+        qp_loaded.update(
+          nullopt, g, nullopt, nullopt, nullopt, nullopt, nullopt);
+      }
+      qp.solve();
+      qp_loaded.solve();
+      DOCTEST_CHECK(qp.results.info.status == QPSolverOutput::PROXQP_SOLVED);
+      DOCTEST_CHECK(qp_loaded.results.info.iter == qp.results.info.iter);
+      DOCTEST_CHECK(qp_loaded.results.x == qp.results.x);
+      DOCTEST_CHECK(qp_loaded.results.y == qp.results.y);
+      DOCTEST_CHECK(qp_loaded.results.z == qp.results.z);
+    }
+  }
+}
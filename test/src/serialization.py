@@ -92,6 +92,57 @@ class DenseqpWrapperSerialization(unittest.TestCase):
         generic_test(qp.results, "qp_results")
         generic_test(qp, "qp_wrapper")
 
+    def test_pickle_hot_restart(self):
+        print("------------------------test pickle hot restart")
+        n = 10
+        H, g, A, b, C, u, l = generate_mixed_qp(n)
+        n_eq = A.shape[0]
+        n_in = C.shape[0]
+        qp = proxsuite.proxqp.dense.QP(n, n_eq, n_in)
+        qp.settings.initial_guess = (
+            proxsuite.proxqp.InitialGuess.WARM_START_WITH_PREVIOUS_RESULT
+        )
+        qp.settings.max_iter = 2
+        qp.init(H, g, A, b, C, l, u)
+        qp.solve()
+
+        # the loaded qp continues from the workspace of the saved one
+        loaded_qp = pickle.loads(pickle.dumps(qp))
+        qp.settings.max_iter = 10000
+        loaded_qp.settings.max_iter = 10000
+        qp.solve()
+        loaded_qp.solve()
+        assert loaded_qp.results.info.iter == qp.results.info.iter
+        assert np.array_equal(loaded_qp.results.x, qp.results.x)
+
+
+class SparseqpWrapperSerialization(unittest.TestCase):
+    def test_pickle(self):
+        print("------------------------test pickle sparse")
+        n = 10
+        H, g, A, b, C, u, l = generate_mixed_qp(n)
+        n_eq = A.shape[0]
+        n_in = C.shape[0]
+        qp = proxsuite.proxqp.sparse.QP(n, n_eq, n_in)
+        qp.init(
+            spa.csc_matrix(H),
+            g,
+            spa.csc_matrix(A),
+            b,
+            spa.csc_matrix(C),
+            l,
+            u,
+        )
+        qp.solve()
+
+        loaded_qp = pickle.loads(pickle.dumps(qp))
+        assert np.array_equal(loaded_qp.results.x, qp.results.x)
+
+        qp.solve()
+        loaded_qp.solve()
+        assert loaded_qp.results.info.iter == qp.results.info.iter
+        assert np.array_equal(loaded_qp.results.x, qp.results.x)
+
 
 if __name__ == "__main__":
     unittest.main()
@@ -4,9 +4,11 @@
 #include <proxsuite/linalg/sparse/factorize.hpp>
 #include <proxsuite/linalg/sparse/update.hpp>
 #include <proxsuite/linalg/sparse/rowmod.hpp>
+#include <proxsuite/linalg/sparse/supernodal.hpp>
 #include <proxsuite/linalg/veg/vec.hpp>
 #include <doctest.hpp>
 #include <iostream>
+#include <random>
 
 template<typename T, typename I>
 auto
@@ -629,3 +631,378 @@ TEST_CASE("ldlt: row mod")
   std::cout << to_eigen(ld.as_const()) << '\n' << '\n';
   dump_reconstructed();
 }
+
+TEST_CASE("ldlt: supernodal factorize and solve")
+{
+  using I = int;
+  using T = double;
+  using Mat = Eigen::Matrix<T, -1, -1, Eigen::ColMajor>;
+
+  // quasi-definite kkt-like matrix: [H A.T; A 0] with a sparse H and a few
+  // dense rows in A, so that the factor has large supernodes
+  isize dim = 40;
+  isize n_eq = 12;
+  isize n = dim + n_eq;
+
+  std::mt19937 gen(1234);
+  std::uniform_real_distribution<T> dist(-1, 1);
+
+  Mat a_dense = Mat::Zero(n, n);
+  for (isize i = 0; i < dim; ++i) {
+    a_dense(i, i) = T(4);
+    if (i + 1 < dim) {
+      a_dense(i, i + 1) = dist(gen);
+    }
+    if (i + 7 < dim) {
+      a_dense(i, i + 7) = dist(gen);
+    }
+  }
+  for (isize j = 0; j < n_eq; ++j) {
+    for (isize i = 0; i < dim; ++i) {
+      if (j < 3 || (i + j) % 5 == 0) {
+        a_dense(i, dim + j) = dist(gen);
+      }
+    }
+  }
+
+  Vec<I> col_ptrs;
+  Vec<I> nnz_per_col;
+  Vec<I> row_ind;
+  Vec<T> vals;
+  col_ptrs.push(0);
+  for (isize j = 0; j < n; ++j) {
+    for (isize i = 0; i <= j; ++i) {
+      if (a_dense(i, j) != T(0)) {
+        row_ind.push(I(i));
+        vals.push(a_dense(i, j));
+      }
+    }
+    col_ptrs.push(I(row_ind.len()));
+    nnz_per_col.push(I(col_ptrs[j + 1] - col_ptrs[j]));
+  }
+  isize nnz = row_ind.len();
+
+  // the last constraints are inactive, as in the active part of the kkt
+  isize n_inactive = 4;
+  isize nnz_active = nnz;
+  for (isize j = n - n_inactive; j < n; ++j) {
+    nnz_active -= nnz_per_col[j];
+    nnz_per_col[j] = 0;
+  }
+
+  Vec<T> diag;
+  for (isize i = 0; i < dim; ++i) {
+    diag.push(T(1e-3));
+  }
+  for (isize i = dim; i < n; ++i) {
+    diag.push(i < n - n_inactive ? T(-1e-2) : T(1));
+  }
+
+  auto a_sym = SymbolicMatRef<I>{
+    from_raw_parts, n, n, nnz, col_ptrs.ptr(), nullptr, row_ind.ptr(),
+  };
+  auto a = MatRef<T, I>{
+    from_raw_parts,
+    n,
+    n,
+    nnz_active,
+    col_ptrs.ptr(),
+    nnz_per_col.ptr(),
+    row_ind.ptr(),
+    vals.ptr(),
+  };
+
+  Vec<I> perm;
+  perm.resize_for_overwrite(n);
+  {
+    Vec<unsigned char> _stack;
+    _stack.resize_for_overwrite(amd_req(Tag<I>{}, n, nnz).alloc_req());
+    dynstack::DynStackMut stack{ from_slice_mut, _stack.as_mut() };
+    amd(perm.ptr_mut(), a_sym, stack);
+  }
+
+  SupernodalLdlt<T, I> ldl;
+  {
+    Vec<unsigned char> _stack;
+    _stack.resize_for_overwrite(
+      factorize_symbolic_supernodal_req(Tag<I>{}, n, nnz).alloc_req());
+    dynstack::DynStackMut stack{ from_slice_mut, _stack.as_mut() };
+    factorize_symbolic_supernodal(ldl, perm.ptr(), a_sym, stack);
+  }
+  CHECK(ldl.n_supernodes < n);
+
+  Vec<unsigned char> _stack;
+  _stack.resize_for_overwrite((factorize_numeric_supernodal_req(ldl, nnz) |
+                               solve_supernodal_req(ldl))
+                                .alloc_req());
+  dynstack::DynStackMut stack{ from_slice_mut, _stack.as_mut() };
+  factorize_numeric_supernodal(ldl, diag.ptr(), a, stack);
+
+  Mat kkt = Mat::Zero(n, n);
+  kkt.template triangularView<Eigen::Upper>() = a.to_eigen().toDense();
+  kkt.template triangularView<Eigen::StrictlyLower>() =
+    kkt.transpose().template triangularView<Eigen::StrictlyLower>();
+  for (isize i = 0; i < n; ++i) {
+    kkt(i, i) += diag[i];
+  }
+
+  Eigen::Matrix<T, -1, 1> rhs(n);
+  for (isize i = 0; i < n; ++i) {
+    rhs[i] = dist(gen);
+  }
+  Eigen::Matrix<T, -1, 1> sol = rhs;
+  solve_supernodal_in_place<T, I>({ from_eigen, sol }, ldl, stack);
+
+  CHECK((kkt * sol - rhs).template lpNorm<Eigen::Infinity>() < T(1e-9));
+}
+
+TEST_CASE("ldlt: supernodal row mod and rank update")
+{
+  using I = int;
+  using T = double;
+  using Mat = Eigen::Matrix<T, -1, -1, Eigen::ColMajor>;
+
+  isize dim = 40;
+  isize n_eq = 12;
+  isize n = dim + n_eq;
+
+  std::mt19937 gen(4321);
+  std::uniform_real_distribution<T> dist(-1, 1);
+
+  Mat a_dense = Mat::Zero(n, n);
+  for (isize i = 0; i < dim; ++i) {
+    a_dense(i, i) = T(4);
+    if (i + 1 < dim) {
+      a_dense(i, i + 1) = dist(gen);
+    }
+    if (i + 7 < dim) {
+      a_dense(i, i + 7) = dist(gen);
+    }
+  }
+  for (isize j = 0; j < n_eq; ++j) {
+    for (isize i = 0; i < dim; ++i) {
+      if (j < 3 || (i + j) % 5 == 0) {
+        a_dense(i, dim + j) = dist(gen);
+      }
+    }
+  }
+
+  Vec<I> col_ptrs;
+  Vec<I> nnz_per_col;
+  Vec<I> row_ind;
+  Vec<T> vals;
+  col_ptrs.push(0);
+  for (isize j = 0; j < n; ++j) {
+    for (isize i = 0; i <= j; ++i) {
+      if (a_dense(i, j) != T(0)) {
+        row_ind.push(I(i));
+        vals.push(a_dense(i, j));
+      }
+    }
+    col_ptrs.push(I(row_ind.len()));
+    nnz_per_col.push(I(col_ptrs[j + 1] - col_ptrs[j]));
+  }
+  isize nnz = row_ind.len();
+
+  // the constraints are all inactive at first, so that their rows are
+  // decoupled
+  isize nnz_active = 0;
+  Vec<T> diag;
+  for (isize i = 0; i < dim; ++i) {
+    diag.push(T(1e-3));
+    nnz_active += nnz_per_col[i];
+  }
+  for (isize i = dim; i < n; ++i) {
+    diag.push(T(1));
+    nnz_per_col[i] = 0;
+  }
+
+  auto a_sym = SymbolicMatRef<I>{
+    from_raw_parts, n, n, nnz, col_ptrs.ptr(), nullptr, row_ind.ptr(),
+  };
+  auto a = MatRef<T, I>{
+    from_raw_parts,
+    n,
+    n,
+    nnz_active,
+    col_ptrs.ptr(),
+    nnz_per_col.ptr(),
+    row_ind.ptr(),
+    vals.ptr(),
+  };
+
+  Vec<I> perm;
+  perm.resize_for_overwrite(n);
+  {
+    Vec<unsigned char> _stack;
+    _stack.resize_for_overwrite(amd_req(Tag<I>{}, n, nnz).alloc_req());
+    dynstack::DynStackMut stack{ from_slice_mut, _stack.as_mut() };
+    amd(perm.ptr_mut(), a_sym, stack);
+  }
+
+  SupernodalLdlt<T, I> ldl;
+  {
+    Vec<unsigned char> _stack;
+    _stack.resize_for_overwrite(
+      factorize_symbolic_supernodal_req(Tag<I>{}, n, nnz).alloc_req());
+    dynstack::DynStackMut stack{ from_slice_mut, _stack.as_mut() };
+    factorize_symbolic_supernodal(ldl, perm.ptr(), a_sym, stack);
+  }
+
+  Vec<unsigned char> _stack;
+  _stack.resize_for_overwrite((factorize_numeric_supernodal_req(ldl, nnz) |
+                               solve_supernodal_req(ldl) |
+                               update_supernodal_req(ldl, n))
+                                .alloc_req());
+  dynstack::DynStackMut stack{ from_slice_mut, _stack.as_mut() };
+  factorize_numeric_supernodal(ldl, diag.ptr(), a, stack);
+
+  Mat kkt = Mat::Zero(n, n);
+  for (isize j = 0; j < dim; ++j) {
+    kkt(j, j) = diag[j];
+  }
+  kkt.topLeftCorner(dim, dim) += a_dense.topLeftCorner(dim, dim);
+  kkt.bottomRightCorner(n_eq, n_eq).setIdentity();
+
+  auto col = [&](isize j) {
+    return VecRef<T, I>{
+      from_raw_parts,
+      n,
+      isize(col_ptrs[j + 1] - col_ptrs[j]),
+      row_ind.ptr() + col_ptrs[j],
+      vals.ptr() + col_ptrs[j],
+    };
+  };
+  auto check_solve = [&] {
+    Mat full = kkt.template selfadjointView<Eigen::Upper>();
+    Eigen::Matrix<T, -1, 1> rhs(n);
+    for (isize i = 0; i < n; ++i) {
+      rhs[i] = dist(gen);
+    }
+    Eigen::Matrix<T, -1, 1> sol = rhs;
+    solve_supernodal_in_place<T, I>({ from_eigen, sol }, ldl, stack);
+    CHECK((full * sol - rhs).template lpNorm<Eigen::Infinity>() < T(1e-9));
+  };
+
+  // activate the constraints one by one
+  for (isize j = dim; j < n; ++j) {
+    add_row_supernodal(ldl, j, col(j), T(-1e-2), stack);
+    kkt.col(j).head(dim) = a_dense.col(j).head(dim);
+    kkt(j, j) = T(-1e-2);
+    check_solve();
+  }
+
+  // remove some of them
+  for (isize j = dim; j < n; j += 3) {
+    delete_row_supernodal(ldl, j, col(j), stack);
+    kkt.col(j).head(dim).setZero();
+    kkt(j, j) = T(1);
+    check_solve();
+  }
+
+  // change the proximal parameter of the remaining ones
+  for (isize j = dim; j < n; ++j) {
+    if ((j - dim) % 3 == 0) {
+      continue;
+    }
+    I row = I(j);
+    T one = 1;
+    rank1_update_supernodal(
+      ldl, VecRef<T, I>{ from_raw_parts, n, 1, &row, &one }, T(9e-3), stack);
+    kkt(j, j) = T(-1e-3);
+  }
+  check_solve();
+
+  // add back a removed constraint
+  add_row_supernodal(ldl, dim + 3, col(dim + 3), T(-1e-3), stack);
+  kkt.col(dim + 3).head(dim) = a_dense.col(dim + 3).head(dim);
+  kkt(dim + 3, dim + 3) = T(-1e-3);
+  check_solve();
+}
+
+TEST_CASE("ldlt: fill-reducing orderings")
+{
+  using I = int;
+
+  // 2d grid laplacian, plus a second disconnected grid, so that the nested
+  // dissection ordering bisects the graph several times
+  isize side0 = 30;
+  isize side1 = 12;
+  isize n = side0 * side0 + side1 * side1;
+
+  Vec<I> col_ptrs;
+  Vec<I> row_ind;
+  col_ptrs.push(0);
+  auto add_grid = [&](isize side, isize offset) {
+    for (isize y = 0; y < side; ++y) {
+      for (isize x = 0; x < side; ++x) {
+        isize j = offset + y * side + x;
+        if (y > 0) {
+          row_ind.push(I(j - side));
+        }
+        if (x > 0) {
+          row_ind.push(I(j - 1));
+        }
+        row_ind.push(I(j));
+        col_ptrs.push(I(row_ind.len()));
+      }
+    }
+  };
+  add_grid(side0, 0);
+  add_grid(side1, side0 * side0);
+  isize nnz = row_ind.len();
+
+  auto a = SymbolicMatRef<I>{
+    from_raw_parts, n, n, nnz, col_ptrs.ptr(), nullptr, row_ind.ptr(),
+  };
+
+  Ordering orderings[3] = {
+    Ordering::natural,
+    Ordering::amd,
+    Ordering::nested_dissection,
+  };
+  isize lnnz[3] = {};
+  for (isize k = 0; k < 3; ++k) {
+    Vec<unsigned char> _stack;
+    _stack.resize_for_overwrite(
+      factorize_symbolic_req(Tag<I>{}, n, nnz, orderings[k]).alloc_req());
+    dynstack::DynStackMut stack{ from_slice_mut, _stack.as_mut() };
+
+    Vec<I> l_col_ptrs;
+    Vec<I> etree;
+    Vec<I> perm_inv;
+    l_col_ptrs.resize_for_overwrite(n + 1);
+    etree.resize_for_overwrite(n);
+    perm_inv.resize_for_overwrite(n);
+
+    factorize_symbolic_col_counts(l_col_ptrs.ptr_mut(),
+                                  etree.ptr_mut(),
+                                  perm_inv.ptr_mut(),
+                                  static_cast<I const*>(nullptr),
+                                  a,
+                                  stack,
+                                  orderings[k]);
+    lnnz[k] = isize(l_col_ptrs[n]);
+
+    // the ordering is a permutation
+    Vec<bool> seen;
+    seen.resize(n);
+    for (isize i = 0; i < n; ++i) {
+      I p = perm_inv[i];
+      CHECK(p >= 0);
+      CHECK(p < n);
+      CHECK(!seen[isize(p)]);
+      seen[isize(p)] = true;
+    }
+    if (orderings[k] == Ordering::natural) {
+      for (isize i = 0; i < n; ++i) {
+        CHECK(perm_inv[i] == I(i));
+      }
+    }
+  }
+
+  CHECK(lnnz[1] < lnnz[0]);
+  CHECK(lnnz[2] < lnnz[0]);
+  std::cout << "lnnz natural: " << lnnz[0] << " amd: " << lnnz[1]
+            << " nested dissection: " << lnnz[2] << std::endl;
+}
@@ -340,6 +340,440 @@ TEST_CASE("ProxQP::sparse: sparse random strongly convex qp with equality and "
   }
 }
 
+TEST_CASE("ProxQP::sparse: sparse random strongly convex qp with equality and "
+          "inequality constraints: test the MatrixFree preconditioners")
+{
+  std::cout << "------------------------sparse random strongly convex qp with "
+               "equality and inequality constraints: test the MatrixFree "
+               "preconditioners"
+            << std::endl;
+  for (auto const& dims : { proxsuite::linalg::veg::tuplify(10, 2, 2),
+                            proxsuite::linalg::veg::tuplify(50, 10, 25) }) {
+    VEG_BIND(auto const&, (n, n_eq, n_in), dims);
+
+    T sparsity_factor = 0.15;
+    T strong_convexity_factor = 0.01;
+    ::proxsuite::proxqp::utils::rand::set_seed(1);
+    proxqp::sparse::SparseModel<T> qp_random = utils::sparse_strongly_convex_qp(
+      n, n_eq, n_in, sparsity_factor, strong_convexity_factor);
+
+    proxqp::sparse::QP<T, I> qp_ldlt(n, n_eq, n_in);
+    qp_ldlt.settings.eps_abs = 1.E-9;
+    qp_ldlt.settings.sparse_backend =
+      proxsuite::proxqp::SparseBackend::SparseCholesky;
+    qp_ldlt.init(qp_random.H,
+                 qp_random.g,
+                 qp_random.A,
+                 qp_random.b,
+                 qp_random.C,
+                 qp_random.l,
+                 qp_random.u);
+    qp_ldlt.solve();
+
+    for (auto preconditioner :
+         { proxsuite::proxqp::MatrixFreePreconditioner::Identity,
+           proxsuite::proxqp::MatrixFreePreconditioner::BlockJacobi,
+           proxsuite::proxqp::MatrixFreePreconditioner::IncompleteLdlt }) {
+      proxqp::sparse::QP<T, I> qp(n, n_eq, n_in);
+      qp.settings.eps_abs = 1.E-9;
+      qp.settings.sparse_backend = proxsuite::proxqp::SparseBackend::MatrixFree;
+      qp.settings.matrix_free_preconditioner = preconditioner;
+      qp.init(qp_random.H,
+              qp_random.g,
+              qp_random.A,
+              qp_random.b,
+              qp_random.C,
+              qp_random.l,
+              qp_random.u);
+      qp.solve();
+      CHECK(qp.results.info.status == QPSolverOutput::PROXQP_SOLVED);
+      T dua_res = proxqp::dense::infty_norm(
+        qp_random.H.selfadjointView<Eigen::Upper>() * qp.results.x +
+        qp_random.g + qp_random.A.transpose() * qp.results.y +
+        qp_random.C.transpose() * qp.results.z);
+      T pri_res = std::max(
+        proxqp::dense::infty_norm(qp_random.A * qp.results.x - qp_random.b),
+        proxqp::dense::infty_norm(
+          helpers::positive_part(qp_random.C * qp.results.x - qp_random.u) +
+          helpers::negative_part(qp_random.C * qp.results.x - qp_random.l)));
+      CHECK(dua_res <= 1e-9);
+      CHECK(pri_res <= 1E-9);
+      CHECK(qp.results.x.isApprox(qp_ldlt.results.x, 1E-6));
+      std::cout << "--n = " << n << " n_eq " << n_eq << " n_in " << n_in
+                << " preconditioner " << preconditioner << std::endl;
+      std::cout << "total number of iteration: " << qp.results.info.iter
+                << "; minres iterations of the last solve: "
+                << qp.work.internal.matrix_free_solver->iterations()
+                << std::endl;
+    }
+  }
+}
+
+TEST_CASE("ProxQP::sparse: sparse random strongly convex qp with equality and "
+          "inequality constraints: test the linear operator interface")
+{
+  std::cout << "------------------------sparse random strongly convex qp with "
+               "equality and inequality constraints: test the linear operator "
+               "interface"
+            << std::endl;
+  for (auto const& dims : { proxsuite::linalg::veg::tuplify(10, 2, 2),
+                            proxsuite::linalg::veg::tuplify(50, 10, 25) }) {
+    VEG_BIND(auto const&, (n, n_eq, n_in), dims);
+
+    T sparsity_factor = 0.15;
+    T strong_convexity_factor = 0.01;
+    ::proxsuite::proxqp::utils::rand::set_seed(1);
+    proxqp::sparse::SparseModel<T> qp_random = utils::sparse_strongly_convex_qp(
+      n, n_eq, n_in, sparsity_factor, strong_convexity_factor);
+
+    proxqp::sparse::QP<T, I> qp_ldlt(n, n_eq, n_in);
+    qp_ldlt.settings.eps_abs = 1.E-9;
+    qp_ldlt.settings.sparse_backend =
+      proxsuite::proxqp::SparseBackend::SparseCholesky;
+    qp_ldlt.init(qp_random.H,
+                 qp_random.g,
+                 qp_random.A,
+                 qp_random.b,
+                 qp_random.C,
+                 qp_random.l,
+                 qp_random.u);
+    qp_ldlt.solve();
+
+    Eigen::SparseMatrix<T> H = qp_random.H.selfadjointView<Eigen::Upper>();
+    Eigen::SparseMatrix<T> A = qp_random.A;
+    Eigen::SparseMatrix<T> C = qp_random.C;
+    using In = proxqp::sparse::VecRef<T>;
+    using Out = Eigen::Ref<proxqp::sparse::Vec<T>>;
+    proxqp::sparse::LinearOperator<T> op;
+    op.H = [&](In in, Out out) { out.noalias() = H * in; };
+    op.A = [&](In in, Out out) { out.noalias() = A * in; };
+    op.AT = [&](In in, Out out) { out.noalias() = A.transpose() * in; };
+    op.C = [&](In in, Out out) { out.noalias() = C * in; };
+    op.CT = [&](In in, Out out) { out.noalias() = C.transpose() * in; };
+
+    for (bool with_diagonal : { false, true }) {
+      if (with_diagonal) {
+        op.H_diagonal = H.diagonal();
+      }
+      proxqp::sparse::QP<T, I> qp(n, n_eq, n_in);
+      qp.settings.eps_abs = 1.E-9;
+      qp.init(op, qp_random.g, qp_random.b, qp_random.l, qp_random.u);
+      qp.solve();
+      CHECK(qp.results.info.sparse_backend ==
+            proxsuite::proxqp::SparseBackend::MatrixFree);
+      CHECK(qp.results.info.status == QPSolverOutput::PROXQP_SOLVED);
+      T dua_res = proxqp::dense::infty_norm(
+        H * qp.results.x + qp_random.g + A.transpose() * qp.results.y +
+        C.transpose() * qp.results.z);
+      T pri_res = std::max(
+        proxqp::dense::infty_norm(A * qp.results.x - qp_random.b),
+        proxqp::dense::infty_norm(
+          helpers::positive_part(C * qp.results.x - qp_random.u) +
+          helpers::negative_part(C * qp.results.x - qp_random.l)));
+      CHECK(dua_res <= 1e-9);
+      CHECK(pri_res <= 1E-9);
+      CHECK(qp.results.x.isApprox(qp_ldlt.results.x, 1E-6));
+      T obj = (T(0.5) * H * qp.results.x + qp_random.g).dot(qp.results.x);
+      CHECK(std::abs(qp.results.info.objValue - obj) <=
+            1E-9 * std::max(T(1), std::abs(obj)));
+
+      // a second solve reuses the linear operators
+      qp.settings.initial_guess =
+        proxsuite::proxqp::InitialGuessStatus::WARM_START_WITH_PREVIOUS_RESULT;
+      qp.solve();
+      CHECK(qp.results.info.status == QPSolverOutput::PROXQP_SOLVED);
+      CHECK(qp.results.x.isApprox(qp_ldlt.results.x, 1E-6));
+      std::cout << "--n = " << n << " n_eq " << n_eq << " n_in " << n_in
+                << " with diagonal of H: " << with_diagonal << std::endl;
+      std::cout << "total number of iteration: " << qp.results.info.iter
+                << std::endl;
+    }
+  }
+}
+
+TEST_CASE("ProxQP::sparse: sparse random strongly convex qp with equality and "
+          "inequality constraints: test the SupernodalCholesky backend")
+{
+  std::cout << "------------------------sparse random strongly convex qp with "
+               "equality and inequality constraints: test the "
+               "SupernodalCholesky backend"
+            << std::endl;
+  for (auto const& dims : { proxsuite::linalg::veg::tuplify(10, 2, 2),
+                            proxsuite::linalg::veg::tuplify(50, 10, 25),
+                            proxsuite::linalg::veg::tuplify(100, 0, 50) }) {
+    VEG_BIND(auto const&, (n, n_eq, n_in), dims);
+
+    T sparsity_factor = 0.15;
+    T strong_convexity_factor = 0.01;
+    ::proxsuite::proxqp::utils::rand::set_seed(1);
+    proxqp::sparse::SparseModel<T> qp_random = utils::sparse_strongly_convex_qp(
+      n, n_eq, n_in, sparsity_factor, strong_convexity_factor);
+
+    proxqp::sparse::QP<T, I> qp(n, n_eq, n_in);
+    qp.settings.eps_abs = 1.E-9;
+    qp.settings.sparse_backend =
+      proxsuite::proxqp::SparseBackend::SupernodalCholesky;
+    qp.init(qp_random.H,
+            qp_random.g,
+            qp_random.A,
+            qp_random.b,
+            qp_random.C,
+            qp_random.l,
+            qp_random.u);
+    qp.solve();
+    CHECK(qp.results.info.sparse_backend ==
+          proxsuite::proxqp::SparseBackend::SupernodalCholesky);
+    CHECK(qp.results.info.status == QPSolverOutput::PROXQP_SOLVED);
+    T dua_res = proxqp::dense::infty_norm(
+      qp_random.H.selfadjointView<Eigen::Upper>() * qp.results.x + qp_random.g +
+      qp_random.A.transpose() * qp.results.y +
+      qp_random.C.transpose() * qp.results.z);
+    T pri_res = std::max(
+      proxqp::dense::infty_norm(qp_random.A * qp.results.x - qp_random.b),
+      proxqp::dense::infty_norm(
+        helpers::positive_part(qp_random.C * qp.results.x - qp_random.u) +
+        helpers::negative_part(qp_random.C * qp.results.x - qp_random.l)));
+    CHECK(dua_res <= 1e-9);
+    CHECK(pri_res <= 1E-9);
+
+    proxqp::sparse::QP<T, I> qp2(n, n_eq, n_in);
+    qp2.settings.eps_abs = 1.E-9;
+    qp2.settings.sparse_backend =
+      proxsuite::proxqp::SparseBackend::SparseCholesky;
+    qp2.init(qp_random.H,
+             qp_random.g,
+             qp_random.A,
+             qp_random.b,
+             qp_random.C,
+             qp_random.l,
+             qp_random.u);
+    qp2.solve();
+    CHECK(qp.results.x.isApprox(qp2.results.x, 1E-6));
+    // the factorization is updated in place on active set changes and mu
+    // updates, as with SparseCholesky
+    CHECK(qp.results.info.iter == qp2.results.info.iter);
+    CHECK(qp.results.info.mu_updates == qp2.results.info.mu_updates);
+#ifdef PROXSUITE_ENABLE_PROFILING
+    CHECK(qp.results.info.profile.mu_update_rank ==
+          qp2.results.info.profile.mu_update_rank);
+    CHECK(qp.results.info.profile.active_set_insertions ==
+          qp2.results.info.profile.active_set_insertions);
+#endif
+    std::cout << "--n = " << n << " n_eq " << n_eq << " n_in " << n_in
+              << std::endl;
+    std::cout << "dual residual " << dua_res << "; primal residual " << pri_res
+              << std::endl;
+    std::cout << "total number of iteration: " << qp.results.info.iter
+              << " (SparseCholesky: " << qp2.results.info.iter << ")"
+              << std::endl;
+
+    // the supernodal structure is kept when only the values are updated
+    qp_random.g.setOnes();
+    qp.update(
+      nullopt, qp_random.g, nullopt, nullopt, nullopt, nullopt, nullopt);
+    qp.solve();
+    dua_res = proxqp::dense::infty_norm(
+      qp_random.H.selfadjointView<Eigen::Upper>() * qp.results.x + qp_random.g +
+      qp_random.A.transpose() * qp.results.y +
+      qp_random.C.transpose() * qp.results.z);
+    pri_res = std::max(
+      proxqp::dense::infty_norm(qp_random.A * qp.results.x - qp_random.b),
+      proxqp::dense::infty_norm(
+        helpers::positive_part(qp_random.C * qp.results.x - qp_random.u) +
+        helpers::negative_part(qp_random.C * qp.results.x - qp_random.l)));
+    CHECK(dua_res <= 1e-9);
+    CHECK(pri_res <= 1E-9);
+  }
+}
+
+TEST_CASE("ProxQP::sparse: sparse random strongly convex qp with equality and "
+          "inequality constraints: test the sparse orderings")
+{
+  std::cout << "------------------------sparse random strongly convex qp with "
+               "equality and inequality constraints: test the sparse orderings"
+            << std::endl;
+  for (auto const& dims : { proxsuite::linalg::veg::tuplify(10, 2, 2),
+                            proxsuite::linalg::veg::tuplify(300, 50, 100) }) {
+    VEG_BIND(auto const&, (n, n_eq, n_in), dims);
+
+    T sparsity_factor = 0.01;
+    T strong_convexity_factor = 0.01;
+    ::proxsuite::proxqp::utils::rand::set_seed(1);
+    proxqp::sparse::SparseModel<T> qp_random = utils::sparse_strongly_convex_qp(
+      n, n_eq, n_in, sparsity_factor, strong_convexity_factor);
+
+    proxsuite::linalg::sparse::Ordering orderings[3] = {
+      proxsuite::linalg::sparse::Ordering::natural,
+      proxsuite::linalg::sparse::Ordering::amd,
+      proxsuite::linalg::sparse::Ordering::nested_dissection,
+    };
+    isize lnnz[3] = {};
+    for (isize k = 0; k < 3; ++k) {
+      proxqp::sparse::QP<T, I> qp(n, n_eq, n_in);
+      qp.settings.eps_abs = 1.E-9;
+      qp.settings.sparse_backend =
+        proxsuite::proxqp::SparseBackend::SparseCholesky;
+      qp.settings.sparse_ordering = orderings[k];
+      qp.init(qp_random.H,
+              qp_random.g,
+              qp_random.A,
+              qp_random.b,
+              qp_random.C,
+              qp_random.l,
+              qp_random.u);
+      qp.solve();
+      CHECK(qp.results.info.status == QPSolverOutput::PROXQP_SOLVED);
+      T dua_res = proxqp::dense::infty_norm(
+        qp_random.H.selfadjointView<Eigen::Upper>() * qp.results.x +
+        qp_random.g + qp_random.A.transpose() * qp.results.y +
+        qp_random.C.transpose() * qp.results.z);
+      T pri_res = std::max(
+        proxqp::dense::infty_norm(qp_random.A * qp.results.x - qp_random.b),
+        proxqp::dense::infty_norm(
+          helpers::positive_part(qp_random.C * qp.results.x - qp_random.u) +
+          helpers::negative_part(qp_random.C * qp.results.x - qp_random.l)));
+      CHECK(dua_res <= 1e-9);
+      CHECK(pri_res <= 1E-9);
+      lnnz[k] = qp.results.info.lnnz;
+      CHECK(lnnz[k] > 0);
+    }
+    CHECK(lnnz[1] <= lnnz[0]);
+    std::cout << "--n = " << n << " n_eq " << n_eq << " n_in " << n_in
+              << std::endl;
+    std::cout << "lnnz natural: " << lnnz[0] << " amd: " << lnnz[1]
+              << " nested dissection: " << lnnz[2] << std::endl;
+
+    // the symbolic factorization computed from the sparsity structure is
+    // recomputed when another ordering is requested
+    proxqp::sparse::QP<T, I> qp(qp_random.H.cast<bool>(),
+                                qp_random.A.cast<bool>(),
+                                qp_random.C.cast<bool>());
+    qp.settings.eps_abs = 1.E-9;
+    qp.settings.sparse_backend =
+      proxsuite::proxqp::SparseBackend::SparseCholesky;
+    qp.settings.sparse_ordering =
+      proxsuite::linalg::sparse::Ordering::nested_dissection;
+    qp.init(qp_random.H,
+            qp_random.g,
+            qp_random.A,
+            qp_random.b,
+            qp_random.C,
+            qp_random.l,
+            qp_random.u);
+    CHECK(qp.results.info.lnnz == lnnz[2]);
+    CHECK(qp.results.info.symbolic_factorization_reuses == 0);
+    qp.solve();
+    CHECK(qp.results.info.status == QPSolverOutput::PROXQP_SOLVED);
+
+    // no permutation can be given to the solver, the user_provided ordering
+    // is rejected at setup
+    proxqp::sparse::QP<T, I> qp_user(n, n_eq, n_in);
+    qp_user.settings.sparse_ordering =
+      proxsuite::linalg::sparse::Ordering::user_provided;
+    CHECK_THROWS_AS(qp_user.init(qp_random.H,
+                                 qp_random.g,
+                                 qp_random.A,
+                                 qp_random.b,
+                                 qp_random.C,
+                                 qp_random.l,
+                                 qp_random.u),
+                    std::invalid_argument);
+  }
+}
+
+TEST_CASE("ProxQP::sparse: test mixed precision factorization")
+{
+  std::cout << "------------------------sparse random strongly convex qp with "
+               "equality and inequality constraints: test mixed precision "
+               "factorization"
+            << std::endl;
+  isize n = 100;
+  isize n_eq = 20;
+  isize n_in = 40;
+  T sparsity_factor = 0.05;
+  T strong_convexity_factor = 0.01;
+  ::proxsuite::proxqp::utils::rand::set_seed(1);
+  proxqp::sparse::SparseModel<T> qp_random = utils::sparse_strongly_convex_qp(
+    n, n_eq, n_in, sparsity_factor, strong_convexity_factor);
+
+  proxqp::sparse::QP<T, I> qp(n, n_eq, n_in);
+  qp.settings.eps_abs = 1.E-9;
+  qp.settings.sparse_backend = proxsuite::proxqp::SparseBackend::SparseCholesky;
+  qp.init(qp_random.H,
+          qp_random.g,
+          qp_random.A,
+          qp_random.b,
+          qp_random.C,
+          qp_random.l,
+          qp_random.u);
+  qp.solve();
+  CHECK(qp.results.info.status == QPSolverOutput::PROXQP_SOLVED);
+
+  proxqp::sparse::QP<T, I> qp_mixed(n, n_eq, n_in);
+  qp_mixed.settings.eps_abs = 1.E-9;
+  qp_mixed.settings.sparse_backend =
+    proxsuite::proxqp::SparseBackend::SparseCholesky;
+  qp_mixed.settings.mixed_precision = true;
+  qp_mixed.init(qp_random.H,
+                qp_random.g,
+                qp_random.A,
+                qp_random.b,
+                qp_random.C,
+                qp_random.l,
+                qp_random.u);
+  qp_mixed.solve();
+  CHECK(qp_mixed.results.info.status == QPSolverOutput::PROXQP_SOLVED);
+  T dua_res = proxqp::dense::infty_norm(
+    qp_random.H.selfadjointView<Eigen::Upper>() * qp_mixed.results.x +
+    qp_random.g + qp_random.A.transpose() * qp_mixed.results.y +
+    qp_random.C.transpose() * qp_mixed.results.z);
+  T pri_res = std::max(
+    proxqp::dense::infty_norm(qp_random.A * qp_mixed.results.x - qp_random.b),
+    proxqp::dense::infty_norm(
+      helpers::positive_part(qp_random.C * qp_mixed.results.x - qp_random.u) +
+      helpers::negative_part(qp_random.C * qp_mixed.results.x - qp_random.l)));
+  CHECK(dua_res <= 1e-9);
+  CHECK(pri_res <= 1E-9);
+  CHECK(proxqp::dense::infty_norm(qp_mixed.results.x - qp.results.x) <= 1e-7);
+  // the single precision factorization needs more refinement steps
+  CHECK(qp_mixed.results.info.iterative_refinement_steps >=
+        qp.results.info.iterative_refinement_steps);
+  CHECK(qp_mixed.results.info.iterative_refinement_steps > 0);
+  std::cout << "refinement steps: double "
+            << qp.results.info.iterative_refinement_steps << " mixed "
+            << qp_mixed.results.info.iterative_refinement_steps
+            << " fallback: " << qp_mixed.results.info.mixed_precision_fallback
+            << std::endl;
+
+  // a badly scaled hessian makes the refinement stall in single precision:
+  // the solver falls back to a double precision factorization
+  n = 60;
+  n_eq = 10;
+  n_in = 20;
+  ::proxsuite::proxqp::utils::rand::set_seed(1);
+  qp_random = utils::sparse_strongly_convex_qp(
+    n, n_eq, n_in, T(0.1), strong_convexity_factor);
+  for (isize i = 0; i < n; ++i) {
+    qp_random.H.coeffRef(i, i) += std::pow(T(10), T(i % 17) - T(8));
+  }
+  proxqp::sparse::QP<T, I> qp_ill(n, n_eq, n_in);
+  qp_ill.settings.eps_abs = 1.E-10;
+  qp_ill.settings.sparse_backend =
+    proxsuite::proxqp::SparseBackend::SparseCholesky;
+  qp_ill.settings.mixed_precision = true;
+  qp_ill.init(qp_random.H,
+              qp_random.g,
+              qp_random.A,
+              qp_random.b,
+              qp_random.C,
+              qp_random.l,
+              qp_random.u,
+              false);
+  qp_ill.solve();
+  CHECK(qp_ill.results.info.status == QPSolverOutput::PROXQP_SOLVED);
+  CHECK(qp_ill.results.info.mixed_precision_fallback);
+}
+
 TEST_CASE("ProxQP::sparse: sparse random strongly convex qp with equality and "
           "inequality constraints: test update mus")
 {
@@ -6061,4 +6495,310 @@ TEST_CASE("ProxQP::sparse: init must be called before update")
               .lpNorm<Eigen::Infinity>();
   DOCTEST_CHECK(pri_res <= eps_abs);
   DOCTEST_CHECK(dua_res <= eps_abs);
-}
\ No newline at end of file
+}
+DOCTEST_TEST_CASE(
+  "ProxQP::sparse: test the symbolic factorization is reused when updating "
+  "the qp with the same sparsity structure")
+{
+  double sparsity_factor = 0.15;
+  T eps_abs = T(1e-9);
+  utils::rand::set_seed(1);
+  sparse::isize dim = 30;
+  sparse::isize n_eq(dim / 4);
+  sparse::isize n_in(dim / 4);
+  T strong_convexity_factor(1.e-2);
+  proxqp::sparse::SparseModel<T> qp_random = utils::sparse_strongly_convex_qp(
+    dim, n_eq, n_in, sparsity_factor, strong_convexity_factor);
+
+  auto check_residuals = [&](const Results<T>& results) {
+    T pri_res = std::max(
+      (qp_random.A * results.x - qp_random.b).lpNorm<Eigen::Infinity>(),
+      (helpers::positive_part(qp_random.C * results.x - qp_random.u) +
+       helpers::negative_part(qp_random.C * results.x - qp_random.l))
+        .lpNorm<Eigen::Infinity>());
+    T dua_res = (qp_random.H.selfadjointView<Eigen::Upper>() * results.x +
+                 qp_random.g + qp_random.A.transpose() * results.y +
+                 qp_random.C.transpose() * results.z)
+                  .lpNorm<Eigen::Infinity>();
+    DOCTEST_CHECK(pri_res <= eps_abs);
+    DOCTEST_CHECK(dua_res <= eps_abs);
+  };
+
+  proxqp::sparse::QP<T, I> qp(dim, n_eq, n_in);
+  qp.settings.eps_abs = eps_abs;
+  qp.settings.eps_rel = 0;
+  qp.init(qp_random.H,
+          qp_random.g,
+          qp_random.A,
+          qp_random.b,
+          qp_random.C,
+          qp_random.l,
+          qp_random.u);
+  DOCTEST_CHECK(qp.results.info.symbolic_factorization_reuses == 0);
+  qp.solve();
+  check_residuals(qp.results);
+  DOCTEST_CHECK(qp.results.info.symbolic_factorization_reuses == 0);
+
+  // a second solve only refreshes the numerical values
+  qp.solve();
+  check_residuals(qp.results);
+  DOCTEST_CHECK(qp.results.info.symbolic_factorization_reuses == 1);
+
+  // same sparsity structure, new values
+  qp_random.H = 2 * qp_random.H;
+  qp_random.A = 3 * qp_random.A;
+  qp_random.b = 3 * qp_random.b;
+  qp_random.g = utils::rand::vector_rand<T>(dim);
+  qp.update(qp_random.H,
+            qp_random.g,
+            qp_random.A,
+            qp_random.b,
+            nullopt,
+            nullopt,
+            nullopt);
+  DOCTEST_CHECK(qp.results.info.symbolic_factorization_reuses == 2);
+  qp.solve();
+  check_residuals(qp.results);
+
+  proxqp::sparse::QP<T, I> qp_fresh(dim, n_eq, n_in);
+  qp_fresh.settings.eps_abs = eps_abs;
+  qp_fresh.settings.eps_rel = 0;
+  qp_fresh.init(qp_random.H,
+                qp_random.g,
+                qp_random.A,
+                qp_random.b,
+                qp_random.C,
+                qp_random.l,
+                qp_random.u);
+  qp_fresh.solve();
+  DOCTEST_CHECK(qp.results.info.iter == qp_fresh.results.info.iter);
+  DOCTEST_CHECK((qp.results.x - qp_fresh.results.x).lpNorm<Eigen::Infinity>() <=
+                T(1e-12));
+
+  // a new sparsity structure given at init triggers a new symbolic
+  // factorization
+  qp_random = utils::sparse_strongly_convex_qp(
+    dim, n_eq, n_in, sparsity_factor, strong_convexity_factor);
+  qp.init(qp_random.H,
+          qp_random.g,
+          qp_random.A,
+          qp_random.b,
+          qp_random.C,
+          qp_random.l,
+          qp_random.u);
+  DOCTEST_CHECK(qp.results.info.symbolic_factorization_reuses == 0);
+  qp.solve();
+  check_residuals(qp.results);
+}
+
+DOCTEST_TEST_CASE(
+  "ProxQP::sparse: test init from borrowed csc matrices and update of their "
+  "values in place")
+{
+  double sparsity_factor = 0.15;
+  T eps_abs = T(1e-9);
+  utils::rand::set_seed(1);
+  sparse::isize dim = 30;
+  sparse::isize n_eq(dim / 4);
+  sparse::isize n_in(dim / 4);
+  T strong_convexity_factor(1.e-2);
+  proxqp::sparse::SparseModel<T> qp_random = utils::sparse_strongly_convex_qp(
+    dim, n_eq, n_in, sparsity_factor, strong_convexity_factor);
+  // compressed column major copies, borrowed by the qp (with both triangular
+  // parts of H stored)
+  proxqp::sparse::SparseMat<T, I> H_triu = qp_random.H;
+  proxqp::sparse::SparseMat<T, I> H = H_triu.selfadjointView<Eigen::Upper>();
+  proxqp::sparse::SparseMat<T, I> A = qp_random.A;
+  proxqp::sparse::SparseMat<T, I> C = qp_random.C;
+  H.makeCompressed();
+  A.makeCompressed();
+  C.makeCompressed();
+
+  using MatRef = proxsuite::linalg::sparse::MatRef<T, I>;
+  proxqp::sparse::QP<T, I> qp(dim, n_eq, n_in);
+  qp.settings.eps_abs = eps_abs;
+  qp.settings.eps_rel = 0;
+  qp.init(MatRef(linalg::sparse::from_eigen, H),
+          qp_random.g,
+          MatRef(linalg::sparse::from_eigen, A),
+          qp_random.b,
+          MatRef(linalg::sparse::from_eigen, C),
+          qp_random.l,
+          qp_random.u);
+  qp.solve();
+
+  proxqp::sparse::QP<T, I> qp_eigen(dim, n_eq, n_in);
+  qp_eigen.settings.eps_abs = eps_abs;
+  qp_eigen.settings.eps_rel = 0;
+  qp_eigen.init(H,
+                qp_random.g,
+                qp_random.A,
+                qp_random.b,
+                qp_random.C,
+                qp_random.l,
+                qp_random.u);
+  qp_eigen.solve();
+  DOCTEST_CHECK(qp.results.info.iter == qp_eigen.results.info.iter);
+  DOCTEST_CHECK(
+    (qp.results.x - qp_eigen.results.x).lpNorm<Eigen::Infinity>() <= T(1e-12));
+
+  // same sparsity structure, new values given in the order of the stored
+  // entries of the matrices passed to init
+  qp_random.A = 3 * qp_random.A;
+  H = 2 * H;
+  A = 3 * A;
+  qp_random.b = 3 * qp_random.b;
+  qp_random.g = utils::rand::vector_rand<T>(dim);
+  using Map = Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1>>;
+  qp.update_values(Map(H.valuePtr(), H.nonZeros()),
+                   qp_random.g,
+                   Map(A.valuePtr(), A.nonZeros()),
+                   qp_random.b,
+                   nullopt,
+                   nullopt,
+                   nullopt);
+  DOCTEST_CHECK(qp.results.info.symbolic_factorization_reuses == 1);
+  qp.solve();
+  qp_eigen.update(H,
+                  qp_random.g,
+                  qp_random.A,
+                  qp_random.b,
+                  nullopt,
+                  nullopt,
+                  nullopt);
+  qp_eigen.solve();
+  DOCTEST_CHECK(qp.results.info.iter == qp_eigen.results.info.iter);
+  DOCTEST_CHECK(
+    (qp.results.x - qp_eigen.results.x).lpNorm<Eigen::Infinity>() <= T(1e-12));
+
+  T pri_res = std::max(
+    (qp_random.A * qp.results.x - qp_random.b).lpNorm<Eigen::Infinity>(),
+    (helpers::positive_part(qp_random.C * qp.results.x - qp_random.u) +
+     helpers::negative_part(qp_random.C * qp.results.x - qp_random.l))
+      .lpNorm<Eigen::Infinity>());
+  T dua_res = (H * qp.results.x + qp_random.g +
+               qp_random.A.transpose() * qp.results.y +
+               qp_random.C.transpose() * qp.results.z)
+                .lpNorm<Eigen::Infinity>();
+  DOCTEST_CHECK(pri_res <= eps_abs);
+  DOCTEST_CHECK(dua_res <= eps_abs);
+
+  // the number of values must match the structure given to init
+  Eigen::Matrix<T, Eigen::Dynamic, 1> too_short(1);
+  DOCTEST_CHECK_THROWS(qp.update_values(
+    too_short, nullopt, nullopt, nullopt, nullopt, nullopt, nullopt));
+}
+
+DOCTEST_TEST_CASE("ProxQP::sparse: test the per-phase profile of the solver")
+{
+  double sparsity_factor = 0.15;
+  T eps_abs = T(1e-9);
+  utils::rand::set_seed(1);
+  sparse::isize dim = 50;
+  sparse::isize n_eq(dim / 4);
+  sparse::isize n_in(dim / 2);
+  T strong_convexity_factor(1.e-2);
+  proxqp::sparse::SparseModel<T> qp_random = utils::sparse_strongly_convex_qp(
+    dim, n_eq, n_in, sparsity_factor, strong_convexity_factor);
+
+  proxqp::sparse::QP<T, I> qp(dim, n_eq, n_in);
+  qp.settings.eps_abs = eps_abs;
+  qp.settings.eps_rel = 0;
+  qp.init(qp_random.H,
+          qp_random.g,
+          qp_random.A,
+          qp_random.b,
+          qp_random.C,
+          qp_random.l,
+          qp_random.u);
+  qp.solve();
+  DOCTEST_CHECK(qp.results.info.status == QPSolverOutput::PROXQP_SOLVED);
+
+  const Profile<T>& profile = qp.results.info.profile;
+#ifdef PROXSUITE_ENABLE_PROFILING
+  DOCTEST_CHECK(profile.equilibration_time > 0);
+  DOCTEST_CHECK(profile.factorizations == 1);
+  DOCTEST_CHECK(profile.factorization_time > 0);
+  DOCTEST_CHECK(profile.line_searches > 0);
+  DOCTEST_CHECK(profile.active_set_insertions > 0);
+  DOCTEST_CHECK(profile.residual_evaluations > 0);
+  DOCTEST_CHECK(profile.iterative_refinement_time > 0);
+
+  // the timings of the profile do not make identical solves compare unequal
+  proxqp::sparse::QP<T, I> qp2(dim, n_eq, n_in);
+  qp2.settings.eps_abs = eps_abs;
+  qp2.settings.eps_rel = 0;
+  qp2.init(qp_random.H,
+           qp_random.g,
+           qp_random.A,
+           qp_random.b,
+           qp_random.C,
+           qp_random.l,
+           qp_random.u);
+  qp2.solve();
+  DOCTEST_CHECK(qp2.results.info == qp.results.info);
+  DOCTEST_CHECK(qp2.results.info.profile.factorizations ==
+                profile.factorizations);
+
+  // a second solve equilibrates the stored problem again, and its profile
+  // does not accumulate on the previous one
+  qp.solve();
+  DOCTEST_CHECK(profile.equilibration_time > 0);
+  DOCTEST_CHECK(profile.factorizations == 1);
+#else
+  DOCTEST_CHECK(profile == Profile<T>());
+#endif
+}
+
+DOCTEST_TEST_CASE(
+  "ProxQP::sparse: test the warm started equilibration of an update")
+{
+  double sparsity_factor = 0.15;
+  T eps_abs = T(1e-9);
+  utils::rand::set_seed(1);
+  sparse::isize dim = 50;
+  sparse::isize n_eq(dim / 4);
+  sparse::isize n_in(dim / 2);
+  T strong_convexity_factor(1.e-2);
+  proxqp::sparse::SparseModel<T> qp_random = utils::sparse_strongly_convex_qp(
+    dim, n_eq, n_in, sparsity_factor, strong_convexity_factor);
+
+  proxqp::sparse::QP<T, I> qp(dim, n_eq, n_in);
+  qp.settings.eps_abs = eps_abs;
+  qp.settings.eps_rel = 0;
+  qp.settings.preconditioner_warm_start = true;
+  qp.init(qp_random.H,
+          qp_random.g,
+          qp_random.A,
+          qp_random.b,
+          qp_random.C,
+          qp_random.l,
+          qp_random.u);
+  qp.solve();
+  DOCTEST_CHECK(qp.results.info.status == QPSolverOutput::PROXQP_SOLVED);
+  Eigen::Matrix<T, Eigen::Dynamic, 1> delta = qp.ruiz.delta;
+
+  // a single pass refines the previous equilibration of the slightly
+  // modified matrices
+  qp.settings.preconditioner_max_iter = 2;
+  proxqp::sparse::SparseMat<T, I> A = qp_random.A * T(1.01);
+  qp.update(nullopt, nullopt, A, nullopt, nullopt, nullopt, nullopt, true);
+  DOCTEST_CHECK(((qp.ruiz.delta - delta).cwiseQuotient(delta))
+                  .lpNorm<Eigen::Infinity>() <= T(1e-2));
+  qp.solve();
+  DOCTEST_CHECK(qp.results.info.status == QPSolverOutput::PROXQP_SOLVED);
+
+  T pri_res = std::max(
+    (A * qp.results.x - qp_random.b).lpNorm<Eigen::Infinity>(),
+    (helpers::positive_part(qp_random.C * qp.results.x - qp_random.u) +
+     helpers::negative_part(qp_random.C * qp.results.x - qp_random.l))
+      .lpNorm<Eigen::Infinity>());
+  proxqp::sparse::SparseMat<T, I> H_triu = qp_random.H;
+  proxqp::sparse::SparseMat<T, I> H = H_triu.selfadjointView<Eigen::Upper>();
+  T dua_res = (H * qp.results.x + qp_random.g +
+               A.transpose() * qp.results.y +
+               qp_random.C.transpose() * qp.results.z)
+                .lpNorm<Eigen::Infinity>();
+  DOCTEST_CHECK(pri_res <= eps_abs);
+  DOCTEST_CHECK(dua_res <= eps_abs);
+}
@@ -4605,6 +4605,57 @@ class SparseqpWrapper(unittest.TestCase):
             )
         )
 
+    def test_case_init_from_csc_and_update_values(self):
+        print(
+            "------------------------sparse random strongly convex qp with equality and inequality constraints: test init from csc matrices and update_values"
+        )
+        n = 10
+        H, g, A, b, C, u, l = generate_mixed_qp(n)
+        H = spa.csc_matrix(H, dtype=np.float64)
+        A = spa.csc_matrix(A, dtype=np.float64)
+        C = spa.csc_matrix(C, dtype=np.float64)
+        # the buffers are borrowed when their index type is int32
+        for M in [H, A, C]:
+            M.sort_indices()
+            M.indptr = M.indptr.astype(np.int32)
+            M.indices = M.indices.astype(np.int32)
+        n_eq = A.shape[0]
+        n_in = C.shape[0]
+        qp = proxsuite.proxqp.sparse.QP(n, n_eq, n_in)
+        qp.settings.eps_abs = 1.0e-9
+        qp.init(H, g, A, b, C, l, u)
+        qp.solve()
+
+        # same sparsity structure, new values
+        H.data *= 2.0
+        A.data *= 3.0
+        b = 3.0 * b
+        qp.update_values(H.data, g, A.data, b)
+        qp.solve()
+
+        qp_ref = proxsuite.proxqp.sparse.QP(n, n_eq, n_in)
+        qp_ref.settings.eps_abs = 1.0e-9
+        qp_ref.init(H, g, A, b, C, l, u)
+        qp_ref.solve()
+
+        dua_res = normInf(
+            H @ qp.results.x
+            + g
+            + A.transpose() @ qp.results.y
+            + C.transpose() @ qp.results.z
+        )
+        pri_res = max(
+            normInf(A @ qp.results.x - b),
+            normInf(
+                np.maximum(C @ qp.results.x - u, 0)
+                + np.minimum(C @ qp.results.x - l, 0)
+            ),
+        )
+        assert dua_res <= 1e-9
+        assert pri_res <= 1e-9
+        assert qp.results.info.iter == qp_ref.results.info.iter
+        assert normInf(qp.results.x - qp_ref.results.x) <= 1e-12
+
 
 if __name__ == "__main__":
     unittest.main()
@@ -7,6 +7,7 @@
 #include <proxsuite/proxqp/utils/random_qp_problems.hpp>
 #include <doctest.hpp>
 #include <proxsuite/linalg/veg/util/dynstack_alloc.hpp>
+#include <proxsuite/helpers/parallel.hpp>
 
 using namespace proxsuite;
 using namespace proxsuite::proxqp;
@@ -52,7 +53,9 @@ TEST_CASE("upper part")
   };
   VEG_MAKE_STACK(stack,
                  ruiz.scale_qp_in_place_req(
-                   proxsuite::linalg::veg::Tag<T>{}, n, n_eq, n_in));
+                   proxsuite::linalg::veg::Tag<T>{}, n, n_eq, n_in) |
+                   ruiz_dense.scale_qp_in_place_req(
+                     proxsuite::linalg::veg::Tag<T>{}, n, n_eq, n_in));
 
   bool execute_preconditioner = true;
   proxsuite::proxqp::Settings<T> settings;
@@ -135,7 +138,9 @@ TEST_CASE("lower part")
   };
   VEG_MAKE_STACK(stack,
                  ruiz.scale_qp_in_place_req(
-                   proxsuite::linalg::veg::Tag<T>{}, n, n_eq, n_in));
+                   proxsuite::linalg::veg::Tag<T>{}, n, n_eq, n_in) |
+                   ruiz_dense.scale_qp_in_place_req(
+                     proxsuite::linalg::veg::Tag<T>{}, n, n_eq, n_in));
   bool execute_preconditioner = true;
   proxsuite::proxqp::Settings<T> settings;
   ruiz.scale_qp_in_place(
@@ -176,3 +181,167 @@ TEST_CASE("lower part")
   CHECK(l_scaled.isApprox(l_scaled_dense));
   CHECK(u_scaled.isApprox(u_scaled_dense));
 }
+
+using SparseMat = Eigen::SparseMatrix<T, Eigen::ColMajor, I>;
+
+// largest deviation from one of the infinity norms of the columns of the kkt
+// matrix of a qp whose hessian is stored as its upper triangular part
+T
+equilibration_error(SparseMat const& H,
+                    SparseMat const& AT,
+                    SparseMat const& CT)
+{
+  isize n = H.rows();
+  Eigen::Matrix<T, -1, -1> H_sym =
+    Eigen::Matrix<T, -1, -1>(H).selfadjointView<Eigen::Upper>();
+  Eigen::Matrix<T, -1, -1> kkt(n, n + AT.cols() + CT.cols());
+  kkt << H_sym, Eigen::Matrix<T, -1, -1>(AT), Eigen::Matrix<T, -1, -1>(CT);
+  T error = 0;
+  for (isize j = 0; j < n; ++j) {
+    error = std::max(error, std::abs(1 - kkt.row(j).cwiseAbs().maxCoeff()));
+  }
+  for (isize j = n; j < kkt.cols(); ++j) {
+    error = std::max(error, std::abs(1 - kkt.col(j).cwiseAbs().maxCoeff()));
+  }
+  return error;
+}
+
+struct SparseQp
+{
+  SparseMat H;
+  Eigen::Matrix<T, -1, 1> g;
+  SparseMat AT;
+  Eigen::Matrix<T, -1, 1> b;
+  SparseMat CT;
+  Eigen::Matrix<T, -1, 1> l;
+  Eigen::Matrix<T, -1, 1> u;
+
+  auto as_mut() -> proxqp::sparse::QpViewMut<T, I>
+  {
+    return {
+      { proxsuite::linalg::sparse::from_eigen, H },
+      { proxsuite::linalg::sparse::from_eigen, g },
+      { proxsuite::linalg::sparse::from_eigen, AT },
+      { proxsuite::linalg::sparse::from_eigen, b },
+      { proxsuite::linalg::sparse::from_eigen, CT },
+      { proxsuite::linalg::sparse::from_eigen, l },
+      { proxsuite::linalg::sparse::from_eigen, u },
+    };
+  }
+};
+
+SparseQp
+random_sparse_qp(isize n, isize n_eq, isize n_in, T density)
+{
+  SparseQp qp;
+  qp.H = utils::rand::sparse_positive_definite_rand(n, T(10.0), density)
+           .triangularView<Eigen::Upper>();
+  qp.g = utils::rand::vector_rand<T>(n);
+  qp.AT = utils::rand::sparse_matrix_rand<T>(n, n_eq, density);
+  qp.b = utils::rand::vector_rand<T>(n_eq);
+  qp.CT = utils::rand::sparse_matrix_rand<T>(n, n_in, density);
+  qp.l = utils::rand::vector_rand<T>(n_in);
+  qp.u = qp.l.array() + T(1);
+  // badly scaled rows of A
+  for (isize k = 0; k < qp.AT.nonZeros(); ++k) {
+    qp.AT.valuePtr()[k] *= std::pow(T(10), T(k % 5 - 2));
+  }
+  return qp;
+}
+
+TEST_CASE("warm started ruiz preconditioner does not depend on the number of "
+          "threads")
+{
+  utils::rand::set_seed(1);
+  isize n = 1000;
+  isize n_eq = 300;
+  isize n_in = 500;
+  SparseQp qp = random_sparse_qp(n, n_eq, n_in, T(0.1));
+  // the values change but not the sparsity structure
+  SparseQp qp_new = qp;
+  for (isize k = 0; k < qp_new.CT.nonZeros(); ++k) {
+    qp_new.CT.valuePtr()[k] *= 1 + T(1e-1) * std::cos(T(k));
+  }
+
+  std::size_t num_threads = proxsuite::helpers::get_default_num_threads();
+  SparseQp qp_scaled[2] = { qp_new, qp_new };
+  proxqp::sparse::preconditioner::RuizEquilibration<T, I> ruiz[2] = {
+    { n, n_eq + n_in }, { n, n_eq + n_in }
+  };
+  for (std::size_t k = 0; k < 2; ++k) {
+    proxsuite::helpers::set_default_omp_options(k == 0 ? 1 : num_threads);
+    VEG_MAKE_STACK(stack,
+                   ruiz[k].scale_qp_in_place_req(
+                     proxsuite::linalg::veg::Tag<T>{}, n, n_eq, n_in));
+    // the passes over the columns of the upper triangular H, AT and CT start
+    // from the scaling of the previous qp
+    SparseQp qp_previous = qp;
+    ruiz[k].scale_qp_in_place(
+      qp_previous.as_mut(), true, 10, 1e-3, false, stack);
+    ruiz[k].scale_qp_in_place(
+      qp_scaled[k].as_mut(), true, 3, 1e-3, true, stack);
+  }
+  proxsuite::helpers::set_default_omp_options(num_threads);
+
+  CHECK(ruiz[0].delta == ruiz[1].delta);
+  CHECK(ruiz[0].c == ruiz[1].c);
+  CHECK(qp_scaled[0].H.isApprox(qp_scaled[1].H, 0));
+  CHECK(qp_scaled[0].AT.isApprox(qp_scaled[1].AT, 0));
+  CHECK(qp_scaled[0].CT.isApprox(qp_scaled[1].CT, 0));
+  CHECK(qp_scaled[0].g == qp_scaled[1].g);
+}
+
+TEST_CASE("warm started ruiz preconditioner")
+{
+  utils::rand::set_seed(1);
+  isize n = 200;
+  isize n_eq = 50;
+  isize n_in = 100;
+  SparseQp qp = random_sparse_qp(n, n_eq, n_in, T(0.05));
+
+  proxqp::sparse::preconditioner::RuizEquilibration<T, I> ruiz{
+    n, n_eq + n_in
+  };
+  VEG_MAKE_STACK(stack,
+                 ruiz.scale_qp_in_place_req(
+                   proxsuite::linalg::veg::Tag<T>{}, n, n_eq, n_in));
+  SparseQp qp_scaled = qp;
+  ruiz.scale_qp_in_place(qp_scaled.as_mut(), true, 10, 1e-3, false, stack);
+
+  // slightly modified matrices
+  SparseQp qp_new = qp;
+  for (isize k = 0; k < qp_new.H.nonZeros(); ++k) {
+    qp_new.H.valuePtr()[k] *= 1 + T(1e-2) * std::cos(T(k));
+  }
+  for (isize k = 0; k < qp_new.AT.nonZeros(); ++k) {
+    qp_new.AT.valuePtr()[k] *= 1 + T(1e-2) * std::sin(T(k));
+  }
+
+  SparseQp qp_cold = qp_new;
+  proxqp::sparse::preconditioner::RuizEquilibration<T, I> ruiz_cold = ruiz;
+  ruiz_cold.scale_qp_in_place(qp_cold.as_mut(), true, 10, 1e-3, false, stack);
+
+  // two passes starting from the previous equilibration
+  SparseQp qp_warm = qp_new;
+  ruiz.scale_qp_in_place(qp_warm.as_mut(), true, 3, 1e-3, true, stack);
+
+  CHECK(equilibration_error(qp_warm.H, qp_warm.AT, qp_warm.CT) <=
+        equilibration_error(qp_cold.H, qp_cold.AT, qp_cold.CT));
+
+  // the scaled qp is the equilibration of the new qp with the final scaling
+  auto head = ruiz.delta.head(n).asDiagonal();
+  auto tail_eq = ruiz.delta.segment(n, n_eq).asDiagonal();
+  auto tail_in = ruiz.delta.tail(n_in).asDiagonal();
+  Eigen::Matrix<T, -1, -1> H_new = Eigen::Matrix<T, -1, -1>(qp_new.H);
+  Eigen::Matrix<T, -1, -1> AT_new = Eigen::Matrix<T, -1, -1>(qp_new.AT);
+  Eigen::Matrix<T, -1, -1> CT_new = Eigen::Matrix<T, -1, -1>(qp_new.CT);
+  H_new = ruiz.c * (head * H_new * head);
+  AT_new = head * AT_new * tail_eq;
+  CT_new = head * CT_new * tail_in;
+  CHECK(Eigen::Matrix<T, -1, -1>(qp_warm.H).isApprox(H_new));
+  CHECK(Eigen::Matrix<T, -1, -1>(qp_warm.AT).isApprox(AT_new));
+  CHECK(Eigen::Matrix<T, -1, -1>(qp_warm.CT).isApprox(CT_new));
+  CHECK(qp_warm.g.isApprox(ruiz.c * (head * qp_new.g)));
+  CHECK(qp_warm.b.isApprox(tail_eq * qp_new.b));
+  CHECK(qp_warm.u.isApprox(tail_in * qp_new.u));
+}